@@ -9,6 +9,8 @@ import '../utils/database_helper.dart';
 import '../utils/logger.dart';
 import '../utils/file_utils.dart';
 import '../config/drive_config.dart';
+import '../optimization/performance_optimizer.dart';
+import '../platform/windows/provider_metrics.dart';
 import 'notification_manager.dart';
 import 'status_manager.dart';
 
@@ -224,6 +226,15 @@ class DriveManager {
       // 데이터베이스 통계
       final stats = await _databaseHelper.getStatistics();
       _statusManager.updateStatistics(stats);
+
+      // 네이티브 provider 지표 (콜백 지연 시간, 큐 깊이 등)
+      if (Platform.isWindows) {
+        final nativeMetrics = ProviderMetricsReader.instance.poll();
+        if (nativeMetrics != null) {
+          PerformanceOptimizer.instance.recordNativeMetrics(nativeMetrics);
+          _statusManager.updateStatistics({'nativeProvider': nativeMetrics.toJson()});
+        }
+      }
     } catch (e) {
       _logger.error('상태 업데이트 실패', e);
     }
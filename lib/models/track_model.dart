@@ -15,7 +15,8 @@ class DriveTrack {
   final String localPath;
   final SyncStatus syncStatus;
   final int? fileSize;
-  final String? fileHash;
+  final String? fileHash; // 파일 전체 SHA-256 (이전 클라이언트 호환)
+  final String? fileTreeHash; // 'sha256t:' 트리 해시 (충돌 감지와 블록 매니페스트 ID)
 
   DriveTrack({
     required this.id,
@@ -32,6 +33,7 @@ class DriveTrack {
     this.syncStatus = SyncStatus.pending,
     this.fileSize,
     this.fileHash,
+    this.fileTreeHash,
   });
 
   /// Firestore 데이터로부터 생성
@@ -55,6 +57,7 @@ class DriveTrack {
       localPath: '$projectLocalPath/Tracks/${data['name']}.wav',
       fileSize: data['fileSize'],
       fileHash: data['fileHash'],
+      fileTreeHash: data['fileTreeHash'],
     );
   }
 
@@ -73,6 +76,7 @@ class DriveTrack {
         'syncStatus': syncStatus.toString(),
         'fileSize': fileSize,
         'fileHash': fileHash,
+        'fileTreeHash': fileTreeHash,
       };
 }
 
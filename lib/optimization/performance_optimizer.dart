@@ -6,6 +6,7 @@ import 'dart:async';
 import 'dart:isolate';
 import 'dart:typed_data';
 import '../utils/logger.dart';
+import '../platform/windows/provider_metrics.dart';
 
 class PerformanceOptimizer {
   static PerformanceOptimizer? _instance;
@@ -23,6 +24,7 @@ class PerformanceOptimizer {
   // 성능 추적
   final Map<String, PerformanceMetrics> _metrics = {};
   final List<TransferTask> _activeTasks = [];
+  NativeProviderMetrics? _nativeMetrics;
   
   PerformanceOptimizer._();
   
@@ -236,6 +238,20 @@ class PerformanceOptimizer {
     _metrics[key]!.addSample(duration, dataSize);
   }
   
+  /// 네이티브 provider 지표 반영
+  /// 이전 스냅샷과의 차이(전송 바이트, 워커 실행 시간)를 하이드레이션 샘플로 기록
+  void recordNativeMetrics(NativeProviderMetrics metrics) {
+    final previous = _nativeMetrics;
+    _nativeMetrics = metrics;
+    if (previous == null) return;
+
+    final bytes = metrics.bytesTransferred - previous.bytesTransferred;
+    final busyTime = metrics.workerBusyTime - previous.workerBusyTime;
+    if (bytes > 0 && busyTime > Duration.zero) {
+      recordMetrics('native_hydration', busyTime, bytes);
+    }
+  }
+  
   /// 성능 통계 조회
   Map<String, dynamic> getPerformanceStats() {
     final stats = <String, dynamic>{};
@@ -246,6 +262,9 @@ class PerformanceOptimizer {
     
     stats['activeTasks'] = _activeTasks.length;
     stats['memoryUsage'] = _getMemoryUsage();
+    if (_nativeMetrics != null) {
+      stats['nativeProvider'] = _nativeMetrics!.toJson();
+    }
     
     return stats;
   }
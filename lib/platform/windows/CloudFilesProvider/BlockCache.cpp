@@ -0,0 +1,709 @@
+#include "BlockCache.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+namespace {
+
+const uint32_t kIndexMagic = 0x4342424D; // "MBBC"
+const uint32_t kIndexVersion = 1;
+
+HRESULT EnsureDirectory(const std::wstring& path) {
+    // 상위 폴더부터 차례로 생성
+    for (size_t separator = path.find_first_of(L"\\/", 3); ; separator = path.find_first_of(L"\\/", separator + 1)) {
+        std::wstring partial = path.substr(0, separator);
+        if (!CreateDirectoryW(partial.c_str(), nullptr) && GetLastError() != ERROR_ALREADY_EXISTS) {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+        if (separator == std::wstring::npos) {
+            return S_OK;
+        }
+    }
+}
+
+HRESULT WriteWholeFile(const std::wstring& path, const BYTE* data, size_t size) {
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+    
+    HRESULT hr = S_OK;
+    while (size > 0) {
+        DWORD written = 0;
+        DWORD toWrite = static_cast<DWORD>((std::min)(size, static_cast<size_t>(MAXDWORD)));
+        if (!WriteFile(file, data, toWrite, &written, nullptr)) {
+            hr = HRESULT_FROM_WIN32(GetLastError());
+            break;
+        }
+        data += written;
+        size -= written;
+    }
+    CloseHandle(file);
+    return hr;
+}
+
+HRESULT ReadWholeFile(const std::wstring& path, std::vector<BYTE>& data) {
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+    
+    LARGE_INTEGER size = {};
+    HRESULT hr = S_OK;
+    if (!GetFileSizeEx(file, &size)) {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+    } else {
+        data.resize(static_cast<size_t>(size.QuadPart));
+        size_t offset = 0;
+        while (offset < data.size()) {
+            DWORD read = 0;
+            DWORD toRead = static_cast<DWORD>((std::min)(data.size() - offset, static_cast<size_t>(MAXDWORD)));
+            if (!ReadFile(file, data.data() + offset, toRead, &read, nullptr) || read == 0) {
+                hr = HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+                break;
+            }
+            offset += read;
+        }
+    }
+    CloseHandle(file);
+    return hr;
+}
+
+// 인덱스 직렬화 도우미
+template <typename T>
+void Append(std::vector<BYTE>& buffer, const T& value) {
+    const BYTE* bytes = reinterpret_cast<const BYTE*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool Consume(const std::vector<BYTE>& buffer, size_t& offset, T& value) {
+    if (buffer.size() - offset < sizeof(T)) {
+        return false;
+    }
+    memcpy(&value, buffer.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+// 원격 데이터를 대상 sink로 넘기면서 완성된 블록을 캐시에 저장하는 sink
+class CacheFillSink : public FetchSink {
+public:
+    CacheFillSink(BlockCache& cache, FetchSink& target, const FetchRequest& request, LONGLONG fetchOffset,
+                  TransferBufferPool* bufferPool)
+        : m_cache(cache), m_target(target), m_request(request), m_position(fetchOffset), m_blockStart(fetchOffset),
+          m_bufferPool(bufferPool) {}
+    
+    HRESULT Write(const BYTE* data, size_t length) override {
+        // 요청 범위에 해당하는 부분만 대상 sink로 전달
+        LONGLONG requestEnd = m_request.offset + m_request.length;
+        LONGLONG start = (std::max)(m_position, m_request.offset);
+        LONGLONG end = (std::min)(m_position + static_cast<LONGLONG>(length), requestEnd);
+        if (start < end) {
+            HRESULT hr = m_target.Write(data + (start - m_position), static_cast<size_t>(end - start));
+            if (FAILED(hr)) {
+                return hr;
+            }
+        }
+        m_position += static_cast<LONGLONG>(length);
+        
+        const size_t blockSize = static_cast<size_t>(m_cache.BlockSize());
+        while (length > 0) {
+            if (!m_block) {
+                m_block = AcquireTransferBuffer(m_bufferPool, blockSize);
+                if (!m_block) {
+                    return E_OUTOFMEMORY;
+                }
+            }
+            size_t copied = (std::min)(length, blockSize - m_blockSize);
+            memcpy(m_block.Data() + m_blockSize, data, copied);
+            m_blockSize += copied;
+            data += copied;
+            length -= copied;
+            if (m_blockSize == blockSize) {
+                CommitBlock();
+            }
+        }
+        return S_OK;
+    }
+    
+    size_t PreferredChunkSize() const override { return m_target.PreferredChunkSize(); }
+    
+    LONGLONG Position() const { return m_position; }
+    
+    // 파일 끝에서 끝나는 마지막 부분 블록 저장
+    void Finish() {
+        if (m_blockSize > 0 && m_position == m_request.fileSize) {
+            CommitBlock();
+        }
+        m_block.Release();
+        m_blockSize = 0;
+    }
+
+private:
+    void CommitBlock() {
+        BlockKey key;
+        key.fileIdentity = m_request.fileIdentity;
+        key.version = m_request.contentVersion;
+        key.blockIndex = static_cast<ULONGLONG>(m_blockStart / m_cache.BlockSize());
+        // 해시와 디스크 기록은 캐시의 기록 스레드가 처리하므로 전송 경로를 막지 않음
+        m_cache.InsertAsync(key, std::move(m_block), m_blockSize);
+        
+        m_blockStart += static_cast<LONGLONG>(m_blockSize);
+        m_blockSize = 0;
+    }
+    
+    BlockCache& m_cache;
+    FetchSink& m_target;
+    const FetchRequest& m_request;
+    LONGLONG m_position;
+    LONGLONG m_blockStart;
+    TransferBufferPool* m_bufferPool;
+    TransferBuffer m_block;
+    size_t m_blockSize = 0;
+};
+
+} // namespace
+
+MappedBlock::~MappedBlock() {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+    }
+    if (m_file != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_file);
+    }
+}
+
+BlockCache::BlockCache(const BlockCacheConfig& config)
+    : m_config(config) {
+}
+
+BlockCache::~BlockCache() {
+    Close();
+}
+
+HRESULT BlockCache::Open() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_open) {
+        return S_OK;
+    }
+    
+    HRESULT hr = EnsureDirectory(m_config.directory);
+    if (FAILED(hr)) {
+        return hr;
+    }
+    
+    // 인덱스가 없거나 손상되었으면 빈 캐시로 시작
+    if (FAILED(LoadIndex())) {
+        m_keys.clear();
+        m_contents.clear();
+        m_lru.clear();
+        m_stats = BlockCacheStats();
+    }
+    ReconcileLocked();
+    EvictLocked();
+    
+    m_open = true;
+    {
+        std::lock_guard<std::mutex> writeLock(m_writeMutex);
+        m_writerRunning = true;
+    }
+    m_writer = std::thread([this]() { WriterLoop(); });
+    return S_OK;
+}
+
+void BlockCache::Close() {
+    // 남은 기록을 마친 뒤 인덱스 저장
+    StopWriter();
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_open) {
+        return;
+    }
+    if (m_indexDirty) {
+        std::vector<BYTE> buffer;
+        SerializeIndexLocked(buffer);
+        if (SUCCEEDED(WriteIndex(buffer))) {
+            m_indexDirty = false;
+            m_stats.indexSaves++;
+        }
+    }
+    m_open = false;
+}
+
+std::shared_ptr<MappedBlock> BlockCache::Lookup(const BlockKey& key) {
+    std::wstring hashHex;
+    ULONGLONG size = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto found = m_keys.find(key);
+        if (found == m_keys.end()) {
+            m_stats.misses++;
+            return nullptr;
+        }
+        hashHex = found->second;
+        ContentEntry& entry = m_contents[hashHex];
+        size = entry.size;
+        Touch(entry);
+    }
+    
+    // 제거와 겹쳐도 열린 매핑은 유지되도록 FILE_SHARE_DELETE로 열기
+    std::wstring path = BlockPath(hashHex);
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    HANDLE mapping = nullptr;
+    const BYTE* data = nullptr;
+    if (file != INVALID_HANDLE_VALUE) {
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            data = static_cast<const BYTE*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+    }
+    
+    if (!data) {
+        // 블록 파일이 사라졌으면 인덱스에서도 제거
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_contents.count(hashHex)) {
+            RemoveContentLocked(hashHex);
+        }
+        m_stats.misses++;
+        return nullptr;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.hits++;
+    }
+    return std::make_shared<MappedBlock>(file, mapping, data, static_cast<size_t>(size));
+}
+
+bool BlockCache::Contains(const BlockKey& key) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_keys.count(key) != 0;
+}
+
+HRESULT BlockCache::Insert(const BlockKey& key, const BYTE* data, size_t size) {
+    if (size == 0 || size > m_config.maxBytes) {
+        return E_INVALIDARG;
+    }
+    
+    ContentHash hash;
+    HRESULT hr = ComputeContentHash(data, size, hash);
+    if (FAILED(hr)) {
+        return hr;
+    }
+    std::wstring hashHex = hash.ToHex();
+    
+    {
+        // 같은 내용이 이미 있으면 키만 연결
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto existing = m_contents.find(hashHex);
+        if (existing != m_contents.end()) {
+            AddKeyLocked(key, hashHex);
+            Touch(existing->second);
+            m_stats.dedupedInsertions++;
+            return S_OK;
+        }
+    }
+    
+    // 임시 파일에 쓴 뒤 이름을 바꿔 불완전한 블록이 보이지 않도록 함
+    std::wstring path = BlockPath(hashHex);
+    std::wstring tempPath = path + L".tmp" + std::to_wstring(GetCurrentThreadId());
+    hr = WriteWholeFile(tempPath, data, size);
+    if (SUCCEEDED(hr) && !MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+    }
+    if (FAILED(hr)) {
+        DeleteFileW(tempPath.c_str());
+        return hr;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_contents.count(hashHex)) {
+        ContentEntry& entry = m_contents[hashHex];
+        entry.size = size;
+        m_lru.push_front(hashHex);
+        entry.lruPosition = m_lru.begin();
+        m_stats.usedBytes += size;
+    }
+    AddKeyLocked(key, hashHex);
+    m_stats.insertions++;
+    EvictLocked();
+    return S_OK;
+}
+
+bool BlockCache::InsertAsync(const BlockKey& key, TransferBuffer buffer, size_t size) {
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        if (!m_writerRunning || m_pendingWrites.size() >= m_config.maxPendingWrites) {
+            m_droppedWrites++;
+            return false;
+        }
+        m_pendingWrites.push_back({ key, std::move(buffer), size });
+    }
+    m_writeAvailable.notify_one();
+    return true;
+}
+
+void BlockCache::FlushPendingWrites() {
+    std::unique_lock<std::mutex> lock(m_writeMutex);
+    m_writesDrained.wait(lock, [this]() { return !m_writerRunning || (m_pendingWrites.empty() && !m_writing); });
+}
+
+void BlockCache::StopWriter() {
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        m_writerRunning = false;
+    }
+    m_writeAvailable.notify_all();
+    m_writesDrained.notify_all();
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+}
+
+void BlockCache::WriterLoop() {
+    auto nextSave = std::chrono::steady_clock::now() + m_config.indexSaveInterval;
+    
+    std::unique_lock<std::mutex> lock(m_writeMutex);
+    while (true) {
+        m_writeAvailable.wait_until(lock, nextSave, [this]() { return !m_writerRunning || !m_pendingWrites.empty(); });
+        
+        if (!m_pendingWrites.empty()) {
+            PendingWrite write = std::move(m_pendingWrites.front());
+            m_pendingWrites.pop_front();
+            m_writing = true;
+            lock.unlock();
+            
+            HRESULT hr = Insert(write.key, write.buffer.Data(), write.size);
+            write.buffer.Release();
+            
+            lock.lock();
+            m_writing = false;
+            if (FAILED(hr)) {
+                m_failedWrites++;
+            }
+            if (m_pendingWrites.empty()) {
+                m_writesDrained.notify_all();
+            }
+        } else if (!m_writerRunning) {
+            // 정지 요청이 와도 큐에 남은 블록은 모두 기록한 뒤 종료 (인덱스는 Close가 저장)
+            break;
+        }
+        
+        // 기록이 계속 들어와도 주기마다 인덱스 저장
+        if (std::chrono::steady_clock::now() >= nextSave) {
+            lock.unlock();
+            SaveIndexIfDirty();
+            lock.lock();
+            nextSave = std::chrono::steady_clock::now() + m_config.indexSaveInterval;
+        }
+    }
+}
+
+void BlockCache::InvalidateFile(const std::string& fileIdentity) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<BlockKey> keys;
+    for (const auto& entry : m_keys) {
+        if (entry.first.fileIdentity == fileIdentity) {
+            keys.push_back(entry.first);
+        }
+    }
+    for (const auto& key : keys) {
+        RemoveKeyLocked(key);
+    }
+}
+
+BlockCacheStats BlockCache::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    BlockCacheStats stats = m_stats;
+    stats.blocks = m_contents.size();
+    stats.keys = m_keys.size();
+    
+    std::lock_guard<std::mutex> writeLock(m_writeMutex);
+    stats.pendingWrites = m_pendingWrites.size() + (m_writing ? 1 : 0);
+    stats.droppedWrites = m_droppedWrites;
+    stats.failedWrites = m_failedWrites;
+    return stats;
+}
+
+std::wstring BlockCache::BlockPath(const std::wstring& hashHex) const {
+    return m_config.directory + L"\\" + hashHex;
+}
+
+std::wstring BlockCache::IndexPath() const {
+    return m_config.directory + L"\\index.bin";
+}
+
+void BlockCache::Touch(ContentEntry& entry) {
+    m_lru.splice(m_lru.begin(), m_lru, entry.lruPosition);
+}
+
+void BlockCache::AddKeyLocked(const BlockKey& key, const std::wstring& hashHex) {
+    auto existing = m_keys.find(key);
+    if (existing != m_keys.end()) {
+        if (existing->second == hashHex) {
+            return;
+        }
+        RemoveKeyLocked(key);
+    }
+    m_keys[key] = hashHex;
+    m_contents[hashHex].keys.push_back(key);
+    m_indexDirty = true;
+}
+
+void BlockCache::RemoveKeyLocked(const BlockKey& key) {
+    auto found = m_keys.find(key);
+    if (found == m_keys.end()) {
+        return;
+    }
+    std::wstring hashHex = found->second;
+    m_keys.erase(found);
+    m_indexDirty = true;
+    
+    ContentEntry& entry = m_contents[hashHex];
+    entry.keys.erase(std::remove(entry.keys.begin(), entry.keys.end(), key), entry.keys.end());
+    if (entry.keys.empty()) {
+        RemoveContentLocked(hashHex);
+    }
+}
+
+void BlockCache::RemoveContentLocked(const std::wstring& hashHex) {
+    auto found = m_contents.find(hashHex);
+    if (found == m_contents.end()) {
+        return;
+    }
+    
+    for (const auto& key : found->second.keys) {
+        m_keys.erase(key);
+    }
+    m_lru.erase(found->second.lruPosition);
+    m_stats.usedBytes -= found->second.size;
+    m_contents.erase(found);
+    m_indexDirty = true;
+    
+    DeleteFileW(BlockPath(hashHex).c_str());
+}
+
+void BlockCache::EvictLocked() {
+    while (m_stats.usedBytes > m_config.maxBytes && !m_lru.empty()) {
+        std::wstring victim = m_lru.back();
+        RemoveContentLocked(victim);
+        m_stats.evictions++;
+    }
+}
+
+void BlockCache::ReconcileLocked() {
+    // 마지막 인덱스 저장 뒤에 기록되었거나 지워진 블록을 정리
+    // (인덱스에 없는 블록은 어느 파일의 블록인지 알 수 없으므로 지움)
+    std::unordered_set<std::wstring> present;
+    WIN32_FIND_DATAW findData;
+    HANDLE find = FindFirstFileW((m_config.directory + L"\\*").c_str(), &findData);
+    if (find != INVALID_HANDLE_VALUE) {
+        do {
+            if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+                continue;
+            }
+            std::wstring name = findData.cFileName;
+            if (m_contents.count(name)) {
+                present.insert(name);
+                continue;
+            }
+            if (name == L"index.bin") {
+                continue;
+            }
+            // 인덱스에 없는 블록이나 중단된 기록의 임시 파일
+            DeleteFileW((m_config.directory + L"\\" + name).c_str());
+            m_stats.orphanedFiles++;
+        } while (FindNextFileW(find, &findData));
+        FindClose(find);
+    }
+    
+    std::vector<std::wstring> missing;
+    for (const auto& entry : m_contents) {
+        if (!present.count(entry.first)) {
+            missing.push_back(entry.first);
+        }
+    }
+    for (const auto& hashHex : missing) {
+        RemoveContentLocked(hashHex);
+        m_stats.missingBlocks++;
+    }
+}
+
+HRESULT BlockCache::LoadIndex() {
+    std::vector<BYTE> buffer;
+    HRESULT hr = ReadWholeFile(IndexPath(), buffer);
+    if (FAILED(hr)) {
+        return hr;
+    }
+    
+    size_t offset = 0;
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t contentCount = 0;
+    if (!Consume(buffer, offset, magic) || !Consume(buffer, offset, version) || !Consume(buffer, offset, contentCount) ||
+        magic != kIndexMagic || version != kIndexVersion) {
+        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+    
+    // 저장 순서가 LRU 순서 (최근 사용이 먼저)
+    for (uint64_t i = 0; i < contentCount; ++i) {
+        char hashHex[64];
+        uint64_t size = 0;
+        uint32_t keyCount = 0;
+        if (!Consume(buffer, offset, hashHex) || !Consume(buffer, offset, size) || !Consume(buffer, offset, keyCount)) {
+            return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        }
+        
+        std::wstring hex(hashHex, hashHex + sizeof(hashHex));
+        ContentEntry& entry = m_contents[hex];
+        entry.size = size;
+        m_lru.push_back(hex);
+        entry.lruPosition = std::prev(m_lru.end());
+        m_stats.usedBytes += size;
+        
+        for (uint32_t k = 0; k < keyCount; ++k) {
+            uint32_t identityLength = 0;
+            BlockKey key;
+            if (!Consume(buffer, offset, identityLength) || buffer.size() - offset < identityLength) {
+                return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+            }
+            key.fileIdentity.assign(reinterpret_cast<const char*>(buffer.data() + offset), identityLength);
+            offset += identityLength;
+            if (!Consume(buffer, offset, key.version) || !Consume(buffer, offset, key.blockIndex)) {
+                return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+            }
+            m_keys[key] = hex;
+            entry.keys.push_back(key);
+        }
+    }
+    
+    return S_OK;
+}
+
+void BlockCache::SerializeIndexLocked(std::vector<BYTE>& buffer) {
+    Append(buffer, kIndexMagic);
+    Append(buffer, kIndexVersion);
+    Append(buffer, static_cast<uint64_t>(m_lru.size()));
+    
+    for (const auto& hex : m_lru) {
+        const ContentEntry& entry = m_contents[hex];
+        for (size_t i = 0; i < 64; ++i) {
+            buffer.push_back(static_cast<BYTE>(i < hex.size() ? hex[i] : L'0'));
+        }
+        Append(buffer, static_cast<uint64_t>(entry.size));
+        Append(buffer, static_cast<uint32_t>(entry.keys.size()));
+        for (const auto& key : entry.keys) {
+            Append(buffer, static_cast<uint32_t>(key.fileIdentity.size()));
+            buffer.insert(buffer.end(), key.fileIdentity.begin(), key.fileIdentity.end());
+            Append(buffer, static_cast<ULONGLONG>(key.version));
+            Append(buffer, static_cast<ULONGLONG>(key.blockIndex));
+        }
+    }
+}
+
+HRESULT BlockCache::WriteIndex(const std::vector<BYTE>& buffer) const {
+    std::wstring tempPath = IndexPath() + L".tmp";
+    HRESULT hr = WriteWholeFile(tempPath, buffer.data(), buffer.size());
+    if (SUCCEEDED(hr) && !MoveFileExW(tempPath.c_str(), IndexPath().c_str(), MOVEFILE_REPLACE_EXISTING)) {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+    }
+    return hr;
+}
+
+HRESULT BlockCache::SaveIndexIfDirty() {
+    // 직렬화만 잠금 안에서 하고 파일 기록은 잠금 밖에서
+    std::vector<BYTE> buffer;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_indexDirty) {
+            return S_OK;
+        }
+        SerializeIndexLocked(buffer);
+        m_indexDirty = false;
+    }
+    
+    HRESULT hr = WriteIndex(buffer);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (FAILED(hr)) {
+        m_indexDirty = true;
+    } else {
+        m_stats.indexSaves++;
+    }
+    return hr;
+}
+
+HRESULT FetchThroughBlockCache(BlockCache& cache, const StreamingFetchCallback& upstream, const FetchRequest& request, FetchSink& sink,
+                               TransferBufferPool* bufferPool) {
+    if (request.fileIdentity.empty() || request.length <= 0) {
+        return upstream(request, sink);
+    }
+    
+    const LONGLONG blockSize = cache.BlockSize();
+    const LONGLONG end = request.offset + request.length;
+    const LONGLONG fileEnd = request.fileSize > 0 ? request.fileSize : end;
+    
+    BlockKey key;
+    key.fileIdentity = request.fileIdentity;
+    key.version = request.contentVersion;
+    
+    ULONGLONG block = static_cast<ULONGLONG>(request.offset / blockSize);
+    const ULONGLONG lastBlock = static_cast<ULONGLONG>((end - 1) / blockSize);
+    while (block <= lastBlock) {
+        if (request.cancelToken && request.cancelToken->IsCancelled()) {
+            return HRESULT_FROM_WIN32(ERROR_CANCELLED);
+        }
+        
+        // 캐시 적중: 매핑된 블록을 그대로 sink에 기록
+        const LONGLONG blockStart = static_cast<LONGLONG>(block) * blockSize;
+        const LONGLONG expectedSize = (std::min)(blockSize, fileEnd - blockStart);
+        key.blockIndex = block;
+        auto mapped = cache.Lookup(key);
+        if (mapped && static_cast<LONGLONG>(mapped->Size()) >= expectedSize) {
+            LONGLONG start = (std::max)(blockStart, request.offset);
+            LONGLONG stop = (std::min)(blockStart + expectedSize, end);
+            HRESULT hr = sink.Write(mapped->Data() + (start - blockStart), static_cast<size_t>(stop - start));
+            if (FAILED(hr)) {
+                return hr;
+            }
+            block++;
+            continue;
+        }
+        
+        // 캐시 미스: 연속으로 빠진 블록 구간을 블록 경계로 맞춰 한 번에 가져옴
+        ULONGLONG runEnd = block;
+        for (BlockKey next = key; runEnd < lastBlock; ++runEnd) {
+            next.blockIndex = runEnd + 1;
+            if (cache.Contains(next)) {
+                break;
+            }
+        }
+        
+        FetchRequest upstreamRequest = request;
+        upstreamRequest.offset = blockStart;
+        upstreamRequest.length = (std::min)(static_cast<LONGLONG>(runEnd + 1) * blockSize, fileEnd) - blockStart;
+        
+        CacheFillSink fillSink(cache, sink, request, upstreamRequest.offset, bufferPool);
+        HRESULT hr = upstream(upstreamRequest, fillSink);
+        if (FAILED(hr)) {
+            return hr;
+        }
+        fillSink.Finish();
+        if (fillSink.Position() < upstreamRequest.offset + upstreamRequest.length) {
+            return HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+        }
+        
+        block = runEnd + 1;
+    }
+    
+    return S_OK;
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include <vector>
+#include <list>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <unordered_map>
+
+#include "ContentHash.h"
+#include "FetchStream.h"
+
+// 블록 캐시 설정
+struct BlockCacheConfig {
+    std::wstring directory;                               // 비어 있으면 DriveConfig.cachePath 아래 Blocks
+    ULONGLONG maxBytes = 10ULL * 1024 * 1024 * 1024;      // 0이면 캐시 사용 안 함
+    LONGLONG blockSize = 4 * 1024 * 1024;                 // TRANSFER_DATA 청크 크기와 같게 유지
+    size_t maxPendingWrites = 8;                          // 백그라운드 기록 대기 블록 수 (넘으면 그 블록은 캐시하지 않음)
+    std::chrono::milliseconds indexSaveInterval{ 30000 }; // 바뀐 인덱스를 디스크에 저장하는 주기
+};
+
+// (파일 식별자, 버전, 블록 번호)
+struct BlockKey {
+    std::string fileIdentity;
+    ULONGLONG version = 0;
+    ULONGLONG blockIndex = 0;
+    
+    bool operator==(const BlockKey& other) const {
+        return blockIndex == other.blockIndex && version == other.version && fileIdentity == other.fileIdentity;
+    }
+};
+
+struct BlockKeyHash {
+    size_t operator()(const BlockKey& key) const {
+        size_t hash = std::hash<std::string>()(key.fileIdentity);
+        hash ^= std::hash<ULONGLONG>()(key.version) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<ULONGLONG>()(key.blockIndex) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+};
+
+// 메모리 맵으로 연 캐시 블록 (소멸 시 매핑 해제)
+class MappedBlock {
+public:
+    MappedBlock(HANDLE file, HANDLE mapping, const BYTE* data, size_t size)
+        : m_file(file), m_mapping(mapping), m_data(data), m_size(size) {}
+    ~MappedBlock();
+    MappedBlock(const MappedBlock&) = delete;
+    MappedBlock& operator=(const MappedBlock&) = delete;
+    
+    const BYTE* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+
+private:
+    HANDLE m_file;
+    HANDLE m_mapping;
+    const BYTE* m_data;
+    size_t m_size;
+};
+
+struct BlockCacheStats {
+    ULONGLONG usedBytes = 0;
+    size_t blocks = 0;         // 고유 콘텐츠 블록 수
+    size_t keys = 0;           // 블록을 가리키는 (파일, 버전, 블록) 수
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t insertions = 0;
+    uint64_t dedupedInsertions = 0;
+    uint64_t evictions = 0;
+    size_t pendingWrites = 0;      // 백그라운드 기록 대기 중인 블록
+    uint64_t droppedWrites = 0;    // 기록 큐가 가득 차서 캐시하지 않은 블록
+    uint64_t failedWrites = 0;
+    uint64_t indexSaves = 0;
+    uint64_t orphanedFiles = 0;    // 열 때 인덱스에 없어서 지운 블록 파일
+    uint64_t missingBlocks = 0;    // 열 때 파일이 없어서 인덱스에서 뺀 블록
+};
+
+// 디하이드레이트된 파일을 네트워크 없이 다시 채우기 위한 디스크 블록 저장소
+// 블록은 SHA-256 콘텐츠 해시 이름으로 저장되어 같은 내용은 한 번만 저장되고, 용량 초과 시 LRU로 제거됨
+// 인덱스는 바뀌었을 때 주기적으로 저장하고, 열 때 디렉토리와 맞춰 비정상 종료로 어긋난 부분을 정리함
+class BlockCache {
+public:
+    explicit BlockCache(const BlockCacheConfig& config);
+    ~BlockCache();
+    
+    HRESULT Open();
+    void Close();
+    
+    LONGLONG BlockSize() const { return m_config.blockSize; }
+    
+    std::shared_ptr<MappedBlock> Lookup(const BlockKey& key);
+    bool Contains(const BlockKey& key) const;
+    HRESULT Insert(const BlockKey& key, const BYTE* data, size_t size);
+    
+    // 해시 계산과 파일 기록을 백그라운드 스레드로 넘김 (큐가 가득 찼거나 닫혀 있으면 false)
+    bool InsertAsync(const BlockKey& key, TransferBuffer buffer, size_t size);
+    
+    // 지금까지 InsertAsync로 넘긴 블록이 모두 기록될 때까지 대기
+    void FlushPendingWrites();
+    
+    // 파일의 모든 버전 블록 연결 해제 (원격 파일이 바뀌었거나 삭제됨)
+    void InvalidateFile(const std::string& fileIdentity);
+    
+    BlockCacheStats GetStats() const;
+
+private:
+    struct ContentEntry {
+        ULONGLONG size = 0;
+        std::vector<BlockKey> keys;
+        std::list<std::wstring>::iterator lruPosition;
+    };
+    
+    struct PendingWrite {
+        BlockKey key;
+        TransferBuffer buffer;
+        size_t size = 0;
+    };
+    
+    std::wstring BlockPath(const std::wstring& hashHex) const;
+    std::wstring IndexPath() const;
+    void Touch(ContentEntry& entry);
+    void AddKeyLocked(const BlockKey& key, const std::wstring& hashHex);
+    void RemoveKeyLocked(const BlockKey& key);
+    void RemoveContentLocked(const std::wstring& hashHex);
+    void EvictLocked();
+    void ReconcileLocked();
+    HRESULT LoadIndex();
+    void SerializeIndexLocked(std::vector<BYTE>& buffer);
+    HRESULT WriteIndex(const std::vector<BYTE>& buffer) const;
+    HRESULT SaveIndexIfDirty();
+    void StopWriter();
+    void WriterLoop();
+    
+    BlockCacheConfig m_config;
+    bool m_open = false;
+    
+    mutable std::mutex m_mutex;
+    std::unordered_map<BlockKey, std::wstring, BlockKeyHash> m_keys;
+    std::unordered_map<std::wstring, ContentEntry> m_contents;
+    std::list<std::wstring> m_lru;  // 앞쪽이 가장 최근
+    bool m_indexDirty = false;
+    BlockCacheStats m_stats;
+    
+    // 백그라운드 기록 (m_writeMutex 보호, m_mutex를 잡은 채로 잡지 않음)
+    std::thread m_writer;
+    mutable std::mutex m_writeMutex;
+    std::condition_variable m_writeAvailable;
+    std::condition_variable m_writesDrained;
+    bool m_writerRunning = false;
+    bool m_writing = false;
+    std::deque<PendingWrite> m_pendingWrites;
+    uint64_t m_droppedWrites = 0;
+    uint64_t m_failedWrites = 0;
+};
+
+// 블록 캐시를 거쳐 fetch: 캐시된 블록은 디스크에서 바로 쓰고, 빠진 블록 구간만 원격에서 받아 캐시에 채움
+HRESULT FetchThroughBlockCache(BlockCache& cache, const StreamingFetchCallback& upstream,
+                               const FetchRequest& request, FetchSink& sink,
+                               TransferBufferPool* bufferPool = nullptr);
@@ -0,0 +1,316 @@
+#include "BlockManifest.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include "FetchExecutor.h"
+
+namespace {
+
+const uint32_t kManifestMagic = 0x4D42424D; // "MBBM"
+const uint32_t kManifestVersion = 1;
+const LONGLONG kBlockAlignment = 4096;
+
+// 파일에 그대로 저장되는 헤더 (뒤에 blockCount개의 32바이트 해시)
+struct ManifestFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    int64_t fileSize;
+    int64_t blockSize;
+    uint64_t blockCount;
+};
+
+static_assert(sizeof(ManifestFileHeader) == 32, "ManifestFileHeader layout");
+static_assert(sizeof(ContentHash) == 32, "ContentHash layout");
+
+HRESULT EnsureDirectory(const std::wstring& path) {
+    // 상위 폴더부터 차례로 생성
+    for (size_t separator = path.find_first_of(L"\\/", 3); ; separator = path.find_first_of(L"\\/", separator + 1)) {
+        std::wstring partial = path.substr(0, separator);
+        if (!CreateDirectoryW(partial.c_str(), nullptr) && GetLastError() != ERROR_ALREADY_EXISTS) {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+        if (separator == std::wstring::npos) {
+            return S_OK;
+        }
+    }
+}
+
+HRESULT ReadExact(HANDLE file, void* data, size_t size) {
+    BYTE* bytes = static_cast<BYTE*>(data);
+    while (size > 0) {
+        DWORD read = 0;
+        DWORD toRead = static_cast<DWORD>((std::min)(size, static_cast<size_t>(MAXDWORD)));
+        if (!ReadFile(file, bytes, toRead, &read, nullptr)) {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+        if (read == 0) {
+            return HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+        }
+        bytes += read;
+        size -= read;
+    }
+    return S_OK;
+}
+
+HRESULT WriteAll(HANDLE file, const void* data, size_t size) {
+    const BYTE* bytes = static_cast<const BYTE*>(data);
+    while (size > 0) {
+        DWORD written = 0;
+        DWORD toWrite = static_cast<DWORD>((std::min)(size, static_cast<size_t>(MAXDWORD)));
+        if (!WriteFile(file, bytes, toWrite, &written, nullptr)) {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+        bytes += written;
+        size -= written;
+    }
+    return S_OK;
+}
+
+} // namespace
+
+size_t BlockManifest::ExpectedBlockCount() const {
+    if (blockSize <= 0 || fileSize <= 0) {
+        return 0;
+    }
+    return static_cast<size_t>((fileSize + blockSize - 1) / blockSize);
+}
+
+bool BlockManifest::IsConsistent() const {
+    return blockSize > 0 && blockSize % kBlockAlignment == 0 && static_cast<ULONGLONG>(blockSize) <= MAXULONG &&
+           fileSize >= 0 && blockHashes.size() == ExpectedBlockCount();
+}
+
+BlockManifestStore::BlockManifestStore(const std::wstring& directory, size_t cacheCapacity)
+    : m_directory(directory), m_cacheCapacity((std::max)(cacheCapacity, static_cast<size_t>(1))) {
+}
+
+HRESULT BlockManifestStore::Open() {
+    return EnsureDirectory(m_directory);
+}
+
+std::wstring BlockManifestStore::ManifestPath(const std::string& key) const {
+    static const wchar_t digits[] = L"0123456789abcdef";
+    std::wstring path = m_directory + L"\\";
+    for (char value : key) {
+        BYTE byte = static_cast<BYTE>(value);
+        path.push_back(digits[byte >> 4]);
+        path.push_back(digits[byte & 0x0F]);
+    }
+    return path + L".mbm";
+}
+
+HRESULT BlockManifestStore::Put(const BYTE* manifestId, const BlockManifest& manifest) {
+    if (!manifestId || !manifest.IsConsistent()) {
+        return E_INVALIDARG;
+    }
+    std::string key(reinterpret_cast<const char*>(manifestId), kManifestIdSize);
+
+    ManifestFileHeader header = {};
+    header.magic = kManifestMagic;
+    header.version = kManifestVersion;
+    header.fileSize = manifest.fileSize;
+    header.blockSize = manifest.blockSize;
+    header.blockCount = manifest.blockHashes.size();
+
+    // 임시 파일에 쓴 뒤 교체
+    std::wstring path = ManifestPath(key);
+    std::wstring tempPath = path + L".tmp";
+    HANDLE file = CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+    HRESULT hr = WriteAll(file, &header, sizeof(header));
+    if (SUCCEEDED(hr)) {
+        hr = WriteAll(file, manifest.blockHashes.data(), manifest.blockHashes.size() * sizeof(ContentHash));
+    }
+    CloseHandle(file);
+
+    if (SUCCEEDED(hr) && !MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+    }
+    if (FAILED(hr)) {
+        DeleteFileW(tempPath.c_str());
+        return hr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    CacheLocked(key, std::make_shared<const BlockManifest>(manifest));
+    return S_OK;
+}
+
+std::shared_ptr<const BlockManifest> BlockManifestStore::Find(const BYTE* manifestId) {
+    if (!manifestId) {
+        return nullptr;
+    }
+    std::string key(reinterpret_cast<const char*>(manifestId), kManifestIdSize);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto cached = m_cache.find(key);
+        if (cached != m_cache.end()) {
+            m_lru.splice(m_lru.begin(), m_lru, cached->second.lruPosition);
+            return cached->second.manifest;
+        }
+    }
+
+    // 메모리에 없으면 디스크에서 읽음 (잠금 밖에서 읽고 캐시에만 잠금)
+    HANDLE file = CreateFileW(ManifestPath(key).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+
+    auto manifest = std::make_shared<BlockManifest>();
+    ManifestFileHeader header = {};
+    HRESULT hr = ReadExact(file, &header, sizeof(header));
+    if (SUCCEEDED(hr) && (header.magic != kManifestMagic || header.version != kManifestVersion)) {
+        hr = HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+    if (SUCCEEDED(hr)) {
+        manifest->fileSize = header.fileSize;
+        manifest->blockSize = header.blockSize;
+        // 헤더가 손상되어 블록 수가 터무니없으면 할당 전에 거름
+        LARGE_INTEGER fileSize = {};
+        if (header.blockCount != manifest->ExpectedBlockCount() || !GetFileSizeEx(file, &fileSize) ||
+            static_cast<ULONGLONG>(fileSize.QuadPart) != sizeof(header) + header.blockCount * sizeof(ContentHash)) {
+            hr = HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        }
+    }
+    if (SUCCEEDED(hr)) {
+        manifest->blockHashes.resize(static_cast<size_t>(header.blockCount));
+        hr = ReadExact(file, manifest->blockHashes.data(), manifest->blockHashes.size() * sizeof(ContentHash));
+    }
+    CloseHandle(file);
+    if (FAILED(hr) || !manifest->IsConsistent()) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    CacheLocked(key, manifest);
+    return manifest;
+}
+
+void BlockManifestStore::Remove(const BYTE* manifestId) {
+    if (!manifestId) {
+        return;
+    }
+    std::string key(reinterpret_cast<const char*>(manifestId), kManifestIdSize);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto cached = m_cache.find(key);
+    if (cached != m_cache.end()) {
+        m_lru.erase(cached->second.lruPosition);
+        m_cache.erase(cached);
+    }
+    DeleteFileW(ManifestPath(key).c_str());
+}
+
+void BlockManifestStore::CacheLocked(const std::string& key, std::shared_ptr<const BlockManifest> manifest) {
+    auto cached = m_cache.find(key);
+    if (cached != m_cache.end()) {
+        cached->second.manifest = std::move(manifest);
+        m_lru.splice(m_lru.begin(), m_lru, cached->second.lruPosition);
+        return;
+    }
+
+    m_lru.push_front(key);
+    m_cache[key] = CachedManifest{ std::move(manifest), m_lru.begin() };
+    while (m_cache.size() > m_cacheCapacity) {
+        m_cache.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+}
+
+HRESULT VerifyBlockRange(const BlockManifest& manifest, LONGLONG offset, LONGLONG length, const BlockReader& reader,
+                         TransferBufferPool* bufferPool, FetchExecutor* executor, size_t threadCount,
+                         BlockVerification& result) {
+    result = BlockVerification();
+    if (!manifest.IsConsistent() || !reader || offset < 0 || length <= 0 || offset >= manifest.fileSize) {
+        return E_INVALIDARG;
+    }
+
+    const LONGLONG blockSize = manifest.blockSize;
+    const LONGLONG end = (std::min)(offset + length, manifest.fileSize);
+    const size_t firstBlock = static_cast<size_t>(offset / blockSize);
+    const size_t blockCount = static_cast<size_t>((end - 1) / blockSize) - firstBlock + 1;
+    result.firstBlock = firstBlock;
+    result.verified.assign(blockCount, 0);
+
+    std::atomic<size_t> nextBlock{ 0 };
+    std::atomic<ULONGLONG> bytesHashed{ 0 };
+
+    // 각 스레드가 다음 블록을 가져가 읽고 해시 (블록 순서와 무관하게 끝나는 대로 다음 블록)
+    auto worker = [&]() {
+        TransferBuffer buffer = AcquireTransferBuffer(bufferPool, static_cast<size_t>(blockSize));
+        if (!buffer) {
+            return;
+        }
+        for (size_t index = nextBlock++; index < blockCount; index = nextBlock++) {
+            const size_t block = firstBlock + index;
+            const LONGLONG blockOffset = static_cast<LONGLONG>(block) * blockSize;
+            const LONGLONG blockLength = (std::min)(blockSize, manifest.fileSize - blockOffset);
+
+            // 한 번에 다 읽히지 않을 수 있으므로 블록 끝까지 이어 읽음
+            LONGLONG filled = 0;
+            while (filled < blockLength) {
+                LONGLONG returned = 0;
+                HRESULT hr = reader(buffer.Data() + filled, blockOffset + filled, blockLength - filled, returned);
+                if (FAILED(hr) || returned <= 0) {
+                    break;
+                }
+                filled += returned;
+            }
+            if (filled != blockLength) {
+                continue;  // 잘린 데이터는 불일치
+            }
+
+            ContentHash hash;
+            if (SUCCEEDED(ComputeContentHash(buffer.Data(), static_cast<size_t>(blockLength), hash))) {
+                result.verified[index] = hash == manifest.blockHashes[block] ? 1 : 0;
+                bytesHashed += static_cast<ULONGLONG>(blockLength);
+            }
+        }
+    };
+
+    // 도우미는 이 호출이 끝난 뒤에 시작될 수도 있으므로 공유 상태로 참여 여부를 정함
+    // 호출한 스레드가 끝나면 닫아서 늦게 시작한 도우미는 스택의 상태를 건드리지 않고 바로 반환
+    struct HelperState {
+        std::mutex mutex;
+        std::condition_variable idle;
+        bool closed = false;
+        size_t active = 0;
+    };
+    auto helpers = std::make_shared<HelperState>();
+    
+    const size_t threads = (std::min)((std::max)(threadCount, static_cast<size_t>(1)), blockCount);
+    if (executor) {
+        for (size_t i = 1; i < threads; ++i) {
+            executor->Submit(std::wstring(), HydrationPriority::Foreground, [helpers, &worker]() {
+                {
+                    std::lock_guard<std::mutex> lock(helpers->mutex);
+                    if (helpers->closed) {
+                        return;
+                    }
+                    helpers->active++;
+                }
+                worker();
+                std::lock_guard<std::mutex> lock(helpers->mutex);
+                if (--helpers->active == 0) {
+                    helpers->idle.notify_all();
+                }
+            });
+        }
+    }
+    worker();
+    
+    // 모든 블록을 누군가 가져갔으므로 이미 시작한 도우미가 현재 블록을 마칠 때까지만 기다림
+    {
+        std::unique_lock<std::mutex> lock(helpers->mutex);
+        helpers->closed = true;
+        helpers->idle.wait(lock, [&helpers] { return helpers->active == 0; });
+    }
+    
+    result.bytesHashed = bytesHashed.load();
+    return S_OK;
+}
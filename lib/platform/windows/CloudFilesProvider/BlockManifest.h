@@ -0,0 +1,93 @@
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include <unordered_map>
+
+#include "ContentHash.h"
+#include "TransferBufferPool.h"
+
+class FetchExecutor;
+
+// 매니페스트 ID 크기 (PlaceholderIdentity.manifestId)
+constexpr size_t kManifestIdSize = 16;
+
+// 하이드레이션 데이터 검증 설정
+struct DataValidationConfig {
+    bool enabled = false;                 // 켜면 하이드레이션된 범위마다 VALIDATE_DATA를 받아 블록 해시로 확인
+    // 매니페스트가 없는 파일을 실패로 응답 (끄면 확인 없이 ACK하고 unverifiedValidations로 셈)
+    // 매니페스트는 이 기기에서 올린 파일에만 있으므로, 다른 기기에서 올린 파일을 열 수 있도록 기본값은 꺼 둠
+    bool requireManifest = false;
+    size_t verifyThreads = 0;             // 범위 하나를 나눠 해시할 스레드 수 (0이면 코어 수, 최대 8)
+    std::wstring manifestDirectory;       // 비어 있으면 DriveConfig.cachePath 아래 Manifests
+    size_t cachedManifests = 256;         // 메모리에 유지할 매니페스트 수
+};
+
+// 파일 하나의 블록 해시 목록
+// 블록 i는 [i * blockSize, min((i + 1) * blockSize, fileSize)) 구간의 SHA-256
+struct BlockManifest {
+    LONGLONG fileSize = 0;
+    LONGLONG blockSize = 0;
+    std::vector<ContentHash> blockHashes;
+
+    size_t ExpectedBlockCount() const;
+
+    // 블록 크기가 4KB 정렬이고 블록 수가 파일 크기와 맞는지
+    bool IsConsistent() const;
+};
+
+// 매니페스트 ID(PlaceholderIdentity.manifestId, 16바이트)로 찾는 블록 매니페스트 저장소
+// ID별 파일로 저장해 재시작 후에도 검증할 수 있고, 최근 사용한 매니페스트는 메모리에 둠
+class BlockManifestStore {
+public:
+    BlockManifestStore(const std::wstring& directory, size_t cacheCapacity);
+
+    BlockManifestStore(const BlockManifestStore&) = delete;
+    BlockManifestStore& operator=(const BlockManifestStore&) = delete;
+
+    HRESULT Open();
+
+    HRESULT Put(const BYTE* manifestId, const BlockManifest& manifest);
+    std::shared_ptr<const BlockManifest> Find(const BYTE* manifestId);
+    void Remove(const BYTE* manifestId);
+
+private:
+    struct CachedManifest {
+        std::shared_ptr<const BlockManifest> manifest;
+        std::list<std::string>::iterator lruPosition;
+    };
+
+    std::wstring ManifestPath(const std::string& key) const;
+    void CacheLocked(const std::string& key, std::shared_ptr<const BlockManifest> manifest);
+
+    std::wstring m_directory;
+    size_t m_cacheCapacity;
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, CachedManifest> m_cache;
+    std::list<std::string> m_lru;  // 앞쪽이 가장 최근
+};
+
+// 범위 검증 결과 (범위와 겹치는 첫 블록부터 블록마다 1이면 해시 일치)
+struct BlockVerification {
+    size_t firstBlock = 0;
+    std::vector<BYTE> verified;
+    ULONGLONG bytesHashed = 0;
+};
+
+// 파일의 [offset, offset + length)를 buffer로 읽음 (읽은 바이트 수는 returned)
+using BlockReader = std::function<HRESULT(BYTE* buffer, LONGLONG offset, LONGLONG length, LONGLONG& returned)>;
+
+// 범위와 겹치는 블록을 모두 읽어 매니페스트와 비교
+// 호출한 스레드와 executor에 넣은 threadCount - 1개의 도우미 작업이 블록을 나눠 읽고 해시하며
+// (SHA-256은 CNG가 SHA 확장 명령으로 계산), 스레드마다 블록 하나 크기의 버퍼만 사용함
+// 도우미는 호출마다 스레드를 만들지 않고 executor 워커에서 돌며, 시작하지 못한 도우미는 기다리지 않으므로
+// executor가 없거나 바쁘면 호출한 스레드가 나머지 블록을 모두 처리함. 읽기에 실패하거나 짧게 읽힌 블록은 불일치로 기록
+HRESULT VerifyBlockRange(const BlockManifest& manifest, LONGLONG offset, LONGLONG length, const BlockReader& reader,
+                         TransferBufferPool* bufferPool, FetchExecutor* executor, size_t threadCount,
+                         BlockVerification& result);
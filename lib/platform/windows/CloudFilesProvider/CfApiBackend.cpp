@@ -0,0 +1,546 @@
+#include "CfApiBackend.h"
+#include "CloudFilesProvider.h"
+#include "PlaceholderIdentity.h"
+#include "Logger.h"
+#include <algorithm>
+
+CfApiBackend::~CfApiBackend() {
+    Disconnect();
+}
+
+HRESULT CfApiBackend::Connect(const std::wstring& syncRootPath, const std::wstring& displayName,
+                              const BackendSyncPolicy& policy, ProviderBackendEvents* events) {
+    m_syncRootPath = syncRootPath;
+    m_syncRootVolumePath = syncRootPath.size() >= 2 && syncRootPath[1] == L':' ? syncRootPath.substr(2) : syncRootPath;
+    m_events = events;
+
+    // 디렉토리 생성
+    if (!CreateDirectoryW(syncRootPath.c_str(), nullptr) && GetLastError() != ERROR_ALREADY_EXISTS) {
+        DWORD error = GetLastError();
+        MBD_LOG_ERROR(L"Failed to create sync root directory: ", error);
+        return HRESULT_FROM_WIN32(error);
+    }
+
+    // 동기화 등록 구조체와 정책 생성
+    CF_SYNC_REGISTRATION registration = {};
+    CF_SYNC_POLICIES policies = {};
+    HRESULT hr = CreateSyncRegistration(displayName, policy, registration, policies);
+    if (FAILED(hr)) {
+        return hr;
+    }
+
+    // 동기화 루트 등록 (정책은 등록 구조체가 아닌 별도 인자로 전달)
+    hr = CfRegisterSyncRoot(syncRootPath.c_str(), &registration, &policies, CF_REGISTER_FLAG_NONE);
+    if (FAILED(hr)) {
+        MBD_LOG_ERROR(L"Failed to register sync root: ", LogHex(hr));
+        return hr;
+    }
+
+    // 콜백 등록
+    std::vector<CF_CALLBACK_REGISTRATION> callbackTable = {
+        { CF_CALLBACK_TYPE_FETCH_DATA, OnFetchData },
+        { CF_CALLBACK_TYPE_VALIDATE_DATA, OnValidateData },
+        { CF_CALLBACK_TYPE_CANCEL_FETCH_DATA, OnCancelFetchData },
+        { CF_CALLBACK_TYPE_NOTIFY_FILE_OPEN_COMPLETION, OnNotifyFileOpenCompletion },
+        { CF_CALLBACK_TYPE_NOTIFY_FILE_CLOSE_COMPLETION, OnNotifyFileCloseCompletion },
+        { CF_CALLBACK_TYPE_NOTIFY_DEHYDRATE, OnNotifyDehydrate },
+        { CF_CALLBACK_TYPE_NOTIFY_DEHYDRATE_COMPLETION, OnNotifyDehydrateCompletion },
+        { CF_CALLBACK_TYPE_NOTIFY_DELETE, OnNotifyDelete },
+        { CF_CALLBACK_TYPE_NOTIFY_DELETE_COMPLETION, OnNotifyDeleteCompletion },
+        { CF_CALLBACK_TYPE_NOTIFY_RENAME, OnNotifyRename },
+        { CF_CALLBACK_TYPE_NOTIFY_RENAME_COMPLETION, OnNotifyRenameCompletion }
+    };
+    if (policy.populationMode == PopulationMode::Partial) {
+        callbackTable.push_back({ CF_CALLBACK_TYPE_FETCH_PLACEHOLDERS, OnFetchPlaceholders });
+        callbackTable.push_back({ CF_CALLBACK_TYPE_CANCEL_FETCH_PLACEHOLDERS, OnCancelFetchPlaceholders });
+    }
+    callbackTable.push_back(CF_CALLBACK_REGISTRATION_END);
+
+    hr = CfConnectSyncRoot(syncRootPath.c_str(), callbackTable.data(), this, CF_CONNECT_FLAG_REQUIRE_PROCESS_INFO | CF_CONNECT_FLAG_REQUIRE_FULL_FILE_PATH, &m_connectionKey);
+    if (FAILED(hr)) {
+        MBD_LOG_ERROR(L"Failed to connect sync root: ", LogHex(hr));
+        CfUnregisterSyncRoot(syncRootPath.c_str());
+        return hr;
+    }
+
+    return S_OK;
+}
+
+void CfApiBackend::Disconnect() {
+    if (m_connectionKey != CF_CONNECTION_KEY_INVALID) {
+        CfDisconnectSyncRoot(m_connectionKey);
+        m_connectionKey = CF_CONNECTION_KEY_INVALID;
+    }
+    m_fileHandles.Clear();
+}
+
+HRESULT CfApiBackend::Unregister(const std::wstring& syncRootPath) {
+    Disconnect();
+
+    HRESULT hr = CfUnregisterSyncRoot(syncRootPath.c_str());
+    if (FAILED(hr)) {
+        MBD_LOG_ERROR(L"Failed to unregister sync root: ", LogHex(hr));
+    }
+    return hr;
+}
+
+HRESULT CfApiBackend::CreatePlaceholders(const std::wstring& parentRelativePath, const PlaceholderEntry* entries, size_t count,
+                                         std::vector<HRESULT>& results) {
+    results.assign(count, S_OK);
+    if (count == 0) {
+        return S_OK;
+    }
+    if (count > MAXDWORD) {
+        return E_INVALIDARG;
+    }
+
+    // 이름, 파일 ID, 생성 정보 배열을 모두 배치 arena에 연속으로 담고 끝나면 한 번에 해제
+    PlaceholderArena arena(count * (sizeof(CF_PLACEHOLDER_CREATE_INFO) + sizeof(size_t) + 128));
+    CF_PLACEHOLDER_CREATE_INFO* placeholderInfos = arena.AllocateArray<CF_PLACEHOLDER_CREATE_INFO>(count);
+    size_t* entryIndices = arena.AllocateArray<size_t>(count);
+    if (!placeholderInfos || !entryIndices) {
+        return E_OUTOFMEMORY;
+    }
+
+    // 항목별 생성 정보 준비 (준비에 실패한 항목은 배치에서 빼고 결과만 기록)
+    size_t prepared = 0;
+    std::wstring relativePath;
+    for (size_t i = 0; i < count; ++i) {
+        relativePath.assign(parentRelativePath);
+        if (!relativePath.empty()) {
+            relativePath += L'\\';
+        }
+        relativePath += entries[i].name;
+
+        HRESULT hr = CreatePlaceholderInfo(arena, relativePath, entries[i], placeholderInfos[prepared]);
+        if (FAILED(hr)) {
+            results[i] = hr;
+            continue;
+        }
+        entryIndices[prepared++] = i;
+    }
+
+    // CF_CREATE_FLAG_NONE: 중간 항목이 실패해도 나머지를 계속 생성하고 항목별 Result를 채움
+    HRESULT hr = S_OK;
+    DWORD entriesProcessed = 0;
+    if (prepared > 0) {
+        std::wstring basePath = parentRelativePath.empty() ? m_syncRootPath : GetFullPath(parentRelativePath);
+        hr = CfCreatePlaceholders(basePath.c_str(), placeholderInfos, static_cast<DWORD>(prepared),
+                                  CF_CREATE_FLAG_NONE, &entriesProcessed);
+        if (FAILED(hr)) {
+            MBD_LOG_ERROR(L"Failed to create placeholders: ", LogHex(hr), L" (", entriesProcessed, L"/", prepared, L" processed)");
+        }
+    }
+
+    for (size_t i = 0; i < prepared; ++i) {
+        // 처리되지 못한 항목은 호출 전체의 결과로 기록
+        results[entryIndices[i]] = i < entriesProcessed ? placeholderInfos[i].Result : (FAILED(hr) ? hr : E_ABORT);
+    }
+    return hr;
+}
+
+HRESULT CfApiBackend::TransferPlaceholders(const FetchKey& key, const std::wstring& relativeDirectory,
+                                           const std::vector<PlaceholderEntry>* children) {
+    CF_OPERATION_INFO opInfo = {};
+    opInfo.StructSize = sizeof(CF_OPERATION_INFO);
+    opInfo.Type = CF_OPERATION_TYPE_TRANSFER_PLACEHOLDERS;
+    opInfo.ConnectionKey = ResolveConnection(key);
+    opInfo.TransferKey = key.transferKey;
+
+    CF_OPERATION_PARAMETERS opParams = {};
+    opParams.ParamSize = sizeof(CF_OPERATION_PARAMETERS);
+    opParams.TransferPlaceholders.CompletionStatus = STATUS_SUCCESS;
+
+    if (!children) {
+        // 아직 목록이 없는 폴더는 빈 결과로 완료하되 채우기를 끄지 않아 다음 열거 때 다시 요청됨
+        opParams.TransferPlaceholders.Flags = CF_OPERATION_TRANSFER_PLACEHOLDERS_FLAG_NONE;
+        return CfExecute(&opInfo, &opParams);
+    }
+
+    // 페이지 단위로 전송 (arena는 페이지마다 재사용)
+    const size_t total = children->size();
+    PlaceholderArena arena(kPlaceholderPageSize * (sizeof(CF_PLACEHOLDER_CREATE_INFO) + 128));
+    std::wstring childPath;
+    size_t offset = 0;
+    do {
+        arena.Reset();
+        const size_t pageCount = (std::min)(kPlaceholderPageSize, total - offset);
+        CF_PLACEHOLDER_CREATE_INFO* page = arena.AllocateArray<CF_PLACEHOLDER_CREATE_INFO>((std::max)(pageCount, static_cast<size_t>(1)));
+        if (!page) {
+            opParams.TransferPlaceholders.CompletionStatus = STATUS_CLOUD_FILE_UNSUCCESSFUL;
+            opParams.TransferPlaceholders.PlaceholderCount = 0;
+            CfExecute(&opInfo, &opParams);
+            return E_OUTOFMEMORY;
+        }
+
+        for (size_t i = 0; i < pageCount; ++i) {
+            const PlaceholderEntry& entry = (*children)[offset + i];
+            childPath.assign(relativeDirectory);
+            if (!childPath.empty()) {
+                childPath += L'\\';
+            }
+            childPath += entry.name;
+
+            HRESULT hr = CreatePlaceholderInfo(arena, childPath, entry, page[i]);
+            if (FAILED(hr)) {
+                opParams.TransferPlaceholders.CompletionStatus = STATUS_CLOUD_FILE_UNSUCCESSFUL;
+                opParams.TransferPlaceholders.PlaceholderCount = 0;
+                CfExecute(&opInfo, &opParams);
+                return hr;
+            }
+            page[i].Flags = CF_PLACEHOLDER_CREATE_FLAG_MARK_IN_SYNC;
+        }
+        offset += pageCount;
+
+        // 마지막 페이지에서 폴더가 모두 채워졌음을 알려 다시 요청되지 않게 함
+        opParams.TransferPlaceholders.Flags = offset == total ? CF_OPERATION_TRANSFER_PLACEHOLDERS_FLAG_DISABLE_ON_DEMAND_POPULATION
+                                                              : CF_OPERATION_TRANSFER_PLACEHOLDERS_FLAG_NONE;
+        opParams.TransferPlaceholders.PlaceholderTotalCount.QuadPart = static_cast<LONGLONG>(total);
+        opParams.TransferPlaceholders.PlaceholderArray = page;
+        opParams.TransferPlaceholders.PlaceholderCount = static_cast<DWORD>(pageCount);
+        opParams.TransferPlaceholders.EntriesProcessed = 0;
+
+        HRESULT hr = CfExecute(&opInfo, &opParams);
+        if (FAILED(hr)) {
+            return hr;
+        }
+    } while (offset < total);
+
+    return S_OK;
+}
+
+HRESULT CfApiBackend::TransferData(const FetchKey& key, const BYTE* buffer, LONGLONG offset, LONGLONG length) {
+    return ExecuteTransfer(key, buffer, offset, length, STATUS_SUCCESS);
+}
+
+HRESULT CfApiBackend::FailTransfer(const FetchKey& key, LONGLONG offset, LONGLONG length, TransferFailure reason) {
+    NTSTATUS status = reason == TransferFailure::Aborted ? STATUS_CLOUD_FILE_REQUEST_ABORTED : STATUS_CLOUD_FILE_UNSUCCESSFUL;
+    return ExecuteTransfer(key, nullptr, offset, length, status);
+}
+
+HRESULT CfApiBackend::ExecuteTransfer(const FetchKey& key, const BYTE* buffer, LONGLONG offset, LONGLONG length, NTSTATUS completionStatus) {
+    CF_OPERATION_INFO opInfo = {};
+    CF_OPERATION_PARAMETERS opParams = {};
+
+    opInfo.StructSize = sizeof(CF_OPERATION_INFO);
+    opInfo.Type = CF_OPERATION_TYPE_TRANSFER_DATA;
+    opInfo.ConnectionKey = ResolveConnection(key);
+    opInfo.TransferKey = key.transferKey;
+
+    opParams.ParamSize = sizeof(CF_OPERATION_PARAMETERS);
+    opParams.TransferData.CompletionStatus = completionStatus;
+    opParams.TransferData.Buffer = buffer;
+    opParams.TransferData.Offset.QuadPart = offset;
+    opParams.TransferData.Length.QuadPart = length;
+
+    return CfExecute(&opInfo, &opParams);
+}
+
+void CfApiBackend::ReportProgress(const FetchKey& key, LONGLONG total, LONGLONG completed) {
+    LARGE_INTEGER totalBytes = {};
+    LARGE_INTEGER completedBytes = {};
+    totalBytes.QuadPart = total;
+    completedBytes.QuadPart = completed;
+    CfReportProviderProgress(ResolveConnection(key), key.transferKey, totalBytes, completedBytes);
+}
+
+HRESULT CfApiBackend::RetrieveData(const FetchKey& key, BYTE* buffer, LONGLONG offset, LONGLONG length,
+                                   LONGLONG& returnedLength) {
+    CF_OPERATION_INFO opInfo = {};
+    CF_OPERATION_PARAMETERS opParams = {};
+
+    opInfo.StructSize = sizeof(CF_OPERATION_INFO);
+    opInfo.Type = CF_OPERATION_TYPE_RETRIEVE_DATA;
+    opInfo.ConnectionKey = ResolveConnection(key);
+    opInfo.TransferKey = key.transferKey;
+
+    opParams.ParamSize = sizeof(CF_OPERATION_PARAMETERS);
+    opParams.RetrieveData.Buffer = buffer;
+    opParams.RetrieveData.Offset.QuadPart = offset;
+    opParams.RetrieveData.Length.QuadPart = length;
+
+    HRESULT hr = CfExecute(&opInfo, &opParams);
+    returnedLength = SUCCEEDED(hr) ? opParams.RetrieveData.ReturnedLength.QuadPart : 0;
+    return hr;
+}
+
+HRESULT CfApiBackend::AcknowledgeData(const FetchKey& key, LONGLONG offset, LONGLONG length, bool valid) {
+    CF_OPERATION_INFO opInfo = {};
+    CF_OPERATION_PARAMETERS opParams = {};
+
+    opInfo.StructSize = sizeof(CF_OPERATION_INFO);
+    opInfo.Type = CF_OPERATION_TYPE_ACK_DATA;
+    opInfo.ConnectionKey = ResolveConnection(key);
+    opInfo.TransferKey = key.transferKey;
+
+    opParams.ParamSize = sizeof(CF_OPERATION_PARAMETERS);
+    opParams.AckData.CompletionStatus = valid ? STATUS_SUCCESS : STATUS_CLOUD_FILE_UNSUCCESSFUL;
+    opParams.AckData.Offset.QuadPart = offset;
+    opParams.AckData.Length.QuadPart = length;
+
+    return CfExecute(&opInfo, &opParams);
+}
+
+HRESULT CfApiBackend::HydratePlaceholder(const std::wstring& relativePath) {
+    std::wstring fullPath = GetFullPath(relativePath);
+    HANDLE fileHandle = CreateFileW(fullPath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                    nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+
+    LARGE_INTEGER offset = {};
+    LARGE_INTEGER length = {};
+    length.QuadPart = -1; // 파일 끝까지
+    HRESULT hr = CfHydratePlaceholder(fileHandle, offset, length, CF_HYDRATE_FLAG_NONE, nullptr);
+    CloseHandle(fileHandle);
+    return hr;
+}
+
+HRESULT CfApiBackend::WithTransferKey(const std::wstring& relativePath,
+                                      const std::function<HRESULT(const FetchKey& key)>& operation) {
+    return WithFileHandle(relativePath, [&operation](HANDLE fileHandle) -> HRESULT {
+        // 연결 키는 비워 두면 TransferData가 현재 연결을 사용
+        FetchKey key;
+        HRESULT hr = CfGetTransferKey(fileHandle, &key.transferKey);
+        if (FAILED(hr)) {
+            MBD_LOG_ERROR(L"Failed to get transfer key: ", LogHex(hr));
+            return hr;
+        }
+        hr = operation(key);
+        CfReleaseTransferKey(fileHandle, &key.transferKey);
+        return hr;
+    });
+}
+
+HRESULT CfApiBackend::SetInSyncState(const std::wstring& relativePath, InSyncState state) {
+    const CF_IN_SYNC_STATE cfState = state == InSyncState::InSync ? CF_IN_SYNC_STATE_IN_SYNC : CF_IN_SYNC_STATE_NOT_IN_SYNC;
+    return WithFileHandle(relativePath, [cfState](HANDLE fileHandle) {
+        return CfSetInSyncState(fileHandle, cfState, CF_SET_IN_SYNC_FLAG_NONE, nullptr);
+    });
+}
+
+HRESULT CfApiBackend::SetPinState(const std::wstring& relativePath, PinState state) {
+    static_assert(static_cast<int>(PinState::Unspecified) == CF_PIN_STATE_UNSPECIFIED &&
+                  static_cast<int>(PinState::Inherit) == CF_PIN_STATE_INHERIT, "PinState mirrors CF_PIN_STATE");
+    const CF_PIN_STATE cfState = static_cast<CF_PIN_STATE>(state);
+    return WithFileHandle(relativePath, [cfState](HANDLE fileHandle) {
+        return CfSetPinState(fileHandle, cfState, CF_SET_PIN_FLAG_NONE, nullptr);
+    });
+}
+
+void CfApiBackend::SetHandleCacheCapacity(size_t capacity) {
+    m_fileHandles.SetCapacity(capacity);
+}
+
+FileHandleCacheStats CfApiBackend::GetHandleCacheStats() const {
+    return m_fileHandles.GetStats();
+}
+
+HRESULT CfApiBackend::WithFileHandle(const std::wstring& relativePath, const std::function<HRESULT(HANDLE)>& operation) {
+    const PathId pathId = m_paths.Intern(relativePath);
+    return m_fileHandles.WithHandle(pathId, [this, pathId]() { return m_paths.GetFullPath(m_syncRootPath, pathId); }, operation);
+}
+
+void CfApiBackend::InvalidateHandle(const BackendFileInfo& file) {
+    // 등록된 적 없는 경로면 캐시된 핸들도 없음
+    const PathId pathId = m_paths.Find(file.relativePath, file.relativePathLength);
+    if (pathId != kInvalidPathId) {
+        m_fileHandles.Invalidate(pathId);
+    }
+}
+
+HRESULT CfApiBackend::CreateSyncRegistration(const std::wstring& displayName, const BackendSyncPolicy& policy,
+                                             CF_SYNC_REGISTRATION& registration, CF_SYNC_POLICIES& policies) {
+    ZeroMemory(&registration, sizeof(registration));
+    ZeroMemory(&policies, sizeof(policies));
+
+    registration.StructSize = sizeof(CF_SYNC_REGISTRATION);
+    registration.ProviderId = MainBoothDriveProviderId;
+    registration.ProviderName = displayName.c_str();
+    registration.ProviderVersion = L"1.0.0";
+
+    // 동기화 정책 설정
+    policies.StructSize = sizeof(CF_SYNC_POLICIES);
+    // 부분 하이드레이션이어야 FETCH_DATA가 앱이 읽는 범위로 와서 범위 요청, read-ahead, 블록 캐시가 의미가 있음
+    switch (policy.hydrationPolicy) {
+    case HydrationPolicy::Partial:
+        policies.Hydration.Primary = CF_HYDRATION_POLICY_PARTIAL;
+        break;
+    case HydrationPolicy::Progressive:
+        policies.Hydration.Primary = CF_HYDRATION_POLICY_PROGRESSIVE;
+        break;
+    case HydrationPolicy::Full:
+        policies.Hydration.Primary = CF_HYDRATION_POLICY_FULL;
+        break;
+    default:
+        return E_INVALIDARG;
+    }
+    policies.Hydration.Modifier = policy.validateData ? CF_HYDRATION_POLICY_MODIFIER_VALIDATION_REQUIRED
+                                                      : CF_HYDRATION_POLICY_MODIFIER_NONE;
+    policies.Population.Primary = policy.populationMode == PopulationMode::Partial ? CF_POPULATION_POLICY_PARTIAL
+                                                                                   : CF_POPULATION_POLICY_ALWAYS_FULL;
+    policies.InSync = CF_INSYNC_POLICY_TRACK_ALL;
+    policies.HardLink = CF_HARDLINK_POLICY_NONE;
+    policies.PlaceholderManagement = CF_PLACEHOLDER_MANAGEMENT_POLICY_DEFAULT;
+
+    return S_OK;
+}
+
+HRESULT CfApiBackend::CreatePlaceholderInfo(PlaceholderArena& arena, const std::wstring& relativePath, const PlaceholderEntry& entry, CF_PLACEHOLDER_CREATE_INFO& placeholderInfo) {
+    ZeroMemory(&placeholderInfo, sizeof(placeholderInfo));
+
+    // 파일명과 파일 ID는 배치 arena에 복사 (CfCreatePlaceholders가 끝날 때까지 유지됨)
+    LPCWSTR fileName = arena.CopyString(entry.name);
+    BYTE* fileIdentity = static_cast<BYTE*>(arena.Allocate(kPlaceholderIdentitySize, 1));
+    if (!fileName || !fileIdentity) {
+        return E_OUTOFMEMORY;
+    }
+
+    // 객체 ID가 없는 항목은 경로에서 만든 ID에 요청된 버전을 붙임
+    if (entry.identity.HasObjectId()) {
+        entry.identity.SerializeTo(fileIdentity);
+    } else {
+        PlaceholderIdentity identity = PlaceholderIdentity::FromPath(relativePath);
+        identity.contentVersion = entry.identity.contentVersion;
+        memcpy(identity.manifestId, entry.identity.manifestId, sizeof(identity.manifestId));
+        identity.SerializeTo(fileIdentity);
+    }
+
+    // 플레이스홀더 정보 설정
+    placeholderInfo.RelativeFileName = fileName;
+    placeholderInfo.FileIdentity = fileIdentity;
+    placeholderInfo.FileIdentityLength = static_cast<DWORD>(kPlaceholderIdentitySize);
+
+    // 파일 시스템 메타데이터는 생성 정보 안에 값으로 저장
+    placeholderInfo.FsMetadata.FileSize = entry.fileSize;
+    placeholderInfo.FsMetadata.BasicInfo = entry.basicInfo;
+
+    return S_OK;
+}
+
+CF_CONNECTION_KEY CfApiBackend::ResolveConnection(const FetchKey& key) const {
+    return key.connectionKey != CF_CONNECTION_KEY_INVALID ? key.connectionKey : m_connectionKey;
+}
+
+std::wstring CfApiBackend::GetFullPath(const std::wstring& relativePath) const {
+    return m_syncRootPath + L"\\" + relativePath;
+}
+
+const wchar_t* CfApiBackend::StripSyncRoot(const wchar_t* normalizedPath, size_t& length) const {
+    // NormalizedPath는 볼륨 루트 기준 경로이므로 드라이브 문자를 뺀 동기화 루트 경로와 비교
+    length = wcslen(normalizedPath);
+    const size_t rootLength = m_syncRootVolumePath.size();
+    if (length < rootLength || _wcsnicmp(normalizedPath, m_syncRootVolumePath.c_str(), rootLength) != 0) {
+        return normalizedPath;
+    }
+
+    size_t start = rootLength;
+    while (start < length && (normalizedPath[start] == L'\\' || normalizedPath[start] == L'/')) {
+        start++;
+    }
+    length -= start;
+    return normalizedPath + start;
+}
+
+CfApiBackend* CfApiBackend::FromCallback(const CF_CALLBACK_INFO* callbackInfo, BackendFileInfo& file) {
+    CfApiBackend* backend = static_cast<CfApiBackend*>(callbackInfo->CallbackContext);
+    file.relativePath = backend->StripSyncRoot(callbackInfo->NormalizedPath, file.relativePathLength);
+    file.displayPath = callbackInfo->NormalizedPath;
+    file.fileIdentity = callbackInfo->FileIdentity;
+    file.fileIdentityLength = callbackInfo->FileIdentityLength;
+    file.fileSize = callbackInfo->FileSize.QuadPart;
+    file.processId = callbackInfo->ProcessInfo ? callbackInfo->ProcessInfo->ProcessId : 0;
+    return backend;
+}
+
+FetchKey CfApiBackend::ToFetchKey(const CF_CALLBACK_INFO* callbackInfo) {
+    FetchKey key;
+    key.connectionKey = callbackInfo->ConnectionKey;
+    key.transferKey = callbackInfo->TransferKey;
+    key.fileId = callbackInfo->FileId.QuadPart;
+    return key;
+}
+
+// 콜백 함수 구현
+void CALLBACK CfApiBackend::OnFetchData(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters) {
+    BackendFileInfo file;
+    CfApiBackend* backend = FromCallback(CallbackInfo, file);
+    backend->m_events->OnFetchData(file, ToFetchKey(CallbackInfo),
+                                   CallbackParameters->FetchData.RequiredFileOffset.QuadPart,
+                                   CallbackParameters->FetchData.RequiredLength.QuadPart);
+}
+
+void CALLBACK CfApiBackend::OnValidateData(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters) {
+    BackendFileInfo file;
+    CfApiBackend* backend = FromCallback(CallbackInfo, file);
+    backend->m_events->OnValidateData(file, ToFetchKey(CallbackInfo),
+                                      CallbackParameters->ValidateData.RequiredFileOffset.QuadPart,
+                                      CallbackParameters->ValidateData.RequiredLength.QuadPart);
+}
+
+void CALLBACK CfApiBackend::OnCancelFetchData(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters) {
+    BackendFileInfo file;
+    CfApiBackend* backend = FromCallback(CallbackInfo, file);
+    backend->m_events->OnCancelFetchData(file, ToFetchKey(CallbackInfo),
+                                         CallbackParameters->Cancel.FetchData.FileOffset.QuadPart,
+                                         CallbackParameters->Cancel.FetchData.Length.QuadPart);
+}
+
+void CALLBACK CfApiBackend::OnFetchPlaceholders(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS*) {
+    BackendFileInfo directory;
+    CfApiBackend* backend = FromCallback(CallbackInfo, directory);
+    backend->m_events->OnFetchPlaceholders(directory, ToFetchKey(CallbackInfo));
+}
+
+void CALLBACK CfApiBackend::OnCancelFetchPlaceholders(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS*) {
+    // 페이지 전송은 로컬 목록만 사용하므로 진행 중인 작업은 곧 끝남
+    UNREFERENCED_PARAMETER(CallbackInfo);
+    MBD_LOG_DEBUG(L"Cancel fetch placeholders for: ", CallbackInfo->NormalizedPath);
+}
+
+void CALLBACK CfApiBackend::OnNotifyFileOpenCompletion(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS*) {
+    BackendFileInfo file;
+    FromCallback(CallbackInfo, file)->m_events->OnFileOpened(file);
+}
+
+void CALLBACK CfApiBackend::OnNotifyFileCloseCompletion(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS*) {
+    BackendFileInfo file;
+    FromCallback(CallbackInfo, file)->m_events->OnFileClosed(file);
+}
+
+void CALLBACK CfApiBackend::OnNotifyDehydrate(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS*) {
+    UNREFERENCED_PARAMETER(CallbackInfo);
+    MBD_LOG_DEBUG(L"Dehydrate notification for: ", CallbackInfo->NormalizedPath);
+}
+
+void CALLBACK CfApiBackend::OnNotifyDehydrateCompletion(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS*) {
+    UNREFERENCED_PARAMETER(CallbackInfo);
+    MBD_LOG_DEBUG(L"Dehydrate completion for: ", CallbackInfo->NormalizedPath);
+}
+
+void CALLBACK CfApiBackend::OnNotifyDelete(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS*) {
+    BackendFileInfo file;
+    CfApiBackend* backend = FromCallback(CallbackInfo, file);
+    // 삭제되는 파일의 캐시된 핸들을 닫아 삭제를 막지 않도록 함
+    backend->InvalidateHandle(file);
+    backend->m_events->OnFileDeleted(file);
+}
+
+void CALLBACK CfApiBackend::OnNotifyDeleteCompletion(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS*) {
+    UNREFERENCED_PARAMETER(CallbackInfo);
+    MBD_LOG_DEBUG(L"Delete completion for: ", CallbackInfo->NormalizedPath);
+}
+
+void CALLBACK CfApiBackend::OnNotifyRename(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS*) {
+    BackendFileInfo file;
+    CfApiBackend* backend = FromCallback(CallbackInfo, file);
+    // 이전 경로로 캐시된 핸들은 더 이상 맞지 않으므로 닫음
+    backend->InvalidateHandle(file);
+    backend->m_events->OnFileRenamed(file);
+}
+
+void CALLBACK CfApiBackend::OnNotifyRenameCompletion(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS*) {
+    UNREFERENCED_PARAMETER(CallbackInfo);
+    MBD_LOG_DEBUG(L"Rename completion for: ", CallbackInfo->NormalizedPath);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <windows.h>
+#include <cfapi.h>
+#include <string>
+#include <vector>
+
+#include "ProviderBackend.h"
+#include "PlaceholderArena.h"
+#include "FileHandleCache.h"
+#include "PathTable.h"
+
+// Windows Cloud Files API(cfapi) 백엔드
+// cfapi 콜백을 엔진 이벤트로 바꾸고 엔진의 응답을 CfExecute 작업으로 보냄
+class CfApiBackend : public ProviderBackend {
+public:
+    CfApiBackend() = default;
+    ~CfApiBackend() override;
+
+    CfApiBackend(const CfApiBackend&) = delete;
+    CfApiBackend& operator=(const CfApiBackend&) = delete;
+
+    const wchar_t* Name() const override { return L"cfapi"; }
+
+    HRESULT Connect(const std::wstring& syncRootPath, const std::wstring& displayName,
+                    const BackendSyncPolicy& policy, ProviderBackendEvents* events) override;
+    void Disconnect() override;
+    HRESULT Unregister(const std::wstring& syncRootPath) override;
+
+    HRESULT CreatePlaceholders(const std::wstring& parentRelativePath, const PlaceholderEntry* entries, size_t count,
+                               std::vector<HRESULT>& results) override;
+    HRESULT TransferPlaceholders(const FetchKey& key, const std::wstring& relativeDirectory,
+                                 const std::vector<PlaceholderEntry>* children) override;
+
+    // key.connectionKey가 비어 있으면 현재 연결을 사용 (CfGetTransferKey로 얻은 전송 키)
+    HRESULT TransferData(const FetchKey& key, const BYTE* buffer, LONGLONG offset, LONGLONG length) override;
+    HRESULT FailTransfer(const FetchKey& key, LONGLONG offset, LONGLONG length, TransferFailure reason) override;
+    void ReportProgress(const FetchKey& key, LONGLONG total, LONGLONG completed) override;
+    HRESULT RetrieveData(const FetchKey& key, BYTE* buffer, LONGLONG offset, LONGLONG length,
+                         LONGLONG& returnedLength) override;
+    HRESULT AcknowledgeData(const FetchKey& key, LONGLONG offset, LONGLONG length, bool valid) override;
+
+    HRESULT HydratePlaceholder(const std::wstring& relativePath) override;
+
+    // 아래 작업은 CfOpenFileWithOplock으로 연 보호 핸들을 캐시해 재사용함
+    HRESULT WithTransferKey(const std::wstring& relativePath,
+                            const std::function<HRESULT(const FetchKey& key)>& operation) override;
+    HRESULT SetInSyncState(const std::wstring& relativePath, InSyncState state) override;
+    HRESULT SetPinState(const std::wstring& relativePath, PinState state) override;
+    void SetHandleCacheCapacity(size_t capacity) override;
+    FileHandleCacheStats GetHandleCacheStats() const override;
+
+    // TRANSFER_PLACEHOLDERS 한 번에 보내는 플레이스홀더 수
+    static constexpr size_t kPlaceholderPageSize = 512;
+
+private:
+    HRESULT CreateSyncRegistration(const std::wstring& displayName, const BackendSyncPolicy& policy,
+                                   CF_SYNC_REGISTRATION& registration, CF_SYNC_POLICIES& policies);
+    static HRESULT CreatePlaceholderInfo(PlaceholderArena& arena, const std::wstring& relativePath, const PlaceholderEntry& entry,
+                                         CF_PLACEHOLDER_CREATE_INFO& placeholderInfo);
+    HRESULT ExecuteTransfer(const FetchKey& key, const BYTE* buffer, LONGLONG offset, LONGLONG length, NTSTATUS completionStatus);
+    CF_CONNECTION_KEY ResolveConnection(const FetchKey& key) const;
+    std::wstring GetFullPath(const std::wstring& relativePath) const;
+    HRESULT WithFileHandle(const std::wstring& relativePath, const std::function<HRESULT(HANDLE)>& operation);
+    void InvalidateHandle(const BackendFileInfo& file);
+    const wchar_t* StripSyncRoot(const wchar_t* normalizedPath, size_t& length) const;
+
+    // 콜백 정보를 엔진에 넘길 형태로 변환
+    static CfApiBackend* FromCallback(const CF_CALLBACK_INFO* callbackInfo, BackendFileInfo& file);
+    static FetchKey ToFetchKey(const CF_CALLBACK_INFO* callbackInfo);
+
+    // cfapi 콜백
+    static void CALLBACK OnFetchData(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters);
+    static void CALLBACK OnValidateData(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters);
+    static void CALLBACK OnCancelFetchData(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters);
+    static void CALLBACK OnFetchPlaceholders(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters);
+    static void CALLBACK OnCancelFetchPlaceholders(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters);
+    static void CALLBACK OnNotifyFileOpenCompletion(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters);
+    static void CALLBACK OnNotifyFileCloseCompletion(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters);
+    static void CALLBACK OnNotifyDehydrate(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters);
+    static void CALLBACK OnNotifyDehydrateCompletion(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters);
+    static void CALLBACK OnNotifyDelete(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters);
+    static void CALLBACK OnNotifyDeleteCompletion(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters);
+    static void CALLBACK OnNotifyRename(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters);
+    static void CALLBACK OnNotifyRenameCompletion(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters);
+
+    std::wstring m_syncRootPath;
+    std::wstring m_syncRootVolumePath;  // 드라이브 문자를 뺀 경로 (콜백의 NormalizedPath와 비교)
+    CF_CONNECTION_KEY m_connectionKey = CF_CONNECTION_KEY_INVALID;
+    ProviderBackendEvents* m_events = nullptr;
+
+    // 상태 변경과 전송 키에 쓰는 oplock 보호 핸들 (경로 ID로 찾음)
+    PathTable m_paths;
+    FileHandleCache m_fileHandles;
+};
@@ -1,8 +1,10 @@
 #include "CloudFilesProvider.h"
-#include <iostream>
+#include "CfApiBackend.h"
 #include <shlwapi.h>
 #include <pathcch.h>
 #include <chrono>
+#include <thread>
+#include <algorithm>
 #include <locale>
 #include <codecvt>
 
@@ -30,29 +32,98 @@ HRESULT CloudFilesProvider::Initialize() {
         return S_OK;
     }
     
-    std::wcout << L"Initializing Main Booth Drive Cloud Files Provider..." << std::endl;
+    // 콜백보다 먼저 로거를 시작해 초기화 로그도 파일에 남김
+    if (!Logger::Instance().IsRunning()) {
+        LoggerConfig logConfig = m_logConfig;
+        if (logConfig.filePath.empty()) {
+            logConfig.filePath = GetMainBoothDriveCacheFolder() + L"\\Logs\\CloudFilesProvider.log";
+        }
+        Logger::Instance().Start(logConfig);
+        m_ownsLogger = true;
+    }
     
-    // 워커 스레드 시작
-    m_shouldStop = false;
-    m_workerThread = std::thread([this]() {
-        while (!m_shouldStop) {
-            std::unique_lock<std::mutex> lock(m_queueMutex);
-            m_queueCondition.wait(lock, [this] { return !m_workQueue.empty() || m_shouldStop; });
-            
-            while (!m_workQueue.empty() && !m_shouldStop) {
-                auto work = m_workQueue.front();
-                m_workQueue.pop();
-                lock.unlock();
-                
-                work();
-                
-                lock.lock();
-            }
+    MBD_LOG_INFO(L"Initializing Main Booth Drive Cloud Files Provider...");
+    
+    // 전송 버퍼 풀 (워커가 사용하므로 워커보다 먼저 만들고 나중에 해제)
+    TransferBufferPoolConfig bufferConfig = m_transferBufferConfig;
+    bufferConfig.bufferSize = static_cast<size_t>((std::max)(kTransferChunkSize, m_blockCacheConfig.blockSize));
+    m_transferBuffers = std::make_unique<TransferBufferPool>(bufferConfig);
+    
+    // fetch 워커 풀 시작
+    m_executor = std::make_unique<FetchExecutor>(m_executorConfig);
+    m_executor->Start();
+    MBD_LOG_INFO(L"Started ", m_executor->GetWorkerCount(), L" fetch workers");
+    
+    // 블록 캐시 열기 (실패해도 원격 fetch로 계속 동작)
+    if (m_blockCacheConfig.maxBytes > 0) {
+        BlockCacheConfig cacheConfig = m_blockCacheConfig;
+        if (cacheConfig.directory.empty()) {
+            cacheConfig.directory = GetMainBoothDriveCacheFolder() + L"\\Blocks";
         }
-    });
+        m_blockCache = std::make_unique<BlockCache>(cacheConfig);
+        HRESULT hr = m_blockCache->Open();
+        if (FAILED(hr)) {
+            MBD_LOG_ERROR(L"Failed to open block cache: ", LogHex(hr));
+            m_blockCache.reset();
+        }
+    }
+    
+    // 데이터 검증용 블록 매니페스트 저장소 (열지 못하면 매니페스트 없이 검증 설정대로 응답)
+    if (m_validationConfig.enabled) {
+        std::wstring manifestDirectory = m_validationConfig.manifestDirectory;
+        if (manifestDirectory.empty()) {
+            manifestDirectory = GetMainBoothDriveCacheFolder() + L"\\Manifests";
+        }
+        m_manifests = std::make_unique<BlockManifestStore>(manifestDirectory, m_validationConfig.cachedManifests);
+        HRESULT hr = m_manifests->Open();
+        if (FAILED(hr)) {
+            MBD_LOG_ERROR(L"Failed to open block manifest store: ", LogHex(hr));
+            m_manifests.reset();
+        }
+        
+        size_t cores = (std::max)(std::thread::hardware_concurrency(), 1u);
+        m_verifyThreads = m_validationConfig.verifyThreads > 0 ? m_validationConfig.verifyThreads
+                                                               : (std::min)(cores, static_cast<size_t>(8));
+    }
+    
+    // 지난 실행에서 저장한 메타데이터 인덱스 매핑 (없으면 PublishMetadata 때 생성)
+    auto metadataIndex = std::make_shared<MetadataIndex>();
+    HRESULT indexHr = metadataIndex->Open(GetMetadataIndexPath());
+    if (SUCCEEDED(indexHr)) {
+        std::atomic_store(&m_metadataIndex, std::shared_ptr<const MetadataIndex>(metadataIndex));
+        MBD_LOG_INFO(L"Loaded metadata index: ", metadataIndex->Count(), L" entries");
+    } else if (indexHr != HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND)) {
+        MBD_LOG_ERROR(L"Failed to open metadata index: ", LogHex(indexHr));
+    }
+    
+    // 동기화 상태 변경 큐 시작
+    m_inSyncUpdater = std::make_unique<InSyncUpdater>(InSyncUpdaterConfig(),
+        [this](const std::wstring& relativePath, InSyncState state) { return SetInSyncState(relativePath, state); },
+        [this](const std::wstring& relativePath, HRESULT) {
+            // 실패 로그는 SetInSyncState가 이미 남김
+            if (m_notifyCallback) {
+                m_notifyCallback(relativePath, L"in_sync_failed");
+            }
+        });
+    m_inSyncUpdater->Start();
+    
+    // 미리 가져오기 엔진 시작 (자체 스레드에서 Prefetch 우선순위로 하이드레이션)
+    if (m_prefetchConfig.enabled) {
+        m_prefetcher = std::make_unique<PrefetchPredictor>(m_prefetchConfig,
+            [this](const std::wstring& relativePath) { return HydratePlaceholder(relativePath, HydrationPriority::Prefetch); },
+            [this](const std::wstring& relativeDirectory) { return ListDirectoryFiles(relativeDirectory); },
+            [this](const std::wstring& relativePath) -> LONGLONG {
+                WIN32_FILE_ATTRIBUTE_DATA attributes;
+                if (!GetFileAttributesExW(GetFullPath(relativePath).c_str(), GetFileExInfoStandard, &attributes)) {
+                    return -1;
+                }
+                return (static_cast<LONGLONG>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+            });
+        m_prefetcher->Start();
+    }
     
     m_initialized = true;
-    std::wcout << L"Cloud Files Provider initialized successfully" << std::endl;
+    MBD_LOG_INFO(L"Cloud Files Provider initialized successfully");
     
     return S_OK;
 }
@@ -62,377 +133,1051 @@ void CloudFilesProvider::Shutdown() {
         return;
     }
     
-    std::wcout << L"Shutting down Cloud Files Provider..." << std::endl;
+    MBD_LOG_INFO(L"Shutting down Cloud Files Provider...");
     
-    // 워커 스레드 정지
-    {
-        std::lock_guard<std::mutex> lock(m_queueMutex);
-        m_shouldStop = true;
+    // 미리 가져오기는 워커 풀을 기다리므로 먼저 정지
+    if (m_prefetcher) {
+        m_prefetcher->Stop();
+        m_prefetcher.reset();
     }
-    m_queueCondition.notify_all();
     
-    if (m_workerThread.joinable()) {
-        m_workerThread.join();
+    // 남은 상태 변경을 처리한 뒤 정지 (핸들 캐시보다 먼저)
+    if (m_inSyncUpdater) {
+        m_inSyncUpdater->Stop();
+        m_inSyncUpdater.reset();
     }
     
-    // 연결 해제
-    if (m_connectionKey != CF_CONNECTION_KEY_INVALID) {
-        CfDisconnectSyncRoot(m_connectionKey);
-        m_connectionKey = CF_CONNECTION_KEY_INVALID;
+    // 새 다운로드를 받지 않고, 큐에 남은 다운로드의 요청은 연결이 살아 있는 동안 중단으로 완료
+    if (m_executor) {
+        m_executor->Close();
     }
     
-    m_initialized = false;
-    std::wcout << L"Cloud Files Provider shut down" << std::endl;
-}
-
-HRESULT CloudFilesProvider::RegisterSyncRoot(const std::wstring& syncRootPath, const std::wstring& displayName) {
-    std::wcout << L"Registering sync root: " << syncRootPath << std::endl;
+    // 연결을 먼저 끊어 이후에는 콜백이 워커 풀, 캐시, 버퍼를 쓰지 않게 함
+    if (m_backend) {
+        m_backend->Disconnect();
+    }
     
-    m_syncRootPath = syncRootPath;
+    // 실행 중이던 다운로드가 끝나기를 기다린 뒤 워커 풀 정리
+    if (m_executor) {
+        m_executor->Stop();
+        m_executor.reset();
+    }
     
-    // 디렉토리 생성
-    if (!CreateDirectoryW(syncRootPath.c_str(), nullptr) && GetLastError() != ERROR_ALREADY_EXISTS) {
-        DWORD error = GetLastError();
-        std::wcout << L"Failed to create sync root directory: " << error << std::endl;
-        return HRESULT_FROM_WIN32(error);
+    if (m_blockCache) {
+        m_blockCache->Close();
+        m_blockCache.reset();
     }
+    m_manifests.reset();
     
-    // 동기화 등록 구조체 생성
-    CF_SYNC_REGISTRATION registration = {};
-    HRESULT hr = CreateSyncRegistration(displayName, registration);
-    if (FAILED(hr)) {
-        return hr;
+    m_transferBuffers.reset();
+    {
+        std::lock_guard<std::mutex> lock(m_progressMutex);
+        m_hydratedBytes.clear();
     }
+    std::atomic_store(&m_metadataIndex, std::shared_ptr<const MetadataIndex>());
     
-    // 동기화 루트 등록
-    hr = CfRegisterSyncRoot(syncRootPath.c_str(), &registration, nullptr, CF_REGISTER_FLAG_NONE);
-    if (FAILED(hr)) {
-        std::wcout << L"Failed to register sync root: 0x" << std::hex << hr << std::endl;
-        return hr;
+    m_initialized = false;
+    MBD_LOG_INFO(L"Cloud Files Provider shut down");
+    
+    // 남은 로그를 모두 쓴 뒤 정지
+    if (m_ownsLogger) {
+        Logger::Instance().Stop();
+        m_ownsLogger = false;
+    }
+}
+
+void CloudFilesProvider::SetBackend(std::unique_ptr<ProviderBackend> backend) {
+    m_backend = std::move(backend);
+}
+
+HRESULT CloudFilesProvider::RegisterSyncRoot(const std::wstring& syncRootPath, const std::wstring& displayName) {
+    if (!m_backend) {
+        m_backend = std::make_unique<CfApiBackend>();
     }
+    m_backend->SetHandleCacheCapacity(m_fileHandleCacheCapacity);
+    MBD_LOG_INFO(L"Registering sync root: ", syncRootPath, L" (", m_backend->Name(), L" backend)");
     
-    // 콜백 등록
-    CF_CALLBACK_REGISTRATION callbackTable[] = {
-        { CF_CALLBACK_TYPE_FETCH_DATA, OnFetchData },
-        { CF_CALLBACK_TYPE_VALIDATE_DATA, OnValidateData },
-        { CF_CALLBACK_TYPE_CANCEL_FETCH_DATA, OnCancelFetchData },
-        { CF_CALLBACK_TYPE_NOTIFY_FILE_OPEN_COMPLETION, OnNotifyFileOpenCompletion },
-        { CF_CALLBACK_TYPE_NOTIFY_FILE_CLOSE_COMPLETION, OnNotifyFileCloseCompletion },
-        { CF_CALLBACK_TYPE_NOTIFY_DEHYDRATE, OnNotifyDehydrate },
-        { CF_CALLBACK_TYPE_NOTIFY_DEHYDRATE_COMPLETION, OnNotifyDehydrateCompletion },
-        { CF_CALLBACK_TYPE_NOTIFY_DELETE, OnNotifyDelete },
-        { CF_CALLBACK_TYPE_NOTIFY_DELETE_COMPLETION, OnNotifyDeleteCompletion },
-        { CF_CALLBACK_TYPE_NOTIFY_RENAME, OnNotifyRename },
-        { CF_CALLBACK_TYPE_NOTIFY_RENAME_COMPLETION, OnNotifyRenameCompletion },
-        CF_CALLBACK_REGISTRATION_END
-    };
-    
-    hr = CfConnectSyncRoot(syncRootPath.c_str(), callbackTable, this, CF_CONNECT_FLAG_REQUIRE_PROCESS_INFO | CF_CONNECT_FLAG_REQUIRE_FULL_FILE_PATH, &m_connectionKey);
+    m_syncRootPath = syncRootPath;
+    BackendSyncPolicy policy;
+    policy.populationMode = m_populationMode;
+    policy.hydrationPolicy = m_hydrationPolicy;
+    policy.validateData = m_validationConfig.enabled;
+    HRESULT hr = m_backend->Connect(syncRootPath, displayName, policy, this);
     if (FAILED(hr)) {
-        std::wcout << L"Failed to connect sync root: 0x" << std::hex << hr << std::endl;
-        CfUnregisterSyncRoot(syncRootPath.c_str());
         return hr;
     }
     
-    std::wcout << L"Sync root registered successfully" << std::endl;
+    MBD_LOG_INFO(L"Sync root registered successfully");
     return S_OK;
 }
 
 HRESULT CloudFilesProvider::UnregisterSyncRoot(const std::wstring& syncRootPath) {
-    std::wcout << L"Unregistering sync root: " << syncRootPath << std::endl;
+    MBD_LOG_INFO(L"Unregistering sync root: ", syncRootPath);
     
-    if (m_connectionKey != CF_CONNECTION_KEY_INVALID) {
-        CfDisconnectSyncRoot(m_connectionKey);
-        m_connectionKey = CF_CONNECTION_KEY_INVALID;
+    if (m_backend) {
+        m_backend->Disconnect();
     }
     
-    HRESULT hr = CfUnregisterSyncRoot(syncRootPath.c_str());
-    if (FAILED(hr)) {
-        std::wcout << L"Failed to unregister sync root: 0x" << std::hex << hr << std::endl;
-    }
+    return m_backend ? m_backend->Unregister(syncRootPath) : S_OK;
+}
+
+HRESULT CloudFilesProvider::CreatePlaceholder(const std::wstring& relativePath, const FILE_BASIC_INFO& basicInfo, LARGE_INTEGER fileSize,
+                                              const PlaceholderIdentity& identity) {
+    MBD_LOG_DEBUG(L"Creating placeholder: ", relativePath);
     
-    return hr;
+    // 부모 폴더 기준으로 한 항목짜리 배치 생성
+    size_t separator = relativePath.find_last_of(L"\\/");
+    PlaceholderEntry entry;
+    entry.name = separator == std::wstring::npos ? relativePath : relativePath.substr(separator + 1);
+    entry.basicInfo = basicInfo;
+    entry.fileSize = fileSize;
+    entry.identity = identity;
+    
+    std::vector<HRESULT> results;
+    HRESULT hr = CreatePlaceholders(separator == std::wstring::npos ? std::wstring() : relativePath.substr(0, separator),
+                                    &entry, 1, &results);
+    return FAILED(hr) ? hr : results.front();
 }
 
-HRESULT CloudFilesProvider::CreatePlaceholder(const std::wstring& relativePath, const FILE_BASIC_INFO& basicInfo, LARGE_INTEGER fileSize) {
-    std::wcout << L"Creating placeholder: " << relativePath << std::endl;
+HRESULT CloudFilesProvider::CreatePlaceholders(const std::wstring& parentRelativePath, const PlaceholderEntry* entries, size_t count,
+                                               std::vector<HRESULT>* results) {
+    if (results) {
+        results->assign(count, S_OK);
+    }
+    if (count == 0) {
+        return S_OK;
+    }
+    if (count > MAXDWORD) {
+        return E_INVALIDARG;
+    }
     
-    CF_PLACEHOLDER_CREATE_INFO placeholderInfo = {};
-    HRESULT hr = CreatePlaceholderInfo(relativePath, basicInfo, fileSize, placeholderInfo);
-    if (FAILED(hr)) {
-        return hr;
+    if (!m_backend) {
+        return HRESULT_FROM_WIN32(ERROR_NOT_READY);
     }
     
-    hr = CfCreatePlaceholders(m_syncRootPath.c_str(), &placeholderInfo, 1, CF_CREATE_FLAG_NONE, nullptr);
-    if (FAILED(hr)) {
-        std::wcout << L"Failed to create placeholder: 0x" << std::hex << hr << std::endl;
+    MBD_LOG_DEBUG(L"Creating ", count, L" placeholders in: ", parentRelativePath);
+    
+    std::vector<HRESULT> entryResults;
+    HRESULT hr;
+    {
+        ScopedLatency latency(m_metrics, MetricHistogram::PlaceholderBatch);
+        hr = m_backend->CreatePlaceholders(parentRelativePath, entries, count, entryResults);
     }
     
-    // 메모리 정리
-    if (placeholderInfo.RelativeFileName) {
-        HeapFree(GetProcessHeap(), 0, (LPVOID)placeholderInfo.RelativeFileName);
+    size_t failed = 0;
+    for (HRESULT entryHr : entryResults) {
+        if (FAILED(entryHr)) {
+            failed++;
+        }
     }
-    if (placeholderInfo.FileIdentity) {
-        HeapFree(GetProcessHeap(), 0, placeholderInfo.FileIdentity);
+    m_metrics.Add(MetricCounter::PlaceholdersCreated, count - failed);
+    if (failed > 0) {
+        MBD_LOG_WARNING(L"Placeholders failed: ", failed, L"/", count);
+    }
+    if (results) {
+        *results = std::move(entryResults);
     }
     
-    return hr;
+    if (FAILED(hr)) {
+        return hr;
+    }
+    return failed > 0 ? S_FALSE : S_OK;
 }
 
 HRESULT CloudFilesProvider::HydrateFile(const std::wstring& relativePath, const std::vector<BYTE>& data, std::function<void(double)> progressCallback) {
-    std::wcout << L"Hydrating file: " << relativePath << std::endl;
+    MBD_LOG_DEBUG(L"Hydrating file: ", relativePath);
     
-    std::wstring fullPath = GetFullPath(relativePath);
-    HANDLE fileHandle = GetFileHandle(relativePath);
+    if (!m_backend) {
+        return HRESULT_FROM_WIN32(ERROR_NOT_READY);
+    }
     
-    if (fileHandle == INVALID_HANDLE_VALUE) {
-        DWORD error = GetLastError();
-        std::wcout << L"Failed to get file handle: " << error << std::endl;
-        return HRESULT_FROM_WIN32(error);
+    const LONGLONG totalLength = static_cast<LONGLONG>(data.size());
+    const PathId pathId = m_paths.Intern(relativePath);
+    HRESULT hr = m_backend->WithTransferKey(relativePath, [&](const FetchKey& key) -> HRESULT {
+        HRESULT hr = S_OK;
+        
+        // 청크 단위로 나누어 전송하면서 셸과 앱에 진행률 보고
+        for (LONGLONG offset = 0; offset < totalLength && SUCCEEDED(hr); offset += kTransferChunkSize) {
+            LONGLONG chunkLength = (std::min)(kTransferChunkSize, totalLength - offset);
+            {
+                ScopedTrace trace(kHydrationTraceCategory, "TRANSFER_DATA", 0, pathId, { "offset", offset }, { "length", chunkLength });
+                hr = m_backend->TransferData(key, data.data() + offset, offset, chunkLength);
+            }
+            if (FAILED(hr)) {
+                break;
+            }
+            m_metrics.Add(MetricCounter::BytesTransferred, static_cast<uint64_t>(chunkLength));
+            
+            const LONGLONG completed = offset + chunkLength;
+            m_backend->ReportProgress(key, totalLength, completed);
+            if (progressCallback && m_progressThrottle.ShouldReport(pathId, completed, totalLength)) {
+                progressCallback(static_cast<double>(completed) / totalLength);
+            }
+        }
+        if (FAILED(hr)) {
+            MBD_LOG_ERROR(L"Failed to transfer data: ", LogHex(hr));
+            m_progressThrottle.Forget(pathId);
+        }
+        return hr;
+    });
+    if (FAILED(hr)) {
+        MBD_LOG_ERROR(L"Failed to hydrate file: ", relativePath, L" (", LogHex(hr), L")");
+        return hr;
     }
     
-    CF_OPERATION_INFO opInfo = {};
-    CF_OPERATION_PARAMETERS opParams = {};
+    if (progressCallback && totalLength == 0) {
+        progressCallback(1.0); // 빈 파일
+    }
     
-    opInfo.StructSize = sizeof(CF_OPERATION_INFO);
-    opInfo.Type = CF_OPERATION_TYPE_TRANSFER_DATA;
-    opInfo.ConnectionKey = m_connectionKey;
-    opInfo.TransferKey = CF_TRANSFER_KEY_INVALID; // 실제 구현에서는 적절한 키 사용
+    return hr;
+}
+
+HRESULT CloudFilesProvider::HydratePlaceholder(const std::wstring& relativePath, HydrationPriority priority) {
+    if (!m_backend) {
+        return HRESULT_FROM_WIN32(ERROR_NOT_READY);
+    }
     
-    opParams.ParamSize = sizeof(CF_OPERATION_PARAMETERS);
-    opParams.TransferData.CompletionStatus = STATUS_SUCCESS;
-    opParams.TransferData.Buffer = const_cast<BYTE*>(data.data());
-    opParams.TransferData.Length = static_cast<DWORD>(data.size());
-    opParams.TransferData.Offset.QuadPart = 0;
+    // 이 프로세스가 보내는 이어지는 FETCH_DATA가 요청한 우선순위로 스케줄되도록 기록
+    // 같은 파일을 여러 곳에서 동시에 요청할 수 있으므로 호출마다 하나씩 넣고 빼며, 가장 급한 값을 사용
+    const PathId pathId = m_paths.Intern(relativePath);
+    std::multiset<HydrationPriority>::iterator registered;
+    {
+        std::lock_guard<std::mutex> lock(m_priorityMutex);
+        registered = m_requestedPriorities[pathId].insert(priority);
+    }
     
-    HRESULT hr = CfExecute(&opInfo, &opParams);
+    HRESULT hr = m_backend->HydratePlaceholder(relativePath);
     if (FAILED(hr)) {
-        std::wcout << L"Failed to transfer data: 0x" << std::hex << hr << std::endl;
+        MBD_LOG_ERROR(L"Failed to hydrate placeholder: ", LogHex(hr));
     }
     
-    CloseHandle(fileHandle);
-    
-    if (progressCallback) {
-        progressCallback(1.0); // 완료
+    {
+        std::lock_guard<std::mutex> lock(m_priorityMutex);
+        auto requested = m_requestedPriorities.find(pathId);
+        requested->second.erase(registered);
+        if (requested->second.empty()) {
+            m_requestedPriorities.erase(requested);
+        }
     }
     
     return hr;
 }
 
-HRESULT CloudFilesProvider::SetInSyncState(const std::wstring& relativePath, CF_IN_SYNC_STATE state) {
-    HANDLE fileHandle = GetFileHandle(relativePath);
-    if (fileHandle == INVALID_HANDLE_VALUE) {
-        return HRESULT_FROM_WIN32(GetLastError());
+HRESULT CloudFilesProvider::SetInSyncState(const std::wstring& relativePath, InSyncState state) {
+    if (!m_backend) {
+        return HRESULT_FROM_WIN32(ERROR_NOT_READY);
+    }
+    HRESULT hr = m_backend->SetInSyncState(relativePath, state);
+    if (FAILED(hr)) {
+        MBD_LOG_ERROR(L"Failed to set in-sync state for: ", relativePath, L" (", LogHex(hr), L")");
+    }
+    return hr;
+}
+
+HRESULT CloudFilesProvider::SetPinState(const std::wstring& relativePath, PinState pinState) {
+    if (!m_backend) {
+        return HRESULT_FROM_WIN32(ERROR_NOT_READY);
+    }
+    HRESULT hr = m_backend->SetPinState(relativePath, pinState);
+    if (FAILED(hr)) {
+        MBD_LOG_ERROR(L"Failed to set pin state for: ", relativePath, L" (", LogHex(hr), L")");
+    }
+    return hr;
+}
+
+void CloudFilesProvider::QueueInSyncState(const std::wstring& relativePath, InSyncState state) {
+    if (m_inSyncUpdater) {
+        m_inSyncUpdater->Queue(relativePath, state);
+    } else {
+        SetInSyncState(relativePath, state);
+    }
+}
+
+void CloudFilesProvider::FlushInSyncUpdates() {
+    if (m_inSyncUpdater) {
+        m_inSyncUpdater->Flush();
+    }
+}
+
+InSyncUpdaterStats CloudFilesProvider::GetInSyncUpdaterStats() const {
+    return m_inSyncUpdater ? m_inSyncUpdater->GetStats() : InSyncUpdaterStats();
+}
+
+void CloudFilesProvider::SetFileHandleCacheCapacity(size_t capacity) {
+    m_fileHandleCacheCapacity = capacity;
+    if (m_backend) {
+        m_backend->SetHandleCacheCapacity(capacity);
+    }
+}
+
+FileHandleCacheStats CloudFilesProvider::GetFileHandleCacheStats() const {
+    return m_backend ? m_backend->GetHandleCacheStats() : FileHandleCacheStats();
+}
+
+void CloudFilesProvider::SetFetchDataCallback(std::function<std::vector<BYTE>(const std::wstring&)> callback) {
+    m_fetchDataCallback = callback ? MakeStreamingFetchCallback(callback) : nullptr;
+}
+
+void CloudFilesProvider::SetRangedFetchDataCallback(std::function<std::vector<BYTE>(const std::wstring&, LONGLONG, LONGLONG)> callback) {
+    m_fetchDataCallback = callback ? MakeStreamingFetchCallback(callback) : nullptr;
+}
+
+void CloudFilesProvider::SetProgressCallback(std::function<void(const std::wstring&, LONGLONG, LONGLONG)> callback) {
+    m_progressCallback = callback;
+}
+
+void CloudFilesProvider::SetProgressUpdateRate(double maxUpdatesPerSecond) {
+    m_progressThrottle.SetMaxUpdatesPerSecond(maxUpdatesPerSecond);
+}
+
+void CloudFilesProvider::SetStreamingFetchCallback(StreamingFetchCallback callback) {
+    m_fetchDataCallback = callback;
+}
+
+void CloudFilesProvider::SetExecutorConfig(const FetchExecutorConfig& config) {
+    m_executorConfig = config;
+}
+
+FetchExecutorStats CloudFilesProvider::GetExecutorStats() const {
+    return m_executor ? m_executor->GetStats() : FetchExecutorStats();
+}
+
+InFlightFetchStats CloudFilesProvider::GetInFlightFetchStats() const {
+    return m_inFlightFetches.GetStats();
+}
+
+void CloudFilesProvider::SetBlockCacheConfig(const BlockCacheConfig& config) {
+    m_blockCacheConfig = config;
+}
+
+BlockCacheStats CloudFilesProvider::GetBlockCacheStats() const {
+    return m_blockCache ? m_blockCache->GetStats() : BlockCacheStats();
+}
+
+void CloudFilesProvider::InvalidateCachedFile(const std::wstring& relativePath) {
+    if (!m_blockCache) {
+        return;
     }
     
-    HRESULT hr = CfSetInSyncState(fileHandle, state, CF_SET_IN_SYNC_FLAG_NONE, nullptr);
-    CloseHandle(fileHandle);
+    // 인덱스에 객체 ID가 있으면 사용하고, 없으면 플레이스홀더를 만들 때와 같이 경로에서 계산
+    std::string cacheKey = PlaceholderIdentity::FromPath(relativePath).CacheKey();
+    FileMetadata metadata;
+    if (LookupMetadata(relativePath, metadata)) {
+        ULONGLONG contentVersion = 0;
+        ResolveCacheIdentity(metadata.fileIdentity.data(), metadata.fileIdentity.size(), cacheKey, contentVersion);
+    }
+    m_blockCache->InvalidateFile(cacheKey);
+}
+
+void CloudFilesProvider::SetDataValidationConfig(const DataValidationConfig& config) {
+    m_validationConfig = config;
+}
+
+HRESULT CloudFilesProvider::PublishBlockManifest(const BYTE* manifestId, const BlockManifest& manifest) {
+    if (!m_manifests) {
+        return HRESULT_FROM_WIN32(ERROR_NOT_READY);
+    }
     
+    HRESULT hr = m_manifests->Put(manifestId, manifest);
+    if (FAILED(hr)) {
+        MBD_LOG_ERROR(L"Failed to publish block manifest: ", LogHex(hr));
+    }
     return hr;
 }
 
-HRESULT CloudFilesProvider::SetPinState(const std::wstring& relativePath, CF_PIN_STATE pinState) {
-    HANDLE fileHandle = GetFileHandle(relativePath);
-    if (fileHandle == INVALID_HANDLE_VALUE) {
-        return HRESULT_FROM_WIN32(GetLastError());
+void CloudFilesProvider::RemoveBlockManifest(const BYTE* manifestId) {
+    if (m_manifests) {
+        m_manifests->Remove(manifestId);
+    }
+}
+
+void CloudFilesProvider::SetPopulationMode(PopulationMode mode) {
+    m_populationMode = mode;
+}
+
+void CloudFilesProvider::SetHydrationPolicy(HydrationPolicy policy) {
+    m_hydrationPolicy = policy;
+}
+
+void CloudFilesProvider::SetDirectoryContents(const std::wstring& relativeDirectory, std::vector<PlaceholderEntry> entries) {
+    m_directoryIndex.SetChildren(relativeDirectory, std::move(entries));
+}
+
+void CloudFilesProvider::RemoveDirectoryContents(const std::wstring& relativeDirectory) {
+    m_directoryIndex.Remove(relativeDirectory);
+}
+
+void CloudFilesProvider::SetMetadataIndexPath(const std::wstring& path) {
+    m_metadataIndexPath = path;
+}
+
+HRESULT CloudFilesProvider::PublishMetadata(std::vector<FileMetadata> entries) {
+    size_t count = entries.size();
+    std::wstring path = GetMetadataIndexPath();
+    
+    // 열려 있는 인덱스는 FILE_SHARE_DELETE로 매핑되어 있어 파일을 교체해도 기존 조회는 계속 유효
+    HRESULT hr = MetadataIndex::Write(path, std::move(entries));
+    if (FAILED(hr)) {
+        MBD_LOG_ERROR(L"Failed to write metadata index: ", LogHex(hr));
+        return hr;
+    }
+    
+    auto metadataIndex = std::make_shared<MetadataIndex>();
+    hr = metadataIndex->Open(path);
+    if (FAILED(hr)) {
+        MBD_LOG_ERROR(L"Failed to open metadata index: ", LogHex(hr));
+        return hr;
+    }
+    std::atomic_store(&m_metadataIndex, std::shared_ptr<const MetadataIndex>(metadataIndex));
+    
+    MBD_LOG_INFO(L"Published metadata index: ", count, L" entries");
+    return S_OK;
+}
+
+bool CloudFilesProvider::LookupMetadata(const std::wstring& relativePath, FileMetadata& metadata) const {
+    auto metadataIndex = GetMetadataIndex();
+    MetadataView view;
+    if (!metadataIndex || !metadataIndex->Find(relativePath, view)) {
+        return false;
     }
     
-    HRESULT hr = CfSetPinState(fileHandle, pinState, CF_SET_PIN_FLAG_NONE, nullptr);
-    CloseHandle(fileHandle);
+    metadata.relativePath.assign(view.relativePath, view.relativePathLength);
+    metadata.fileIdentity.assign(reinterpret_cast<const char*>(view.fileIdentity), view.fileIdentityLength);
+    metadata.fileSize = view.fileSize;
+    metadata.contentVersion = view.contentVersion;
+    memcpy(metadata.contentHash.bytes, view.contentHash, sizeof(metadata.contentHash.bytes));
+    metadata.syncState = view.syncState;
+    return true;
+}
+
+std::wstring CloudFilesProvider::GetMetadataIndexPath() const {
+    return m_metadataIndexPath.empty() ? GetMainBoothDriveCacheFolder() + L"\\metadata.idx" : m_metadataIndexPath;
+}
+
+std::shared_ptr<const MetadataIndex> CloudFilesProvider::GetMetadataIndex() const {
+    return std::atomic_load(&m_metadataIndex);
+}
+
+void CloudFilesProvider::SetTransferBufferConfig(const TransferBufferPoolConfig& config) {
+    m_transferBufferConfig = config;
+}
+
+TransferBufferPoolStats CloudFilesProvider::GetTransferBufferStats() const {
+    return m_transferBuffers ? m_transferBuffers->GetStats() : TransferBufferPoolStats();
+}
+
+void CloudFilesProvider::SetPrefetchConfig(const PrefetchConfig& config) {
+    m_prefetchConfig = config;
+}
+
+void CloudFilesProvider::SetLogConfig(const LoggerConfig& config) {
+    m_logConfig = config;
+}
+
+LoggerStats CloudFilesProvider::GetLogStats() const {
+    return Logger::Instance().GetStats();
+}
+
+namespace {
+
+MbdLatencySummary ToLatencySummary(const LatencySummary& summary) {
+    MbdLatencySummary result = {};
+    result.count = summary.count;
+    result.meanNs = summary.mean;
+    result.p50Ns = summary.p50;
+    result.p90Ns = summary.p90;
+    result.p99Ns = summary.p99;
+    result.p999Ns = summary.p999;
+    result.maxNs = summary.max;
+    return result;
+}
+
+} // namespace
+
+HRESULT CloudFilesProvider::GetMetricsSnapshot(MbdMetricsSnapshot& snapshot) const {
+    snapshot = {};
+    snapshot.structSize = sizeof(MbdMetricsSnapshot);
+    snapshot.version = MBD_METRICS_VERSION;
+    
+    snapshot.fetchData = ToLatencySummary(m_metrics.Summarize(MetricHistogram::FetchDataCallback));
+    snapshot.validateData = ToLatencySummary(m_metrics.Summarize(MetricHistogram::ValidateDataCallback));
+    snapshot.cancelFetchData = ToLatencySummary(m_metrics.Summarize(MetricHistogram::CancelFetchDataCallback));
+    snapshot.fetchPlaceholders = ToLatencySummary(m_metrics.Summarize(MetricHistogram::FetchPlaceholdersCallback));
+    snapshot.notifications = ToLatencySummary(m_metrics.Summarize(MetricHistogram::NotificationCallback));
+    snapshot.timeToFirstByte = ToLatencySummary(m_metrics.Summarize(MetricHistogram::TimeToFirstByte));
+    snapshot.queueWait = ToLatencySummary(m_metrics.Summarize(MetricHistogram::QueueWait));
+    snapshot.download = ToLatencySummary(m_metrics.Summarize(MetricHistogram::Download));
+    
+    snapshot.bytesTransferred = m_metrics.Get(MetricCounter::BytesTransferred);
+    snapshot.fetchRequests = m_metrics.Get(MetricCounter::FetchRequests);
+    snapshot.downloadsStarted = m_metrics.Get(MetricCounter::DownloadsStarted);
+    snapshot.downloadsCompleted = m_metrics.Get(MetricCounter::DownloadsCompleted);
+    snapshot.downloadsFailed = m_metrics.Get(MetricCounter::DownloadsFailed);
+    snapshot.downloadsCancelled = m_metrics.Get(MetricCounter::DownloadsCancelled);
+    
+    if (m_executor) {
+        FetchExecutorStats executorStats = m_executor->GetStats();
+        snapshot.queueDepth = static_cast<uint32_t>(executorStats.queuedTasks);
+        snapshot.activeWorkers = static_cast<uint32_t>(executorStats.activeTasks);
+        snapshot.workerCount = static_cast<uint32_t>(executorStats.workerCount);
+        snapshot.workerUtilization = executorStats.workerCount > 0 
+            ? static_cast<double>(executorStats.activeTasks) / executorStats.workerCount : 0.0;
+        snapshot.workerBusyMs = static_cast<uint64_t>(executorStats.totalRunMs);
+    }
+    snapshot.inFlightFetches = static_cast<uint32_t>(m_inFlightFetches.GetStats().inFlight);
+    
+    snapshot.placeholderBatch = ToLatencySummary(m_metrics.Summarize(MetricHistogram::PlaceholderBatch));
+    snapshot.placeholdersCreated = m_metrics.Get(MetricCounter::PlaceholdersCreated);
+    if (m_transferBuffers) {
+        TransferBufferPoolStats bufferStats = m_transferBuffers->GetStats();
+        ULONGLONG freeBytes = static_cast<ULONGLONG>(bufferStats.freeBuffers) * bufferStats.bufferSize;
+        snapshot.transferPoolBytes = bufferStats.pooledBytes;
+        snapshot.transferBytesInUse = bufferStats.pooledBytes > freeBytes ? bufferStats.pooledBytes - freeBytes : 0;
+    }
     
+    snapshot.bytesVerified = m_metrics.Get(MetricCounter::BytesVerified);
+    snapshot.blocksFailedVerification = m_metrics.Get(MetricCounter::BlocksFailedVerification);
+    snapshot.unverifiedValidations = m_metrics.Get(MetricCounter::UnverifiedValidations);
+    return S_OK;
+}
+
+void CloudFilesProvider::ResetMetrics() {
+    m_metrics.Reset();
+}
+
+void CloudFilesProvider::EnableTracing(size_t capacity) {
+    TraceRecorder::Instance().Enable(capacity);
+    MBD_LOG_INFO(L"Hydration tracing enabled (", TraceRecorder::Instance().Capacity(), L" events)");
+}
+
+void CloudFilesProvider::DisableTracing() {
+    TraceRecorder::Instance().Disable();
+}
+
+HRESULT CloudFilesProvider::DumpTrace(const std::wstring& path) const {
+    HRESULT hr = TraceRecorder::Instance().WriteChromeTrace(path, [this](PathId pathId) {
+        return m_paths.GetPath(pathId);
+    });
+    if (FAILED(hr)) {
+        MBD_LOG_ERROR(L"Failed to write trace ", path, L": ", LogHex(hr));
+    } else {
+        MBD_LOG_INFO(L"Trace written: ", path);
+    }
     return hr;
 }
 
-void CloudFilesProvider::SetFetchDataCallback(std::function<std::vector<BYTE>(const std::wstring&)> callback) {
-    m_fetchDataCallback = callback;
+PrefetchStats CloudFilesProvider::GetPrefetchStats() const {
+    return m_prefetcher ? m_prefetcher->GetStats() : PrefetchStats();
+}
+
+void CloudFilesProvider::SetReadAheadSize(LONGLONG readAheadBytes) {
+    m_readAheadBytes = (std::max)(readAheadBytes, 0LL);
 }
 
 void CloudFilesProvider::SetNotifyCallback(std::function<void(const std::wstring&, const std::wstring&)> callback) {
     m_notifyCallback = callback;
 }
 
-// 콜백 함수 구현
-void CALLBACK CloudFilesProvider::OnFetchData(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters) {
-    CloudFilesProvider* provider = static_cast<CloudFilesProvider*>(CallbackInfo->CallbackContext);
-    
-    std::wstring relativePath = CallbackInfo->NormalizedPath;
-    std::wcout << L"Fetch data requested for: " << relativePath << std::endl;
-    
-    if (provider->m_fetchDataCallback) {
-        // 비동기 작업으로 큐에 추가
-        {
-            std::lock_guard<std::mutex> lock(provider->m_queueMutex);
-            provider->m_workQueue.push([provider, relativePath, transferKey = CallbackParameters->FetchData.RequiredFileOffset]() {
-                std::vector<BYTE> data = provider->m_fetchDataCallback(relativePath);
-                
-                // 데이터 전송
-                CF_OPERATION_INFO opInfo = {};
-                CF_OPERATION_PARAMETERS opParams = {};
-                
-                opInfo.StructSize = sizeof(CF_OPERATION_INFO);
-                opInfo.Type = CF_OPERATION_TYPE_TRANSFER_DATA;
-                opInfo.ConnectionKey = provider->m_connectionKey;
-                opInfo.TransferKey = transferKey;
-                
-                opParams.ParamSize = sizeof(CF_OPERATION_PARAMETERS);
-                opParams.TransferData.CompletionStatus = STATUS_SUCCESS;
-                opParams.TransferData.Buffer = data.data();
-                opParams.TransferData.Length = static_cast<DWORD>(data.size());
-                opParams.TransferData.Offset.QuadPart = 0;
-                
-                HRESULT hr = CfExecute(&opInfo, &opParams);
-                if (FAILED(hr)) {
-                    std::wcout << L"Failed to transfer data in callback: 0x" << std::hex << hr << std::endl;
-                }
-            });
+// 백엔드 이벤트 구현
+void CloudFilesProvider::OnFetchData(const BackendFileInfo& file, const FetchKey& key, LONGLONG requiredOffset, LONGLONG requiredLength) {
+    ScopedLatency latency(m_metrics, MetricHistogram::FetchDataCallback);
+    m_metrics.Add(MetricCounter::FetchRequests);
+    
+    // 경로는 ID로만 전달하고 문자열은 앱 콜백이나 Win32 호출 직전에 만듦
+    PathId pathId = m_paths.Intern(file.relativePath, file.relativePathLength);
+    ScopedTrace trace(kHydrationTraceCategory, "FETCH_DATA", 0, pathId, { "offset", requiredOffset }, { "length", requiredLength });
+    
+    // 순차 읽기로 판단되면 미리 읽기 크기를 늘림
+    LONGLONG readAhead = m_readAheadBytes;
+    if (m_prefetcher) {
+        readAhead = (std::max)(readAhead, m_prefetcher->OnFetchRange(pathId, requiredOffset, requiredLength));
+    }
+    
+    HydrationRange range = AlignToManifestBlocks(ComputeHydrationRange(requiredOffset, requiredLength, readAhead, file.fileSize), file);
+    MBD_LOG_DEBUG(L"Fetch data requested for: ", file.displayPath, L" (offset ", range.offset, L", length ", range.length, L")");
+    
+    if (!m_fetchDataCallback || !m_executor) {
+        // 데이터 소스나 워커 풀이 없으면 요청을 실패로 완료해 열기가 멈추지 않도록 함
+        m_backend->FailTransfer(key, requiredOffset, requiredLength, TransferFailure::Failed);
+        return;
+    }
+    
+    // 사용자가 연 파일은 포그라운드, provider가 시작한 하이드레이션은 요청된 우선순위
+    // (같은 파일을 다른 프로세스가 읽는 요청까지 낮은 우선순위가 되지 않도록 이 프로세스의 요청에만 적용)
+    HydrationPriority priority = HydrationPriority::Foreground;
+    if (file.processId != 0 && file.processId == GetCurrentProcessId()) {
+        std::lock_guard<std::mutex> lock(m_priorityMutex);
+        auto requested = m_requestedPriorities.find(pathId);
+        if (requested != m_requestedPriorities.end() && !requested->second.empty()) {
+            priority = *requested->second.begin();
+        }
+    }
+    
+    // 취소할 수 있도록 진행 중 테이블에 등록 (같은 파일의 겹치는 다운로드가 있으면 합류)
+    auto fetch = m_inFlightFetches.Register(key, pathId, range.offset, range.length, priority);
+    TraceRecorder::Instance().AsyncBegin(kHydrationTraceCategory, "fetch", fetch->id, pathId,
+                                         { "offset", range.offset }, { "length", range.length });
+    if (!fetch->ownsDownload) {
+        TraceRecorder::Instance().Instant(kHydrationTraceCategory, "joined download", fetch->id, pathId,
+                                          { "download", static_cast<int64_t>(fetch->download->id) });
+        MBD_LOG_DEBUG(L"Joined in-flight download for: ", file.displayPath);
+        
+        // 큐에 있던 낮은 우선순위 다운로드는 이 요청의 우선순위로 올림
+        // (작업 ID가 아직 없으면 다운로드를 만든 쪽이 Submit 뒤에 다시 확인함)
+        uint64_t taskId = fetch->download->taskId.load();
+        if (fetch->promotedDownload && taskId != 0) {
+            m_executor->Reprioritize(taskId, priority);
         }
-        provider->m_queueCondition.notify_one();
+        return;
+    }
+    
+    // 비동기 작업으로 워커 풀에 추가
+    std::shared_ptr<SharedDownload> download = fetch->download;
+    m_metrics.Add(MetricCounter::DownloadsStarted);
+    download->fileSize = file.fileSize;
+    
+    // 플레이스홀더 ID에서 객체와 버전을 경로 조회 없이 얻음
+    // 이전 형식 ID면 메타데이터 인덱스에서 버전을 찾음 (할당 없이 매핑에서 바로)
+    bool structured = ResolveCacheIdentity(file.fileIdentity, file.fileIdentityLength,
+                                           download->fileIdentity, download->contentVersion);
+    auto metadataIndex = structured ? nullptr : GetMetadataIndex();
+    if (metadataIndex) {
+        MetadataView metadata;
+        if (metadataIndex->Find(file.relativePath, file.relativePathLength, metadata)) {
+            download->contentVersion = metadata.contentVersion;
+        }
+    }
+    // 스케줄러는 폴더별 공정성을 위해 경로 문자열이 필요하므로 새 다운로드마다 한 번만 만듦
+    download->taskId = m_executor->Submit(m_paths.GetPath(pathId), priority,
+                                          [this, download, submittedAt = std::chrono::steady_clock::now()]() {
+        const auto startedAt = std::chrono::steady_clock::now();
+        m_metrics.Record(MetricHistogram::QueueWait, startedAt - submittedAt);
+        TraceRecorder::Instance().AsyncSpan(kHydrationTraceCategory, "queued", download->id, submittedAt, startedAt,
+                                            download->pathId, { "priority", static_cast<int64_t>(download->priority.load()) });
+        download->started = true;
+        TransferDownload(download);
+    }, [this, download]() { AbortDownload(download); });
+    if (download->taskId == 0) {
+        // 정지 중이라 워커 풀이 작업을 받지 않음
+        AbortDownload(download);
+    } else if (download->priority.load() != priority) {
+        // Submit 전에 더 급한 요청이 합류해 우선순위를 올림
+        m_executor->Reprioritize(download->taskId, download->priority);
     }
 }
 
-void CALLBACK CloudFilesProvider::OnValidateData(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters) {
-    std::wcout << L"Validate data for: " << CallbackInfo->NormalizedPath << std::endl;
+void CloudFilesProvider::OnValidateData(const BackendFileInfo& file, const FetchKey& key, LONGLONG offset, LONGLONG length) {
+    ScopedLatency latency(m_metrics, MetricHistogram::ValidateDataCallback);
+    ScopedTrace trace(kHydrationTraceCategory, "VALIDATE_DATA", 0, m_paths.Find(file.relativePath, file.relativePathLength),
+                      { "offset", offset }, { "length", length });
+    MBD_LOG_DEBUG(L"Validate data for: ", file.displayPath, L" (offset ", offset, L", length ", length, L")");
     
-    CF_OPERATION_INFO opInfo = {};
-    CF_OPERATION_PARAMETERS opParams = {};
+    // 플레이스홀더 ID의 매니페스트 ID로 블록 해시를 찾음
+    PlaceholderIdentity identity;
+    bool structured = PlaceholderIdentity::Parse(file.fileIdentity, file.fileIdentityLength, identity);
+    std::shared_ptr<const BlockManifest> manifest;
+    if (m_manifests && structured && identity.HasManifestId()) {
+        manifest = m_manifests->Find(identity.manifestId);
+    }
+    if (!manifest) {
+        // 비교할 해시가 없으면 설정에 따라 그대로 ACK하거나 실패로 응답
+        m_metrics.Add(MetricCounter::UnverifiedValidations);
+        bool accept = !m_validationConfig.requireManifest;
+        if (!accept) {
+            MBD_LOG_WARNING(L"No block manifest for: ", file.displayPath);
+        }
+        m_backend->AcknowledgeData(key, offset, length, accept);
+        return;
+    }
     
-    opInfo.StructSize = sizeof(CF_OPERATION_INFO);
-    opInfo.Type = CF_OPERATION_TYPE_ACK_DATA;
-    opInfo.ConnectionKey = CallbackInfo->ConnectionKey;
-    opInfo.TransferKey = CallbackParameters->ValidateData.RequiredFileOffset;
+    // 크기가 다르면 잘렸거나 다른 버전이므로 블록을 읽지 않고 실패로 응답
+    BlockVerification verification;
+    HRESULT hr = E_INVALIDARG;
+    if (manifest->fileSize == file.fileSize) {
+        hr = VerifyBlockRange(*manifest, offset, length,
+            [this, &key](BYTE* buffer, LONGLONG readOffset, LONGLONG readLength, LONGLONG& returned) {
+                return m_backend->RetrieveData(key, buffer, readOffset, readLength, returned);
+            },
+            m_transferBuffers.get(), m_executor.get(), m_verifyThreads, verification);
+    }
+    m_metrics.Add(MetricCounter::BytesVerified, verification.bytesHashed);
     
-    opParams.ParamSize = sizeof(CF_OPERATION_PARAMETERS);
-    opParams.AckData.CompletionStatus = STATUS_SUCCESS;
-    opParams.AckData.Offset = CallbackParameters->ValidateData.RequiredFileOffset;
-    opParams.AckData.Length = CallbackParameters->ValidateData.RequiredLength;
+    size_t failedBlocks = 0;
+    if (FAILED(hr)) {
+        failedBlocks = 1;
+        m_backend->AcknowledgeData(key, offset, length, false);
+    } else {
+        // 결과가 같은 연속 블록끼리 묶어 요청 범위 안에서 응답 (해시가 맞은 구간만 ACK)
+        const LONGLONG end = offset + length;
+        const size_t blockCount = verification.verified.size();
+        LONGLONG runStart = offset;
+        for (size_t i = 0; i < blockCount; ++i) {
+            const bool valid = verification.verified[i] != 0;
+            if (!valid) {
+                failedBlocks++;
+            }
+            if (i + 1 < blockCount && (verification.verified[i + 1] != 0) == valid) {
+                continue;
+            }
+            const LONGLONG runEnd = i + 1 < blockCount
+                ? static_cast<LONGLONG>(verification.firstBlock + i + 1) * manifest->blockSize : end;
+            m_backend->AcknowledgeData(key, runStart, runEnd - runStart, valid);
+            runStart = runEnd;
+        }
+    }
+    if (failedBlocks == 0) {
+        return;
+    }
     
-    CfExecute(&opInfo, &opParams);
-}
-
-void CALLBACK CloudFilesProvider::OnCancelFetchData(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters) {
-    std::wcout << L"Cancel fetch data for: " << CallbackInfo->NormalizedPath << std::endl;
-    // 진행 중인 다운로드 취소 로직 구현
+    // 캐시에서 채운 블록이 손상되었을 수 있으므로 이 파일의 캐시 블록을 버리고 다음 fetch는 원격에서 받음
+    m_metrics.Add(MetricCounter::BlocksFailedVerification, failedBlocks);
+    MBD_LOG_WARNING(L"Data validation failed for: ", file.displayPath, L" (", failedBlocks, L" blocks)");
+    if (m_blockCache && structured) {
+        m_blockCache->InvalidateFile(identity.CacheKey());
+    }
+    if (m_notifyCallback) {
+        m_notifyCallback(file.displayPath, L"validation_failed");
+    }
 }
 
-void CALLBACK CloudFilesProvider::OnNotifyFileOpenCompletion(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters) {
-    CloudFilesProvider* provider = static_cast<CloudFilesProvider*>(CallbackInfo->CallbackContext);
-    if (provider->m_notifyCallback) {
-        provider->m_notifyCallback(CallbackInfo->NormalizedPath, L"file_opened");
+void CloudFilesProvider::OnCancelFetchData(const BackendFileInfo& file, const FetchKey& key, LONGLONG offset, LONGLONG length) {
+    ScopedLatency latency(m_metrics, MetricHistogram::CancelFetchDataCallback);
+    ScopedTrace trace(kHydrationTraceCategory, "CANCEL_FETCH_DATA", 0, m_paths.Find(file.relativePath, file.relativePathLength),
+                      { "offset", offset }, { "length", length });
+    auto orphaned = m_inFlightFetches.Cancel(key, offset, length);
+    
+    // 기다리는 요청이 없어진 다운로드가 아직 큐에 있으면 바로 제거해 워커 슬롯을 반환,
+    // 실행 중인 다운로드는 다음 청크에서 중단됨
+    for (const auto& download : orphaned) {
+        uint64_t taskId = download->taskId.load();
+        if (taskId != 0 && m_executor) {
+            m_executor->Cancel(taskId);
+        }
     }
+    
+    MBD_LOG_DEBUG(L"Cancel fetch data for: ", file.displayPath, L" (", orphaned.size(), L" downloads stopped)");
 }
 
-void CALLBACK CloudFilesProvider::OnNotifyFileCloseCompletion(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters) {
-    CloudFilesProvider* provider = static_cast<CloudFilesProvider*>(CallbackInfo->CallbackContext);
-    if (provider->m_notifyCallback) {
-        provider->m_notifyCallback(CallbackInfo->NormalizedPath, L"file_closed");
+void CloudFilesProvider::OnFetchPlaceholders(const BackendFileInfo& directory, const FetchKey& key) {
+    ScopedLatency latency(m_metrics, MetricHistogram::FetchPlaceholdersCallback);
+    std::wstring relativeDirectory = directory.RelativePath();
+    
+    MBD_LOG_DEBUG(L"Fetch placeholders requested for: ", relativeDirectory);
+    
+    RemoteDirectoryIndex::Children children = m_directoryIndex.GetChildren(relativeDirectory);
+    if (!children && m_notifyCallback) {
+        m_notifyCallback(relativeDirectory, L"directory_requested");
     }
+    
+    if (!children) {
+        // 아직 목록이 없는 폴더는 빈 결과로 완료되어 다음 열거 때 다시 요청됨
+        HRESULT hr = m_backend->TransferPlaceholders(key, relativeDirectory, nullptr);
+        if (FAILED(hr)) {
+            MBD_LOG_ERROR(L"Failed to transfer placeholders: ", LogHex(hr));
+        }
+        return;
+    }
+    
+    HRESULT hr;
+    {
+        ScopedLatency batchLatency(m_metrics, MetricHistogram::PlaceholderBatch);
+        hr = m_backend->TransferPlaceholders(key, relativeDirectory, children.get());
+    }
+    if (FAILED(hr)) {
+        MBD_LOG_ERROR(L"Failed to transfer placeholders: ", LogHex(hr));
+        return;
+    }
+    m_metrics.Add(MetricCounter::PlaceholdersCreated, children->size());
+    MBD_LOG_DEBUG(L"Transferred ", children->size(), L" placeholders for: ", relativeDirectory);
 }
 
-void CALLBACK CloudFilesProvider::OnNotifyDehydrate(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters) {
-    std::wcout << L"Dehydrate notification for: " << CallbackInfo->NormalizedPath << std::endl;
+void CloudFilesProvider::OnFileOpened(const BackendFileInfo& file) {
+    ScopedLatency latency(m_metrics, MetricHistogram::NotificationCallback);
+    if (m_prefetcher) {
+        m_prefetcher->OnFileOpened(file.RelativePath(), file.processId);
+    }
+    if (m_notifyCallback) {
+        m_notifyCallback(file.displayPath, L"file_opened");
+    }
 }
 
-void CALLBACK CloudFilesProvider::OnNotifyDehydrateCompletion(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters) {
-    std::wcout << L"Dehydrate completion for: " << CallbackInfo->NormalizedPath << std::endl;
+void CloudFilesProvider::OnFileClosed(const BackendFileInfo& file) {
+    ScopedLatency latency(m_metrics, MetricHistogram::NotificationCallback);
+    const PathId pathId = m_paths.Find(file.relativePath, file.relativePathLength);
+    if (m_prefetcher) {
+        m_prefetcher->OnFileClosed(file.RelativePath(), pathId);
+    }
+    {
+        // 다음에 열 때는 진행률을 처음부터 다시 셈
+        std::lock_guard<std::mutex> lock(m_progressMutex);
+        m_hydratedBytes.erase(pathId);
+    }
+    if (m_notifyCallback) {
+        m_notifyCallback(file.displayPath, L"file_closed");
+    }
 }
 
-void CALLBACK CloudFilesProvider::OnNotifyDelete(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters) {
-    CloudFilesProvider* provider = static_cast<CloudFilesProvider*>(CallbackInfo->CallbackContext);
-    if (provider->m_notifyCallback) {
-        provider->m_notifyCallback(CallbackInfo->NormalizedPath, L"file_deleted");
+void CloudFilesProvider::OnFileDeleted(const BackendFileInfo& file) {
+    ScopedLatency latency(m_metrics, MetricHistogram::NotificationCallback);
+    
+    // 삭제된 파일의 캐시 블록 연결 해제
+    if (m_blockCache && file.fileIdentity && file.fileIdentityLength > 0) {
+        std::string cacheKey;
+        ULONGLONG contentVersion = 0;
+        ResolveCacheIdentity(file.fileIdentity, file.fileIdentityLength, cacheKey, contentVersion);
+        m_blockCache->InvalidateFile(cacheKey);
+    }
+    
+    if (m_notifyCallback) {
+        m_notifyCallback(file.displayPath, L"file_deleted");
     }
 }
 
-void CALLBACK CloudFilesProvider::OnNotifyDeleteCompletion(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters) {
-    std::wcout << L"Delete completion for: " << CallbackInfo->NormalizedPath << std::endl;
+void CloudFilesProvider::OnFileRenamed(const BackendFileInfo& file) {
+    ScopedLatency latency(m_metrics, MetricHistogram::NotificationCallback);
+    
+    if (m_notifyCallback) {
+        m_notifyCallback(file.displayPath, L"file_renamed");
+    }
 }
 
-void CALLBACK CloudFilesProvider::OnNotifyRename(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters) {
-    CloudFilesProvider* provider = static_cast<CloudFilesProvider*>(CallbackInfo->CallbackContext);
-    if (provider->m_notifyCallback) {
-        provider->m_notifyCallback(CallbackInfo->NormalizedPath, L"file_renamed");
+// 헬퍼 메서드 구현
+bool CloudFilesProvider::ResolveCacheIdentity(const void* fileIdentity, size_t length, std::string& cacheKey, ULONGLONG& contentVersion) {
+    // 구조화된 ID면 객체 ID와 버전으로, 이전 형식이면 바이트 그대로 캐시 키로 사용
+    PlaceholderIdentity identity;
+    if (PlaceholderIdentity::Parse(fileIdentity, length, identity)) {
+        cacheKey = identity.CacheKey();
+        contentVersion = identity.contentVersion;
+        return true;
     }
+    
+    cacheKey.assign(static_cast<const char*>(fileIdentity), fileIdentity ? length : 0);
+    return false;
 }
 
-void CALLBACK CloudFilesProvider::OnNotifyRenameCompletion(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters) {
-    std::wcout << L"Rename completion for: " << CallbackInfo->NormalizedPath << std::endl;
+std::wstring CloudFilesProvider::GetFullPath(const std::wstring& relativePath) {
+    return m_syncRootPath + L"\\" + relativePath;
 }
 
-// 헬퍼 메서드 구현
-HRESULT CloudFilesProvider::CreateSyncRegistration(const std::wstring& displayName, CF_SYNC_REGISTRATION& registration) {
-    ZeroMemory(&registration, sizeof(registration));
+std::vector<std::wstring> CloudFilesProvider::ListDirectoryFiles(const std::wstring& relativeDirectory) {
+    std::vector<std::wstring> files;
+    std::wstring pattern = GetFullPath(relativeDirectory) + L"\\*";
+    
+    WIN32_FIND_DATAW findData;
+    HANDLE findHandle = FindFirstFileW(pattern.c_str(), &findData);
+    if (findHandle == INVALID_HANDLE_VALUE) {
+        return files;
+    }
     
-    registration.StructSize = sizeof(CF_SYNC_REGISTRATION);
-    registration.ProviderId = &MainBoothDriveProviderId;
-    registration.ProviderName = displayName.c_str();
-    registration.ProviderVersion = L"1.0.0";
+    do {
+        if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+            files.push_back(relativeDirectory + L"\\" + findData.cFileName);
+        }
+    } while (FindNextFileW(findHandle, &findData));
+    FindClose(findHandle);
     
-    // 동기화 정책 설정
-    CF_SYNC_POLICIES policies = {};
-    policies.StructSize = sizeof(CF_SYNC_POLICIES);
-    policies.Hydration.Primary = CF_HYDRATION_POLICY_FULL;
-    policies.Population.Primary = CF_POPULATION_POLICY_ALWAYS_FULL;
-    policies.InSync = CF_INSYNC_POLICY_TRACK_ALL;
-    policies.HardLink = CF_HARDLINK_POLICY_NONE;
-    policies.PlaceholderManagement = CF_PLACEHOLDER_MANAGEMENT_POLICY_DEFAULT;
+    return files;
+}
+
+CloudFilesProvider::HydrationRange CloudFilesProvider::ComputeHydrationRange(LONGLONG requiredOffset, LONGLONG requiredLength, LONGLONG readAheadBytes, LONGLONG fileSize) {
+    // TRANSFER_DATA의 오프셋/길이는 4KB 정렬이어야 함 (파일 끝에서 끝나는 경우 제외)
+    LONGLONG start = requiredOffset & ~(kTransferAlignment - 1);
+    LONGLONG end = requiredOffset + requiredLength + (std::max)(readAheadBytes, 0LL);
+    end = (end + kTransferAlignment - 1) & ~(kTransferAlignment - 1);
+    if (end > fileSize) {
+        end = fileSize;
+    }
     
-    registration.SyncPolicies = &policies;
+    HydrationRange range;
+    range.offset = start;
+    range.length = (std::max)(end - start, 0LL);
+    return range;
+}
+
+CloudFilesProvider::HydrationRange CloudFilesProvider::AlignToManifestBlocks(const HydrationRange& range, const BackendFileInfo& file) const {
+    // VALIDATE_DATA는 요청 범위와 겹치는 블록 전체를 해시하므로, 블록 일부만 받아 두면
+    // 나머지를 읽지 못해 불일치로 응답하게 됨 -> 받을 때부터 블록 단위로 받음
+    if (!m_manifests || range.length <= 0) {
+        return range;
+    }
+    PlaceholderIdentity identity;
+    if (!PlaceholderIdentity::Parse(file.fileIdentity, file.fileIdentityLength, identity) || !identity.HasManifestId()) {
+        return range;
+    }
+    std::shared_ptr<const BlockManifest> manifest = m_manifests->Find(identity.manifestId);
+    if (!manifest || manifest->fileSize != file.fileSize || !manifest->IsConsistent()) {
+        return range;
+    }
     
-    return S_OK;
+    const LONGLONG blockSize = manifest->blockSize;
+    LONGLONG start = range.offset / blockSize * blockSize;
+    LONGLONG end = (range.offset + range.length + blockSize - 1) / blockSize * blockSize;
+    if (end > file.fileSize) {
+        end = file.fileSize;
+    }
+    
+    HydrationRange aligned;
+    aligned.offset = start;
+    aligned.length = end - start;
+    return aligned;
 }
 
-HRESULT CloudFilesProvider::CreatePlaceholderInfo(const std::wstring& relativePath, const FILE_BASIC_INFO& basicInfo, LARGE_INTEGER fileSize, CF_PLACEHOLDER_CREATE_INFO& placeholderInfo) {
-    ZeroMemory(&placeholderInfo, sizeof(placeholderInfo));
+HRESULT CloudFilesProvider::TransferDownload(const std::shared_ptr<SharedDownload>& download) {
+    TraceRecorder& tracer = TraceRecorder::Instance();
+    if (download->cancelToken->IsCancelled()) {
+        for (const auto& fetch : m_inFlightFetches.FinishDownload(download)) {
+            tracer.AsyncEnd(kHydrationTraceCategory, "fetch", fetch->id, fetch->pathId, { "cancelled", 1 });
+        }
+        m_metrics.Add(MetricCounter::DownloadsCancelled);
+        return HRESULT_FROM_WIN32(ERROR_CANCELLED);
+    }
+    
+    const auto startedAt = std::chrono::steady_clock::now();
+    tracer.AsyncBegin(kHydrationTraceCategory, "download", download->id, download->pathId,
+                      { "offset", download->offset }, { "length", download->length });
+    FetchRequest request;
+    request.relativePath = m_paths.GetPath(download->pathId);
+    request.offset = download->offset;
+    request.length = download->length;
+    request.fileSize = download->fileSize;
+    request.fileIdentity = download->fileIdentity;
+    request.contentVersion = download->contentVersion;
+    request.cancelToken = download->cancelToken;
+    
+    ChunkedFetchSink sink(download->offset, download->length, static_cast<size_t>(kTransferChunkSize),
+        [this, download](const BYTE* buffer, LONGLONG offset, LONGLONG length) {
+            return FanOutChunk(download, buffer, offset, length);
+        }, download->cancelToken, m_transferBuffers.get());
     
-    // 파일명 복사
-    size_t pathLength = (relativePath.length() + 1) * sizeof(WCHAR);
-    LPWSTR fileName = static_cast<LPWSTR>(HeapAlloc(GetProcessHeap(), 0, pathLength));
-    if (!fileName) {
-        return E_OUTOFMEMORY;
+    HRESULT hr = m_blockCache ? FetchThroughBlockCache(*m_blockCache, m_fetchDataCallback, request, sink, m_transferBuffers.get())
+                              : m_fetchDataCallback(request, sink);
+    HRESULT finishHr = sink.Finish();
+    if (SUCCEEDED(hr)) {
+        hr = finishHr;
     }
-    wcscpy_s(fileName, relativePath.length() + 1, relativePath.c_str());
     
-    // 파일 ID 생성 (간단한 해시 사용)
-    std::hash<std::wstring> hasher;
-    size_t hashValue = hasher(relativePath);
+    auto consumers = m_inFlightFetches.FinishDownload(download);
+    m_metrics.Record(MetricHistogram::Download, std::chrono::steady_clock::now() - startedAt);
+    m_metrics.Add(sink.IsCancelled() ? MetricCounter::DownloadsCancelled 
+                  : FAILED(hr) ? MetricCounter::DownloadsFailed : MetricCounter::DownloadsCompleted);
+    if (tracer.IsEnabled()) {
+        tracer.AsyncEnd(kHydrationTraceCategory, "download", download->id, download->pathId,
+                        { "hr", static_cast<int64_t>(static_cast<uint32_t>(hr)) }, { "cancelled", sink.IsCancelled() ? 1 : 0 });
+        for (const auto& fetch : consumers) {
+            tracer.AsyncEnd(kHydrationTraceCategory, "fetch", fetch->id, fetch->pathId,
+                            { "hr", static_cast<int64_t>(static_cast<uint32_t>(hr)) }, { "transferred", fetch->transferred.load() });
+        }
+    }
     
-    BYTE* fileIdentity = static_cast<BYTE*>(HeapAlloc(GetProcessHeap(), 0, sizeof(size_t)));
-    if (!fileIdentity) {
-        HeapFree(GetProcessHeap(), 0, fileName);
-        return E_OUTOFMEMORY;
+    if (FAILED(hr)) {
+        m_progressThrottle.Forget(download->pathId);
     }
-    memcpy(fileIdentity, &hashValue, sizeof(size_t));
     
-    // 플레이스홀더 정보 설정
-    placeholderInfo.RelativeFileName = fileName;
-    placeholderInfo.FileIdentity = fileIdentity;
-    placeholderInfo.FileIdentityLength = sizeof(size_t);
+    if (sink.IsCancelled()) {
+        // 취소된 전송은 이미 종료되었으므로 CfExecute를 호출하지 않음
+        MBD_LOG_DEBUG(L"Fetch cancelled: ", request.relativePath, L" at offset ", sink.CommittedOffset());
+        return HRESULT_FROM_WIN32(ERROR_CANCELLED);
+    }
     
-    // 파일 시스템 메타데이터 설정
-    CF_FS_METADATA fsMetadata = {};
-    fsMetadata.FileSize = fileSize;
-    fsMetadata.BasicInfo = basicInfo;
+    if (FAILED(hr)) {
+        // 각 요청에서 전송되지 않은 남은 범위를 실패로 완료
+        MBD_LOG_ERROR(L"Failed to fetch ", request.relativePath, L" at offset ", sink.CommittedOffset(), L": ", LogHex(hr));
+        for (const auto& fetch : consumers) {
+            LONGLONG start = (std::max)(fetch->offset, sink.CommittedOffset());
+            LONGLONG end = fetch->offset + fetch->length;
+            if (!fetch->cancelToken->IsCancelled() && start < end) {
+                m_backend->FailTransfer(fetch->key, start, end - start, TransferFailure::Failed);
+            }
+        }
+    }
     
-    placeholderInfo.FsMetadata = &fsMetadata;
+    return hr;
+}
+
+void CloudFilesProvider::AbortDownload(const std::shared_ptr<SharedDownload>& download) {
+    // 시작되지 못한 다운로드에 합류한 요청을 모두 중단으로 완료해 앱이 열기를 기다리며 멈추지 않게 함
+    auto consumers = m_inFlightFetches.FinishDownload(download);
+    m_metrics.Add(MetricCounter::DownloadsFailed);
+    for (const auto& fetch : consumers) {
+        TraceRecorder::Instance().AsyncEnd(kHydrationTraceCategory, "fetch", fetch->id, fetch->pathId, { "aborted", 1 });
+        if (!fetch->cancelToken->IsCancelled()) {
+            m_backend->FailTransfer(fetch->key, fetch->offset, fetch->length, TransferFailure::Aborted);
+        }
+    }
+    MBD_LOG_DEBUG(L"Aborted queued download: ", m_paths.GetPath(download->pathId), L" (", consumers.size(), L" requests)");
+}
+
+HRESULT CloudFilesProvider::FanOutChunk(const std::shared_ptr<SharedDownload>& download, const BYTE* buffer, LONGLONG offset, LONGLONG length) {
+    // 청크와 겹치는 각 요청의 전송 키로 데이터를 나눠 전송
+    auto consumers = m_inFlightFetches.BeginChunk(download, offset + length);
     
-    return S_OK;
+    // 진행률은 요청 범위가 아니라 파일 전체 기준 (부분 하이드레이션에서도 탐색기 표시가 파일 크기와 맞도록)
+    const LONGLONG fileSize = download->fileSize > 0 ? download->fileSize : download->offset + download->length;
+    LONGLONG fileCompleted = -1;
+    
+    size_t liveConsumers = 0;
+    HRESULT lastError = S_OK;
+    for (const auto& fetch : consumers) {
+        if (fetch->cancelToken->IsCancelled()) {
+            continue;
+        }
+        
+        LONGLONG start = (std::max)(offset, fetch->offset);
+        LONGLONG end = (std::min)(offset + length, fetch->offset + fetch->length);
+        if (start < end) {
+            HRESULT hr;
+            {
+                ScopedTrace trace(kHydrationTraceCategory, "TRANSFER_DATA", fetch->id, fetch->pathId,
+                                  { "offset", start }, { "length", end - start });
+                hr = m_backend->TransferData(fetch->key, buffer + (start - offset), start, end - start);
+            }
+            if (FAILED(hr)) {
+                // 실패한 전송에는 더 이상 데이터를 보내지 않음
+                MBD_LOG_ERROR(L"Failed to transfer data in callback: ", LogHex(hr));
+                fetch->cancelToken->Cancel();
+                m_progressThrottle.Forget(fetch->pathId);
+                lastError = hr;
+                continue;
+            }
+            LONGLONG transferred = fetch->transferred += end - start;
+            if (transferred == end - start) {
+                auto firstByte = std::chrono::steady_clock::now() - fetch->requestedAt;
+                m_metrics.Record(MetricHistogram::TimeToFirstByte, firstByte);
+                TraceRecorder::Instance().Instant(kHydrationTraceCategory, "first byte", fetch->id, fetch->pathId,
+                    { "latencyUs", std::chrono::duration_cast<std::chrono::microseconds>(firstByte).count() });
+            }
+            m_metrics.Add(MetricCounter::BytesTransferred, static_cast<uint64_t>(end - start));
+            if (fileCompleted < 0) {
+                // 겹치는 요청이 여럿이어도 청크 하나는 파일에 한 번만 채워짐
+                fileCompleted = AddHydratedBytes(download->pathId, length, fileSize);
+            }
+            ReportProgress(*fetch, fileSize, fileCompleted);
+        }
+        liveConsumers++;
+    }
+    
+    return liveConsumers > 0 || consumers.empty() ? S_OK : lastError;
 }
 
-std::wstring CloudFilesProvider::GetFullPath(const std::wstring& relativePath) {
-    return m_syncRootPath + L"\\" + relativePath;
+LONGLONG CloudFilesProvider::AddHydratedBytes(PathId pathId, LONGLONG length, LONGLONG fileSize) {
+    std::lock_guard<std::mutex> lock(m_progressMutex);
+    LONGLONG& hydrated = m_hydratedBytes[pathId];
+    hydrated = (std::min)(hydrated + length, fileSize);
+    LONGLONG completed = hydrated;
+    if (completed >= fileSize) {
+        m_hydratedBytes.erase(pathId);
+    }
+    return completed;
 }
 
-HANDLE CloudFilesProvider::GetFileHandle(const std::wstring& relativePath) {
-    std::wstring fullPath = GetFullPath(relativePath);
-    return CreateFileW(
-        fullPath.c_str(),
-        GENERIC_READ | GENERIC_WRITE,
-        FILE_SHARE_READ | FILE_SHARE_WRITE,
-        nullptr,
-        OPEN_EXISTING,
-        FILE_ATTRIBUTE_NORMAL,
-        nullptr
-    );
+void CloudFilesProvider::ReportProgress(const InFlightFetch& fetch, LONGLONG fileSize, LONGLONG fileCompleted) {
+    // 셸(탐색기 진행 표시줄)에는 청크마다 보고
+    m_backend->ReportProgress(fetch.key, fileSize, fileCompleted);
+    
+    // 앱에는 파일별 초당 최대 횟수까지만 전달
+    if (m_progressCallback && m_progressThrottle.ShouldReport(fetch.pathId, fileCompleted, fileSize)) {
+        m_progressCallback(m_paths.GetPath(fetch.pathId), fileCompleted, fileSize);
+    }
 }
 
 // 헬퍼 함수 구현
@@ -445,6 +1190,15 @@ std::wstring GetMainBoothDriveFolder() {
     return std::wstring(userProfile) + L"\\Main Booth Drive";
 }
 
+std::wstring GetMainBoothDriveCacheFolder() {
+    WCHAR localAppData[MAX_PATH];
+    if (GetEnvironmentVariableW(L"LOCALAPPDATA", localAppData, MAX_PATH) == 0) {
+        return L"";
+    }
+    
+    return std::wstring(localAppData) + L"\\com.mainbooth.drive\\Cache";
+}
+
 std::string WStringToString(const std::wstring& wstr) {
     std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
     return converter.to_bytes(wstr);
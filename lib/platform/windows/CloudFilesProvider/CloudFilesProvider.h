@@ -6,12 +6,32 @@
 #include <vector>
 #include <memory>
 #include <functional>
-#include <thread>
 #include <mutex>
-#include <condition_variable>
-#include <queue>
+#include <unordered_map>
+#include <set>
 
-class CloudFilesProvider {
+#include "FetchStream.h"
+#include "FetchExecutor.h"
+#include "InFlightFetches.h"
+#include "BlockCache.h"
+#include "BlockManifest.h"
+#include "PrefetchPredictor.h"
+#include "ProgressThrottle.h"
+#include "PlaceholderArena.h"
+#include "RemoteDirectoryIndex.h"
+#include "MetadataIndex.h"
+#include "FileHandleCache.h"
+#include "InSyncUpdater.h"
+#include "PathTable.h"
+#include "Logger.h"
+#include "Metrics.h"
+#include "TraceRecorder.h"
+#include "ProviderMetricsApi.h"
+#include "ProviderBackend.h"
+
+// fetch 엔진, 캐시, 지표를 묶은 provider
+// OS와의 연결(플레이스홀더, 하이드레이션 전송, 알림)은 ProviderBackend를 통해서만 함
+class CloudFilesProvider : private ProviderBackendEvents {
 public:
     static CloudFilesProvider& GetInstance();
     
@@ -19,108 +39,221 @@ public:
     HRESULT Initialize();
     void Shutdown();
     
+    // 플랫폼 백엔드 (RegisterSyncRoot 전에 호출, 설정하지 않으면 cfapi 백엔드)
+    void SetBackend(std::unique_ptr<ProviderBackend> backend);
+    
     // 동기화 루트 관리
     HRESULT RegisterSyncRoot(const std::wstring& syncRootPath, const std::wstring& displayName);
     HRESULT UnregisterSyncRoot(const std::wstring& syncRootPath);
     
     // 파일 작업
-    HRESULT CreatePlaceholder(const std::wstring& relativePath, const FILE_BASIC_INFO& basicInfo, LARGE_INTEGER fileSize);
+    HRESULT CreatePlaceholder(const std::wstring& relativePath, const FILE_BASIC_INFO& basicInfo, LARGE_INTEGER fileSize,
+                              const PlaceholderIdentity& identity = PlaceholderIdentity());
+    
+    // 한 폴더의 플레이스홀더를 백엔드 호출 한 번으로 생성
+    // results에는 항목별 결과가 entries와 같은 순서로 채워짐 (일부 실패해도 나머지는 계속 생성)
+    HRESULT CreatePlaceholders(const std::wstring& parentRelativePath, const PlaceholderEntry* entries, size_t count,
+                               std::vector<HRESULT>* results = nullptr);
     HRESULT HydrateFile(const std::wstring& relativePath, const std::vector<BYTE>& data, std::function<void(double)> progressCallback);
     HRESULT UpdateFileMetadata(const std::wstring& relativePath, const FILE_BASIC_INFO& basicInfo);
     HRESULT DeleteFile(const std::wstring& relativePath);
     
-    // 동기화 상태 관리
-    HRESULT SetInSyncState(const std::wstring& relativePath, CF_IN_SYNC_STATE state);
-    HRESULT SetPinState(const std::wstring& relativePath, CF_PIN_STATE pinState);
+    // provider가 직접 시작하는 하이드레이션 (고정 폴더, 미리 가져오기)
+    // 완료될 때까지 호출 스레드를 블록하므로 fetch 워커에서 호출하면 안 됨
+    HRESULT HydratePlaceholder(const std::wstring& relativePath, HydrationPriority priority);
+    
+    // 동기화 상태 관리 (백엔드로 전달)
+    HRESULT SetInSyncState(const std::wstring& relativePath, InSyncState state);
+    HRESULT SetPinState(const std::wstring& relativePath, PinState pinState);
+    
+    // 비동기 동기화 상태 변경 (같은 경로는 합치고 폴더별로 묶어 백그라운드에서 처리)
+    // 실패한 경로는 알림 콜백으로 "in_sync_failed" 전달
+    void QueueInSyncState(const std::wstring& relativePath, InSyncState state);
+    void FlushInSyncUpdates();
+    InSyncUpdaterStats GetInSyncUpdaterStats() const;
+    
+    // 백엔드가 상태 변경에 재사용하는 파일 핸들 캐시 (0이면 매번 열고 닫음)
+    void SetFileHandleCacheCapacity(size_t capacity);
+    FileHandleCacheStats GetFileHandleCacheStats() const;
     
     // 콜백 설정
     void SetFetchDataCallback(std::function<std::vector<BYTE>(const std::wstring&)> callback);
+    void SetRangedFetchDataCallback(std::function<std::vector<BYTE>(const std::wstring&, LONGLONG, LONGLONG)> callback);
+    void SetStreamingFetchCallback(StreamingFetchCallback callback);
     void SetNotifyCallback(std::function<void(const std::wstring&, const std::wstring&)> callback);
+    
+    // 하이드레이션 진행률 (경로, 전송된 바이트, 전체 바이트), 파일별 초당 최대 횟수로 제한됨
+    void SetProgressCallback(std::function<void(const std::wstring&, LONGLONG, LONGLONG)> callback);
+    void SetProgressUpdateRate(double maxUpdatesPerSecond);
+    
+    // fetch 워커 풀 설정 (Initialize 전에 호출)
+    void SetExecutorConfig(const FetchExecutorConfig& config);
+    FetchExecutorStats GetExecutorStats() const;
+    InFlightFetchStats GetInFlightFetchStats() const;
+    
+    // 로컬 블록 캐시 설정 (Initialize 전에 호출)
+    void SetBlockCacheConfig(const BlockCacheConfig& config);
+    BlockCacheStats GetBlockCacheStats() const;
+    void InvalidateCachedFile(const std::wstring& relativePath);
+    
+    // 폴더 채우기 방식 (RegisterSyncRoot 전에 호출)
+    void SetPopulationMode(PopulationMode mode);
+    
+    // 하이드레이션 방식 (RegisterSyncRoot 전에 호출, 기본은 부분 하이드레이션)
+    void SetHydrationPolicy(HydrationPolicy policy);
+    
+    // 부분 채우기 모드에서 폴더가 열거될 때 내려줄 원격 하위 항목
+    // 아직 열거되지 않은 폴더만 반영되므로 이미 채워진 폴더는 CreatePlaceholders로 갱신
+    void SetDirectoryContents(const std::wstring& relativeDirectory, std::vector<PlaceholderEntry> entries);
+    void RemoveDirectoryContents(const std::wstring& relativeDirectory);
+    
+    // 하이드레이션 데이터 검증 설정 (Initialize 전에 호출, 동기화 루트를 등록할 때 적용)
+    // 켜면 하이드레이션된 범위를 블록 매니페스트와 비교해 해시가 맞는 구간만 ACK함
+    void SetDataValidationConfig(const DataValidationConfig& config);
+    
+    // 블록 매니페스트 등록/제거 (manifestId는 PlaceholderIdentity.manifestId와 같은 16바이트)
+    // 앱은 업로드/다운로드 뒤 MbdPublishBlockManifest로 등록하고, ID는 ManifestIdFromTreeRoot(트리 해시)로 정함
+    HRESULT PublishBlockManifest(const BYTE* manifestId, const BlockManifest& manifest);
+    void RemoveBlockManifest(const BYTE* manifestId);
+    
+    // 원격 메타데이터 인덱스 (비어 있으면 DriveConfig.cachePath 아래 metadata.idx)
+    // PublishMetadata는 인덱스 파일을 새로 쓰고 열린 인덱스를 교체함
+    void SetMetadataIndexPath(const std::wstring& path);
+    HRESULT PublishMetadata(std::vector<FileMetadata> entries);
+    bool LookupMetadata(const std::wstring& relativePath, FileMetadata& metadata) const;
+    
+    // 전송 버퍼 풀 설정 (Initialize 전에 호출, 버퍼 크기는 전송 청크와 캐시 블록 중 큰 값으로 맞춰짐)
+    void SetTransferBufferConfig(const TransferBufferPoolConfig& config);
+    TransferBufferPoolStats GetTransferBufferStats() const;
+    
+    // 접근 패턴 기반 미리 가져오기 설정 (Initialize 전에 호출)
+    void SetPrefetchConfig(const PrefetchConfig& config);
+    PrefetchStats GetPrefetchStats() const;
+    
+    // 콜백 지연 시간, 첫 바이트까지 시간, 전송량, 큐 깊이 (MbdGetMetricsSnapshot으로 노출)
+    HRESULT GetMetricsSnapshot(MbdMetricsSnapshot& snapshot) const;
+    void ResetMetrics();
+    
+    // 하이드레이션 과정(콜백 수신, 큐 대기, 다운로드, 첫 바이트, 각 TRANSFER_DATA, 완료/취소) 추적
+    // 이벤트는 고정 크기 링 버퍼에 남고 DumpTrace로 Chrome/Perfetto trace JSON 파일을 씀
+    void EnableTracing(size_t capacity = 65536);
+    void DisableTracing();
+    HRESULT DumpTrace(const std::wstring& path) const;
+    
+    // 비동기 로거 설정 (Initialize 전에 호출, 파일 경로가 비어 있으면 캐시 폴더 아래 Logs)
+    void SetLogConfig(const LoggerConfig& config);
+    LoggerStats GetLogStats() const;
+    
+    // 하이드레이션 설정 (요청 범위 뒤로 미리 가져올 바이트 수)
+    void SetReadAheadSize(LONGLONG readAheadBytes);
+    
+    // TRANSFER_DATA 한 번에 전송하는 청크 크기 (4KB 정렬)
+    static constexpr LONGLONG kTransferChunkSize = 4 * 1024 * 1024;
+    static constexpr LONGLONG kTransferAlignment = 4096;
 
 private:
     CloudFilesProvider() = default;
     ~CloudFilesProvider() = default;
+    friend struct std::default_delete<CloudFilesProvider>;
     CloudFilesProvider(const CloudFilesProvider&) = delete;
     CloudFilesProvider& operator=(const CloudFilesProvider&) = delete;
     
     // 내부 헬퍼 메서드
-    HRESULT CreateSyncRegistration(const std::wstring& displayName, CF_SYNC_REGISTRATION& registration);
-    HRESULT CreatePlaceholderInfo(const std::wstring& relativePath, const FILE_BASIC_INFO& basicInfo, 
-                                  LARGE_INTEGER fileSize, CF_PLACEHOLDER_CREATE_INFO& placeholderInfo);
+    static bool ResolveCacheIdentity(const void* fileIdentity, size_t length, std::string& cacheKey, ULONGLONG& contentVersion);
     std::wstring GetFullPath(const std::wstring& relativePath);
-    HANDLE GetFileHandle(const std::wstring& relativePath);
+    std::wstring GetMetadataIndexPath() const;
+    std::shared_ptr<const MetadataIndex> GetMetadataIndex() const;
+    std::vector<std::wstring> ListDirectoryFiles(const std::wstring& relativeDirectory);
     
-    // 콜백 함수들
-    static void CALLBACK OnFetchData(
-        const CF_CALLBACK_INFO* CallbackInfo,
-        const CF_CALLBACK_PARAMETERS* CallbackParameters
-    );
-    
-    static void CALLBACK OnValidateData(
-        const CF_CALLBACK_INFO* CallbackInfo,
-        const CF_CALLBACK_PARAMETERS* CallbackParameters
-    );
-    
-    static void CALLBACK OnCancelFetchData(
-        const CF_CALLBACK_INFO* CallbackInfo,
-        const CF_CALLBACK_PARAMETERS* CallbackParameters
-    );
-    
-    static void CALLBACK OnNotifyFileOpenCompletion(
-        const CF_CALLBACK_INFO* CallbackInfo,
-        const CF_CALLBACK_PARAMETERS* CallbackParameters
-    );
-    
-    static void CALLBACK OnNotifyFileCloseCompletion(
-        const CF_CALLBACK_INFO* CallbackInfo,
-        const CF_CALLBACK_PARAMETERS* CallbackParameters
-    );
-    
-    static void CALLBACK OnNotifyDehydrate(
-        const CF_CALLBACK_INFO* CallbackInfo,
-        const CF_CALLBACK_PARAMETERS* CallbackParameters
-    );
-    
-    static void CALLBACK OnNotifyDehydrateCompletion(
-        const CF_CALLBACK_INFO* CallbackInfo,
-        const CF_CALLBACK_PARAMETERS* CallbackParameters
-    );
-    
-    static void CALLBACK OnNotifyDelete(
-        const CF_CALLBACK_INFO* CallbackInfo,
-        const CF_CALLBACK_PARAMETERS* CallbackParameters
-    );
-    
-    static void CALLBACK OnNotifyDeleteCompletion(
-        const CF_CALLBACK_INFO* CallbackInfo,
-        const CF_CALLBACK_PARAMETERS* CallbackParameters
-    );
-    
-    static void CALLBACK OnNotifyRename(
-        const CF_CALLBACK_INFO* CallbackInfo,
-        const CF_CALLBACK_PARAMETERS* CallbackParameters
-    );
-    
-    static void CALLBACK OnNotifyRenameCompletion(
-        const CF_CALLBACK_INFO* CallbackInfo,
-        const CF_CALLBACK_PARAMETERS* CallbackParameters
-    );
+    // 범위 하이드레이션
+    struct HydrationRange {
+        LONGLONG offset = 0;
+        LONGLONG length = 0;
+    };
+    static HydrationRange ComputeHydrationRange(LONGLONG requiredOffset, LONGLONG requiredLength, 
+                                                LONGLONG readAheadBytes, LONGLONG fileSize);
+    // 검증할 매니페스트가 있으면 범위를 블록 경계로 넓힘 (부분 하이드레이션에서도 VALIDATE_DATA가 블록 전체를 읽을 수 있게)
+    HydrationRange AlignToManifestBlocks(const HydrationRange& range, const BackendFileInfo& file) const;
+    HRESULT TransferDownload(const std::shared_ptr<SharedDownload>& download);
+    void AbortDownload(const std::shared_ptr<SharedDownload>& download);
+    HRESULT FanOutChunk(const std::shared_ptr<SharedDownload>& download, const BYTE* buffer, LONGLONG offset, LONGLONG length);
+    LONGLONG AddHydratedBytes(PathId pathId, LONGLONG length, LONGLONG fileSize);
+    void ReportProgress(const InFlightFetch& fetch, LONGLONG fileSize, LONGLONG fileCompleted);
+    
+    // 백엔드 이벤트 (백엔드의 콜백 스레드에서 호출됨)
+    void OnFetchData(const BackendFileInfo& file, const FetchKey& key, LONGLONG offset, LONGLONG length) override;
+    void OnCancelFetchData(const BackendFileInfo& file, const FetchKey& key, LONGLONG offset, LONGLONG length) override;
+    void OnValidateData(const BackendFileInfo& file, const FetchKey& key, LONGLONG offset, LONGLONG length) override;
+    void OnFetchPlaceholders(const BackendFileInfo& directory, const FetchKey& key) override;
+    void OnFileOpened(const BackendFileInfo& file) override;
+    void OnFileClosed(const BackendFileInfo& file) override;
+    void OnFileDeleted(const BackendFileInfo& file) override;
+    void OnFileRenamed(const BackendFileInfo& file) override;
 
 private:
     bool m_initialized = false;
     std::wstring m_syncRootPath;
-    CF_CONNECTION_KEY m_connectionKey = CF_CONNECTION_KEY_INVALID;
+    std::unique_ptr<ProviderBackend> m_backend;
     
     // 비동기 작업 관리
-    std::thread m_workerThread;
-    std::mutex m_queueMutex;
-    std::condition_variable m_queueCondition;
-    std::queue<std::function<void()>> m_workQueue;
-    bool m_shouldStop = false;
+    FetchExecutorConfig m_executorConfig;
+    std::unique_ptr<FetchExecutor> m_executor;
+    InFlightFetchTable m_inFlightFetches;
+    
+    // 동기화 루트 기준 경로의 인터닝 테이블 (콜백과 내부 상태는 경로 대신 ID를 사용)
+    PathTable m_paths;
+    
+    // 부분 채우기 모드의 폴더별 원격 하위 항목
+    PopulationMode m_populationMode = PopulationMode::Full;
+    HydrationPolicy m_hydrationPolicy = HydrationPolicy::Partial;
+    RemoteDirectoryIndex m_directoryIndex;
+    
+    // 콜백에서 경로로 원격 메타데이터를 찾는 메모리 맵 인덱스 (교체는 원자적으로)
+    std::wstring m_metadataIndexPath;
+    std::shared_ptr<const MetadataIndex> m_metadataIndex;
+    
+    // 프로젝트 다운로드 후 대량의 동기화 상태 변경을 모아서 처리
+    std::unique_ptr<InSyncUpdater> m_inSyncUpdater;
+    
+    // 백엔드를 연결할 때 적용하는 파일 핸들 캐시 크기
+    size_t m_fileHandleCacheCapacity = 256;
+    
+    // 스테이징과 캐시 채우기에 재사용하는 페이지 정렬 버퍼
+    TransferBufferPoolConfig m_transferBufferConfig;
+    std::unique_ptr<TransferBufferPool> m_transferBuffers;
+    
+    // 디하이드레이트 후 다시 여는 파일을 로컬에서 채우는 블록 캐시
+    BlockCacheConfig m_blockCacheConfig;
+    std::unique_ptr<BlockCache> m_blockCache;
+    
+    // VALIDATE_DATA에서 비교할 파일별 블록 해시
+    DataValidationConfig m_validationConfig;
+    std::unique_ptr<BlockManifestStore> m_manifests;
+    size_t m_verifyThreads = 1;
+    
+    // 콜백별 지연 시간 히스토그램과 전송 카운터
+    MetricsRegistry m_metrics;
+    
+    // 콜백 스레드에서 콘솔 대신 쓰는 비동기 로거 (Initialize에서 시작했으면 Shutdown에서 정지)
+    LoggerConfig m_logConfig;
+    bool m_ownsLogger = false;
+    
+    // 열기/닫기 알림으로 학습하는 미리 가져오기 엔진
+    PrefetchConfig m_prefetchConfig;
+    std::unique_ptr<PrefetchPredictor> m_prefetcher;
+    
+    // HydratePlaceholder로 시작된 하이드레이션의 우선순위 (경로별)
+    std::mutex m_priorityMutex;
+    std::unordered_map<PathId, std::multiset<HydrationPriority>> m_requestedPriorities;  // 진행 중인 HydratePlaceholder 호출마다 하나
+    LONGLONG m_readAheadBytes = 0;
     
     // 콜백 함수들
-    std::function<std::vector<BYTE>(const std::wstring&)> m_fetchDataCallback;
+    StreamingFetchCallback m_fetchDataCallback;
     std::function<void(const std::wstring&, const std::wstring&)> m_notifyCallback;
+    std::function<void(const std::wstring&, LONGLONG, LONGLONG)> m_progressCallback;
+    ProgressThrottle m_progressThrottle;
+    std::mutex m_progressMutex;
+    std::unordered_map<PathId, LONGLONG> m_hydratedBytes;  // 파일별로 지금까지 전송한 바이트 (다 채우거나 닫히면 제거)
     
     // 정적 인스턴스
     static std::unique_ptr<CloudFilesProvider> s_instance;
@@ -132,6 +265,7 @@ extern const GUID MainBoothDriveProviderId;
 
 // 헬퍼 함수들
 std::wstring GetMainBoothDriveFolder();
+std::wstring GetMainBoothDriveCacheFolder();
 std::string WStringToString(const std::wstring& wstr);
 std::wstring StringToWString(const std::string& str);
 FILETIME DateTimeToFileTime(const std::chrono::system_clock::time_point& timePoint);
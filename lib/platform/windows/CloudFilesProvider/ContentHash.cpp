@@ -0,0 +1,74 @@
+#include "ContentHash.h"
+#include <bcrypt.h>
+#include <algorithm>
+
+#pragma comment(lib, "bcrypt.lib")
+
+std::wstring ContentHash::ToHex() const {
+    static const wchar_t digits[] = L"0123456789abcdef";
+    std::wstring hex;
+    hex.reserve(sizeof(bytes) * 2);
+    for (BYTE value : bytes) {
+        hex.push_back(digits[value >> 4]);
+        hex.push_back(digits[value & 0x0F]);
+    }
+    return hex;
+}
+
+HRESULT ComputeContentHash(const BYTE* data, size_t length, ContentHash& hash) {
+    if (length > MAXULONG) {
+        return E_INVALIDARG;
+    }
+    
+    NTSTATUS status = BCryptHash(BCRYPT_SHA256_ALG_HANDLE, nullptr, 0, 
+                                 const_cast<BYTE*>(data), static_cast<ULONG>(length), 
+                                 hash.bytes, sizeof(hash.bytes));
+    return BCRYPT_SUCCESS(status) ? S_OK : HRESULT_FROM_NT(status);
+}
+
+ContentHasher::~ContentHasher() {
+    if (m_hash) {
+        BCryptDestroyHash(m_hash);
+    }
+}
+
+HRESULT ContentHasher::EnsureStarted() {
+    if (m_hash) {
+        return S_OK;
+    }
+    
+    BCRYPT_HASH_HANDLE hash = nullptr;
+    NTSTATUS status = BCryptCreateHash(BCRYPT_SHA256_ALG_HANDLE, &hash, nullptr, 0, nullptr, 0, 0);
+    if (!BCRYPT_SUCCESS(status)) {
+        return HRESULT_FROM_NT(status);
+    }
+    m_hash = hash;
+    return S_OK;
+}
+
+HRESULT ContentHasher::Update(const BYTE* data, size_t length) {
+    HRESULT hr = EnsureStarted();
+    while (SUCCEEDED(hr) && length > 0) {
+        ULONG part = static_cast<ULONG>((std::min)(length, static_cast<size_t>(MAXULONG)));
+        NTSTATUS status = BCryptHashData(m_hash, const_cast<BYTE*>(data), part, 0);
+        if (!BCRYPT_SUCCESS(status)) {
+            return HRESULT_FROM_NT(status);
+        }
+        data += part;
+        length -= part;
+    }
+    return hr;
+}
+
+HRESULT ContentHasher::Finish(ContentHash& hash) {
+    HRESULT hr = EnsureStarted();
+    if (FAILED(hr)) {
+        return hr;
+    }
+    
+    // 끝낸 핸들은 다시 쓸 수 없으므로 해제하고 다음 Update에서 새로 만듦
+    NTSTATUS status = BCryptFinishHash(m_hash, hash.bytes, sizeof(hash.bytes), 0);
+    BCryptDestroyHash(m_hash);
+    m_hash = nullptr;
+    return BCRYPT_SUCCESS(status) ? S_OK : HRESULT_FROM_NT(status);
+}
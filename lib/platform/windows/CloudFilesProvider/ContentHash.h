@@ -0,0 +1,35 @@
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include <cstring>
+
+// SHA-256 콘텐츠 해시
+struct ContentHash {
+    BYTE bytes[32] = {};
+    
+    bool operator==(const ContentHash& other) const { return memcmp(bytes, other.bytes, sizeof(bytes)) == 0; }
+    bool operator!=(const ContentHash& other) const { return !(*this == other); }
+    std::wstring ToHex() const;
+};
+
+// CNG(BCrypt)로 SHA-256 계산 (지원 CPU에서는 SHA 확장 명령 사용)
+HRESULT ComputeContentHash(const BYTE* data, size_t length, ContentHash& hash);
+
+// 데이터를 나눠 넣는 SHA-256 (파일 전체를 메모리에 올리지 않고 해시)
+class ContentHasher {
+public:
+    ContentHasher() = default;
+    ~ContentHasher();
+    
+    ContentHasher(const ContentHasher&) = delete;
+    ContentHasher& operator=(const ContentHasher&) = delete;
+    
+    HRESULT Update(const BYTE* data, size_t length);
+    HRESULT Finish(ContentHash& hash);
+
+private:
+    HRESULT EnsureStarted();
+    
+    void* m_hash = nullptr;  // BCRYPT_HASH_HANDLE
+};
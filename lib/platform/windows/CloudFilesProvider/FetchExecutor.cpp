@@ -0,0 +1,167 @@
+#include "FetchExecutor.h"
+#include <algorithm>
+
+namespace {
+
+double ElapsedMs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+} // namespace
+
+FetchExecutor::FetchExecutor(const FetchExecutorConfig& config)
+    : m_scheduler(config.strictFifo, config.folderWeights) {
+    if (config.strictFifo) {
+        m_workerCount = 1;
+    } else if (config.workerCount > 0) {
+        m_workerCount = config.workerCount;
+    } else {
+        m_workerCount = RecommendedWorkerCount(config.expectedIoLatencyMs, config.expectedCpuTimeMs, config.maxWorkers);
+    }
+}
+
+FetchExecutor::~FetchExecutor() {
+    Stop();
+}
+
+void FetchExecutor::Start() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_running) {
+        return;
+    }
+    
+    m_running = true;
+    m_stats.workerCount = m_workerCount;
+    for (size_t i = 0; i < m_workerCount; ++i) {
+        m_workers.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+void FetchExecutor::Close() {
+    std::vector<ScheduledTask> dropped;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            return;
+        }
+        m_running = false;
+        dropped = m_scheduler.Drain();
+        m_stats.abortedTasks += dropped.size();
+    }
+    m_condition.notify_all();
+    
+    // 기다리던 요청이 멈춰 있지 않도록 잠금 밖에서 버려진 작업을 알림
+    for (auto& task : dropped) {
+        if (task.dropped) {
+            task.dropped();
+        }
+    }
+}
+
+void FetchExecutor::Stop() {
+    Close();
+    
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_workers.clear();
+}
+
+uint64_t FetchExecutor::Submit(const std::wstring& label, HydrationPriority priority, Task task, Task dropped) {
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            return 0;
+        }
+        id = m_nextTaskId++;
+        
+        ScheduledTask queued;
+        queued.info.id = id;
+        queued.info.label = label;
+        queued.info.priority = priority;
+        queued.info.enqueuedAt = std::chrono::steady_clock::now();
+        queued.task = std::move(task);
+        queued.dropped = std::move(dropped);
+        m_scheduler.Push(std::move(queued));
+        
+        m_stats.submittedTasks++;
+    }
+    m_condition.notify_one();
+    return id;
+}
+
+bool FetchExecutor::Cancel(uint64_t taskId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_scheduler.Remove(taskId)) {
+        return false;
+    }
+    m_stats.cancelledTasks++;
+    return true;
+}
+
+bool FetchExecutor::Reprioritize(uint64_t taskId, HydrationPriority priority) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_scheduler.Reprioritize(taskId, priority)) {
+        return false;
+    }
+    m_stats.reprioritizedTasks++;
+    return true;
+}
+
+FetchExecutorStats FetchExecutor::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FetchExecutorStats stats = m_stats;
+    stats.queuedTasks = m_scheduler.Size();
+    for (size_t i = 0; i < kHydrationPriorityCount; ++i) {
+        stats.queuedByPriority[i] = m_scheduler.Size(static_cast<HydrationPriority>(i));
+    }
+    stats.activeTasks = m_activeTasks.size();
+    return stats;
+}
+
+std::vector<FetchTaskInfo> FetchExecutor::GetActiveTasks() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<FetchTaskInfo> tasks;
+    tasks.reserve(m_activeTasks.size());
+    for (const auto& entry : m_activeTasks) {
+        tasks.push_back(entry.second);
+    }
+    return tasks;
+}
+
+size_t FetchExecutor::RecommendedWorkerCount(double ioLatencyMs, double cpuTimeMs, size_t maxWorkers) {
+    size_t cores = (std::max)(std::thread::hardware_concurrency(), 1u);
+    double blockingRatio = cpuTimeMs > 0.0 ? ioLatencyMs / cpuTimeMs : 0.0;
+    size_t workers = static_cast<size_t>(cores * (1.0 + (std::max)(blockingRatio, 0.0)));
+    return (std::min)((std::max)(workers, static_cast<size_t>(1)), (std::max)(maxWorkers, static_cast<size_t>(1)));
+}
+
+void FetchExecutor::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_condition.wait(lock, [this] { return !m_scheduler.Empty() || !m_running; });
+        if (!m_running) {
+            return;
+        }
+        
+        ScheduledTask queued = m_scheduler.Pop();
+        
+        queued.info.startedAt = std::chrono::steady_clock::now();
+        double waitMs = ElapsedMs(queued.info.enqueuedAt, queued.info.startedAt);
+        m_stats.totalQueueWaitMs += waitMs;
+        m_stats.maxQueueWaitMs = (std::max)(m_stats.maxQueueWaitMs, waitMs);
+        m_activeTasks[queued.info.id] = queued.info;
+        lock.unlock();
+        
+        queued.task();
+        
+        auto finishedAt = std::chrono::steady_clock::now();
+        lock.lock();
+        m_activeTasks.erase(queued.info.id);
+        m_stats.completedTasks++;
+        m_stats.totalRunMs += ElapsedMs(queued.info.startedAt, finishedAt);
+    }
+}
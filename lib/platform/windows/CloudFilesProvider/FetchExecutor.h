@@ -0,0 +1,90 @@
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#include "HydrationScheduler.h"
+
+// fetch 워커 풀 설정
+struct FetchExecutorConfig {
+    size_t workerCount = 0;             // 0이면 하드웨어 동시성과 I/O 지연으로 자동 계산
+    double expectedIoLatencyMs = 50.0;  // 작업당 원격 I/O 대기 시간
+    double expectedCpuTimeMs = 5.0;     // 작업당 CPU 사용 시간
+    size_t maxWorkers = 64;
+    bool strictFifo = false;            // true면 워커 1개로 기존 FIFO 순서를 그대로 유지
+    std::unordered_map<std::wstring, unsigned> folderWeights;  // 비어 있으면 기본 폴더 가중치
+};
+
+// 실행기 통계
+struct FetchExecutorStats {
+    size_t workerCount = 0;
+    size_t queuedTasks = 0;
+    size_t queuedByPriority[kHydrationPriorityCount] = {};
+    size_t activeTasks = 0;
+    uint64_t submittedTasks = 0;
+    uint64_t completedTasks = 0;
+    uint64_t cancelledTasks = 0;   // 실행 전에 큐에서 제거된 작업
+    uint64_t reprioritizedTasks = 0;
+    uint64_t abortedTasks = 0;     // 정지할 때 큐에 남아 실행되지 못한 작업
+    double totalQueueWaitMs = 0.0;
+    double maxQueueWaitMs = 0.0;
+    double totalRunMs = 0.0;
+};
+
+// 여러 하이드레이션을 동시에 처리하는 fetch 워커 풀
+class FetchExecutor {
+public:
+    using Task = std::function<void()>;
+    
+    explicit FetchExecutor(const FetchExecutorConfig& config = FetchExecutorConfig());
+    ~FetchExecutor();
+    FetchExecutor(const FetchExecutor&) = delete;
+    FetchExecutor& operator=(const FetchExecutor&) = delete;
+    
+    void Start();
+    
+    // 새 작업을 더 받지 않고 큐에 남은 작업을 버림 (각 작업의 dropped를 호출, 실행 중인 작업은 계속 진행)
+    void Close();
+    
+    // Close 후 실행 중인 작업이 끝날 때까지 워커를 기다림
+    void Stop();
+    
+    // 작업 추가, 작업 ID 반환 (label은 폴더 가중치 계산에 쓰이는 경로)
+    // 실행 중이 아니면 작업을 받지 않고 0을 반환하며, 받은 작업이 실행되지 못하고 버려지면 dropped를 호출함
+    uint64_t Submit(const std::wstring& label, HydrationPriority priority, Task task, Task dropped = nullptr);
+    
+    // 아직 시작되지 않은 작업을 큐에서 제거 (이미 실행 중이면 false)
+    bool Cancel(uint64_t taskId);
+    
+    // 아직 시작되지 않은 작업의 우선순위 변경 (이미 실행 중이면 false)
+    bool Reprioritize(uint64_t taskId, HydrationPriority priority);
+    
+    FetchExecutorStats GetStats() const;
+    std::vector<FetchTaskInfo> GetActiveTasks() const;
+    size_t GetWorkerCount() const { return m_workerCount; }
+    
+    // 워커 수 = 코어 수 * (1 + I/O 대기 시간 / CPU 시간)
+    static size_t RecommendedWorkerCount(double ioLatencyMs, double cpuTimeMs, size_t maxWorkers);
+
+private:
+    void WorkerLoop();
+    
+    size_t m_workerCount;
+    std::vector<std::thread> m_workers;
+    
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    HydrationScheduler m_scheduler;
+    std::unordered_map<uint64_t, FetchTaskInfo> m_activeTasks;
+    bool m_running = false;
+    uint64_t m_nextTaskId = 1;
+    
+    FetchExecutorStats m_stats;
+};
@@ -0,0 +1,145 @@
+#include "FetchStream.h"
+#include <algorithm>
+#include <cstring>
+
+StreamingFetchCallback MakeStreamingFetchCallback(std::function<std::vector<BYTE>(const std::wstring&)> wholeFileCallback) {
+    return [wholeFileCallback](const FetchRequest& request, FetchSink& sink) -> HRESULT {
+        // 기존 콜백은 파일 전체를 반환하므로 요청 범위만 잘라서 전달
+        std::vector<BYTE> data = wholeFileCallback(request.relativePath);
+        LONGLONG available = static_cast<LONGLONG>(data.size()) - request.offset;
+        if (available <= 0) {
+            return HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+        }
+        
+        size_t length = static_cast<size_t>((std::min)(available, request.length));
+        return sink.Write(data.data() + request.offset, length);
+    };
+}
+
+StreamingFetchCallback MakeStreamingFetchCallback(std::function<std::vector<BYTE>(const std::wstring&, LONGLONG, LONGLONG)> rangedCallback) {
+    return [rangedCallback](const FetchRequest& request, FetchSink& sink) -> HRESULT {
+        const LONGLONG end = request.offset + request.length;
+        const LONGLONG chunkSize = static_cast<LONGLONG>(sink.PreferredChunkSize());
+        
+        for (LONGLONG offset = request.offset; offset < end; ) {
+            LONGLONG length = (std::min)(chunkSize, end - offset);
+            std::vector<BYTE> chunk = rangedCallback(request.relativePath, offset, length);
+            if (chunk.empty()) {
+                return HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+            }
+            
+            size_t written = (std::min)(chunk.size(), static_cast<size_t>(length));
+            HRESULT hr = sink.Write(chunk.data(), written);
+            if (FAILED(hr)) {
+                return hr;
+            }
+            offset += static_cast<LONGLONG>(written);
+        }
+        return S_OK;
+    };
+}
+
+ChunkedFetchSink::ChunkedFetchSink(LONGLONG offset, LONGLONG length, size_t chunkSize, ChunkWriter writer,
+                                   std::shared_ptr<const CancelToken> cancelToken,
+                                   TransferBufferPool* bufferPool)
+    : m_committedOffset(offset),
+      m_endOffset(offset + length),
+      m_chunkSize(chunkSize),
+      m_writer(std::move(writer)),
+      m_bufferPool(bufferPool),
+      m_cancelToken(std::move(cancelToken)) {
+}
+
+HRESULT ChunkedFetchSink::Write(const BYTE* data, size_t length) {
+    if (SUCCEEDED(m_status) && IsCancelled()) {
+        m_status = HRESULT_FROM_WIN32(ERROR_CANCELLED);
+        ReleaseStaging();
+    }
+    if (FAILED(m_status)) {
+        return m_status;
+    }
+    
+    // 범위를 넘는 데이터는 버림
+    LONGLONG pending = m_committedOffset + static_cast<LONGLONG>(m_stagingSize);
+    length = static_cast<size_t>((std::min)(static_cast<LONGLONG>(length), m_endOffset - pending));
+    
+    while (length > 0) {
+        // 스테이징이 비어 있고 입력이 청크 하나 이상이면 복사 없이 바로 전달
+        if (m_stagingSize == 0 && length >= m_chunkSize) {
+            HRESULT hr = WriteChunk(data, static_cast<LONGLONG>(m_chunkSize));
+            if (FAILED(hr)) {
+                return hr;
+            }
+            data += m_chunkSize;
+            length -= m_chunkSize;
+            continue;
+        }
+        
+        if (!m_staging) {
+            m_staging = AcquireTransferBuffer(m_bufferPool, m_chunkSize);
+            if (!m_staging) {
+                m_status = E_OUTOFMEMORY;
+                return m_status;
+            }
+        }
+        size_t copied = (std::min)(length, m_chunkSize - m_stagingSize);
+        memcpy(m_staging.Data() + m_stagingSize, data, copied);
+        m_stagingSize += copied;
+        data += copied;
+        length -= copied;
+        
+        if (m_stagingSize == m_chunkSize) {
+            HRESULT hr = Flush();
+            if (FAILED(hr)) {
+                return hr;
+            }
+        }
+    }
+    
+    return S_OK;
+}
+
+HRESULT ChunkedFetchSink::Finish() {
+    if (FAILED(m_status)) {
+        ReleaseStaging();
+        return m_status;
+    }
+    
+    // 범위 끝까지 채워진 경우에만 마지막 청크를 내보냄 (중간에서 끊긴 청크는 정렬이 맞지 않음)
+    LONGLONG pending = m_committedOffset + static_cast<LONGLONG>(m_stagingSize);
+    HRESULT hr = S_OK;
+    if (pending != m_endOffset) {
+        hr = HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+    } else if (m_stagingSize > 0) {
+        hr = Flush();
+    }
+    ReleaseStaging();
+    return hr;
+}
+
+HRESULT ChunkedFetchSink::Flush() {
+    HRESULT hr = WriteChunk(m_staging.Data(), static_cast<LONGLONG>(m_stagingSize));
+    m_stagingSize = 0;
+    return hr;
+}
+
+void ChunkedFetchSink::ReleaseStaging() {
+    // 버퍼를 풀에 돌려줌
+    m_staging.Release();
+    m_stagingSize = 0;
+}
+
+HRESULT ChunkedFetchSink::WriteChunk(const BYTE* buffer, LONGLONG length) {
+    if (IsCancelled()) {
+        // 취소되면 스테이징 버퍼를 즉시 반환
+        m_status = HRESULT_FROM_WIN32(ERROR_CANCELLED);
+        ReleaseStaging();
+        return m_status;
+    }
+    
+    m_status = m_writer(buffer, m_committedOffset, length);
+    if (SUCCEEDED(m_status)) {
+        m_committedOffset += length;
+    }
+    return m_status;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include <vector>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include "TransferBufferPool.h"
+
+// 협조적 취소 토큰 (청크 사이마다 확인)
+class CancelToken {
+public:
+    void Cancel() { m_cancelled.store(true, std::memory_order_release); }
+    bool IsCancelled() const { return m_cancelled.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<bool> m_cancelled{ false };
+};
+
+// 원격 데이터 요청 범위
+struct FetchRequest {
+    std::wstring relativePath;
+    LONGLONG offset = 0;
+    LONGLONG length = 0;
+    LONGLONG fileSize = 0;
+    std::string fileIdentity;                        // 플레이스홀더의 FileIdentity 바이트
+    ULONGLONG contentVersion = 0;
+    std::shared_ptr<const CancelToken> cancelToken;  // 데이터 소스도 다운로드 중 확인 가능
+};
+
+// provider가 소유하는 데이터 수신자
+// Write는 데이터가 다음 단계로 넘어갈 때까지 반환하지 않으므로 자연스럽게 백프레셔가 걸림
+class FetchSink {
+public:
+    virtual ~FetchSink() = default;
+    
+    // 실패 HRESULT가 반환되면 데이터 소스는 즉시 전송을 중단해야 함
+    // (취소된 요청은 HRESULT_FROM_WIN32(ERROR_CANCELLED))
+    virtual HRESULT Write(const BYTE* data, size_t length) = 0;
+    
+    // 데이터 소스가 한 번에 가져오기 적당한 크기
+    virtual size_t PreferredChunkSize() const = 0;
+};
+
+// 스트리밍 fetch 콜백: 요청 범위의 데이터를 순서대로 sink에 기록
+using StreamingFetchCallback = std::function<HRESULT(const FetchRequest&, FetchSink&)>;
+
+// 기존 콜백 어댑터
+StreamingFetchCallback MakeStreamingFetchCallback(std::function<std::vector<BYTE>(const std::wstring&)> wholeFileCallback);
+StreamingFetchCallback MakeStreamingFetchCallback(std::function<std::vector<BYTE>(const std::wstring&, LONGLONG, LONGLONG)> rangedCallback);
+
+// 범위 데이터를 고정 크기 청크로 모아 writer에 넘기는 sink
+// 메모리 사용량은 청크 크기 하나로 제한되며, 스테이징 버퍼는 풀에서 빌려 씀
+class ChunkedFetchSink : public FetchSink {
+public:
+    using ChunkWriter = std::function<HRESULT(const BYTE* buffer, LONGLONG offset, LONGLONG length)>;
+    
+    ChunkedFetchSink(LONGLONG offset, LONGLONG length, size_t chunkSize, ChunkWriter writer,
+                     std::shared_ptr<const CancelToken> cancelToken = nullptr,
+                     TransferBufferPool* bufferPool = nullptr);
+    
+    HRESULT Write(const BYTE* data, size_t length) override;
+    size_t PreferredChunkSize() const override { return m_chunkSize; }
+    
+    // 남은 스테이징 데이터를 내보내고 범위가 모두 채워졌는지 확인
+    HRESULT Finish();
+    
+    // writer로 전달이 끝난 지점 (실패 시 남은 범위를 처리하는 데 사용)
+    LONGLONG CommittedOffset() const { return m_committedOffset; }
+    LONGLONG EndOffset() const { return m_endOffset; }
+    bool IsCancelled() const { return m_cancelToken && m_cancelToken->IsCancelled(); }
+
+private:
+    HRESULT Flush();
+    HRESULT WriteChunk(const BYTE* buffer, LONGLONG length);
+    void ReleaseStaging();
+    
+    LONGLONG m_committedOffset;
+    LONGLONG m_endOffset;
+    size_t m_chunkSize;
+    ChunkWriter m_writer;
+    TransferBufferPool* m_bufferPool;
+    TransferBuffer m_staging;
+    size_t m_stagingSize = 0;
+    std::shared_ptr<const CancelToken> m_cancelToken;
+    HRESULT m_status = S_OK;
+};
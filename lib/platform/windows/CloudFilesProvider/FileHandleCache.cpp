@@ -0,0 +1,126 @@
+#include "FileHandleCache.h"
+#include <cfapi.h>
+
+FileHandleCache::CachedHandle::~CachedHandle() {
+    if (protectedHandle != INVALID_HANDLE_VALUE) {
+        CfCloseHandle(protectedHandle);
+    }
+}
+
+FileHandleCache::FileHandleCache(size_t capacity)
+    : m_capacity(capacity) {
+}
+
+FileHandleCache::~FileHandleCache() {
+    Clear();
+}
+
+HRESULT FileHandleCache::WithHandle(PathId key, const FullPathResolver& fullPath,
+                                    const std::function<HRESULT(HANDLE)>& operation) {
+    // oplock이 깨진 핸들은 한 번만 다시 열어 봄
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        HRESULT hr = S_OK;
+        std::shared_ptr<CachedHandle> handle = Acquire(key, fullPath, hr);
+        if (!handle) {
+            return hr;
+        }
+        
+        if (!CfReferenceProtectedHandle(handle->protectedHandle)) {
+            // 다른 프로세스가 파일을 열어 oplock이 깨짐
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stats.oplockBreaks++;
+            }
+            Remove(key, handle);
+            continue;
+        }
+        
+        hr = operation(CfGetWin32HandleFromProtectedHandle(handle->protectedHandle));
+        CfReleaseProtectedHandle(handle->protectedHandle);
+        return hr;
+    }
+    return HRESULT_FROM_WIN32(ERROR_OPLOCK_NOT_GRANTED);
+}
+
+std::shared_ptr<FileHandleCache::CachedHandle> FileHandleCache::Acquire(PathId key, const FullPathResolver& fullPath, HRESULT& hr) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto found = m_entries.find(key);
+        if (found != m_entries.end()) {
+            m_lru.splice(m_lru.begin(), m_lru, found->second.lruPosition);
+            m_stats.hits++;
+            return found->second.handle;
+        }
+        m_stats.misses++;
+    }
+    
+    // 잠금 밖에서 열기 (같은 파일을 동시에 열면 먼저 등록된 핸들을 사용)
+    auto handle = std::make_shared<CachedHandle>();
+    hr = CfOpenFileWithOplock(fullPath().c_str(), CF_OPEN_FILE_FLAG_WRITE_ACCESS, &handle->protectedHandle);
+    if (FAILED(hr)) {
+        handle->protectedHandle = INVALID_HANDLE_VALUE;
+        return nullptr;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_capacity == 0) {
+        // 캐시를 쓰지 않으면 이번 작업이 끝날 때 닫힘
+        return handle;
+    }
+    auto inserted = m_entries.emplace(key, Entry());
+    if (!inserted.second) {
+        return inserted.first->second.handle;
+    }
+    m_lru.push_front(key);
+    inserted.first->second.handle = handle;
+    inserted.first->second.lruPosition = m_lru.begin();
+    EvictLocked();
+    return handle;
+}
+
+void FileHandleCache::Remove(PathId key, const std::shared_ptr<CachedHandle>& handle) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_entries.find(key);
+    if (found != m_entries.end() && found->second.handle == handle) {
+        m_lru.erase(found->second.lruPosition);
+        m_entries.erase(found);
+    }
+}
+
+void FileHandleCache::Invalidate(PathId key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_entries.find(key);
+    if (found != m_entries.end()) {
+        m_lru.erase(found->second.lruPosition);
+        m_entries.erase(found);
+    }
+}
+
+void FileHandleCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_lru.clear();
+}
+
+void FileHandleCache::SetCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = capacity;
+    EvictLocked();
+}
+
+FileHandleCacheStats FileHandleCache::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FileHandleCacheStats stats = m_stats;
+    stats.openHandles = m_entries.size();
+    stats.capacity = m_capacity;
+    return stats;
+}
+
+void FileHandleCache::EvictLocked() {
+    // 사용 중인 핸들은 shared_ptr로 유지되므로 목록에서만 빠지고 사용이 끝나면 닫힘
+    while (m_entries.size() > m_capacity && !m_lru.empty()) {
+        m_entries.erase(m_lru.back());
+        m_lru.pop_back();
+        m_stats.evictions++;
+    }
+}
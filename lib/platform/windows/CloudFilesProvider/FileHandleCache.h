@@ -0,0 +1,69 @@
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include <unordered_map>
+
+#include "PathTable.h"
+
+struct FileHandleCacheStats {
+    size_t openHandles = 0;
+    size_t capacity = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t oplockBreaks = 0;   // 다른 프로세스가 파일을 열어 무효화된 핸들
+};
+
+// CfOpenFileWithOplock으로 연 보호 핸들의 LRU 캐시
+// 같은 파일의 상태를 반복해서 바꿀 때 열기/닫기를 생략하고,
+// 다른 앱이 파일에 접근해 oplock이 깨지면 해당 핸들을 버리고 다시 엶
+class FileHandleCache {
+public:
+    explicit FileHandleCache(size_t capacity = 256);
+    ~FileHandleCache();
+    
+    FileHandleCache(const FileHandleCache&) = delete;
+    FileHandleCache& operator=(const FileHandleCache&) = delete;
+    
+    // 핸들을 새로 열 때만 전체 경로를 만들도록 경로 대신 생성 함수를 받음
+    using FullPathResolver = std::function<std::wstring()>;
+    
+    // key(인터닝된 상대 경로 ID)에 해당하는 파일 핸들로 operation 실행
+    // 핸들은 operation이 끝날 때까지 참조되어 있으므로 그 사이에 제거되어도 안전함
+    HRESULT WithHandle(PathId key, const FullPathResolver& fullPath,
+                       const std::function<HRESULT(HANDLE)>& operation);
+    
+    // 삭제/이름 변경된 파일의 핸들을 닫음
+    void Invalidate(PathId key);
+    void Clear();
+    
+    void SetCapacity(size_t capacity);
+    FileHandleCacheStats GetStats() const;
+
+private:
+    // 보호 핸들 (마지막 사용자가 놓을 때 닫힘)
+    struct CachedHandle {
+        HANDLE protectedHandle = INVALID_HANDLE_VALUE;
+        ~CachedHandle();
+    };
+    
+    struct Entry {
+        std::shared_ptr<CachedHandle> handle;
+        std::list<PathId>::iterator lruPosition;
+    };
+    
+    std::shared_ptr<CachedHandle> Acquire(PathId key, const FullPathResolver& fullPath, HRESULT& hr);
+    void Remove(PathId key, const std::shared_ptr<CachedHandle>& handle);
+    void EvictLocked();
+    
+    mutable std::mutex m_mutex;
+    size_t m_capacity;
+    std::unordered_map<PathId, Entry> m_entries;
+    std::list<PathId> m_lru;  // 앞쪽이 가장 최근
+    FileHandleCacheStats m_stats;
+};
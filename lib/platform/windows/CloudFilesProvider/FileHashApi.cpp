@@ -0,0 +1,77 @@
+#include "FileHashApi.h"
+#include "FileHasher.h"
+#include "CloudFilesProvider.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace {
+
+// 트리 해시 결과를 호출자가 아는 크기까지만 복사
+void CopyTreeHash(const BlockManifest& manifest, const ContentHash& root, MbdFileTreeHash* result) {
+    MbdFileTreeHash current = {};
+    current.blockSize = static_cast<uint32_t>(manifest.blockSize);
+    current.fileSize = static_cast<uint64_t>(manifest.fileSize);
+    current.blockCount = manifest.blockHashes.size();
+    memcpy(current.root, root.bytes, sizeof(current.root));
+    ManifestIdFromTreeRoot(root, current.manifestId);
+
+    size_t size = (std::min)(static_cast<size_t>(result->structSize), sizeof(current));
+    current.structSize = static_cast<uint32_t>(size);
+    memcpy(result, &current, size);
+}
+
+bool IsValidResult(const MbdFileTreeHash* result) {
+    return result && result->structSize >= offsetof(MbdFileTreeHash, fileSize);
+}
+
+} // namespace
+
+int32_t MbdHashFileTree(const wchar_t* path, uint32_t threads, MbdFileTreeHash* result) {
+    if (!path || !*path || !IsValidResult(result)) {
+        return E_INVALIDARG;
+    }
+
+    BlockManifest manifest;
+    ContentHash root;
+    HRESULT hr = HashFileTree(path, threads, manifest, root);
+    if (FAILED(hr)) {
+        return hr;
+    }
+    CopyTreeHash(manifest, root, result);
+    return S_OK;
+}
+
+int32_t MbdPublishBlockManifest(const wchar_t* path, uint32_t threads, MbdFileTreeHash* result) {
+    if (!path || !*path || !IsValidResult(result)) {
+        return E_INVALIDARG;
+    }
+
+    BlockManifest manifest;
+    ContentHash root;
+    HRESULT hr = HashFileTree(path, threads, manifest, root);
+    if (FAILED(hr)) {
+        return hr;
+    }
+    CopyTreeHash(manifest, root, result);
+
+    // 저장 실패는 provider가 기록하고, 해시 결과는 그대로 쓸 수 있으므로 S_FALSE
+    BYTE manifestId[kManifestIdSize];
+    ManifestIdFromTreeRoot(root, manifestId);
+    hr = CloudFilesProvider::GetInstance().PublishBlockManifest(manifestId, manifest);
+    return SUCCEEDED(hr) ? S_OK : S_FALSE;
+}
+
+int32_t MbdHashFileSha256(const wchar_t* path, uint8_t* digest) {
+    if (!path || !*path || !digest) {
+        return E_INVALIDARG;
+    }
+
+    ContentHash hash;
+    HRESULT hr = HashFileSha256(path, hash);
+    if (FAILED(hr)) {
+        return hr;
+    }
+    memcpy(digest, hash.bytes, sizeof(hash.bytes));
+    return S_OK;
+}
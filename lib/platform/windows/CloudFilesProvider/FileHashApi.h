@@ -0,0 +1,41 @@
+#pragma once
+
+// Dart(FFI)에서 업로드 해시와 충돌 감지에 쓰는 파일 해시 C ABI
+// 큰 오디오 파일을 Dart 힙에 올리지 않고 네이티브에서 여러 스레드로 해시함
+// 결과 구조체는 지표 스냅샷과 같이 호출자가 structSize를 채워 넘기면 그 크기까지만 채움
+
+#include <stdint.h>
+#include <wchar.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MBD_FILE_HASH_BLOCK_SIZE (4 * 1024 * 1024)
+
+#ifndef MBD_API
+#define MBD_API __declspec(dllexport)
+#endif
+
+typedef struct MbdFileTreeHash {
+    uint32_t structSize;          // 호출자가 sizeof(MbdFileTreeHash)로 설정
+    uint32_t blockSize;           // MBD_FILE_HASH_BLOCK_SIZE
+    uint64_t fileSize;
+    uint64_t blockCount;
+    uint8_t root[32];             // SHA-256(블록별 SHA-256을 순서대로 이어 붙인 값)
+    uint8_t manifestId[16];       // root 앞 16바이트 (플레이스홀더 ID의 매니페스트 ID)
+} MbdFileTreeHash;
+
+// 파일 트리 해시 계산 (threads가 0이면 코어 수, 최대 8) (HRESULT 반환)
+MBD_API int32_t MbdHashFileTree(const wchar_t* path, uint32_t threads, MbdFileTreeHash* result);
+
+// 파일 트리 해시를 계산하고 블록 해시를 provider의 검증 매니페스트로 저장 (result는 MbdHashFileTree와 같음)
+// 저장하면 S_OK, 해시는 구했지만 매니페스트 저장소가 없거나(검증이 꺼져 있음) 저장에 실패하면 S_FALSE
+MBD_API int32_t MbdPublishBlockManifest(const wchar_t* path, uint32_t threads, MbdFileTreeHash* result);
+
+// 파일 전체의 SHA-256 계산 (digest는 32바이트) (HRESULT 반환)
+MBD_API int32_t MbdHashFileSha256(const wchar_t* path, uint8_t* digest);
+
+#ifdef __cplusplus
+}
+#endif
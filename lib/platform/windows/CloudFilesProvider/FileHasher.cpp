@@ -0,0 +1,158 @@
+#include "FileHasher.h"
+#include "TransferBufferPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const size_t kMaxHashThreads = 8;
+
+HANDLE OpenForHashing(const std::wstring& path, DWORD flags) {
+    // 해시하는 동안 다른 프로그램이 파일을 열어 두고 있어도 읽을 수 있게 공유
+    return CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                       nullptr, OPEN_EXISTING, flags, nullptr);
+}
+
+// 블록 하나를 위치 지정 읽기로 읽음 (버퍼링 없는 핸들이라 길이는 정렬된 블록 크기로 요청하고 파일 끝에서 짧게 읽힘)
+HRESULT ReadBlock(HANDLE file, BYTE* buffer, LONGLONG offset, DWORD length, DWORD& read) {
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(static_cast<ULONGLONG>(offset));
+    overlapped.OffsetHigh = static_cast<DWORD>(static_cast<ULONGLONG>(offset) >> 32);
+    read = 0;
+    if (!ReadFile(file, buffer, length, &read, &overlapped)) {
+        DWORD error = GetLastError();
+        return error == ERROR_HANDLE_EOF ? S_OK : HRESULT_FROM_WIN32(error);
+    }
+    return S_OK;
+}
+
+} // namespace
+
+HRESULT HashFileTree(const std::wstring& path, size_t threadCount, BlockManifest& manifest, ContentHash& root) {
+    manifest = BlockManifest();
+
+    HANDLE file = OpenForHashing(path, FILE_FLAG_NO_BUFFERING);
+    if (file == INVALID_HANDLE_VALUE) {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(file, &fileSize)) {
+        HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
+        CloseHandle(file);
+        return hr;
+    }
+
+    manifest.fileSize = fileSize.QuadPart;
+    manifest.blockSize = kFileHashBlockSize;
+    manifest.blockHashes.resize(manifest.ExpectedBlockCount());
+    const size_t blockCount = manifest.blockHashes.size();
+
+    std::atomic<size_t> nextBlock{ 0 };
+    std::atomic<HRESULT> failure{ S_OK };
+
+    // 각 스레드가 다음 블록을 가져가 읽고 해시 (블록 해시는 블록 번호 자리에 기록)
+    auto worker = [&](HANDLE handle) {
+        TransferBuffer buffer = TransferBufferPool::AllocateUnpooled(static_cast<size_t>(kFileHashBlockSize));
+        if (!buffer) {
+            HRESULT expected = S_OK;
+            failure.compare_exchange_strong(expected, E_OUTOFMEMORY);
+            return;
+        }
+        for (size_t index = nextBlock++; index < blockCount && SUCCEEDED(failure.load()); index = nextBlock++) {
+            const LONGLONG offset = static_cast<LONGLONG>(index) * kFileHashBlockSize;
+            const DWORD blockLength = static_cast<DWORD>((std::min)(kFileHashBlockSize, manifest.fileSize - offset));
+
+            DWORD read = 0;
+            HRESULT hr = ReadBlock(handle, buffer.Data(), offset, static_cast<DWORD>(kFileHashBlockSize), read);
+            if (SUCCEEDED(hr) && read != blockLength) {
+                hr = HRESULT_FROM_WIN32(ERROR_INVALID_DATA);  // 해시하는 동안 파일 크기가 바뀜
+            }
+            if (SUCCEEDED(hr)) {
+                hr = ComputeContentHash(buffer.Data(), blockLength, manifest.blockHashes[index]);
+            }
+            if (FAILED(hr)) {
+                HRESULT expected = S_OK;
+                failure.compare_exchange_strong(expected, hr);
+                return;
+            }
+        }
+    };
+
+    if (blockCount > 0) {
+        size_t cores = (std::max)(std::thread::hardware_concurrency(), 1u);
+        size_t threads = threadCount > 0 ? threadCount : (std::min)(cores, kMaxHashThreads);
+        threads = (std::min)(threads, blockCount);
+
+        // 동기 핸들 하나의 읽기는 직렬화되므로 보조 스레드마다 핸들을 따로 열고, 열지 못하면 있는 스레드로만 계산
+        std::vector<std::thread> helpers;
+        helpers.reserve(threads - 1);
+        for (size_t i = 1; i < threads; ++i) {
+            HANDLE handle = OpenForHashing(path, FILE_FLAG_NO_BUFFERING);
+            if (handle == INVALID_HANDLE_VALUE) {
+                break;
+            }
+            helpers.emplace_back([&worker, handle]() {
+                worker(handle);
+                CloseHandle(handle);
+            });
+        }
+        worker(file);
+        for (auto& helper : helpers) {
+            helper.join();
+        }
+    }
+    CloseHandle(file);
+
+    if (FAILED(failure.load())) {
+        HRESULT hr = failure.load();
+        manifest = BlockManifest();
+        return hr;
+    }
+    return ComputeTreeRoot(manifest, root);
+}
+
+HRESULT ComputeTreeRoot(const BlockManifest& manifest, ContentHash& root) {
+    static_assert(sizeof(ContentHash) == 32, "ContentHash layout");
+    return ComputeContentHash(reinterpret_cast<const BYTE*>(manifest.blockHashes.data()),
+                              manifest.blockHashes.size() * sizeof(ContentHash), root);
+}
+
+void ManifestIdFromTreeRoot(const ContentHash& root, BYTE* manifestId) {
+    memcpy(manifestId, root.bytes, kManifestIdSize);
+}
+
+HRESULT HashFileSha256(const std::wstring& path, ContentHash& hash) {
+    HANDLE file = OpenForHashing(path, FILE_FLAG_SEQUENTIAL_SCAN);
+    if (file == INVALID_HANDLE_VALUE) {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+
+    TransferBuffer buffer = TransferBufferPool::AllocateUnpooled(static_cast<size_t>(kFileHashBlockSize));
+    if (!buffer) {
+        CloseHandle(file);
+        return E_OUTOFMEMORY;
+    }
+
+    ContentHasher hasher;
+    HRESULT hr = S_OK;
+    for (;;) {
+        DWORD read = 0;
+        if (!ReadFile(file, buffer.Data(), static_cast<DWORD>(buffer.Size()), &read, nullptr)) {
+            hr = HRESULT_FROM_WIN32(GetLastError());
+            break;
+        }
+        if (read == 0) {
+            break;
+        }
+        hr = hasher.Update(buffer.Data(), read);
+        if (FAILED(hr)) {
+            break;
+        }
+    }
+    CloseHandle(file);
+
+    return SUCCEEDED(hr) ? hasher.Finish(hash) : hr;
+}
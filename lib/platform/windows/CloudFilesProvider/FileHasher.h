@@ -0,0 +1,26 @@
+#pragma once
+
+#include <windows.h>
+#include <string>
+
+#include "BlockManifest.h"
+#include "ContentHash.h"
+
+// 파일 트리 해시의 블록 크기 (블록 캐시, 블록 매니페스트와 같은 4MB)
+constexpr LONGLONG kFileHashBlockSize = 4 * 1024 * 1024;
+
+// 파일 트리 해시: 4MB 블록마다 SHA-256을 구하고, 블록 해시를 순서대로 이어 붙인 값의 SHA-256을 루트로 사용
+// 블록끼리 독립이라 threadCount개 스레드(0이면 코어 수, 최대 8)가 각자 파일 핸들과 블록 버퍼 하나로 나눠 계산하고,
+// 시스템 캐시를 거치지 않는 정렬 읽기라 큰 파일도 스레드 수 x 4MB만 메모리에 둠
+// manifest에는 블록 해시가 남으므로 PublishBlockManifest에 그대로 넘길 수 있음
+HRESULT HashFileTree(const std::wstring& path, size_t threadCount, BlockManifest& manifest, ContentHash& root);
+
+// 블록 해시 목록에서 트리 루트 계산
+HRESULT ComputeTreeRoot(const BlockManifest& manifest, ContentHash& root);
+
+// 트리 루트 앞 kManifestIdSize바이트를 매니페스트 ID로 사용 (내용이 같으면 어느 기기에서든 같은 ID)
+// 플레이스홀더를 만들 때 원격 트리 해시로 PlaceholderIdentity.manifestId를 채우면 PublishBlockManifest로 저장한 매니페스트와 맞음
+void ManifestIdFromTreeRoot(const ContentHash& root, BYTE* manifestId);
+
+// 파일 전체의 SHA-256 (트리 해시 이전에 저장된 해시와 비교할 때), 블록 하나 크기로 순차 읽기
+HRESULT HashFileSha256(const std::wstring& path, ContentHash& hash);
@@ -0,0 +1,755 @@
+#include "FuseBackend.h"
+#include "PlaceholderIdentity.h"
+#include "RemoteDirectoryIndex.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace {
+
+// 저장 파일 읽기/쓰기 한 번의 최대 크기 (DWORD 범위 안)
+const LONGLONG kMaxStoreIo = 1LL << 30;
+
+std::wstring ParentKey(const std::wstring& key) {
+    size_t separator = key.find_last_of(L'\\');
+    return separator == std::wstring::npos ? std::wstring() : key.substr(0, separator);
+}
+
+OVERLAPPED OverlappedAt(LONGLONG offset) {
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(static_cast<ULONGLONG>(offset) & 0xFFFFFFFF);
+    overlapped.OffsetHigh = static_cast<DWORD>(static_cast<ULONGLONG>(offset) >> 32);
+    return overlapped;
+}
+
+HRESULT LastErrorResult() {
+    DWORD error = GetLastError();
+    return error != ERROR_SUCCESS ? HRESULT_FROM_WIN32(error) : E_FAIL;
+}
+
+} // namespace
+
+FuseBackend::FuseBackend(const std::wstring& storeDirectory) : m_storeDirectory(storeDirectory) {}
+
+FuseBackend::~FuseBackend() {
+    Disconnect();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    CloseStores();
+}
+
+HRESULT FuseBackend::Connect(const std::wstring& syncRootPath, const std::wstring& displayName,
+                             const BackendSyncPolicy& policy, ProviderBackendEvents* events) {
+    if (!CreateDirectoryW(m_storeDirectory.c_str(), nullptr) && GetLastError() != ERROR_ALREADY_EXISTS) {
+        DWORD error = GetLastError();
+        MBD_LOG_ERROR(L"Failed to create FUSE store directory: ", error);
+        return HRESULT_FROM_WIN32(error);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_syncRootPath = syncRootPath;
+    m_policy = policy;
+    m_events = events;
+    m_connectionKey = 1;
+    if (m_nodes.find(std::wstring()) == m_nodes.end()) {
+        auto root = std::make_shared<Node>();
+        root->isDirectory = true;
+        root->fileId = m_nextFileId++;
+        root->basicInfo.FileAttributes = FILE_ATTRIBUTE_DIRECTORY;
+        m_nodes.emplace(std::wstring(), root);
+    }
+
+    MBD_LOG_INFO(L"FUSE backend connected: ", displayName, L" at ", syncRootPath);
+    return S_OK;
+}
+
+void FuseBackend::Disconnect() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_events = nullptr;
+    m_connectionKey = CF_CONNECTION_KEY_INVALID;
+
+    // 기다리던 읽기와 열거는 실패로 반환
+    for (auto& entry : m_requests) {
+        if (!entry.second->completed) {
+            entry.second->completed = true;
+            entry.second->result = HRESULT_FROM_WIN32(ERROR_OPERATION_ABORTED);
+        }
+    }
+    m_changed.notify_all();
+}
+
+HRESULT FuseBackend::Unregister(const std::wstring&) {
+    Disconnect();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    CloseStores();
+    for (const auto& entry : m_nodes) {
+        if (!entry.second->isDirectory) {
+            DeleteFileW(StorePath(*entry.second).c_str());
+        }
+    }
+    m_nodes.clear();
+    return S_OK;
+}
+
+HRESULT FuseBackend::CreatePlaceholders(const std::wstring& parentRelativePath, const PlaceholderEntry* entries, size_t count,
+                                        std::vector<HRESULT>& results) {
+    results.assign(count, S_OK);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::shared_ptr<Node> parent = FindNode(parentRelativePath);
+    if (!parent || !parent->isDirectory) {
+        return HRESULT_FROM_WIN32(ERROR_PATH_NOT_FOUND);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        results[i] = AddChild(parent, entries[i], InSyncState::NotInSync);
+    }
+    return S_OK;
+}
+
+HRESULT FuseBackend::TransferPlaceholders(const FetchKey& key, const std::wstring& relativeDirectory,
+                                          const std::vector<PlaceholderEntry>* children) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::shared_ptr<Request> request = FindRequest(key);
+    std::shared_ptr<Node> directory = request ? request->node : FindNode(relativeDirectory);
+
+    HRESULT hr = S_OK;
+    if (!directory || !directory->isDirectory) {
+        hr = HRESULT_FROM_WIN32(ERROR_PATH_NOT_FOUND);
+    } else if (children) {
+        for (const PlaceholderEntry& child : *children) {
+            // CreatePlaceholders로 먼저 만든 항목은 그대로 둠
+            HRESULT childResult = AddChild(directory, child, InSyncState::InSync);
+            if (FAILED(childResult) && childResult != HRESULT_FROM_WIN32(ERROR_ALREADY_EXISTS)) {
+                hr = childResult;
+            }
+        }
+        // 목록을 받은 폴더는 다시 요청하지 않음 (목록이 없으면 다음 열거 때 다시 요청됨)
+        directory->populated = SUCCEEDED(hr);
+    }
+
+    if (request) {
+        request->completed = true;
+        request->result = hr;
+        m_changed.notify_all();
+    }
+    return hr;
+}
+
+HRESULT FuseBackend::TransferData(const FetchKey& key, const BYTE* buffer, LONGLONG offset, LONGLONG length) {
+    std::shared_ptr<Request> request;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        request = FindRequest(key);
+    }
+    // 시간이 지나 끝난 요청이거나 모르는 전송 키
+    if (!request || request->kind == Request::Kind::Placeholders) {
+        return HRESULT_FROM_WIN32(ERROR_OPERATION_ABORTED);
+    }
+
+    Node& node = *request->node;
+    if (!buffer || offset < 0 || length <= 0 || offset + length > node.fileSize) {
+        return E_INVALIDARG;
+    }
+    HRESULT hr = WriteStore(node, buffer, offset, length);
+    if (FAILED(hr)) {
+        return hr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (request->kind == Request::Kind::Data && m_policy.validateData) {
+        // 검증이 끝날 때까지 앱에 보이지 않음
+        AddRange(request->transferred, offset, offset + length);
+    } else {
+        AddRange(node.hydrated, offset, offset + length);
+    }
+    m_changed.notify_all();
+    return S_OK;
+}
+
+HRESULT FuseBackend::FailTransfer(const FetchKey& key, LONGLONG, LONGLONG, TransferFailure reason) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::shared_ptr<Request> request = FindRequest(key);
+    if (!request) {
+        return HRESULT_FROM_WIN32(ERROR_OPERATION_ABORTED);
+    }
+
+    // 요청 범위의 일부만 실패해도 읽기는 실패로 반환
+    if (!request->completed) {
+        request->completed = true;
+        request->result = reason == TransferFailure::Aborted ? HRESULT_FROM_WIN32(ERROR_OPERATION_ABORTED)
+                                                             : HRESULT_FROM_WIN32(ERROR_GEN_FAILURE);
+        m_changed.notify_all();
+    }
+    return S_OK;
+}
+
+HRESULT FuseBackend::RetrieveData(const FetchKey& key, BYTE* buffer, LONGLONG offset, LONGLONG length,
+                                  LONGLONG& returnedLength) {
+    returnedLength = 0;
+    std::shared_ptr<Request> request;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        request = FindRequest(key);
+    }
+    if (!request || request->kind == Request::Kind::Placeholders) {
+        return HRESULT_FROM_WIN32(ERROR_OPERATION_ABORTED);
+    }
+    if (!buffer || offset < 0 || length < 0) {
+        return E_INVALIDARG;
+    }
+
+    Node& node = *request->node;
+    return ReadStore(node, buffer, offset, (std::min)(length, node.fileSize - offset), returnedLength);
+}
+
+HRESULT FuseBackend::AcknowledgeData(const FetchKey& key, LONGLONG offset, LONGLONG length, bool valid) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::shared_ptr<Request> request = FindRequest(key);
+    if (!request) {
+        return HRESULT_FROM_WIN32(ERROR_OPERATION_ABORTED);
+    }
+
+    const LONGLONG end = (std::min)(offset + length, request->node->fileSize);
+    if (valid) {
+        AddRange(request->validated, offset, end);
+        AddRange(request->node->hydrated, offset, end);
+    } else {
+        // 해시가 맞지 않은 범위는 보이지 않게 버리고 읽기를 실패시킴 (다음 읽기에서 다시 받음)
+        RemoveRange(request->transferred, offset, end);
+        if (!request->completed) {
+            request->completed = true;
+            request->result = HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        }
+    }
+    m_changed.notify_all();
+    return S_OK;
+}
+
+HRESULT FuseBackend::HydratePlaceholder(const std::wstring& relativePath) {
+    std::shared_ptr<Node> node = ResolveNode(relativePath, GetCurrentProcessId());
+    if (!node) {
+        return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+    }
+    if (node->isDirectory) {
+        return E_INVALIDARG;
+    }
+    return Hydrate(node, 0, node->fileSize, GetCurrentProcessId());
+}
+
+HRESULT FuseBackend::WithTransferKey(const std::wstring& relativePath,
+                                     const std::function<HRESULT(const FetchKey& key)>& operation) {
+    std::shared_ptr<Node> node = ResolveNode(relativePath, GetCurrentProcessId());
+    if (!node) {
+        return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+    }
+    if (node->isDirectory) {
+        return E_INVALIDARG;
+    }
+
+    // provider가 가진 데이터라 검증 없이 바로 읽을 수 있는 범위가 됨
+    auto request = std::make_shared<Request>();
+    request->kind = Request::Kind::Session;
+    request->node = node;
+    FetchKey key;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        key = BeginRequest(request);
+    }
+    HRESULT hr = operation(key);
+    EndRequest(key);
+    return hr;
+}
+
+HRESULT FuseBackend::SetInSyncState(const std::wstring& relativePath, InSyncState state) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::shared_ptr<Node> node = FindNode(relativePath);
+    if (!node) {
+        return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+    }
+    node->inSyncState = state;
+    return S_OK;
+}
+
+HRESULT FuseBackend::SetPinState(const std::wstring& relativePath, PinState state) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::shared_ptr<Node> node = FindNode(relativePath);
+    if (!node) {
+        return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+    }
+    node->pinState = state;
+    return S_OK;
+}
+
+HRESULT FuseBackend::GetAttributes(const std::wstring& relativePath, FuseNodeInfo& info, DWORD processId) {
+    std::shared_ptr<Node> node = ResolveNode(relativePath, processId);
+    if (!node) {
+        return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    info = ToNodeInfo(*node);
+    return S_OK;
+}
+
+HRESULT FuseBackend::ReadDirectory(const std::wstring& relativePath, std::vector<FuseNodeInfo>& entries, DWORD processId) {
+    entries.clear();
+    std::shared_ptr<Node> directory = ResolveNode(relativePath, processId);
+    if (!directory) {
+        return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+    }
+    if (!directory->isDirectory) {
+        return HRESULT_FROM_WIN32(ERROR_DIRECTORY);
+    }
+
+    HRESULT hr = Populate(directory, processId);
+    if (FAILED(hr)) {
+        return hr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    entries.reserve(directory->children.size());
+    for (const auto& child : directory->children) {
+        entries.push_back(ToNodeInfo(*child));
+    }
+    return S_OK;
+}
+
+HRESULT FuseBackend::Open(const std::wstring& relativePath, DWORD processId) {
+    std::shared_ptr<Node> node = ResolveNode(relativePath, processId);
+    if (!node) {
+        return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+    }
+    if (!node->isDirectory && m_policy.hydrationPolicy == HydrationPolicy::Full) {
+        HRESULT hr = Hydrate(node, 0, node->fileSize, processId);
+        if (FAILED(hr)) {
+            return hr;
+        }
+    }
+
+    ProviderBackendEvents* events;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        events = m_events;
+    }
+    if (events) {
+        const std::wstring displayPath = MakeDisplayPath(node->relativePath);
+        events->OnFileOpened(MakeFileInfo(*node, displayPath, processId));
+    }
+    return S_OK;
+}
+
+void FuseBackend::Release(const std::wstring& relativePath, DWORD processId) {
+    ProviderBackendEvents* events;
+    std::shared_ptr<Node> node;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        events = m_events;
+        node = FindNode(relativePath);
+    }
+    if (events && node) {
+        const std::wstring displayPath = MakeDisplayPath(node->relativePath);
+        events->OnFileClosed(MakeFileInfo(*node, displayPath, processId));
+    }
+}
+
+HRESULT FuseBackend::Read(const std::wstring& relativePath, BYTE* buffer, LONGLONG offset, LONGLONG length,
+                          LONGLONG& returned, DWORD processId) {
+    returned = 0;
+    if (!buffer || offset < 0 || length < 0) {
+        return E_INVALIDARG;
+    }
+    std::shared_ptr<Node> node = ResolveNode(relativePath, processId);
+    if (!node) {
+        return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+    }
+    if (node->isDirectory) {
+        return E_INVALIDARG;
+    }
+
+    const LONGLONG end = (std::min)(offset + length, node->fileSize);
+    if (offset >= end) {
+        return S_OK;  // 파일 끝
+    }
+    HRESULT hr = Hydrate(node, offset, end - offset, processId);
+    if (FAILED(hr)) {
+        return hr;
+    }
+    return ReadStore(*node, buffer, offset, end - offset, returned);
+}
+
+void FuseBackend::SetRequestTimeout(std::chrono::milliseconds timeout) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_requestTimeout = timeout;
+}
+
+std::shared_ptr<FuseBackend::Node> FuseBackend::ResolveNode(const std::wstring& relativePath, DWORD processId) {
+    const std::wstring key = RemoteDirectoryIndex::NormalizeKey(relativePath);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto found = m_nodes.find(key);
+        if (found != m_nodes.end()) {
+            return found->second;
+        }
+        if (key.empty()) {
+            return nullptr;  // 연결되지 않음
+        }
+    }
+
+    // 상위 폴더가 아직 채워지지 않았으면 채운 뒤 다시 찾음 (cfapi가 경로를 따라 FETCH_PLACEHOLDERS를 보내는 것과 같음)
+    std::shared_ptr<Node> parent = ResolveNode(ParentKey(key), processId);
+    if (!parent || !parent->isDirectory || FAILED(Populate(parent, processId))) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_nodes.find(key);
+    return found != m_nodes.end() ? found->second : nullptr;
+}
+
+std::shared_ptr<FuseBackend::Node> FuseBackend::FindNode(const std::wstring& relativePath) const {
+    auto found = m_nodes.find(RemoteDirectoryIndex::NormalizeKey(relativePath));
+    return found != m_nodes.end() ? found->second : nullptr;
+}
+
+HRESULT FuseBackend::AddChild(const std::shared_ptr<Node>& parent, const PlaceholderEntry& entry, InSyncState inSyncState) {
+    if (entry.name.empty() || entry.name.find_first_of(L"\\/") != std::wstring::npos || entry.fileSize.QuadPart < 0) {
+        return E_INVALIDARG;
+    }
+    std::wstring relativePath = parent->relativePath.empty() ? entry.name : parent->relativePath + L'\\' + entry.name;
+    std::wstring key = RemoteDirectoryIndex::NormalizeKey(relativePath);
+    if (m_nodes.find(key) != m_nodes.end()) {
+        return HRESULT_FROM_WIN32(ERROR_ALREADY_EXISTS);
+    }
+
+    auto node = std::make_shared<Node>();
+    node->name = entry.name;
+    node->isDirectory = (entry.basicInfo.FileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+    node->fileId = m_nextFileId++;
+    node->fileSize = node->isDirectory ? 0 : entry.fileSize.QuadPart;
+    node->basicInfo = entry.basicInfo;
+    node->inSyncState = inSyncState;
+
+    // 객체 ID가 없는 항목은 cfapi 백엔드와 같이 경로에서 만든 ID에 요청된 버전을 붙임
+    PlaceholderIdentity identity = entry.identity;
+    if (!identity.HasObjectId()) {
+        identity = PlaceholderIdentity::FromPath(relativePath);
+        identity.contentVersion = entry.identity.contentVersion;
+        memcpy(identity.manifestId, entry.identity.manifestId, sizeof(identity.manifestId));
+    }
+    node->identity = identity.Serialize();
+    node->relativePath = std::move(relativePath);
+
+    parent->children.push_back(node);
+    m_nodes.emplace(std::move(key), std::move(node));
+    return S_OK;
+}
+
+bool FuseBackend::NeedsPopulation(const Node& directory) const {
+    return m_policy.populationMode == PopulationMode::Partial && directory.isDirectory && !directory.populated;
+}
+
+HRESULT FuseBackend::Populate(const std::shared_ptr<Node>& directory, DWORD processId) {
+    auto request = std::make_shared<Request>();
+    request->kind = Request::Kind::Placeholders;
+    request->node = directory;
+    ProviderBackendEvents* events;
+    FetchKey key;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!NeedsPopulation(*directory)) {
+            return S_OK;
+        }
+        if (!m_events) {
+            return HRESULT_FROM_WIN32(ERROR_NOT_READY);
+        }
+        events = m_events;
+        key = BeginRequest(request);
+    }
+
+    const std::wstring displayPath = MakeDisplayPath(directory->relativePath);
+    events->OnFetchPlaceholders(MakeFileInfo(*directory, displayPath, processId), key);
+
+    HRESULT hr;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        hr = WaitForRequest(lock, *request, []() { return false; });
+    }
+    EndRequest(key);
+    if (FAILED(hr)) {
+        MBD_LOG_WARNING(L"Failed to populate directory: ", displayPath, L" (", LogHex(hr), L")");
+    }
+    return hr;
+}
+
+HRESULT FuseBackend::Hydrate(const std::shared_ptr<Node>& node, LONGLONG offset, LONGLONG length, DWORD processId) {
+    const LONGLONG end = (std::min)(offset + length, node->fileSize);
+    for (;;) {
+        LONGLONG missingStart = 0;
+        LONGLONG missingEnd = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!FindMissing(node->hydrated, offset, end, missingStart, missingEnd)) {
+                return S_OK;
+            }
+        }
+
+        // 비어 있는 구간 전체를 cfapi처럼 4KB 정렬해 요청 (엔진이 read-ahead로 더 넓힐 수 있음)
+        missingStart -= missingStart % kTransferAlignment;
+        missingEnd = (std::min)((missingEnd + kTransferAlignment - 1) / kTransferAlignment * kTransferAlignment, node->fileSize);
+        HRESULT hr = FetchRange(node, missingStart, missingEnd, processId);
+        if (FAILED(hr)) {
+            return hr;
+        }
+    }
+}
+
+HRESULT FuseBackend::FetchRange(const std::shared_ptr<Node>& node, LONGLONG offset, LONGLONG end, DWORD processId) {
+    auto request = std::make_shared<Request>();
+    request->node = node;
+    ProviderBackendEvents* events;
+    FetchKey key;
+    bool validate;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_events) {
+            return HRESULT_FROM_WIN32(ERROR_NOT_READY);
+        }
+        events = m_events;
+        validate = m_policy.validateData;
+        key = BeginRequest(request);
+    }
+
+    const std::wstring displayPath = MakeDisplayPath(node->relativePath);
+    const BackendFileInfo file = MakeFileInfo(*node, displayPath, processId);
+    events->OnFetchData(file, key, offset, end - offset);
+
+    HRESULT hr;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        hr = WaitForRequest(lock, *request, [&]() {
+            return CoversRange(validate ? request->transferred : node->hydrated, offset, end);
+        });
+    }
+    if (hr == HRESULT_FROM_WIN32(ERROR_TIMEOUT)) {
+        events->OnCancelFetchData(file, key, offset, end - offset);
+    }
+
+    // 받은 범위는 엔진이 블록 해시로 확인해 AcknowledgeData로 응답한 뒤에야 읽을 수 있음
+    if (SUCCEEDED(hr) && validate) {
+        events->OnValidateData(file, key, offset, end - offset);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        hr = WaitForRequest(lock, *request, [&]() { return CoversRange(request->validated, offset, end); });
+    }
+    EndRequest(key);
+    return hr;
+}
+
+FetchKey FuseBackend::BeginRequest(const std::shared_ptr<Request>& request) {
+    FetchKey key;
+    key.connectionKey = m_connectionKey;
+    key.transferKey = m_nextTransferKey++;
+    key.fileId = request->node->fileId;
+    m_requests.emplace(key.transferKey, request);
+    return key;
+}
+
+std::shared_ptr<FuseBackend::Request> FuseBackend::FindRequest(const FetchKey& key) const {
+    auto found = m_requests.find(key.transferKey);
+    return found != m_requests.end() ? found->second : nullptr;
+}
+
+void FuseBackend::EndRequest(const FetchKey& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_requests.erase(key.transferKey);
+}
+
+template <typename Predicate>
+HRESULT FuseBackend::WaitForRequest(std::unique_lock<std::mutex>& lock, const Request& request, Predicate done) {
+    if (!m_changed.wait_for(lock, m_requestTimeout, [&]() { return request.completed || done(); })) {
+        return HRESULT_FROM_WIN32(ERROR_TIMEOUT);
+    }
+    return done() ? S_OK : request.result;
+}
+
+std::wstring FuseBackend::StorePath(const Node& node) const {
+    return m_storeDirectory + L"\\" + std::to_wstring(node.fileId) + L".data";
+}
+
+HRESULT FuseBackend::OpenStore(Node& node, HANDLE& store) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (node.store == INVALID_HANDLE_VALUE) {
+        // 지난 실행에서 남은 내용은 채워진 범위로 기록되어 있지 않으므로 비우고 시작
+        node.store = CreateFileW(StorePath(node).c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                                 CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (node.store == INVALID_HANDLE_VALUE) {
+            HRESULT hr = LastErrorResult();
+            MBD_LOG_ERROR(L"Failed to open FUSE store file for: ", node.relativePath, L" (", LogHex(hr), L")");
+            return hr;
+        }
+    }
+    store = node.store;
+    return S_OK;
+}
+
+HRESULT FuseBackend::WriteStore(Node& node, const BYTE* buffer, LONGLONG offset, LONGLONG length) {
+    HANDLE store;
+    HRESULT hr = OpenStore(node, store);
+    if (FAILED(hr)) {
+        return hr;
+    }
+
+    // 저장 핸들은 CloseStores 전까지 유지되므로 잠금 없이 위치 지정 쓰기
+    while (length > 0) {
+        OVERLAPPED overlapped = OverlappedAt(offset);
+        DWORD written = 0;
+        if (!WriteFile(store, buffer, static_cast<DWORD>((std::min)(length, kMaxStoreIo)), &written, &overlapped) || written == 0) {
+            return LastErrorResult();
+        }
+        buffer += written;
+        offset += written;
+        length -= written;
+    }
+    return S_OK;
+}
+
+HRESULT FuseBackend::ReadStore(Node& node, BYTE* buffer, LONGLONG offset, LONGLONG length, LONGLONG& returned) {
+    returned = 0;
+    if (length <= 0) {
+        return S_OK;
+    }
+    HANDLE store;
+    HRESULT hr = OpenStore(node, store);
+    if (FAILED(hr)) {
+        return hr;
+    }
+
+    while (returned < length) {
+        OVERLAPPED overlapped = OverlappedAt(offset + returned);
+        DWORD read = 0;
+        if (!ReadFile(store, buffer + returned, static_cast<DWORD>((std::min)(length - returned, kMaxStoreIo)), &read, &overlapped)) {
+            if (GetLastError() == ERROR_HANDLE_EOF) {
+                break;
+            }
+            return LastErrorResult();
+        }
+        if (read == 0) {
+            break;
+        }
+        returned += read;
+    }
+    return S_OK;
+}
+
+void FuseBackend::CloseStores() {
+    for (auto& entry : m_nodes) {
+        if (entry.second->store != INVALID_HANDLE_VALUE) {
+            CloseHandle(entry.second->store);
+            entry.second->store = INVALID_HANDLE_VALUE;
+        }
+    }
+}
+
+std::wstring FuseBackend::MakeDisplayPath(const std::wstring& relativePath) const {
+    return relativePath.empty() ? m_syncRootPath : m_syncRootPath + L"\\" + relativePath;
+}
+
+BackendFileInfo FuseBackend::MakeFileInfo(const Node& node, const std::wstring& displayPath, DWORD processId) {
+    BackendFileInfo file;
+    file.relativePath = node.relativePath.c_str();
+    file.relativePathLength = node.relativePath.size();
+    file.displayPath = displayPath.c_str();
+    file.fileIdentity = node.identity.empty() ? nullptr : node.identity.data();
+    file.fileIdentityLength = node.identity.size();
+    file.fileSize = node.fileSize;
+    file.processId = processId;
+    return file;
+}
+
+FuseNodeInfo FuseBackend::ToNodeInfo(const Node& node) {
+    FuseNodeInfo info;
+    info.name = node.name;
+    info.isDirectory = node.isDirectory;
+    info.fileSize = node.fileSize;
+    info.hydratedBytes = CountBytes(node.hydrated);
+    info.basicInfo = node.basicInfo;
+    info.inSyncState = node.inSyncState;
+    info.pinState = node.pinState;
+    return info;
+}
+
+void FuseBackend::AddRange(RangeSet& ranges, LONGLONG offset, LONGLONG end) {
+    if (offset >= end) {
+        return;
+    }
+    // 앞쪽에서 겹치거나 맞닿은 구간부터 뒤로 합침
+    auto it = ranges.upper_bound(offset);
+    if (it != ranges.begin() && std::prev(it)->second >= offset) {
+        --it;
+        offset = it->first;
+    }
+    while (it != ranges.end() && it->first <= end) {
+        end = (std::max)(end, it->second);
+        it = ranges.erase(it);
+    }
+    ranges.emplace(offset, end);
+}
+
+void FuseBackend::RemoveRange(RangeSet& ranges, LONGLONG offset, LONGLONG end) {
+    if (offset >= end) {
+        return;
+    }
+    auto it = ranges.upper_bound(offset);
+    if (it != ranges.begin()) {
+        --it;
+    }
+    while (it != ranges.end() && it->first < end) {
+        const LONGLONG start = it->first;
+        const LONGLONG stop = it->second;
+        if (stop <= offset) {
+            ++it;
+            continue;
+        }
+        it = ranges.erase(it);
+        if (start < offset) {
+            ranges.emplace(start, offset);
+        }
+        if (stop > end) {
+            ranges.emplace(end, stop);
+        }
+    }
+}
+
+bool FuseBackend::CoversRange(const RangeSet& ranges, LONGLONG offset, LONGLONG end) {
+    if (offset >= end) {
+        return true;
+    }
+    auto it = ranges.upper_bound(offset);
+    return it != ranges.begin() && std::prev(it)->second >= end;
+}
+
+bool FuseBackend::FindMissing(const RangeSet& ranges, LONGLONG offset, LONGLONG end, LONGLONG& missingStart, LONGLONG& missingEnd) {
+    if (CoversRange(ranges, offset, end)) {
+        return false;
+    }
+
+    // 첫 빈 바이트: offset을 덮는 구간이 있으면 그 끝
+    missingStart = offset;
+    auto it = ranges.upper_bound(offset);
+    if (it != ranges.begin() && std::prev(it)->second > offset) {
+        missingStart = std::prev(it)->second;
+    }
+    // 마지막 빈 바이트 다음: end 직전을 덮는 구간이 있으면 그 시작
+    missingEnd = end;
+    it = ranges.lower_bound(end);
+    if (it != ranges.begin() && std::prev(it)->second >= end && std::prev(it)->first > missingStart) {
+        missingEnd = std::prev(it)->first;
+    }
+    return true;
+}
+
+LONGLONG FuseBackend::CountBytes(const RangeSet& ranges) {
+    LONGLONG total = 0;
+    for (const auto& range : ranges) {
+        total += range.second - range.first;
+    }
+    return total;
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <windows.h>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ProviderBackend.h"
+
+// FUSE 요청에 돌려주는 노드 속성
+struct FuseNodeInfo {
+    std::wstring name;
+    bool isDirectory = false;
+    LONGLONG fileSize = 0;
+    LONGLONG hydratedBytes = 0;  // 로컬 저장소에 채워진 바이트 수
+    FILE_BASIC_INFO basicInfo = {};
+    InSyncState inSyncState = InSyncState::NotInSync;
+    PinState pinState = PinState::Unspecified;
+};
+
+// Linux FUSE(libfuse3) 백엔드
+// 플레이스홀더 트리와 파일별로 채워진 범위를 관리하고, FUSE의 조회/열거/읽기를 cfapi와 같은 엔진 이벤트로 바꿈
+// 엔진이 TransferData로 보낸 데이터는 저장 폴더의 파일(플레이스홀더마다 하나)에 쓰고,
+// 읽기는 필요한 범위가 채워질 때까지 (데이터 검증을 켜면 AcknowledgeData로 확인될 때까지) 기다림
+// libfuse 연결은 fuse/FuseMount.cpp에 있고 MBD_FUSE_BACKEND 빌드 옵션으로만 빌드됨
+class FuseBackend : public ProviderBackend {
+public:
+    // storeDirectory: 하이드레이션된 내용을 저장하는 폴더 (없으면 Connect에서 생성)
+    explicit FuseBackend(const std::wstring& storeDirectory);
+    ~FuseBackend() override;
+
+    FuseBackend(const FuseBackend&) = delete;
+    FuseBackend& operator=(const FuseBackend&) = delete;
+
+    const wchar_t* Name() const override { return L"fuse"; }
+
+    // syncRootPath는 마운트 지점 (알림에 쓰는 표시 경로의 기준)
+    HRESULT Connect(const std::wstring& syncRootPath, const std::wstring& displayName,
+                    const BackendSyncPolicy& policy, ProviderBackendEvents* events) override;
+    // 대기 중인 요청을 모두 실패로 깨움 (FUSE 마운트를 먼저 내려야 함)
+    void Disconnect() override;
+    // 플레이스홀더 트리와 저장 폴더의 파일을 지움
+    HRESULT Unregister(const std::wstring& syncRootPath) override;
+
+    HRESULT CreatePlaceholders(const std::wstring& parentRelativePath, const PlaceholderEntry* entries, size_t count,
+                               std::vector<HRESULT>& results) override;
+    HRESULT TransferPlaceholders(const FetchKey& key, const std::wstring& relativeDirectory,
+                                 const std::vector<PlaceholderEntry>* children) override;
+
+    HRESULT TransferData(const FetchKey& key, const BYTE* buffer, LONGLONG offset, LONGLONG length) override;
+    HRESULT FailTransfer(const FetchKey& key, LONGLONG offset, LONGLONG length, TransferFailure reason) override;
+    // FUSE에는 진행률을 표시할 곳이 없음
+    void ReportProgress(const FetchKey&, LONGLONG, LONGLONG) override {}
+    HRESULT RetrieveData(const FetchKey& key, BYTE* buffer, LONGLONG offset, LONGLONG length,
+                         LONGLONG& returnedLength) override;
+    HRESULT AcknowledgeData(const FetchKey& key, LONGLONG offset, LONGLONG length, bool valid) override;
+
+    HRESULT HydratePlaceholder(const std::wstring& relativePath) override;
+    HRESULT WithTransferKey(const std::wstring& relativePath,
+                            const std::function<HRESULT(const FetchKey& key)>& operation) override;
+    HRESULT SetInSyncState(const std::wstring& relativePath, InSyncState state) override;
+    HRESULT SetPinState(const std::wstring& relativePath, PinState state) override;
+
+    // FUSE 작업 (경로는 동기화 루트 기준, 구분자는 '/'와 '\\' 모두 허용)
+    // 부분 채우기 모드에서 아직 채워지지 않은 폴더를 지나면 OnFetchPlaceholders로 먼저 채움
+    HRESULT GetAttributes(const std::wstring& relativePath, FuseNodeInfo& info, DWORD processId = 0);
+    HRESULT ReadDirectory(const std::wstring& relativePath, std::vector<FuseNodeInfo>& entries, DWORD processId = 0);
+    // 전체 하이드레이션 정책이면 파일을 모두 받은 뒤에 반환 (점진적 정책은 부분과 같게 처리)
+    HRESULT Open(const std::wstring& relativePath, DWORD processId = 0);
+    void Release(const std::wstring& relativePath, DWORD processId = 0);
+    // 파일 끝을 넘는 부분은 읽지 않음 (returned가 length보다 작을 수 있음)
+    HRESULT Read(const std::wstring& relativePath, BYTE* buffer, LONGLONG offset, LONGLONG length,
+                 LONGLONG& returned, DWORD processId = 0);
+
+    // 엔진 응답을 기다리는 최대 시간 (cfapi의 60초 제한과 같게 기본 60초)
+    void SetRequestTimeout(std::chrono::milliseconds timeout);
+
+    // 데이터 요청 단위 (cfapi처럼 4KB 정렬, 파일 끝 제외)
+    static constexpr LONGLONG kTransferAlignment = 4096;
+
+private:
+    // 시작 오프셋 -> 끝 오프셋 (겹치거나 맞닿은 구간은 합침)
+    using RangeSet = std::map<LONGLONG, LONGLONG>;
+
+    struct Node {
+        std::wstring relativePath;
+        std::wstring name;
+        bool isDirectory = false;
+        LONGLONG fileId = 0;
+        LONGLONG fileSize = 0;
+        FILE_BASIC_INFO basicInfo = {};
+        std::string identity;  // 플레이스홀더 ID (PlaceholderIdentity::Serialize)
+        std::vector<std::shared_ptr<Node>> children;
+        bool populated = false;
+        InSyncState inSyncState = InSyncState::NotInSync;
+        PinState pinState = PinState::Unspecified;
+        RangeSet hydrated;     // 앱이 읽을 수 있는 범위
+        HANDLE store = INVALID_HANDLE_VALUE;
+    };
+
+    // 전송 키 하나에 대응하는 요청
+    struct Request {
+        enum class Kind { Data, Placeholders, Session } kind = Kind::Data;
+        std::shared_ptr<Node> node;
+        RangeSet transferred;  // 검증을 기다리는 범위 (데이터 검증을 켠 경우)
+        RangeSet validated;
+        bool completed = false;
+        HRESULT result = S_OK;
+    };
+
+    // 경로의 노드를 찾음 (채워지지 않은 상위 폴더는 먼저 채움)
+    std::shared_ptr<Node> ResolveNode(const std::wstring& relativePath, DWORD processId);
+    // 아래 세 함수는 m_mutex를 잡은 상태로 호출
+    std::shared_ptr<Node> FindNode(const std::wstring& relativePath) const;
+    HRESULT AddChild(const std::shared_ptr<Node>& parent, const PlaceholderEntry& entry, InSyncState inSyncState);
+    bool NeedsPopulation(const Node& directory) const;
+    HRESULT Populate(const std::shared_ptr<Node>& directory, DWORD processId);
+    HRESULT Hydrate(const std::shared_ptr<Node>& node, LONGLONG offset, LONGLONG length, DWORD processId);
+    HRESULT FetchRange(const std::shared_ptr<Node>& node, LONGLONG offset, LONGLONG end, DWORD processId);
+
+    // BeginRequest와 FindRequest는 m_mutex를 잡은 상태로 호출
+    FetchKey BeginRequest(const std::shared_ptr<Request>& request);
+    std::shared_ptr<Request> FindRequest(const FetchKey& key) const;
+    void EndRequest(const FetchKey& key);
+    // 요청이 끝나거나 done이 참이 되거나 제한 시간이 지날 때까지 대기 (m_mutex를 잡은 상태로 호출)
+    template <typename Predicate>
+    HRESULT WaitForRequest(std::unique_lock<std::mutex>& lock, const Request& request, Predicate done);
+
+    std::wstring StorePath(const Node& node) const;
+    HRESULT OpenStore(Node& node, HANDLE& store);
+    HRESULT WriteStore(Node& node, const BYTE* buffer, LONGLONG offset, LONGLONG length);
+    HRESULT ReadStore(Node& node, BYTE* buffer, LONGLONG offset, LONGLONG length, LONGLONG& returned);
+    void CloseStores();
+
+    std::wstring MakeDisplayPath(const std::wstring& relativePath) const;
+    // displayPath는 콜백이 끝날 때까지 유지되어야 함
+    static BackendFileInfo MakeFileInfo(const Node& node, const std::wstring& displayPath, DWORD processId);
+    static FuseNodeInfo ToNodeInfo(const Node& node);
+
+    // 범위 집합
+    static void AddRange(RangeSet& ranges, LONGLONG offset, LONGLONG end);
+    static void RemoveRange(RangeSet& ranges, LONGLONG offset, LONGLONG end);
+    static bool CoversRange(const RangeSet& ranges, LONGLONG offset, LONGLONG end);
+    // [offset, end)에서 비어 있는 첫 바이트와 마지막 바이트 다음 위치 (모두 채워져 있으면 false)
+    static bool FindMissing(const RangeSet& ranges, LONGLONG offset, LONGLONG end, LONGLONG& missingStart, LONGLONG& missingEnd);
+    static LONGLONG CountBytes(const RangeSet& ranges);
+
+    std::wstring m_storeDirectory;
+    std::wstring m_syncRootPath;
+    BackendSyncPolicy m_policy;
+    ProviderBackendEvents* m_events = nullptr;
+    CF_CONNECTION_KEY m_connectionKey = CF_CONNECTION_KEY_INVALID;
+    std::chrono::milliseconds m_requestTimeout{ std::chrono::seconds(60) };
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::unordered_map<std::wstring, std::shared_ptr<Node>> m_nodes;  // 정규화한 경로 -> 노드 (루트는 빈 문자열)
+    std::unordered_map<CF_TRANSFER_KEY, std::shared_ptr<Request>> m_requests;
+    CF_TRANSFER_KEY m_nextTransferKey = 1;
+    LONGLONG m_nextFileId = 1;
+};
@@ -0,0 +1,177 @@
+#include "HydrationScheduler.h"
+#include <algorithm>
+
+HydrationScheduler::HydrationScheduler(bool fifoOnly, const std::unordered_map<std::wstring, unsigned>& folderWeights)
+    : m_fifoOnly(fifoOnly),
+      m_folderWeights(folderWeights.empty() ? DefaultFolderWeights() : folderWeights) {
+}
+
+void HydrationScheduler::Push(ScheduledTask task) {
+    size_t priorityIndex = static_cast<size_t>(task.info.priority);
+    m_sizes[priorityIndex]++;
+    m_size++;
+    
+    if (m_fifoOnly) {
+        m_fifo.push_back(std::move(task));
+        return;
+    }
+    
+    std::wstring folder = FolderOf(task.info.label);
+    FolderQueue& queue = m_queues[priorityIndex][folder];
+    if (queue.tasks.empty()) {
+        auto weight = m_folderWeights.find(folder);
+        queue.weight = weight != m_folderWeights.end() ? (std::max)(weight->second, 1u) : 1u;
+        queue.currentWeight = 0;
+    }
+    queue.tasks.push_back(std::move(task));
+}
+
+ScheduledTask HydrationScheduler::Pop() {
+    if (m_fifoOnly) {
+        ScheduledTask task = std::move(m_fifo.front());
+        m_fifo.pop_front();
+        m_sizes[static_cast<size_t>(task.info.priority)]--;
+        m_size--;
+        return task;
+    }
+    
+    for (size_t priorityIndex = 0; priorityIndex < kHydrationPriorityCount; ++priorityIndex) {
+        if (m_sizes[priorityIndex] == 0) {
+            continue;
+        }
+        
+        // smooth weighted round-robin: 가중치만큼 누적 후 가장 큰 큐를 선택
+        auto& queues = m_queues[priorityIndex];
+        FolderQueue* selected = nullptr;
+        long long totalWeight = 0;
+        for (auto& entry : queues) {
+            FolderQueue& queue = entry.second;
+            if (queue.tasks.empty()) {
+                continue;
+            }
+            queue.currentWeight += queue.weight;
+            totalWeight += queue.weight;
+            if (!selected || queue.currentWeight > selected->currentWeight) {
+                selected = &queue;
+            }
+        }
+        selected->currentWeight -= totalWeight;
+        
+        ScheduledTask task = std::move(selected->tasks.front());
+        selected->tasks.pop_front();
+        m_sizes[priorityIndex]--;
+        m_size--;
+        return task;
+    }
+    
+    return ScheduledTask();
+}
+
+bool HydrationScheduler::Remove(uint64_t taskId) {
+    ScheduledTask task;
+    return Extract(taskId, task);
+}
+
+bool HydrationScheduler::Reprioritize(uint64_t taskId, HydrationPriority priority) {
+    if (m_fifoOnly) {
+        // FIFO 모드는 순서만 유지하므로 클래스 집계만 옮김
+        for (auto& task : m_fifo) {
+            if (task.info.id == taskId) {
+                m_sizes[static_cast<size_t>(task.info.priority)]--;
+                m_sizes[static_cast<size_t>(priority)]++;
+                task.info.priority = priority;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    ScheduledTask task;
+    if (!Extract(taskId, task)) {
+        return false;
+    }
+    // 새 클래스의 폴더 큐 뒤에 붙음 (대기 시간 통계는 처음 넣은 시각 기준)
+    task.info.priority = priority;
+    Push(std::move(task));
+    return true;
+}
+
+bool HydrationScheduler::Extract(uint64_t taskId, ScheduledTask& task) {
+    auto matches = [taskId](const ScheduledTask& queued) { return queued.info.id == taskId; };
+    
+    if (m_fifoOnly) {
+        auto found = std::find_if(m_fifo.begin(), m_fifo.end(), matches);
+        if (found == m_fifo.end()) {
+            return false;
+        }
+        m_sizes[static_cast<size_t>(found->info.priority)]--;
+        m_size--;
+        task = std::move(*found);
+        m_fifo.erase(found);
+        return true;
+    }
+    
+    for (size_t priorityIndex = 0; priorityIndex < kHydrationPriorityCount; ++priorityIndex) {
+        for (auto& entry : m_queues[priorityIndex]) {
+            auto& tasks = entry.second.tasks;
+            auto found = std::find_if(tasks.begin(), tasks.end(), matches);
+            if (found != tasks.end()) {
+                task = std::move(*found);
+                tasks.erase(found);
+                m_sizes[priorityIndex]--;
+                m_size--;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+std::vector<ScheduledTask> HydrationScheduler::Drain() {
+    std::vector<ScheduledTask> drained;
+    drained.reserve(m_size);
+    for (auto& task : m_fifo) {
+        drained.push_back(std::move(task));
+    }
+    m_fifo.clear();
+    for (size_t i = 0; i < kHydrationPriorityCount; ++i) {
+        for (auto& entry : m_queues[i]) {
+            for (auto& task : entry.second.tasks) {
+                drained.push_back(std::move(task));
+            }
+        }
+        m_queues[i].clear();
+        m_sizes[i] = 0;
+    }
+    m_size = 0;
+    return drained;
+}
+
+size_t HydrationScheduler::Size(HydrationPriority priority) const {
+    return m_sizes[static_cast<size_t>(priority)];
+}
+
+std::unordered_map<std::wstring, unsigned> HydrationScheduler::DefaultFolderWeights() {
+    return {
+        { L"Tracks", 3 },
+        { L"WorkRequests", 2 },
+        { L"References", 1 },
+    };
+}
+
+std::wstring HydrationScheduler::FolderOf(const std::wstring& path) const {
+    // 경로 구성요소 중 가중치가 지정된 첫 폴더를 찾음
+    size_t start = 0;
+    while (start < path.length()) {
+        size_t end = path.find_first_of(L"\\/", start);
+        if (end == std::wstring::npos) {
+            break; // 마지막 구성요소는 파일명
+        }
+        std::wstring component = path.substr(start, end - start);
+        if (m_folderWeights.count(component)) {
+            return component;
+        }
+        start = end + 1;
+    }
+    return L"";
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include <deque>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <functional>
+#include <chrono>
+
+// 하이드레이션 우선순위 클래스 (값이 작을수록 먼저 처리)
+enum class HydrationPriority {
+    Foreground = 0,        // 사용자가 파일을 열어서 발생한 FETCH_DATA
+    PinnedBackground = 1,  // "항상 오프라인 유지" 폴더의 백그라운드 하이드레이션
+    Prefetch = 2,          // 추측성 미리 가져오기
+};
+
+constexpr size_t kHydrationPriorityCount = 3;
+
+// 작업 정보
+struct FetchTaskInfo {
+    uint64_t id = 0;
+    std::wstring label;
+    HydrationPriority priority = HydrationPriority::Foreground;
+    std::chrono::steady_clock::time_point enqueuedAt;
+    std::chrono::steady_clock::time_point startedAt;
+};
+
+struct ScheduledTask {
+    FetchTaskInfo info;
+    std::function<void()> task;
+    std::function<void()> dropped;  // 실행되지 못하고 버려질 때 호출 (정지 시)
+};
+
+// 우선순위 클래스 간에는 엄격한 순서를, 클래스 안에서는 폴더 가중치에 따른
+// 가중 라운드로빈을 적용하는 작업 큐 (호출자가 동기화 책임)
+class HydrationScheduler {
+public:
+    explicit HydrationScheduler(bool fifoOnly = false,
+                                const std::unordered_map<std::wstring, unsigned>& folderWeights = {});
+    
+    void Push(ScheduledTask task);
+    ScheduledTask Pop();
+    bool Remove(uint64_t taskId);  // 아직 큐에 있는 작업 제거
+    bool Reprioritize(uint64_t taskId, HydrationPriority priority);  // 큐에 있는 작업을 다른 우선순위 클래스로 옮김
+    std::vector<ScheduledTask> Drain();  // 남은 작업을 모두 꺼내고 큐를 비움
+    
+    bool Empty() const { return m_size == 0; }
+    size_t Size() const { return m_size; }
+    size_t Size(HydrationPriority priority) const;
+    
+    // DriveConfig.syncPriority와 같은 순서 (Tracks > WorkRequests > References)
+    static std::unordered_map<std::wstring, unsigned> DefaultFolderWeights();
+
+private:
+    struct FolderQueue {
+        unsigned weight = 1;
+        long long currentWeight = 0;
+        std::deque<ScheduledTask> tasks;
+    };
+    
+    std::wstring FolderOf(const std::wstring& path) const;
+    bool Extract(uint64_t taskId, ScheduledTask& task);
+    
+    bool m_fifoOnly;
+    std::unordered_map<std::wstring, unsigned> m_folderWeights;
+    std::deque<ScheduledTask> m_fifo;
+    std::map<std::wstring, FolderQueue> m_queues[kHydrationPriorityCount];
+    size_t m_sizes[kHydrationPriorityCount] = {};
+    size_t m_size = 0;
+};
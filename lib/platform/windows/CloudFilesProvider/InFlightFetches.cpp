@@ -0,0 +1,164 @@
+#include "InFlightFetches.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+
+InFlightFetchTable::~InFlightFetchTable() {
+    // 끝나지 않은 다운로드의 소비자 목록을 비워 요청과 다운로드 사이의 shared_ptr 순환을 끊음
+    for (auto& entry : m_downloads) {
+        for (const auto& download : entry.second) {
+            download->consumers.clear();
+        }
+    }
+}
+
+std::shared_ptr<InFlightFetch> InFlightFetchTable::Register(const FetchKey& key, PathId pathId, LONGLONG offset, LONGLONG length, HydrationPriority priority) {
+    auto fetch = std::make_shared<InFlightFetch>();
+    fetch->key = key;
+    fetch->pathId = pathId;
+    fetch->offset = offset;
+    fetch->length = length;
+    fetch->requestedAt = std::chrono::steady_clock::now();
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    fetch->id = m_nextId++;
+    m_fetches[key].push_back(fetch);
+    m_stats.registered++;
+    m_stats.inFlight++;
+    
+    // 범위를 포함하고 아직 그 범위에 도달하지 않은 다운로드에 합류
+    // 큐에서 대기 중인 낮은 우선순위 다운로드에 합류하면 그 다운로드를 이 요청의 우선순위로 올림
+    for (const auto& download : m_downloads[key.fileId]) {
+        bool covers = download->nextOffset <= offset && offset + length <= download->offset + download->length;
+        if (download->finished || !covers) {
+            continue;
+        }
+        if (!download->started.load() && priority < download->priority.load()) {
+            download->priority = priority;
+            fetch->promotedDownload = true;
+            m_stats.promoted++;
+        }
+        fetch->download = download;
+        download->consumers.push_back(fetch);
+        m_stats.coalesced++;
+        return fetch;
+    }
+    
+    auto download = std::make_shared<SharedDownload>();
+    download->id = fetch->id;
+    download->fileId = key.fileId;
+    download->pathId = pathId;
+    download->offset = offset;
+    download->length = length;
+    download->priority = priority;
+    download->nextOffset = offset;
+    download->consumers.push_back(fetch);
+    m_downloads[key.fileId].push_back(download);
+    m_stats.activeDownloads++;
+    
+    fetch->download = download;
+    fetch->ownsDownload = true;
+    return fetch;
+}
+
+std::vector<std::shared_ptr<InFlightFetch>> InFlightFetchTable::BeginChunk(const std::shared_ptr<SharedDownload>& download, LONGLONG chunkEnd) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    download->nextOffset = (std::max)(download->nextOffset, chunkEnd);
+    return download->consumers;
+}
+
+std::vector<std::shared_ptr<InFlightFetch>> InFlightFetchTable::FinishDownload(const std::shared_ptr<SharedDownload>& download) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (download->finished) {
+        return {};
+    }
+    
+    std::vector<std::shared_ptr<InFlightFetch>> consumers;
+    consumers.swap(download->consumers);
+    for (const auto& fetch : consumers) {
+        RemoveFetch(fetch);
+        m_stats.completed++;
+    }
+    RemoveDownload(download);
+    return consumers;
+}
+
+std::vector<std::shared_ptr<SharedDownload>> InFlightFetchTable::Cancel(const FetchKey& key, LONGLONG offset, LONGLONG length) {
+    std::vector<std::shared_ptr<SharedDownload>> orphaned;
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto entry = m_fetches.find(key);
+    if (entry == m_fetches.end()) {
+        return orphaned;
+    }
+    
+    std::vector<std::shared_ptr<InFlightFetch>> cancelled;
+    for (const auto& fetch : entry->second) {
+        bool overlaps = length <= 0 || (fetch->offset < offset + length && offset < fetch->offset + fetch->length);
+        if (overlaps) {
+            cancelled.push_back(fetch);
+        }
+    }
+    
+    for (const auto& fetch : cancelled) {
+        fetch->cancelToken->Cancel();
+        RemoveFetch(fetch);
+        TraceRecorder::Instance().AsyncEnd(kHydrationTraceCategory, "fetch", fetch->id, fetch->pathId,
+                                           { "cancelled", 1 }, { "transferred", fetch->transferred.load() });
+        
+        const auto& download = fetch->download;
+        if (download->started.load()) {
+            m_stats.cancelledRunning++;
+        } else {
+            m_stats.cancelledQueued++;
+        }
+        
+        auto& consumers = download->consumers;
+        consumers.erase(std::remove(consumers.begin(), consumers.end(), fetch), consumers.end());
+        if (consumers.empty() && !download->finished) {
+            // 기다리는 요청이 없으면 원격 다운로드도 중단
+            download->cancelToken->Cancel();
+            RemoveDownload(download);
+            orphaned.push_back(download);
+        }
+    }
+    
+    return orphaned;
+}
+
+InFlightFetchStats InFlightFetchTable::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void InFlightFetchTable::RemoveFetch(const std::shared_ptr<InFlightFetch>& fetch) {
+    auto entry = m_fetches.find(fetch->key);
+    if (entry == m_fetches.end()) {
+        return;
+    }
+    
+    auto& fetches = entry->second;
+    auto found = std::find(fetches.begin(), fetches.end(), fetch);
+    if (found == fetches.end()) {
+        return;
+    }
+    fetches.erase(found);
+    if (fetches.empty()) {
+        m_fetches.erase(entry);
+    }
+    m_stats.inFlight--;
+}
+
+void InFlightFetchTable::RemoveDownload(const std::shared_ptr<SharedDownload>& download) {
+    download->finished = true;
+    m_stats.activeDownloads--;
+    
+    auto entry = m_downloads.find(download->fileId);
+    if (entry == m_downloads.end()) {
+        return;
+    }
+    auto& downloads = entry->second;
+    downloads.erase(std::remove(downloads.begin(), downloads.end(), download), downloads.end());
+    if (downloads.empty()) {
+        m_downloads.erase(entry);
+    }
+}
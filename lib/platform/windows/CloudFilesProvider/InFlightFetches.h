@@ -0,0 +1,123 @@
+#pragma once
+
+#include <windows.h>
+#include <cfapi.h>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <chrono>
+
+#include "FetchStream.h"
+#include "HydrationScheduler.h"
+#include "PathTable.h"
+
+// 진행 중인 fetch 식별자
+struct FetchKey {
+    CF_CONNECTION_KEY connectionKey = CF_CONNECTION_KEY_INVALID;
+    CF_TRANSFER_KEY transferKey = CF_TRANSFER_KEY_INVALID;
+    LONGLONG fileId = 0;
+    
+    bool operator==(const FetchKey& other) const {
+        return connectionKey == other.connectionKey && transferKey == other.transferKey && fileId == other.fileId;
+    }
+};
+
+struct FetchKeyHash {
+    size_t operator()(const FetchKey& key) const {
+        size_t hash = std::hash<LONGLONG>()(static_cast<LONGLONG>(key.connectionKey));
+        hash ^= std::hash<LONGLONG>()(static_cast<LONGLONG>(key.transferKey)) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<LONGLONG>()(key.fileId) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+};
+
+struct SharedDownload;
+
+// FETCH_DATA 요청 하나 (전송 키 하나에 대응)
+struct InFlightFetch {
+    uint64_t id = 0;
+    FetchKey key;
+    PathId pathId = kInvalidPathId;
+    LONGLONG offset = 0;
+    LONGLONG length = 0;
+    std::chrono::steady_clock::time_point requestedAt;  // 첫 바이트까지 걸린 시간 측정용
+    std::atomic<LONGLONG> transferred{ 0 };    // 이 전송 키로 보낸 바이트 수 (진행률)
+    std::shared_ptr<CancelToken> cancelToken = std::make_shared<CancelToken>();
+    std::shared_ptr<SharedDownload> download;  // 이 요청에 데이터를 공급하는 원격 다운로드 (consumers와 순환하므로 테이블이 끊음)
+    bool ownsDownload = false;                 // true면 호출자가 다운로드 작업을 스케줄해야 함
+    bool promotedDownload = false;             // 큐에 있던 낮은 우선순위 다운로드에 합류하며 우선순위를 올림
+};
+
+// 같은 파일의 겹치는 요청들이 공유하는 원격 다운로드 하나
+struct SharedDownload {
+    uint64_t id = 0;
+    LONGLONG fileId = 0;
+    PathId pathId = kInvalidPathId;
+    std::string fileIdentity;
+    ULONGLONG contentVersion = 0;
+    LONGLONG fileSize = 0;
+    LONGLONG offset = 0;
+    LONGLONG length = 0;
+    std::atomic<HydrationPriority> priority{ HydrationPriority::Foreground };  // 더 급한 요청이 합류하면 올라감
+    std::atomic<uint64_t> taskId{ 0 };  // 실행기 작업 ID (큐에서 제거하거나 우선순위를 바꿀 때 사용)
+    std::atomic<bool> started{ false };
+    std::shared_ptr<CancelToken> cancelToken = std::make_shared<CancelToken>();  // 모든 소비자가 취소되면 취소됨
+    
+    // 아래는 테이블 뮤텍스로 보호
+    LONGLONG nextOffset = 0;  // 아직 소비자에게 나눠주지 않은 첫 오프셋
+    bool finished = false;
+    std::vector<std::shared_ptr<InFlightFetch>> consumers;
+};
+
+struct InFlightFetchStats {
+    size_t inFlight = 0;
+    size_t activeDownloads = 0;
+    uint64_t registered = 0;
+    uint64_t completed = 0;
+    uint64_t coalesced = 0;         // 기존 다운로드에 합류한 요청
+    uint64_t promoted = 0;          // 합류하면서 큐에 있던 다운로드의 우선순위를 올린 요청
+    uint64_t cancelledQueued = 0;   // 워커에 도달하기 전에 취소됨
+    uint64_t cancelledRunning = 0;  // 다운로드 도중 취소됨
+};
+
+// (연결 키, 전송 키, 파일 ID)로 진행 중인 fetch를 추적하고,
+// 같은 파일의 겹치는 범위 요청을 하나의 원격 다운로드로 합치는 테이블
+class InFlightFetchTable {
+public:
+    InFlightFetchTable() = default;
+    ~InFlightFetchTable();
+    
+    InFlightFetchTable(const InFlightFetchTable&) = delete;
+    InFlightFetchTable& operator=(const InFlightFetchTable&) = delete;
+    
+    // 요청 등록: 합류할 다운로드가 없으면 새 다운로드를 만들고 ownsDownload를 설정
+    // 요청 범위 전체를 아직 보내지 않은 다운로드에만 합류하며, 일부만 겹치는 요청은 새 다운로드를 시작함
+    // 아직 시작되지 않은 낮은 우선순위 다운로드에 합류하면 그 우선순위를 올리고 promotedDownload를 설정
+    // (호출자가 실행기에서 작업의 우선순위를 바꿔야 함)
+    std::shared_ptr<InFlightFetch> Register(const FetchKey& key, PathId pathId, 
+                                            LONGLONG offset, LONGLONG length, HydrationPriority priority);
+    
+    // 청크 [.., chunkEnd) 전송 직전 호출: 이후 합류하는 요청은 chunkEnd부터 받게 되며 현재 소비자 목록을 반환
+    std::vector<std::shared_ptr<InFlightFetch>> BeginChunk(const std::shared_ptr<SharedDownload>& download, LONGLONG chunkEnd);
+    
+    // 다운로드 종료: 더 이상 합류를 받지 않고 남은 소비자를 반환
+    std::vector<std::shared_ptr<InFlightFetch>> FinishDownload(const std::shared_ptr<SharedDownload>& download);
+    
+    // 취소 범위와 겹치는 요청을 취소하고, 소비자가 모두 사라진 다운로드를 반환
+    std::vector<std::shared_ptr<SharedDownload>> Cancel(const FetchKey& key, LONGLONG offset, LONGLONG length);
+    
+    InFlightFetchStats GetStats() const;
+
+private:
+    void RemoveFetch(const std::shared_ptr<InFlightFetch>& fetch);
+    void RemoveDownload(const std::shared_ptr<SharedDownload>& download);
+    
+    mutable std::mutex m_mutex;
+    std::unordered_map<FetchKey, std::vector<std::shared_ptr<InFlightFetch>>, FetchKeyHash> m_fetches;
+    std::unordered_map<LONGLONG, std::vector<std::shared_ptr<SharedDownload>>> m_downloads;
+    uint64_t m_nextId = 1;
+    InFlightFetchStats m_stats;
+};
@@ -0,0 +1,149 @@
+#include "InSyncUpdater.h"
+#include "MetadataIndex.h"
+
+InSyncUpdater::InSyncUpdater(const InSyncUpdaterConfig& config, Applier applier, FailureCallback onFailure)
+    : m_config(config), m_applier(std::move(applier)), m_onFailure(std::move(onFailure)) {
+}
+
+InSyncUpdater::~InSyncUpdater() {
+    Stop();
+}
+
+void InSyncUpdater::Start() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_running) {
+        return;
+    }
+    m_running = true;
+    m_worker = std::thread([this]() { WorkerLoop(); });
+}
+
+void InSyncUpdater::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            return;
+        }
+        m_running = false;
+    }
+    m_condition.notify_all();
+    
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+}
+
+void InSyncUpdater::Queue(const std::wstring& relativePath, InSyncState state) {
+    std::wstring key = NormalizeMetadataPath(relativePath);
+    size_t separator = key.find_last_of(L'\\');
+    std::wstring directory = separator == std::wstring::npos ? std::wstring() : key.substr(0, separator);
+    
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.queued++;
+        
+        auto& files = m_pending[directory];
+        auto inserted = files.emplace(key, PendingUpdate{ relativePath, state });
+        if (!inserted.second) {
+            // 아직 처리되지 않은 같은 경로의 요청은 마지막 상태로 대체
+            inserted.first->second.state = state;
+            m_stats.coalesced++;
+        } else {
+            if (m_pendingCount++ == 0) {
+                m_firstPendingAt = std::chrono::steady_clock::now();
+                wake = true;
+            }
+            wake = wake || m_pendingCount >= m_config.maxPending;
+        }
+    }
+    if (wake) {
+        m_condition.notify_one();
+    }
+}
+
+void InSyncUpdater::Flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // 처리할 요청이 없을 때 플래그를 남기면 다음 요청이 모으는 시간 없이 바로 처리됨
+    if (!m_running || (m_pendingCount == 0 && !m_sweeping)) {
+        return;
+    }
+    m_flushRequested = true;
+    m_condition.notify_one();
+    m_drained.wait(lock, [this] { return !m_running || (m_pendingCount == 0 && !m_sweeping); });
+}
+
+InSyncUpdaterStats InSyncUpdater::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    InSyncUpdaterStats stats = m_stats;
+    stats.pending = m_pendingCount;
+    return stats;
+}
+
+void InSyncUpdater::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_condition.wait(lock, [this] { return !m_running || m_pendingCount > 0; });
+        
+        // 첫 요청 후 잠시 더 모아서 같은 폴더의 요청을 한 번에 처리
+        // (Flush, 정지, 대기 요청이 너무 많으면 바로 처리)
+        if (m_running && !m_flushRequested && m_pendingCount < m_config.maxPending) {
+            m_condition.wait_until(lock, m_firstPendingAt + m_config.batchDelay, [this] {
+                return !m_running || m_flushRequested || m_pendingCount >= m_config.maxPending;
+            });
+        }
+        
+        if (m_pendingCount > 0) {
+            PendingMap batch;
+            batch.swap(m_pending);
+            m_pendingCount = 0;
+            m_sweeping = true;
+            lock.unlock();
+            
+            Sweep(batch);
+            
+            lock.lock();
+            m_sweeping = false;
+        }
+        
+        if (m_pendingCount == 0) {
+            m_flushRequested = false;
+            m_drained.notify_all();
+            if (!m_running) {
+                break;
+            }
+        }
+    }
+}
+
+void InSyncUpdater::Sweep(PendingMap& batch) {
+    auto start = std::chrono::steady_clock::now();
+    uint64_t applied = 0;
+    uint64_t failed = 0;
+    
+    for (auto& directory : batch) {
+        for (auto& file : directory.second) {
+            HRESULT hr = m_applier(file.second.relativePath, file.second.state);
+            if (SUCCEEDED(hr)) {
+                applied++;
+            } else {
+                failed++;
+                if (m_onFailure) {
+                    m_onFailure(file.second.relativePath, hr);
+                }
+            }
+        }
+    }
+    
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.applied += applied;
+    m_stats.failed += failed;
+    m_stats.sweeps++;
+    m_stats.directoriesSwept += batch.size();
+    m_stats.totalSweepMs += elapsedMs;
+    if (m_stats.totalSweepMs > 0) {
+        m_stats.updatesPerSecond = (m_stats.applied + m_stats.failed) * 1000.0 / m_stats.totalSweepMs;
+    }
+}
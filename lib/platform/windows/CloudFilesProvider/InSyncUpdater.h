@@ -0,0 +1,80 @@
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include <map>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#include "ProviderBackend.h"
+
+struct InSyncUpdaterConfig {
+    std::chrono::milliseconds batchDelay{ 50 };  // 첫 요청 후 더 모아서 처리할 시간
+    size_t maxPending = 200000;                  // 넘으면 지연 없이 바로 처리
+};
+
+struct InSyncUpdaterStats {
+    uint64_t queued = 0;
+    uint64_t coalesced = 0;      // 처리 전에 같은 경로의 새 요청으로 대체된 수
+    uint64_t applied = 0;
+    uint64_t failed = 0;
+    uint64_t sweeps = 0;
+    uint64_t directoriesSwept = 0;
+    size_t pending = 0;
+    double totalSweepMs = 0;
+    double updatesPerSecond = 0; // 처리 시간 기준 처리량
+};
+
+// 동기화 상태 변경 비동기 큐
+// 같은 경로의 반복 요청은 마지막 값으로 합치고, 폴더 순서로 정렬해 백그라운드 스레드에서 한 번에 처리
+// CfSetInSyncState는 파일 핸들 단위 API라 폴더 하나를 한 번의 플랫폼 호출로 바꾸지는 못함
+// (이득은 같은 경로의 반복 요청을 합치고 호출 스레드에서 플랫폼 호출을 빼는 데서 나옴)
+class InSyncUpdater {
+public:
+    using Applier = std::function<HRESULT(const std::wstring& relativePath, InSyncState state)>;
+    using FailureCallback = std::function<void(const std::wstring& relativePath, HRESULT hr)>;
+    
+    InSyncUpdater(const InSyncUpdaterConfig& config, Applier applier, FailureCallback onFailure = nullptr);
+    ~InSyncUpdater();
+    
+    void Start();
+    void Stop();  // 남은 요청을 처리한 뒤 정지
+    
+    void Queue(const std::wstring& relativePath, InSyncState state);
+    
+    // 지금까지 들어온 요청이 모두 처리될 때까지 대기
+    void Flush();
+    
+    InSyncUpdaterStats GetStats() const;
+
+private:
+    struct PendingUpdate {
+        std::wstring relativePath;
+        InSyncState state;
+    };
+    // 폴더 키 -> (파일 키 -> 요청), 정렬되어 있어 같은 폴더는 연속으로 처리됨
+    using PendingMap = std::map<std::wstring, std::map<std::wstring, PendingUpdate>>;
+    
+    void WorkerLoop();
+    void Sweep(PendingMap& batch);
+    
+    InSyncUpdaterConfig m_config;
+    Applier m_applier;
+    FailureCallback m_onFailure;
+    
+    std::thread m_worker;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::condition_variable m_drained;
+    bool m_running = false;
+    bool m_sweeping = false;
+    bool m_flushRequested = false;
+    
+    PendingMap m_pending;
+    size_t m_pendingCount = 0;
+    std::chrono::steady_clock::time_point m_firstPendingAt;
+    InSyncUpdaterStats m_stats;
+};
@@ -0,0 +1,431 @@
+#include "Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <cwchar>
+#include <iostream>
+
+namespace {
+
+size_t RoundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+const wchar_t* LevelTag(LogLevel level) {
+    switch (level) {
+    case LogLevel::Debug: return L"D";
+    case LogLevel::Info: return L"I";
+    case LogLevel::Warning: return L"W";
+    case LogLevel::Error: return L"E";
+    }
+    return L"?";
+}
+
+void AppendPadded(std::wstring& out, unsigned value, int width) {
+    wchar_t digits[8];
+    for (int i = width - 1; i >= 0; --i) {
+        digits[i] = static_cast<wchar_t>(L'0' + value % 10);
+        value /= 10;
+    }
+    out.append(digits, width);
+}
+
+void CreateParentDirectories(const std::wstring& path) {
+    // 드라이브 다음 구분자부터 상위 폴더를 차례로 생성 (이미 있으면 무시)
+    size_t last = path.find_last_of(L"\\/");
+    for (size_t separator = path.find_first_of(L"\\/", 3); separator != std::wstring::npos && separator <= last;
+         separator = path.find_first_of(L"\\/", separator + 1)) {
+        CreateDirectoryW(path.substr(0, separator).c_str(), nullptr);
+    }
+}
+
+// 스레드 종료 시 링을 버려진 것으로 표시 (쓰기 스레드가 남은 레코드를 출력한 뒤 정리)
+struct ThreadRingHolder {
+    std::shared_ptr<LogRing> ring;
+    ~ThreadRingHolder() {
+        if (ring) {
+            ring->Abandon();
+        }
+    }
+};
+
+thread_local ThreadRingHolder t_ring;
+
+} // namespace
+
+// ---- LogLine ----
+
+void LogLine::Append(const wchar_t* text) {
+    Append(text, text ? wcslen(text) : 0);
+}
+
+void LogLine::Append(const wchar_t* text, size_t length) {
+    size_t available = LogRecord::kTextCapacity - m_record.length;
+    size_t copied = (std::min)(length, available);
+    if (copied > 0) {
+        memcpy(m_record.text + m_record.length, text, copied * sizeof(wchar_t));
+        m_record.length = static_cast<uint16_t>(m_record.length + copied);
+    }
+}
+
+void LogLine::Append(const char* text) {
+    // ASCII 문자열 (해시, 오류 코드 이름 등)
+    for (; text && *text && m_record.length < LogRecord::kTextCapacity; ++text) {
+        m_record.text[m_record.length++] = static_cast<wchar_t>(static_cast<unsigned char>(*text));
+    }
+}
+
+void LogLine::Append(const std::string& text) {
+    Append(text.c_str());
+}
+
+void LogLine::Append(wchar_t c) {
+    if (m_record.length < LogRecord::kTextCapacity) {
+        m_record.text[m_record.length++] = c;
+    }
+}
+
+void LogLine::AppendUnsigned(uint64_t value) {
+    wchar_t digits[20];
+    size_t count = 0;
+    do {
+        digits[count++] = static_cast<wchar_t>(L'0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (count > 0 && m_record.length < LogRecord::kTextCapacity) {
+        m_record.text[m_record.length++] = digits[--count];
+    }
+}
+
+void LogLine::AppendSigned(int64_t value) {
+    if (value < 0) {
+        Append(L'-');
+        AppendUnsigned(0 - static_cast<uint64_t>(value));
+    } else {
+        AppendUnsigned(static_cast<uint64_t>(value));
+    }
+}
+
+void LogLine::Append(double value) {
+    // 소수점 셋째 자리까지 (처리량, 비율 표시용)
+    if (value < 0) {
+        Append(L'-');
+        value = -value;
+    }
+    uint64_t scaled = static_cast<uint64_t>(value * 1000.0 + 0.5);
+    AppendUnsigned(scaled / 1000);
+    Append(L'.');
+    uint64_t fraction = scaled % 1000;
+    Append(static_cast<wchar_t>(L'0' + fraction / 100));
+    Append(static_cast<wchar_t>(L'0' + fraction / 10 % 10));
+    Append(static_cast<wchar_t>(L'0' + fraction % 10));
+}
+
+void LogLine::Append(LogHex value) {
+    static const wchar_t kDigits[] = L"0123456789ABCDEF";
+    wchar_t digits[16];
+    size_t count = 0;
+    uint64_t remaining = value.value;
+    do {
+        digits[count++] = kDigits[remaining & 0xF];
+        remaining >>= 4;
+    } while (remaining > 0);
+    while (count < 8) {
+        digits[count++] = L'0';
+    }
+    Append(L"0x", 2);
+    while (count > 0 && m_record.length < LogRecord::kTextCapacity) {
+        m_record.text[m_record.length++] = digits[--count];
+    }
+}
+
+// ---- LogRing ----
+
+LogRing::LogRing(size_t capacity, uint32_t threadId)
+    : m_records(new LogRecord[RoundUpToPowerOfTwo((std::max)(capacity, size_t(2)))]),
+      m_mask(RoundUpToPowerOfTwo((std::max)(capacity, size_t(2))) - 1),
+      m_threadId(threadId) {
+}
+
+LogRecord* LogRing::Reserve() {
+    uint64_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) > m_mask) {
+        // 가득 참: 호출 스레드를 막지 않고 버림
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    LogRecord* record = &m_records[head & m_mask];
+    record->length = 0;
+    return record;
+}
+
+void LogRing::Commit() {
+    m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+// ---- Logger ----
+
+Logger& Logger::Instance() {
+    // 정적 소멸자에서 쓰기 스레드를 join하면 DLL 언로드 중(로더 잠금) 교착될 수 있으므로 해제하지 않음
+    // 남은 로그는 CloudFilesProvider::Shutdown이 Stop을 명시적으로 호출해 씀
+    static Logger* instance = new Logger();
+    return *instance;
+}
+
+LogRing& Logger::ThreadRing() {
+    if (!t_ring.ring) {
+        auto ring = std::make_shared<LogRing>(m_ringCapacity.load(std::memory_order_relaxed), GetCurrentThreadId());
+        {
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+            m_rings.push_back(ring);
+        }
+        t_ring.ring = std::move(ring);
+    }
+    return *t_ring.ring;
+}
+
+void Logger::Stamp(LogRecord& record, LogLevel level) {
+    FILETIME now;
+    GetSystemTimePreciseAsFileTime(&now);
+    record.timestamp = (static_cast<int64_t>(now.dwHighDateTime) << 32) | now.dwLowDateTime;
+    record.threadId = GetCurrentThreadId();
+    record.level = level;
+}
+
+HRESULT Logger::Start(const LoggerConfig& config) {
+    Stop();
+
+    m_config = config;
+    m_minLevel.store(config.minLevel, std::memory_order_relaxed);
+    m_ringCapacity.store(config.ringCapacity, std::memory_order_relaxed);
+
+    HRESULT hr = S_OK;
+    if (!m_config.filePath.empty()) {
+        hr = OpenFile();
+        if (FAILED(hr)) {
+            // 파일을 열 수 없어도 콘솔 출력은 계속함
+            m_config.filePath.clear();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        m_stopRequested = false;
+    }
+    m_running.store(true, std::memory_order_release);
+    m_writer = std::thread(&Logger::WriterLoop, this);
+    return hr;
+}
+
+void Logger::Stop() {
+    if (!m_writer.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        m_stopRequested = true;
+    }
+    m_writerCondition.notify_one();
+    m_writer.join();
+    m_running.store(false, std::memory_order_release);
+
+    if (m_file != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+    }
+}
+
+void Logger::Flush() {
+    if (!IsRunning()) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_writerMutex);
+    uint64_t target = ++m_flushRequested;
+    m_writerCondition.notify_one();
+    m_flushedCondition.wait(lock, [this, target] { return m_flushCompleted >= target || m_stopRequested; });
+}
+
+LoggerStats Logger::GetStats() const {
+    LoggerStats stats;
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        stats = m_stats;
+    }
+    std::lock_guard<std::mutex> lock(m_ringsMutex);
+    stats.threads = m_rings.size();
+    return stats;
+}
+
+void Logger::WriterLoop() {
+    // 로그 출력이 콜백이나 전송을 방해하지 않도록 낮은 우선순위로 실행
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+
+    std::unique_lock<std::mutex> lock(m_writerMutex);
+    while (true) {
+        m_writerCondition.wait_for(lock, m_config.flushInterval, [this] {
+            return m_stopRequested || m_flushRequested > m_flushCompleted;
+        });
+        bool stopping = m_stopRequested;
+        uint64_t flushTarget = m_flushRequested;
+
+        lock.unlock();
+        DrainRings();
+        lock.lock();
+
+        m_flushCompleted = flushTarget;
+        m_flushedCondition.notify_all();
+        if (stopping) {
+            break;
+        }
+    }
+}
+
+size_t Logger::DrainRings() {
+    std::vector<std::shared_ptr<LogRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        rings = m_rings;
+    }
+
+    // 모든 스레드의 레코드를 모아 시간순으로 출력
+    m_batchStorage.clear();
+    uint64_t dropped = 0;
+    for (const auto& ring : rings) {
+        ring->Drain([this](const LogRecord& record) {
+            m_batchStorage.push_back(record);
+        });
+        dropped += ring->TakeDropped();
+    }
+
+    m_batch.clear();
+    for (const LogRecord& record : m_batchStorage) {
+        m_batch.push_back(&record);
+    }
+    std::stable_sort(m_batch.begin(), m_batch.end(), [](const LogRecord* a, const LogRecord* b) {
+        return a->timestamp < b->timestamp;
+    });
+
+    m_lineBuffer.clear();
+    for (const LogRecord* record : m_batch) {
+        WriteRecord(*record);
+    }
+    if (dropped > 0) {
+        m_lineBuffer += L"[W] ";
+        m_lineBuffer += std::to_wstring(dropped);
+        m_lineBuffer += L" log messages dropped (thread buffer full)\n";
+    }
+    if (!m_lineBuffer.empty()) {
+        WriteText(m_lineBuffer);
+    }
+
+    // 종료된 스레드의 링은 비운 뒤 제거
+    {
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(), [](const std::shared_ptr<LogRing>& ring) {
+            return ring->IsAbandoned() && ring->IsEmpty();
+        }), m_rings.end());
+    }
+
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    m_stats.written += m_batch.size();
+    m_stats.dropped += dropped;
+    return m_batch.size();
+}
+
+void Logger::WriteRecord(const LogRecord& record) {
+    // "2026-01-31 12:34:56.789 [I] [1234] 메시지"
+    FILETIME fileTime;
+    fileTime.dwLowDateTime = static_cast<DWORD>(record.timestamp);
+    fileTime.dwHighDateTime = static_cast<DWORD>(record.timestamp >> 32);
+    FILETIME localTime;
+    SYSTEMTIME parts = {};
+    FileTimeToLocalFileTime(&fileTime, &localTime);
+    FileTimeToSystemTime(&localTime, &parts);
+
+    AppendPadded(m_lineBuffer, parts.wYear, 4);
+    m_lineBuffer += L'-';
+    AppendPadded(m_lineBuffer, parts.wMonth, 2);
+    m_lineBuffer += L'-';
+    AppendPadded(m_lineBuffer, parts.wDay, 2);
+    m_lineBuffer += L' ';
+    AppendPadded(m_lineBuffer, parts.wHour, 2);
+    m_lineBuffer += L':';
+    AppendPadded(m_lineBuffer, parts.wMinute, 2);
+    m_lineBuffer += L':';
+    AppendPadded(m_lineBuffer, parts.wSecond, 2);
+    m_lineBuffer += L'.';
+    AppendPadded(m_lineBuffer, parts.wMilliseconds, 3);
+    m_lineBuffer += L" [";
+    m_lineBuffer += LevelTag(record.level);
+    m_lineBuffer += L"] [";
+    m_lineBuffer += std::to_wstring(record.threadId);
+    m_lineBuffer += L"] ";
+    m_lineBuffer.append(record.text, record.length);
+    m_lineBuffer += L'\n';
+}
+
+void Logger::WriteText(const std::wstring& text) {
+    if (m_config.console) {
+        std::wcout << text;
+        std::wcout.flush();
+    }
+    if (m_file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    int size = WideCharToMultiByte(CP_UTF8, 0, text.c_str(), static_cast<int>(text.size()), nullptr, 0, nullptr, nullptr);
+    if (size <= 0) {
+        return;
+    }
+    m_utf8Buffer.resize(static_cast<size_t>(size));
+    WideCharToMultiByte(CP_UTF8, 0, text.c_str(), static_cast<int>(text.size()), &m_utf8Buffer[0], size, nullptr, nullptr);
+
+    DWORD written = 0;
+    WriteFile(m_file, m_utf8Buffer.data(), static_cast<DWORD>(m_utf8Buffer.size()), &written, nullptr);
+    m_fileSize += written;
+
+    if (m_config.maxFileBytes > 0 && m_fileSize >= m_config.maxFileBytes) {
+        RotateFile();
+    }
+}
+
+HRESULT Logger::OpenFile() {
+    CreateParentDirectories(m_config.filePath);
+    m_file = CreateFileW(m_config.filePath.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                         OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+
+    LARGE_INTEGER size = {};
+    GetFileSizeEx(m_file, &size);
+    m_fileSize = static_cast<uint64_t>(size.QuadPart);
+    return S_OK;
+}
+
+void Logger::RotateFile() {
+    CloseHandle(m_file);
+    m_file = INVALID_HANDLE_VALUE;
+
+    // log -> log.1 -> log.2 ... (가장 오래된 파일은 삭제)
+    const std::wstring& path = m_config.filePath;
+    if (m_config.maxFiles > 1) {
+        DeleteFileW((path + L"." + std::to_wstring(m_config.maxFiles - 1)).c_str());
+        for (size_t i = m_config.maxFiles - 1; i > 1; --i) {
+            MoveFileExW((path + L"." + std::to_wstring(i - 1)).c_str(), (path + L"." + std::to_wstring(i)).c_str(),
+                        MOVEFILE_REPLACE_EXISTING);
+        }
+        MoveFileExW(path.c_str(), (path + L".1").c_str(), MOVEFILE_REPLACE_EXISTING);
+    } else {
+        DeleteFileW(path.c_str());
+    }
+
+    OpenFile();
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    m_stats.rotations++;
+}
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <windows.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <type_traits>
+
+enum class LogLevel : uint16_t {
+    Debug = 0,
+    Info = 1,
+    Warning = 2,
+    Error = 3,
+};
+
+// 이 값보다 낮은 수준의 로그 매크로는 컴파일 시 제거됨 (릴리스 빌드는 Debug 제외)
+#ifndef MBD_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define MBD_LOG_MIN_LEVEL 1
+#else
+#define MBD_LOG_MIN_LEVEL 0
+#endif
+#endif
+
+struct LoggerConfig {
+    std::wstring filePath;                              // 비어 있으면 파일에 쓰지 않음
+    LogLevel minLevel = LogLevel::Info;                 // 실행 중 필터 (컴파일 시 제거와 별개)
+    bool console = true;                                // 쓰기 스레드에서 콘솔에도 출력
+    uint64_t maxFileBytes = 10ull * 1024 * 1024;        // 넘으면 .1, .2 ... 로 회전
+    size_t maxFiles = 5;                                // 현재 파일을 포함한 보관 개수
+    size_t ringCapacity = 1024;                         // 스레드별 레코드 수 (2의 거듭제곱으로 올림)
+    std::chrono::milliseconds flushInterval{ 50 };
+};
+
+struct LoggerStats {
+    uint64_t written = 0;
+    uint64_t dropped = 0;     // 스레드 버퍼가 가득 차서 버린 메시지
+    uint64_t rotations = 0;
+    size_t threads = 0;       // 버퍼를 가진 스레드 수
+};
+
+// 16진수로 출력할 값 (HRESULT 등)
+struct LogHex {
+    explicit LogHex(uint64_t value) : value(value) {}
+    explicit LogHex(HRESULT value) : value(static_cast<uint32_t>(value)) {}
+    uint64_t value;
+};
+
+// 고정 크기 로그 레코드 (메시지는 호출 스레드에서 바로 이 버퍼에 만들어짐)
+struct LogRecord {
+    static const size_t kTextCapacity = 248;
+
+    int64_t timestamp = 0;    // FILETIME (100ns 단위)
+    uint32_t threadId = 0;
+    LogLevel level = LogLevel::Info;
+    uint16_t length = 0;
+    wchar_t text[kTextCapacity];
+};
+
+// 레코드에 메시지를 이어 붙이는 할당 없는 작성기 (넘치는 부분은 잘림)
+class LogLine {
+public:
+    explicit LogLine(LogRecord& record) : m_record(record) {}
+
+    void Append(const wchar_t* text);
+    void Append(const wchar_t* text, size_t length);
+    void Append(const std::wstring& text) { Append(text.c_str(), text.size()); }
+    void Append(const char* text);
+    void Append(const std::string& text);
+    void Append(wchar_t c);
+    void Append(bool value) { Append(value ? L"true" : L"false"); }
+    void Append(double value);
+    void Append(LogHex value);
+    void AppendSigned(int64_t value);
+    void AppendUnsigned(uint64_t value);
+
+    template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+    void Append(T value) {
+        if (std::is_signed<T>::value) {
+            AppendSigned(static_cast<int64_t>(value));
+        } else {
+            AppendUnsigned(static_cast<uint64_t>(value));
+        }
+    }
+
+    template <typename T, typename std::enable_if<std::is_enum<T>::value, int>::type = 0>
+    void Append(T value) {
+        AppendSigned(static_cast<int64_t>(value));
+    }
+
+private:
+    LogRecord& m_record;
+};
+
+// 스레드 하나가 쓰고 쓰기 스레드 하나가 읽는 잠금 없는 링 버퍼
+class LogRing {
+public:
+    LogRing(size_t capacity, uint32_t threadId);
+
+    // 생산자: 빈 슬롯을 얻어 채운 뒤 Commit (가득 차면 nullptr)
+    LogRecord* Reserve();
+    void Commit();
+
+    // 소비자: 쌓인 레코드를 모두 꺼냄
+    template <typename Fn>
+    size_t Drain(Fn&& consume) {
+        uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        uint64_t head = m_head.load(std::memory_order_acquire);
+        for (uint64_t i = tail; i < head; ++i) {
+            consume(m_records[i & m_mask]);
+        }
+        m_tail.store(head, std::memory_order_release);
+        return static_cast<size_t>(head - tail);
+    }
+
+    uint64_t TakeDropped() { return m_dropped.exchange(0, std::memory_order_relaxed); }
+    uint32_t ThreadId() const { return m_threadId; }
+
+    void Abandon() { m_abandoned.store(true, std::memory_order_release); }
+    bool IsAbandoned() const { return m_abandoned.load(std::memory_order_acquire); }
+    bool IsEmpty() const {
+        return m_tail.load(std::memory_order_relaxed) == m_head.load(std::memory_order_acquire);
+    }
+
+private:
+    std::unique_ptr<LogRecord[]> m_records;
+    size_t m_mask;
+    uint32_t m_threadId;
+    std::atomic<bool> m_abandoned{ false };
+    std::atomic<uint64_t> m_dropped{ 0 };
+    alignas(64) std::atomic<uint64_t> m_head{ 0 };   // 생산자만 씀
+    alignas(64) std::atomic<uint64_t> m_tail{ 0 };   // 소비자만 씀
+};
+
+// 프로세스 전역 비동기 로거
+// 호출 스레드는 자기 링 버퍼에 레코드를 채우기만 하고 (잠금, 할당, 시스템 호출 없음)
+// 파일/콘솔 쓰기와 회전은 백그라운드 스레드가 처리함
+// 프로세스 종료 시 자동으로 정지하지 않으므로 시작한 쪽이 Stop을 호출해야 남은 로그가 기록됨
+class Logger {
+public:
+    static Logger& Instance();
+
+    HRESULT Start(const LoggerConfig& config);
+    void Stop();
+    bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    // 지금까지 기록된 메시지를 모두 출력할 때까지 대기
+    void Flush();
+
+    void SetMinLevel(LogLevel level) { m_minLevel.store(level, std::memory_order_relaxed); }
+    bool IsEnabled(LogLevel level) const { return level >= m_minLevel.load(std::memory_order_relaxed); }
+
+    LoggerStats GetStats() const;
+
+    template <typename... Args>
+    void Log(LogLevel level, const Args&... args) {
+        if (!IsEnabled(level)) {
+            return;
+        }
+        LogRing& ring = ThreadRing();
+        LogRecord* record = ring.Reserve();
+        if (!record) {
+            return;
+        }
+        Stamp(*record, level);
+        LogLine line(*record);
+        (line.Append(args), ...);
+        ring.Commit();
+    }
+
+private:
+    Logger() = default;
+    ~Logger() = default;  // 인스턴스는 해제되지 않음 (Instance 참고)
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    LogRing& ThreadRing();
+    static void Stamp(LogRecord& record, LogLevel level);
+
+    void WriterLoop();
+    size_t DrainRings();
+    void WriteRecord(const LogRecord& record);
+    void WriteText(const std::wstring& text);
+    HRESULT OpenFile();
+    void RotateFile();
+
+    LoggerConfig m_config;
+    std::atomic<LogLevel> m_minLevel{ LogLevel::Info };
+    std::atomic<bool> m_running{ false };
+    std::atomic<size_t> m_ringCapacity{ 1024 };
+
+    // 링 목록 (스레드가 처음 로그를 남길 때만 잠금)
+    mutable std::mutex m_ringsMutex;
+    std::vector<std::shared_ptr<LogRing>> m_rings;
+
+    // 쓰기 스레드
+    std::thread m_writer;
+    std::mutex m_writerMutex;
+    std::condition_variable m_writerCondition;
+    std::condition_variable m_flushedCondition;
+    bool m_stopRequested = false;
+    uint64_t m_flushRequested = 0;
+    uint64_t m_flushCompleted = 0;
+
+    // 쓰기 스레드 전용
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    uint64_t m_fileSize = 0;
+    std::wstring m_lineBuffer;
+    std::string m_utf8Buffer;
+    std::vector<const LogRecord*> m_batch;
+    std::vector<LogRecord> m_batchStorage;
+
+    mutable std::mutex m_statsMutex;
+    LoggerStats m_stats;
+};
+
+#if MBD_LOG_MIN_LEVEL <= 0
+#define MBD_LOG_DEBUG(...) Logger::Instance().Log(LogLevel::Debug, __VA_ARGS__)
+#else
+#define MBD_LOG_DEBUG(...) ((void)0)
+#endif
+
+#if MBD_LOG_MIN_LEVEL <= 1
+#define MBD_LOG_INFO(...) Logger::Instance().Log(LogLevel::Info, __VA_ARGS__)
+#else
+#define MBD_LOG_INFO(...) ((void)0)
+#endif
+
+#if MBD_LOG_MIN_LEVEL <= 2
+#define MBD_LOG_WARNING(...) Logger::Instance().Log(LogLevel::Warning, __VA_ARGS__)
+#else
+#define MBD_LOG_WARNING(...) ((void)0)
+#endif
+
+#define MBD_LOG_ERROR(...) Logger::Instance().Log(LogLevel::Error, __VA_ARGS__)
@@ -0,0 +1,283 @@
+#include "MetadataIndex.h"
+#include <algorithm>
+#include <cwctype>
+
+namespace {
+
+const uint32_t kMetadataMagic = 0x494D424D; // "MBMI"
+const uint32_t kMetadataVersion = 1;
+
+struct MetadataIndexHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t recordCount;
+    uint64_t recordsOffset;
+    uint64_t poolOffset;
+    uint64_t poolSize;
+};
+
+// 파일에 그대로 저장되는 고정 크기 레코드
+struct MetadataRecord {
+    uint64_t pathOffset;       // 문자열 풀 기준 바이트 오프셋
+    uint64_t identityOffset;
+    int64_t fileSize;
+    uint64_t contentVersion;
+    uint32_t pathLength;       // 문자 수
+    uint32_t identityLength;   // 바이트 수
+    uint32_t syncState;
+    uint32_t reserved;
+    uint8_t contentHash[32];
+};
+
+static_assert(sizeof(MetadataIndexHeader) == 40, "MetadataIndexHeader layout");
+static_assert(sizeof(MetadataRecord) == 80, "MetadataRecord layout");
+
+HRESULT EnsureParentDirectory(const std::wstring& path) {
+    // 상위 폴더부터 차례로 생성
+    size_t last = path.find_last_of(L"\\/");
+    if (last == std::wstring::npos) {
+        return S_OK;
+    }
+    for (size_t separator = path.find_first_of(L"\\/", 3); separator != std::wstring::npos && separator <= last;
+         separator = path.find_first_of(L"\\/", separator + 1)) {
+        std::wstring partial = path.substr(0, separator);
+        if (!CreateDirectoryW(partial.c_str(), nullptr) && GetLastError() != ERROR_ALREADY_EXISTS) {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+    }
+    return S_OK;
+}
+
+size_t SkipLeadingSeparators(const wchar_t* path, size_t length) {
+    size_t start = 0;
+    while (start < length && (path[start] == L'\\' || path[start] == L'/')) {
+        start++;
+    }
+    return start;
+}
+
+} // namespace
+
+wchar_t NormalizeMetadataPathChar(wchar_t c) {
+    return c == L'/' ? L'\\' : static_cast<wchar_t>(towlower(c));
+}
+
+std::wstring NormalizeMetadataPath(const std::wstring& relativePath) {
+    size_t start = SkipLeadingSeparators(relativePath.c_str(), relativePath.size());
+    std::wstring normalized;
+    normalized.reserve(relativePath.size() - start);
+    for (size_t i = start; i < relativePath.size(); ++i) {
+        normalized.push_back(NormalizeMetadataPathChar(relativePath[i]));
+    }
+    return normalized;
+}
+
+MetadataIndex::~MetadataIndex() {
+    Close();
+}
+
+HRESULT MetadataIndex::Open(const std::wstring& path) {
+    Close();
+    
+    m_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+    
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(m_file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(MetadataIndexHeader))) {
+        Close();
+        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+    
+    m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping) {
+        m_view = static_cast<const BYTE*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (!m_view) {
+        HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
+        Close();
+        return hr;
+    }
+    m_size = static_cast<ULONGLONG>(fileSize.QuadPart);
+    
+    // 헤더와 영역 경계만 확인 (레코드는 조회할 때 확인)
+    const MetadataIndexHeader* header = reinterpret_cast<const MetadataIndexHeader*>(m_view);
+    if (header->magic != kMetadataMagic || header->version != kMetadataVersion ||
+        header->recordsOffset > m_size ||
+        header->recordCount > (m_size - header->recordsOffset) / sizeof(MetadataRecord) ||
+        header->poolOffset > m_size || header->poolSize > m_size - header->poolOffset) {
+        Close();
+        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+    
+    m_recordCount = static_cast<size_t>(header->recordCount);
+    m_recordsOffset = header->recordsOffset;
+    m_poolOffset = header->poolOffset;
+    m_poolSize = header->poolSize;
+    return S_OK;
+}
+
+void MetadataIndex::Close() {
+    if (m_view) {
+        UnmapViewOfFile(m_view);
+        m_view = nullptr;
+    }
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+    if (m_file != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+    }
+    m_size = 0;
+    m_recordCount = 0;
+}
+
+bool MetadataIndex::Find(const wchar_t* relativePath, size_t length, MetadataView& result) const {
+    if (!m_view) {
+        return false;
+    }
+    
+    size_t start = SkipLeadingSeparators(relativePath, length);
+    relativePath += start;
+    length -= start;
+    
+    // 정렬된 레코드에서 이진 탐색
+    size_t low = 0;
+    size_t high = m_recordCount;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        int order = CompareRecordPath(middle, relativePath, length);
+        if (order == 0) {
+            return ReadRecord(middle, result);
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return false;
+}
+
+int MetadataIndex::CompareRecordPath(size_t index, const wchar_t* relativePath, size_t length) const {
+    const MetadataRecord* record = reinterpret_cast<const MetadataRecord*>(m_view + m_recordsOffset) + index;
+    if (record->pathOffset > m_poolSize || record->pathLength > (m_poolSize - record->pathOffset) / sizeof(wchar_t)) {
+        return 1;  // 손상된 레코드는 찾지 못한 것으로 처리
+    }
+    
+    // 저장된 경로는 이미 정규화되어 있으므로 조회 경로만 문자 단위로 정규화하며 비교
+    const wchar_t* stored = reinterpret_cast<const wchar_t*>(m_view + m_poolOffset + record->pathOffset);
+    size_t common = (std::min)(static_cast<size_t>(record->pathLength), length);
+    for (size_t i = 0; i < common; ++i) {
+        wchar_t query = NormalizeMetadataPathChar(relativePath[i]);
+        if (stored[i] != query) {
+            return stored[i] < query ? -1 : 1;
+        }
+    }
+    if (record->pathLength == length) {
+        return 0;
+    }
+    return record->pathLength < length ? -1 : 1;
+}
+
+bool MetadataIndex::ReadRecord(size_t index, MetadataView& result) const {
+    const MetadataRecord* record = reinterpret_cast<const MetadataRecord*>(m_view + m_recordsOffset) + index;
+    if (record->identityOffset > m_poolSize || record->identityLength > m_poolSize - record->identityOffset) {
+        return false;
+    }
+    
+    result.relativePath = reinterpret_cast<const wchar_t*>(m_view + m_poolOffset + record->pathOffset);
+    result.relativePathLength = record->pathLength;
+    result.fileIdentity = m_view + m_poolOffset + record->identityOffset;
+    result.fileIdentityLength = record->identityLength;
+    result.fileSize = record->fileSize;
+    result.contentVersion = record->contentVersion;
+    result.contentHash = record->contentHash;
+    result.syncState = static_cast<MetadataSyncState>(record->syncState);
+    return true;
+}
+
+HRESULT MetadataIndex::Write(const std::wstring& path, std::vector<FileMetadata> entries) {
+    for (auto& entry : entries) {
+        entry.relativePath = NormalizeMetadataPath(entry.relativePath);
+    }
+    std::stable_sort(entries.begin(), entries.end(), [](const FileMetadata& a, const FileMetadata& b) {
+        return a.relativePath < b.relativePath;
+    });
+    // 같은 경로는 처음 항목만 유지
+    entries.erase(std::unique(entries.begin(), entries.end(), [](const FileMetadata& a, const FileMetadata& b) {
+        return a.relativePath == b.relativePath;
+    }), entries.end());
+    
+    MetadataIndexHeader header = {};
+    header.magic = kMetadataMagic;
+    header.version = kMetadataVersion;
+    header.recordCount = entries.size();
+    header.recordsOffset = sizeof(MetadataIndexHeader);
+    header.poolOffset = header.recordsOffset + entries.size() * sizeof(MetadataRecord);
+    
+    std::vector<MetadataRecord> records(entries.size());
+    std::vector<BYTE> pool;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const FileMetadata& entry = entries[i];
+        MetadataRecord& record = records[i];
+        memset(&record, 0, sizeof(record));
+        
+        record.pathOffset = pool.size();
+        record.pathLength = static_cast<uint32_t>(entry.relativePath.size());
+        const BYTE* pathBytes = reinterpret_cast<const BYTE*>(entry.relativePath.data());
+        pool.insert(pool.end(), pathBytes, pathBytes + entry.relativePath.size() * sizeof(wchar_t));
+        
+        record.identityOffset = pool.size();
+        record.identityLength = static_cast<uint32_t>(entry.fileIdentity.size());
+        pool.insert(pool.end(), entry.fileIdentity.begin(), entry.fileIdentity.end());
+        // 다음 경로가 wchar_t 경계에서 시작하도록 맞춤
+        pool.resize((pool.size() + sizeof(wchar_t) - 1) / sizeof(wchar_t) * sizeof(wchar_t));
+        
+        record.fileSize = entry.fileSize;
+        record.contentVersion = entry.contentVersion;
+        record.syncState = static_cast<uint32_t>(entry.syncState);
+        memcpy(record.contentHash, entry.contentHash.bytes, sizeof(record.contentHash));
+    }
+    header.poolSize = pool.size();
+    
+    HRESULT hr = EnsureParentDirectory(path);
+    if (FAILED(hr)) {
+        return hr;
+    }
+    
+    std::wstring tempPath = path + L".tmp";
+    HANDLE file = CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+    
+    auto writeAll = [&file, &hr](const void* data, size_t size) {
+        const BYTE* bytes = static_cast<const BYTE*>(data);
+        while (SUCCEEDED(hr) && size > 0) {
+            DWORD written = 0;
+            DWORD toWrite = static_cast<DWORD>((std::min)(size, static_cast<size_t>(MAXDWORD)));
+            if (!WriteFile(file, bytes, toWrite, &written, nullptr)) {
+                hr = HRESULT_FROM_WIN32(GetLastError());
+                break;
+            }
+            bytes += written;
+            size -= written;
+        }
+    };
+    writeAll(&header, sizeof(header));
+    writeAll(records.data(), records.size() * sizeof(MetadataRecord));
+    writeAll(pool.data(), pool.size());
+    CloseHandle(file);
+    
+    if (SUCCEEDED(hr) && !MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+    }
+    if (FAILED(hr)) {
+        DeleteFileW(tempPath.c_str());
+    }
+    return hr;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "ContentHash.h"
+
+// 로컬 동기화 상태 (Dart CloudFileSyncState와 같은 순서)
+enum class MetadataSyncState : uint32_t {
+    InSync = 0,
+    NotInSync = 1,
+    Excluded = 2
+};
+
+// 인덱스를 만들 때 넘기는 원격 파일 메타데이터
+struct FileMetadata {
+    std::wstring relativePath;
+    std::string fileIdentity;
+    LONGLONG fileSize = 0;
+    ULONGLONG contentVersion = 0;
+    ContentHash contentHash;
+    MetadataSyncState syncState = MetadataSyncState::NotInSync;
+};
+
+// 매핑된 인덱스 안을 가리키는 조회 결과 (인덱스가 열려 있는 동안만 유효)
+struct MetadataView {
+    const wchar_t* relativePath = nullptr;   // 정규화된 경로 (소문자, '\\' 구분자, NUL 종료 아님)
+    size_t relativePathLength = 0;
+    const BYTE* fileIdentity = nullptr;
+    size_t fileIdentityLength = 0;
+    LONGLONG fileSize = 0;
+    ULONGLONG contentVersion = 0;
+    const BYTE* contentHash = nullptr;       // 32바이트
+    MetadataSyncState syncState = MetadataSyncState::NotInSync;
+};
+
+// 상대 경로로 정렬된 메모리 맵 메타데이터 인덱스
+// 고정 크기 레코드 배열 + 문자열 풀 형식이라 파싱 없이 매핑만으로 열리고,
+// 콜백에서 이진 탐색으로 O(log n), 할당 없이 조회할 수 있음
+class MetadataIndex {
+public:
+    MetadataIndex() = default;
+    ~MetadataIndex();
+    
+    MetadataIndex(const MetadataIndex&) = delete;
+    MetadataIndex& operator=(const MetadataIndex&) = delete;
+    
+    HRESULT Open(const std::wstring& path);
+    void Close();
+    bool IsOpen() const { return m_view != nullptr; }
+    
+    bool Find(const wchar_t* relativePath, size_t length, MetadataView& result) const;
+    bool Find(const std::wstring& relativePath, MetadataView& result) const {
+        return Find(relativePath.c_str(), relativePath.size(), result);
+    }
+    
+    size_t Count() const { return m_recordCount; }
+    
+    // 항목을 정렬해 인덱스 파일로 저장 (임시 파일에 쓴 뒤 교체)
+    static HRESULT Write(const std::wstring& path, std::vector<FileMetadata> entries);
+
+private:
+    bool ReadRecord(size_t index, MetadataView& result) const;
+    int CompareRecordPath(size_t index, const wchar_t* relativePath, size_t length) const;
+    
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+    const BYTE* m_view = nullptr;
+    ULONGLONG m_size = 0;
+    size_t m_recordCount = 0;
+    ULONGLONG m_recordsOffset = 0;
+    ULONGLONG m_poolOffset = 0;
+    ULONGLONG m_poolSize = 0;
+};
+
+// 인덱스 키로 쓰는 경로 정규화 (소문자, '/' -> '\\', 앞쪽 구분자 제거)
+wchar_t NormalizeMetadataPathChar(wchar_t c);
+std::wstring NormalizeMetadataPath(const std::wstring& relativePath);
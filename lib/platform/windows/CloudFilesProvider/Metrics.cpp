@@ -0,0 +1,116 @@
+#include "Metrics.h"
+#include <algorithm>
+
+namespace {
+
+int HighestBit(uint64_t value) {
+    int bit = 0;
+    for (int shift = 32; shift > 0; shift >>= 1) {
+        if (value >> shift) {
+            value >>= shift;
+            bit += shift;
+        }
+    }
+    return bit;
+}
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram() {
+    Reset();
+}
+
+size_t LatencyHistogram::BucketIndex(uint64_t value) {
+    if (value < kSubBucketCount) {
+        return static_cast<size_t>(value);
+    }
+    int exponent = HighestBit(value);
+    if (exponent > kMaxExponent) {
+        return kBucketCount - 1;
+    }
+    size_t subBucket = static_cast<size_t>((value >> (exponent - kSubBucketBits)) & (kSubBucketCount - 1));
+    return kSubBucketCount + static_cast<size_t>(exponent - kSubBucketBits) * kSubBucketCount + subBucket;
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(size_t index) {
+    if (index < kSubBucketCount) {
+        return index;
+    }
+    int shift = static_cast<int>((index - kSubBucketCount) / kSubBucketCount);
+    uint64_t subBucket = (index - kSubBucketCount) % kSubBucketCount;
+    uint64_t lower = (kSubBucketCount + subBucket) << shift;
+    return lower + (uint64_t(1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(uint64_t nanoseconds) {
+    m_buckets[BucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+    uint64_t currentMax = m_max.load(std::memory_order_relaxed);
+    while (nanoseconds > currentMax && !m_max.compare_exchange_weak(currentMax, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+LatencySummary LatencyHistogram::Summarize() const {
+    // 버킷을 한 번 복사한 뒤 백분위를 계산 (기록 중인 값과 약간 어긋날 수 있음)
+    uint64_t counts[kBucketCount];
+    uint64_t total = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    LatencySummary summary;
+    summary.count = total;
+    summary.max = m_max.load(std::memory_order_relaxed);
+    if (total == 0) {
+        return summary;
+    }
+    summary.mean = m_sum.load(std::memory_order_relaxed) / total;
+
+    const double quantiles[] = { 0.50, 0.90, 0.99, 0.999 };
+    uint64_t* targets[] = { &summary.p50, &summary.p90, &summary.p99, &summary.p999 };
+    uint64_t cumulative = 0;
+    size_t next = 0;
+    for (size_t i = 0; i < kBucketCount && next < 4; ++i) {
+        cumulative += counts[i];
+        while (next < 4 && cumulative >= static_cast<uint64_t>(quantiles[next] * total + 0.5)) {
+            *targets[next++] = (std::min)(BucketUpperBound(i), summary.max);
+        }
+    }
+    return summary;
+}
+
+void LatencyHistogram::Reset() {
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::Record(MetricHistogram histogram, std::chrono::steady_clock::duration elapsed) {
+    auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    m_histograms[static_cast<size_t>(histogram)].Record(nanoseconds > 0 ? static_cast<uint64_t>(nanoseconds) : 0);
+}
+
+void MetricsRegistry::Add(MetricCounter counter, uint64_t value) {
+    m_counters[static_cast<size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+}
+
+LatencySummary MetricsRegistry::Summarize(MetricHistogram histogram) const {
+    return m_histograms[static_cast<size_t>(histogram)].Summarize();
+}
+
+uint64_t MetricsRegistry::Get(MetricCounter counter) const {
+    return m_counters[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+}
+
+void MetricsRegistry::Reset() {
+    for (auto& histogram : m_histograms) {
+        histogram.Reset();
+    }
+    for (auto& counter : m_counters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
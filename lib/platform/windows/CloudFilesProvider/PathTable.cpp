@@ -0,0 +1,208 @@
+#include "PathTable.h"
+#include <cwctype>
+#include <mutex>
+
+namespace {
+
+const size_t kInitialSlots = 1024;
+
+bool IsSeparator(wchar_t c) {
+    return c == L'\\' || c == L'/';
+}
+
+// position부터 다음 구성 요소를 찾음 (없으면 false)
+bool NextComponent(const wchar_t* path, size_t length, size_t& position, size_t& start, size_t& count) {
+    while (position < length && IsSeparator(path[position])) {
+        position++;
+    }
+    if (position >= length) {
+        return false;
+    }
+    start = position;
+    while (position < length && !IsSeparator(path[position])) {
+        position++;
+    }
+    count = position - start;
+    return true;
+}
+
+} // namespace
+
+PathTable::PathTable() {
+    // 루트 노드 (이름 없음)
+    m_nodes.push_back(Node{ kInvalidPathId, 0, 0, 0 });
+    m_slots.assign(kInitialSlots, kInvalidPathId);
+}
+
+uint32_t PathTable::HashComponent(PathId parent, const wchar_t* name, size_t length) {
+    // FNV-1a (부모 ID와 소문자로 바꾼 이름)
+    uint32_t hash = 2166136261u;
+    for (int shift = 0; shift < 32; shift += 8) {
+        hash = (hash ^ ((parent >> shift) & 0xFF)) * 16777619u;
+    }
+    for (size_t i = 0; i < length; ++i) {
+        uint32_t c = static_cast<uint32_t>(towlower(name[i]));
+        hash = (hash ^ (c & 0xFF)) * 16777619u;
+        hash = (hash ^ (c >> 8)) * 16777619u;
+    }
+    return hash;
+}
+
+bool PathTable::NameEquals(const Node& node, const wchar_t* name, size_t length) const {
+    if (node.nameLength != length) {
+        return false;
+    }
+    const wchar_t* stored = m_names.data() + node.nameOffset;
+    for (size_t i = 0; i < length; ++i) {
+        if (stored[i] != name[i] && towlower(stored[i]) != towlower(name[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+PathId PathTable::FindChildLocked(PathId parent, const wchar_t* name, size_t length, uint32_t hash) const {
+    size_t mask = m_slots.size() - 1;
+    for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+        PathId id = m_slots[slot];
+        if (id == kInvalidPathId) {
+            return kInvalidPathId;
+        }
+        const Node& node = m_nodes[id];
+        if (node.hash == hash && node.parent == parent && NameEquals(node, name, length)) {
+            return id;
+        }
+    }
+}
+
+PathId PathTable::AddChildLocked(PathId parent, const wchar_t* name, size_t length, uint32_t hash) {
+    // 채움률을 1/2 이하로 유지
+    if ((m_nodes.size() + 1) * 2 > m_slots.size()) {
+        GrowSlotsLocked();
+    }
+
+    PathId id = static_cast<PathId>(m_nodes.size());
+    m_nodes.push_back(Node{ parent, static_cast<uint32_t>(m_names.size()), static_cast<uint32_t>(length), hash });
+    m_names.insert(m_names.end(), name, name + length);
+
+    size_t mask = m_slots.size() - 1;
+    size_t slot = hash & mask;
+    while (m_slots[slot] != kInvalidPathId) {
+        slot = (slot + 1) & mask;
+    }
+    m_slots[slot] = id;
+    return id;
+}
+
+void PathTable::GrowSlotsLocked() {
+    std::vector<PathId> slots(m_slots.size() * 2, kInvalidPathId);
+    size_t mask = slots.size() - 1;
+    for (PathId id = 1; id < m_nodes.size(); ++id) {
+        size_t slot = m_nodes[id].hash & mask;
+        while (slots[slot] != kInvalidPathId) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = id;
+    }
+    m_slots.swap(slots);
+}
+
+PathId PathTable::Intern(const wchar_t* path, size_t length) {
+    PathId current = kRootPathId;
+    size_t position = 0;
+    size_t start = 0;
+    size_t count = 0;
+
+    // 대부분 이미 등록된 경로이므로 공유 잠금으로 먼저 따라감
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        size_t resume = position;
+        while (NextComponent(path, length, position, start, count)) {
+            PathId child = FindChildLocked(current, path + start, count, HashComponent(current, path + start, count));
+            if (child == kInvalidPathId) {
+                position = resume;
+                break;
+            }
+            current = child;
+            resume = position;
+        }
+        if (position >= length) {
+            return current;
+        }
+    }
+
+    // 찾은 접두사 다음부터 배타 잠금으로 추가 (그 사이 다른 스레드가 추가했을 수 있으므로 다시 찾음)
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    while (NextComponent(path, length, position, start, count)) {
+        uint32_t hash = HashComponent(current, path + start, count);
+        PathId child = FindChildLocked(current, path + start, count, hash);
+        current = child != kInvalidPathId ? child : AddChildLocked(current, path + start, count, hash);
+    }
+    return current;
+}
+
+PathId PathTable::Find(const wchar_t* path, size_t length) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    PathId current = kRootPathId;
+    size_t position = 0;
+    size_t start = 0;
+    size_t count = 0;
+    while (NextComponent(path, length, position, start, count)) {
+        current = FindChildLocked(current, path + start, count, HashComponent(current, path + start, count));
+        if (current == kInvalidPathId) {
+            break;
+        }
+    }
+    return current;
+}
+
+PathId PathTable::Parent(PathId id) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return id < m_nodes.size() ? m_nodes[id].parent : kInvalidPathId;
+}
+
+void PathTable::AppendPath(PathId id, std::wstring& out) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    if (id == kRootPathId || id >= m_nodes.size()) {
+        return;
+    }
+
+    // 길이를 먼저 구하고 끝에서부터 채움 (재할당 한 번)
+    size_t total = 0;
+    for (PathId node = id; node != kRootPathId; node = m_nodes[node].parent) {
+        total += m_nodes[node].nameLength + 1;
+    }
+    total--;
+
+    size_t base = out.size();
+    out.resize(base + total);
+    size_t end = base + total;
+    for (PathId node = id; node != kRootPathId; node = m_nodes[node].parent) {
+        const Node& entry = m_nodes[node];
+        end -= entry.nameLength;
+        out.replace(end, entry.nameLength, m_names.data() + entry.nameOffset, entry.nameLength);
+        if (end > base) {
+            out[--end] = L'\\';
+        }
+    }
+}
+
+std::wstring PathTable::GetPath(PathId id) const {
+    std::wstring path;
+    AppendPath(id, path);
+    return path;
+}
+
+std::wstring PathTable::GetFullPath(const std::wstring& root, PathId id) const {
+    std::wstring fullPath = root;
+    if (id != kRootPathId) {
+        fullPath += L'\\';
+        AppendPath(id, fullPath);
+    }
+    return fullPath;
+}
+
+size_t PathTable::Size() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_nodes.size();
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <windows.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <shared_mutex>
+
+// 동기화 루트 기준 상대 경로의 32비트 ID
+using PathId = uint32_t;
+
+const PathId kRootPathId = 0;                 // 동기화 루트 자체 (빈 경로)
+const PathId kInvalidPathId = 0xFFFFFFFF;
+
+// 경로 구성 요소를 (부모 ID, 이름) 단위로 한 번만 저장하는 인터닝 테이블
+// 같은 폴더 아래 파일들은 부모 노드를 공유하므로 접두사가 중복 저장되지 않고,
+// 콜백에서는 힙 문자열 대신 ID를 넘기다가 Win32 호출이 필요할 때만 전체 경로를 만듦
+// 비교는 대소문자와 구분자('\\', '/')를 구분하지 않으며 이름은 처음 등록된 표기로 보관함
+// 노드는 지워지지 않음 (ID는 프로세스 수명 동안 유효)
+class PathTable {
+public:
+    PathTable();
+
+    PathTable(const PathTable&) = delete;
+    PathTable& operator=(const PathTable&) = delete;
+
+    // 경로를 ID로 변환 (처음 보는 구성 요소만 추가, 이미 있으면 할당 없음)
+    PathId Intern(const wchar_t* path, size_t length);
+    PathId Intern(const std::wstring& path) { return Intern(path.c_str(), path.size()); }
+
+    // 등록된 경로만 찾음 (없으면 kInvalidPathId)
+    PathId Find(const wchar_t* path, size_t length) const;
+    PathId Find(const std::wstring& path) const { return Find(path.c_str(), path.size()); }
+
+    PathId Parent(PathId id) const;
+
+    // 상대 경로를 out 뒤에 붙임 (루트는 아무것도 붙이지 않음)
+    void AppendPath(PathId id, std::wstring& out) const;
+    std::wstring GetPath(PathId id) const;
+
+    // root + '\\' + 상대 경로 (Win32 호출용)
+    std::wstring GetFullPath(const std::wstring& root, PathId id) const;
+
+    size_t Size() const;
+
+private:
+    struct Node {
+        PathId parent;
+        uint32_t nameOffset;   // m_names 기준 문자 오프셋
+        uint32_t nameLength;
+        uint32_t hash;
+    };
+
+    static uint32_t HashComponent(PathId parent, const wchar_t* name, size_t length);
+    bool NameEquals(const Node& node, const wchar_t* name, size_t length) const;
+    PathId FindChildLocked(PathId parent, const wchar_t* name, size_t length, uint32_t hash) const;
+    PathId AddChildLocked(PathId parent, const wchar_t* name, size_t length, uint32_t hash);
+    void GrowSlotsLocked();
+
+    mutable std::shared_mutex m_mutex;
+    std::vector<Node> m_nodes;         // ID가 인덱스
+    std::vector<wchar_t> m_names;      // 구성 요소 이름을 이어 붙인 풀
+    std::vector<PathId> m_slots;       // (부모, 이름) 해시의 열린 주소 테이블
+};
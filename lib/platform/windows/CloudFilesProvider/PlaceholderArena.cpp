@@ -0,0 +1,57 @@
+#include "PlaceholderArena.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+PlaceholderArena::PlaceholderArena(size_t blockSize)
+    : m_blockSize(blockSize) {
+}
+
+void* PlaceholderArena::Allocate(size_t size, size_t alignment) {
+    if (!m_blocks.empty()) {
+        Block& block = m_blocks.back();
+        uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        size_t aligned = static_cast<size_t>(((base + m_used + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1)) - base);
+        if (aligned + size <= block.size) {
+            m_used = aligned + size;
+            return block.data.get() + aligned;
+        }
+    }
+    
+    // 새 블록 (큰 요청은 요청 크기만큼 한 블록으로)
+    Block block;
+    block.size = (std::max)(m_blockSize, size + alignment);
+    block.data.reset(new (std::nothrow) BYTE[block.size]);
+    if (!block.data) {
+        return nullptr;
+    }
+    m_reserved += block.size;
+    m_blocks.push_back(std::move(block));
+    m_used = 0;
+    return Allocate(size, alignment);
+}
+
+LPCWSTR PlaceholderArena::CopyString(const std::wstring& value) {
+    size_t bytes = (value.length() + 1) * sizeof(WCHAR);
+    WCHAR* copy = static_cast<WCHAR*>(Allocate(bytes, alignof(WCHAR)));
+    if (copy) {
+        memcpy(copy, value.c_str(), bytes);
+    }
+    return copy;
+}
+
+const void* PlaceholderArena::CopyBytes(const void* data, size_t size) {
+    void* copy = Allocate((std::max)(size, static_cast<size_t>(1)), 1);
+    if (copy && size > 0) {
+        memcpy(copy, data, size);
+    }
+    return copy;
+}
+
+void PlaceholderArena::Reset() {
+    if (m_blocks.size() > 1) {
+        m_blocks.erase(m_blocks.begin() + 1, m_blocks.end());
+        m_reserved = m_blocks.front().size;
+    }
+    m_used = 0;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include <vector>
+#include <memory>
+
+// 플레이스홀더 배치 하나를 만드는 동안 쓰는 단조 증가 arena
+// 이름, 파일 ID, 생성 정보 배열을 연속된 블록에 담고 배치가 끝나면 한 번에 해제
+class PlaceholderArena {
+public:
+    explicit PlaceholderArena(size_t blockSize = 64 * 1024);
+    
+    PlaceholderArena(const PlaceholderArena&) = delete;
+    PlaceholderArena& operator=(const PlaceholderArena&) = delete;
+    
+    // 실패하면 nullptr
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    
+    template <typename T>
+    T* AllocateArray(size_t count) {
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+    
+    LPCWSTR CopyString(const std::wstring& value);
+    const void* CopyBytes(const void* data, size_t size);
+    
+    // 할당한 메모리를 모두 해제 (첫 블록은 재사용을 위해 유지)
+    void Reset();
+    
+    size_t BytesReserved() const { return m_reserved; }
+
+private:
+    struct Block {
+        std::unique_ptr<BYTE[]> data;
+        size_t size = 0;
+    };
+    
+    size_t m_blockSize;
+    std::vector<Block> m_blocks;
+    size_t m_used = 0;       // 마지막 블록에서 사용한 바이트
+    size_t m_reserved = 0;
+};
@@ -0,0 +1,100 @@
+#include "PlaceholderIdentity.h"
+#include "ContentHash.h"
+#include "MetadataIndex.h"
+#include <cstring>
+
+namespace {
+
+const BYTE kIdentityFormat = 1;
+
+// 저장 형식 (리틀 엔디언 고정 배치)
+#pragma pack(push, 1)
+struct PlaceholderIdentityBlob {
+    BYTE format;
+    BYTE reserved[7];
+    BYTE objectId[16];
+    ULONGLONG contentVersion;
+    BYTE manifestId[16];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(PlaceholderIdentityBlob) == kPlaceholderIdentitySize, "PlaceholderIdentityBlob layout");
+
+} // namespace
+
+bool PlaceholderIdentity::HasObjectId() const {
+    static const BYTE empty[sizeof(objectId)] = {};
+    return memcmp(objectId, empty, sizeof(objectId)) != 0;
+}
+
+bool PlaceholderIdentity::HasManifestId() const {
+    static const BYTE empty[sizeof(manifestId)] = {};
+    return memcmp(manifestId, empty, sizeof(manifestId)) != 0;
+}
+
+std::string PlaceholderIdentity::CacheKey() const {
+    return std::string(reinterpret_cast<const char*>(objectId), sizeof(objectId));
+}
+
+std::wstring PlaceholderIdentity::ObjectIdHex() const {
+    static const wchar_t digits[] = L"0123456789abcdef";
+    std::wstring hex;
+    hex.reserve(sizeof(objectId) * 2);
+    for (BYTE value : objectId) {
+        hex.push_back(digits[value >> 4]);
+        hex.push_back(digits[value & 0x0F]);
+    }
+    return hex;
+}
+
+std::string PlaceholderIdentity::Serialize() const {
+    std::string data(sizeof(PlaceholderIdentityBlob), '\0');
+    SerializeTo(reinterpret_cast<BYTE*>(&data[0]));
+    return data;
+}
+
+void PlaceholderIdentity::SerializeTo(BYTE* buffer) const {
+    PlaceholderIdentityBlob blob = {};
+    blob.format = kIdentityFormat;
+    memcpy(blob.objectId, objectId, sizeof(blob.objectId));
+    blob.contentVersion = contentVersion;
+    memcpy(blob.manifestId, manifestId, sizeof(blob.manifestId));
+    memcpy(buffer, &blob, sizeof(blob));
+}
+
+bool PlaceholderIdentity::Parse(const void* data, size_t length, PlaceholderIdentity& identity) {
+    // 이전 형식 (경로 해시 8바이트) 플레이스홀더는 false
+    if (!data || length != sizeof(PlaceholderIdentityBlob)) {
+        return false;
+    }
+    
+    PlaceholderIdentityBlob blob;
+    memcpy(&blob, data, sizeof(blob));
+    if (blob.format != kIdentityFormat) {
+        return false;
+    }
+    
+    memcpy(identity.objectId, blob.objectId, sizeof(identity.objectId));
+    identity.contentVersion = blob.contentVersion;
+    memcpy(identity.manifestId, blob.manifestId, sizeof(identity.manifestId));
+    return true;
+}
+
+PlaceholderIdentity PlaceholderIdentity::FromPath(const std::wstring& relativePath) {
+    PlaceholderIdentity identity;
+    std::wstring normalized = NormalizeMetadataPath(relativePath);
+    
+    // UTF-16LE 바이트로 해시 (wchar_t 크기와 무관하게 앱 쪽 계산과 같은 값)
+    std::string bytes;
+    bytes.reserve(normalized.size() * 2);
+    for (wchar_t c : normalized) {
+        bytes.push_back(static_cast<char>(c & 0xFF));
+        bytes.push_back(static_cast<char>((c >> 8) & 0xFF));
+    }
+    
+    ContentHash hash;
+    if (SUCCEEDED(ComputeContentHash(reinterpret_cast<const BYTE*>(bytes.data()), bytes.size(), hash))) {
+        memcpy(identity.objectId, hash.bytes, sizeof(identity.objectId));
+    }
+    return identity;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include <cstdint>
+
+// 블롭 크기 (cfapi FileIdentity 최대 4KB보다 충분히 작음)
+constexpr size_t kPlaceholderIdentitySize = 48;
+
+// 플레이스홀더 FileIdentity에 저장하는 구조화된 식별자
+// 경로가 아닌 클라우드 객체 ID를 담으므로 이름을 바꿔도 같은 객체로 인식되고,
+// 콜백이 경로 조회 없이 정확한 객체와 버전을 찾을 수 있음
+struct PlaceholderIdentity {
+    BYTE objectId[16] = {};        // 클라우드 객체 ID (128비트)
+    ULONGLONG contentVersion = 0;  // 원격 콘텐츠 버전
+    BYTE manifestId[16] = {};      // 블록 매니페스트 ID (없으면 0)
+    
+    bool HasObjectId() const;
+    bool HasManifestId() const;
+    
+    // 블록 캐시 키 (객체 ID 바이트, 버전은 BlockKey.version에 따로 저장)
+    std::string CacheKey() const;
+    std::wstring ObjectIdHex() const;
+    
+    // FileIdentity 바이트 형식으로 변환 / 해석 (형식이 다르면 false)
+    std::string Serialize() const;
+    void SerializeTo(BYTE* buffer) const;  // kPlaceholderIdentitySize 바이트
+    static bool Parse(const void* data, size_t length, PlaceholderIdentity& identity);
+    
+    // 객체 ID가 없는 항목용: 정규화된 경로의 SHA-256 앞 128비트 (이름을 바꾸면 달라짐)
+    static PlaceholderIdentity FromPath(const std::wstring& relativePath);
+};
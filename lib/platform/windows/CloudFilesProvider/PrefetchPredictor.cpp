@@ -0,0 +1,300 @@
+#include "PrefetchPredictor.h"
+#include <algorithm>
+
+namespace {
+
+const size_t kMaxSuccessorsPerFile = 16;
+const size_t kMaxSequentialStates = 4096;
+const std::chrono::seconds kExpirySweepInterval{ 30 };  // 열기 이벤트가 없어도 빗나간 예측을 정리하는 주기
+
+} // namespace
+
+PrefetchPredictor::PrefetchPredictor(const PrefetchConfig& config, PrefetchAction prefetch, SiblingLister listSiblings,
+                                     FileSizer fileSizer)
+    : m_config(config),
+      m_prefetch(std::move(prefetch)),
+      m_listSiblings(std::move(listSiblings)),
+      m_fileSizer(std::move(fileSizer)) {
+}
+
+PrefetchPredictor::~PrefetchPredictor() {
+    Stop();
+}
+
+void PrefetchPredictor::Start() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_running) {
+        return;
+    }
+    m_running = true;
+    m_worker = std::thread([this]() { WorkerLoop(); });
+}
+
+void PrefetchPredictor::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            return;
+        }
+        m_running = false;
+        m_openedEvents.clear();
+        m_prefetchQueue.clear();
+    }
+    m_condition.notify_all();
+    
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+}
+
+void PrefetchPredictor::OnFileOpened(const std::wstring& relativePath, DWORD processId) {
+    if (processId != 0 && processId == GetCurrentProcessId()) {
+        return; // 미리 가져오기(또는 provider 자신)가 연 파일
+    }
+    
+    auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.opens++;
+        ExpirePrefetchedLocked(now);
+        
+        if (m_queuedOrActive.count(relativePath)) {
+            if (relativePath == m_activePrefetch) {
+                // 하이드레이션 중인 파일: 사용자 요청이 진행 중인 다운로드에 합류하므로 적중
+                m_stats.hits++;
+                m_activeOpened = true;
+            } else {
+                // 큐에서 기다리던 파일: 사용자 요청이 포그라운드로 가져가므로 큐에서 뺌
+                m_prefetchQueue.erase(std::remove(m_prefetchQueue.begin(), m_prefetchQueue.end(), relativePath),
+                                      m_prefetchQueue.end());
+                m_queuedOrActive.erase(relativePath);
+                m_stats.promoted++;
+            }
+        }
+        
+        auto prefetched = m_prefetched.find(relativePath);
+        if (prefetched != m_prefetched.end()) {
+            m_stats.hits++;
+            m_prefetched.erase(prefetched);
+        }
+        
+        // 직전에 열린 파일 다음에 이 파일이 열렸다는 것을 학습
+        if (!m_lastOpened.empty() && m_lastOpened != relativePath && now - m_lastOpenedAt <= m_config.successorWindow) {
+            LearnSuccessorLocked(m_lastOpened, relativePath);
+        }
+        m_lastOpened = relativePath;
+        m_lastOpenedAt = now;
+        
+        m_openFiles.insert(relativePath);
+        m_openedEvents.push_back(relativePath);
+    }
+    m_condition.notify_one();
+}
+
+void PrefetchPredictor::OnFileClosed(const std::wstring& relativePath, PathId pathId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_openFiles.erase(relativePath);
+    m_sequential.erase(pathId);
+}
+
+LONGLONG PrefetchPredictor::OnFetchRange(PathId pathId, LONGLONG offset, LONGLONG length) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_sequential.size() >= kMaxSequentialStates && !m_sequential.count(pathId)) {
+        m_sequential.clear();
+    }
+    
+    // 이전 요청이 끝난 곳 근처에서 이어지면 순차 읽기로 보고 미리 읽기 크기를 두 배씩 늘림
+    SequentialState& state = m_sequential[pathId];
+    bool sequential = state.requestEnd > 0 && offset >= state.requestEnd && 
+                      offset <= state.nextOffset + m_config.initialReadAhead;
+    if (sequential) {
+        state.readAhead = state.readAhead > 0 ? (std::min)(state.readAhead * 2, m_config.maxReadAhead) 
+                                              : m_config.initialReadAhead;
+        m_stats.sequentialReads++;
+    } else {
+        state.readAhead = 0;
+    }
+    state.requestEnd = offset + length;
+    state.nextOffset = state.requestEnd + state.readAhead;
+    return state.readAhead;
+}
+
+PrefetchStats PrefetchPredictor::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    PrefetchStats stats = m_stats;
+    stats.learnedFiles = m_successors.size();
+    uint64_t resolved = stats.hits + stats.misses;
+    stats.hitRate = resolved > 0 ? static_cast<double>(stats.hits) / resolved : 0.0;
+    return stats;
+}
+
+void PrefetchPredictor::WorkerLoop() {
+    // 미리 가져오기는 사용자 I/O를 방해하지 않도록 백그라운드 모드로 실행
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+    
+    // 열기가 한동안 없어도 빗나간 예측이 집계되도록 주기적으로 깨어남
+    const auto sweepInterval = (std::min)(std::chrono::duration_cast<std::chrono::steady_clock::duration>(m_config.prefetchTtl),
+                                          std::chrono::duration_cast<std::chrono::steady_clock::duration>(kExpirySweepInterval));
+    
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        bool woken = m_condition.wait_for(lock, sweepInterval, [this] {
+            return !m_running || !m_openedEvents.empty() || !m_prefetchQueue.empty();
+        });
+        if (!m_running) {
+            break;
+        }
+        if (!woken) {
+            ExpirePrefetchedLocked(std::chrono::steady_clock::now());
+            continue;
+        }
+        
+        // 열기 이벤트를 먼저 처리해 예측 후보를 큐에 넣음
+        if (!m_openedEvents.empty()) {
+            std::wstring opened = std::move(m_openedEvents.front());
+            m_openedEvents.pop_front();
+            lock.unlock();
+            std::vector<std::wstring> candidates = Predict(opened);
+            lock.lock();
+            
+            for (const auto& candidate : candidates) {
+                if (m_queuedOrActive.count(candidate) || m_openFiles.count(candidate) || m_prefetched.count(candidate)) {
+                    continue;
+                }
+                m_stats.predictions++;
+                if (m_prefetchQueue.size() >= m_config.maxQueuedPrefetches) {
+                    m_stats.dropped++;
+                    continue;
+                }
+                m_prefetchQueue.push_back(candidate);
+                m_queuedOrActive.insert(candidate);
+            }
+            continue;
+        }
+        
+        std::wstring path = std::move(m_prefetchQueue.front());
+        m_prefetchQueue.pop_front();
+        m_activePrefetch = path;
+        m_activeOpened = false;
+        m_stats.issued++;
+        lock.unlock();
+        
+        HRESULT hr = m_prefetch(path);
+        
+        lock.lock();
+        m_activePrefetch.clear();
+        m_queuedOrActive.erase(path);
+        auto now = std::chrono::steady_clock::now();
+        if (SUCCEEDED(hr)) {
+            if (!m_activeOpened) {
+                m_prefetched[path] = now;
+            }
+        } else {
+            m_stats.failed++;
+        }
+        ExpirePrefetchedLocked(now);
+    }
+    
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+}
+
+std::vector<std::wstring> PrefetchPredictor::Predict(const std::wstring& relativePath) {
+    std::vector<std::wstring> candidates;
+    ULONGLONG budget = m_config.maxPrefetchBytesPerOpen;
+    
+    // 개수 한도와 바이트 한도 안에 드는 후보만 추가 (큰 파일을 건너뛰면 다음 후보를 계속 확인)
+    auto consider = [&](const std::wstring& candidate) {
+        if (candidate == relativePath || std::find(candidates.begin(), candidates.end(), candidate) != candidates.end()) {
+            return;
+        }
+        if (m_fileSizer) {
+            LONGLONG size = m_fileSizer(candidate);
+            if (size < 0 || static_cast<ULONGLONG>(size) > budget) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stats.overBudget++;
+                return;
+            }
+            budget -= static_cast<ULONGLONG>(size);
+        }
+        candidates.push_back(candidate);
+    };
+    
+    // 1. 학습된 연관 파일 (자주 이어서 열린 순서대로)
+    std::vector<std::pair<std::wstring, uint32_t>> ranked;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto found = m_successors.find(relativePath);
+        if (found != m_successors.end()) {
+            ranked.assign(found->second.counts.begin(), found->second.counts.end());
+            m_successorLru.splice(m_successorLru.begin(), m_successorLru, found->second.lruPosition);
+        }
+    }
+    std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+    for (const auto& entry : ranked) {
+        if (candidates.size() >= m_config.maxPrefetchPerOpen) {
+            break;
+        }
+        consider(entry.first);
+    }
+    
+    // 2. 같은 Tracks 폴더의 형제 스템 (이름 순서상 다음 파일들, 마지막 파일 뒤에서 처음으로 돌아가지 않음)
+    std::wstring parent = ParentOf(relativePath);
+    bool siblingFolder = std::find(m_config.siblingFolders.begin(), m_config.siblingFolders.end(), NameOf(parent)) 
+                         != m_config.siblingFolders.end();
+    if (candidates.size() < m_config.maxPrefetchPerOpen && siblingFolder && m_listSiblings) {
+        std::vector<std::wstring> siblings = m_listSiblings(parent);
+        std::sort(siblings.begin(), siblings.end());
+        
+        for (auto sibling = std::upper_bound(siblings.begin(), siblings.end(), relativePath);
+             sibling != siblings.end() && candidates.size() < m_config.maxPrefetchPerOpen; ++sibling) {
+            consider(*sibling);
+        }
+    }
+    
+    return candidates;
+}
+
+void PrefetchPredictor::LearnSuccessorLocked(const std::wstring& previous, const std::wstring& next) {
+    auto found = m_successors.find(previous);
+    if (found == m_successors.end()) {
+        // 기억하는 파일 수가 한도를 넘으면 가장 오래 쓰이지 않은 파일의 학습을 잊음
+        if (m_successors.size() >= m_config.maxLearnedFiles && !m_successorLru.empty()) {
+            m_successors.erase(m_successorLru.back());
+            m_successorLru.pop_back();
+        }
+        m_successorLru.push_front(previous);
+        found = m_successors.emplace(previous, Successors()).first;
+        found->second.lruPosition = m_successorLru.begin();
+    } else {
+        m_successorLru.splice(m_successorLru.begin(), m_successorLru, found->second.lruPosition);
+    }
+    
+    auto& counts = found->second.counts;
+    counts[next]++;
+    if (counts.size() > kMaxSuccessorsPerFile) {
+        auto weakest = std::min_element(counts.begin(), counts.end(),
+            [](const auto& a, const auto& b) { return a.second < b.second; });
+        counts.erase(weakest);
+    }
+}
+
+void PrefetchPredictor::ExpirePrefetchedLocked(std::chrono::steady_clock::time_point now) {
+    for (auto it = m_prefetched.begin(); it != m_prefetched.end(); ) {
+        if (now - it->second > m_config.prefetchTtl) {
+            m_stats.misses++;
+            it = m_prefetched.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::wstring PrefetchPredictor::ParentOf(const std::wstring& path) {
+    size_t separator = path.find_last_of(L"\\/");
+    return separator == std::wstring::npos ? std::wstring() : path.substr(0, separator);
+}
+
+std::wstring PrefetchPredictor::NameOf(const std::wstring& path) {
+    size_t separator = path.find_last_of(L"\\/");
+    return separator == std::wstring::npos ? path : path.substr(separator + 1);
+}
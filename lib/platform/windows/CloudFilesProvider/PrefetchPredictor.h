@@ -0,0 +1,120 @@
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#include "PathTable.h"
+
+// 미리 가져오기 설정
+struct PrefetchConfig {
+    bool enabled = true;
+    size_t maxPrefetchPerOpen = 4;                            // 파일 하나를 열 때 미리 가져올 최대 파일 수
+    ULONGLONG maxPrefetchBytesPerOpen = 512ULL * 1024 * 1024; // 파일 하나를 열 때 미리 가져올 최대 바이트 수
+    size_t maxQueuedPrefetches = 64;
+    size_t maxLearnedFiles = 4096;                            // 연관 파일을 기억할 파일 수 (넘으면 오래 안 쓴 것부터 잊음)
+    std::chrono::seconds successorWindow{ 30 };               // 이 시간 안에 연달아 열린 파일을 연관 파일로 학습
+    std::chrono::milliseconds prefetchTtl{ std::chrono::minutes(10) };  // 이 시간 안에 열리지 않으면 빗나간 예측
+    std::vector<std::wstring> siblingFolders = { L"Tracks" }; // 형제 파일을 함께 가져올 폴더
+    LONGLONG initialReadAhead = 1024 * 1024;                  // 순차 읽기 감지 시 첫 미리 읽기 크기
+    LONGLONG maxReadAhead = 64 * 1024 * 1024;
+};
+
+struct PrefetchStats {
+    uint64_t opens = 0;
+    uint64_t predictions = 0;        // 예측된 후보 수
+    uint64_t issued = 0;             // 실제로 하이드레이션을 시작한 수
+    uint64_t failed = 0;
+    uint64_t dropped = 0;            // 큐가 가득 차서 버린 예측
+    uint64_t overBudget = 0;         // 바이트 한도를 넘거나 크기를 알 수 없어 건너뛴 후보
+    uint64_t promoted = 0;           // 큐에서 기다리던 중 사용자가 열어 포그라운드로 넘어간 파일
+    uint64_t hits = 0;               // 미리 가져온 뒤 실제로 열린 파일
+    uint64_t misses = 0;             // TTL 안에 열리지 않은 파일
+    uint64_t sequentialReads = 0;    // 순차 읽기로 판단된 FETCH_DATA
+    size_t learnedFiles = 0;         // 연관 파일을 기억하고 있는 파일 수
+    double hitRate = 0.0;
+};
+
+// 파일 열기/닫기와 FETCH_DATA 범위를 관찰해 다음에 쓰일 파일과 범위를 예측하는 엔진
+// 예측된 파일은 자체 백그라운드 스레드에서 낮은 우선순위로 하이드레이션함
+class PrefetchPredictor {
+public:
+    using PrefetchAction = std::function<HRESULT(const std::wstring& relativePath)>;
+    using SiblingLister = std::function<std::vector<std::wstring>(const std::wstring& relativeDirectory)>;
+    using FileSizer = std::function<LONGLONG(const std::wstring& relativePath)>;  // 알 수 없으면 음수
+    
+    // fileSizer가 없으면 바이트 한도를 적용하지 않음
+    PrefetchPredictor(const PrefetchConfig& config, PrefetchAction prefetch, SiblingLister listSiblings,
+                      FileSizer fileSizer = nullptr);
+    ~PrefetchPredictor();
+    PrefetchPredictor(const PrefetchPredictor&) = delete;
+    PrefetchPredictor& operator=(const PrefetchPredictor&) = delete;
+    
+    void Start();
+    void Stop();
+    
+    // 콜백 스레드에서 호출 (가볍게 기록만 함)
+    // processId가 이 프로세스면 미리 가져오기가 연 것이므로 학습하지 않음 (0이면 알 수 없음)
+    void OnFileOpened(const std::wstring& relativePath, DWORD processId = 0);
+    void OnFileClosed(const std::wstring& relativePath, PathId pathId);
+    
+    // FETCH_DATA 범위를 기록하고 순차 읽기면 미리 읽을 바이트 수를 반환
+    LONGLONG OnFetchRange(PathId pathId, LONGLONG offset, LONGLONG length);
+    
+    PrefetchStats GetStats() const;
+
+private:
+    struct SequentialState {
+        LONGLONG requestEnd = 0;   // 이전 요청 범위의 끝
+        LONGLONG nextOffset = 0;   // 미리 읽기까지 포함한 끝
+        LONGLONG readAhead = 0;
+    };
+    
+    struct Successors {
+        std::unordered_map<std::wstring, uint32_t> counts;
+        std::list<std::wstring>::iterator lruPosition;
+    };
+    
+    void WorkerLoop();
+    std::vector<std::wstring> Predict(const std::wstring& relativePath);
+    void LearnSuccessorLocked(const std::wstring& previous, const std::wstring& next);
+    void ExpirePrefetchedLocked(std::chrono::steady_clock::time_point now);
+    static std::wstring ParentOf(const std::wstring& path);
+    static std::wstring NameOf(const std::wstring& path);
+    
+    PrefetchConfig m_config;
+    PrefetchAction m_prefetch;
+    SiblingLister m_listSiblings;
+    FileSizer m_fileSizer;
+    
+    std::thread m_worker;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_running = false;
+    
+    std::deque<std::wstring> m_openedEvents;     // 워커가 예측할 열기 이벤트
+    std::deque<std::wstring> m_prefetchQueue;
+    std::unordered_set<std::wstring> m_queuedOrActive;
+    std::wstring m_activePrefetch;               // 워커가 지금 하이드레이션 중인 파일
+    bool m_activeOpened = false;                 // 하이드레이션 도중 사용자가 열었음 (이미 적중으로 집계)
+    std::unordered_set<std::wstring> m_openFiles;
+    
+    // 학습 상태
+    std::wstring m_lastOpened;
+    std::chrono::steady_clock::time_point m_lastOpenedAt;
+    std::unordered_map<std::wstring, Successors> m_successors;
+    std::list<std::wstring> m_successorLru;      // 앞쪽이 가장 최근
+    std::unordered_map<PathId, SequentialState> m_sequential;
+    std::unordered_map<std::wstring, std::chrono::steady_clock::time_point> m_prefetched;
+    
+    PrefetchStats m_stats;
+};
@@ -0,0 +1,38 @@
+#include "ProgressThrottle.h"
+
+ProgressThrottle::ProgressThrottle(double maxUpdatesPerSecond) {
+    SetMaxUpdatesPerSecond(maxUpdatesPerSecond);
+}
+
+void ProgressThrottle::SetMaxUpdatesPerSecond(double maxUpdatesPerSecond) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_minInterval = maxUpdatesPerSecond > 0.0
+        ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / maxUpdatesPerSecond))
+        : std::chrono::steady_clock::duration::zero();
+}
+
+bool ProgressThrottle::ShouldReport(PathId key, LONGLONG completed, LONGLONG total) {
+    auto now = std::chrono::steady_clock::now();
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (completed >= total) {
+        m_lastReported.erase(key);
+        return true;
+    }
+    
+    auto last = m_lastReported.find(key);
+    if (last == m_lastReported.end()) {
+        m_lastReported.emplace(key, now);
+        return true;
+    }
+    if (now - last->second < m_minInterval) {
+        return false;
+    }
+    last->second = now;
+    return true;
+}
+
+void ProgressThrottle::Forget(PathId key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_lastReported.erase(key);
+}
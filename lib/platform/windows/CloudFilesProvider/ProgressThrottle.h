@@ -0,0 +1,29 @@
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include <mutex>
+#include <unordered_map>
+#include <chrono>
+
+#include "PathTable.h"
+
+// 파일별 진행률 알림을 초당 최대 횟수로 제한
+// 수백 개 파일이 동시에 하이드레이션되어도 앱(FFI) 쪽으로 가는 호출 수가 일정하게 유지됨
+class ProgressThrottle {
+public:
+    explicit ProgressThrottle(double maxUpdatesPerSecond = 4.0);
+    
+    void SetMaxUpdatesPerSecond(double maxUpdatesPerSecond);
+    
+    // 이번 진행률을 알려야 하면 true (시작과 완료는 항상 알림)
+    bool ShouldReport(PathId key, LONGLONG completed, LONGLONG total);
+    
+    // 전송이 중간에 끝났을 때 상태 정리
+    void Forget(PathId key);
+
+private:
+    std::mutex m_mutex;
+    std::chrono::steady_clock::duration m_minInterval;
+    std::unordered_map<PathId, std::chrono::steady_clock::time_point> m_lastReported;
+};
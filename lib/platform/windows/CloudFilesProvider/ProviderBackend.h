@@ -0,0 +1,138 @@
+#pragma once
+
+#include <windows.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "FileHandleCache.h"
+#include "InFlightFetches.h"
+#include "RemoteDirectoryIndex.h"
+
+// 폴더 채우기 방식
+enum class PopulationMode {
+    Full,     // 시작할 때 모든 플레이스홀더를 직접 생성
+    Partial   // 폴더가 처음 열거될 때 FETCH_PLACEHOLDERS로 하위 항목을 채움
+};
+
+// 파일 하이드레이션 방식
+enum class HydrationPolicy {
+    Partial,      // 앱이 읽는 범위만 요청 (엔진이 read-ahead로 앞쪽을 더 채움)
+    Progressive,  // 요청 범위를 먼저 채운 뒤 OS가 나머지를 백그라운드로 계속 요청
+    Full          // 처음 열 때 파일 전체를 받을 때까지 열기가 완료되지 않음
+};
+
+// 동기화 루트를 연결할 때 적용하는 정책
+struct BackendSyncPolicy {
+    PopulationMode populationMode = PopulationMode::Full;
+    HydrationPolicy hydrationPolicy = HydrationPolicy::Partial;
+    bool validateData = false;  // 하이드레이션된 데이터를 OnValidateData로 확인받은 뒤에야 앱에 보이게 함
+};
+
+// 셸에 표시되는 파일의 동기화 상태
+enum class InSyncState {
+    NotInSync = 0,
+    InSync = 1
+};
+
+// 파일 고정 상태 (CF_PIN_STATE와 같은 값)
+enum class PinState {
+    Unspecified = 0,
+    Pinned = 1,     // 항상 로컬에 유지
+    Unpinned = 2,   // 공간이 필요하면 비울 수 있음
+    Excluded = 3,
+    Inherit = 4     // 부모 폴더의 상태를 따름
+};
+
+// 데이터 요청을 실패로 완료하는 이유
+enum class TransferFailure {
+    Failed,   // 원격 fetch 실패
+    Aborted   // provider가 정지하면서 처리하지 못한 요청
+};
+
+// 백엔드가 엔진에 넘기는 파일 정보 (콜백이 끝날 때까지만 유효)
+struct BackendFileInfo {
+    const wchar_t* relativePath = L"";     // 동기화 루트 기준 경로 (널 종료를 가정하지 않음)
+    size_t relativePathLength = 0;
+    const wchar_t* displayPath = L"";      // 앱 알림에 그대로 전달하는 OS 경로
+    const void* fileIdentity = nullptr;    // 플레이스홀더를 만들 때 저장한 ID
+    size_t fileIdentityLength = 0;
+    LONGLONG fileSize = 0;
+    DWORD processId = 0;                   // 요청한 프로세스 (백엔드가 알 수 없으면 0)
+
+    std::wstring RelativePath() const { return std::wstring(relativePath, relativePathLength); }
+};
+
+// OS에서 엔진으로 오는 플레이스홀더/하이드레이션/알림 이벤트
+// 백엔드의 콜백 스레드에서 호출되며, 요청은 FetchKey로 식별해 같은 백엔드에 응답함
+class ProviderBackendEvents {
+public:
+    virtual ~ProviderBackendEvents() = default;
+
+    // 파일 범위 데이터 요청: TransferData/FailTransfer로 [offset, offset+length)를 채워야 함
+    virtual void OnFetchData(const BackendFileInfo& file, const FetchKey& key, LONGLONG offset, LONGLONG length) = 0;
+    virtual void OnCancelFetchData(const BackendFileInfo& file, const FetchKey& key, LONGLONG offset, LONGLONG length) = 0;
+
+    // 하이드레이션된 데이터 확인 요청: RetrieveData로 읽어 확인한 뒤 AcknowledgeData로 응답
+    virtual void OnValidateData(const BackendFileInfo& file, const FetchKey& key, LONGLONG offset, LONGLONG length) = 0;
+
+    // 부분 채우기 모드에서 폴더가 처음 열거됨: TransferPlaceholders로 응답
+    virtual void OnFetchPlaceholders(const BackendFileInfo& directory, const FetchKey& key) = 0;
+
+    virtual void OnFileOpened(const BackendFileInfo& file) = 0;
+    virtual void OnFileClosed(const BackendFileInfo& file) = 0;
+    virtual void OnFileDeleted(const BackendFileInfo& file) = 0;
+    virtual void OnFileRenamed(const BackendFileInfo& file) = 0;
+};
+
+// 동기화 루트를 OS에 노출하는 플랫폼 백엔드
+// fetch 엔진, 캐시, 지표는 CloudFilesProvider에 두고 플랫폼 API 호출만 구현함
+// 경로 인자는 모두 동기화 루트 기준
+class ProviderBackend {
+public:
+    virtual ~ProviderBackend() = default;
+
+    virtual const wchar_t* Name() const = 0;
+
+    // 동기화 루트 등록과 이벤트 연결 (Disconnect 전까지 events를 호출함)
+    virtual HRESULT Connect(const std::wstring& syncRootPath, const std::wstring& displayName,
+                            const BackendSyncPolicy& policy, ProviderBackendEvents* events) = 0;
+    virtual void Disconnect() = 0;
+    virtual HRESULT Unregister(const std::wstring& syncRootPath) = 0;
+
+    // 한 폴더의 플레이스홀더를 한 번에 생성 (results에는 항목별 결과, 일부 실패해도 나머지는 계속 생성)
+    virtual HRESULT CreatePlaceholders(const std::wstring& parentRelativePath, const PlaceholderEntry* entries, size_t count,
+                                       std::vector<HRESULT>& results) = 0;
+
+    // OnFetchPlaceholders 응답 (children이 없으면 빈 결과로 완료하고 다음 열거 때 다시 요청되게 함)
+    virtual HRESULT TransferPlaceholders(const FetchKey& key, const std::wstring& relativeDirectory,
+                                         const std::vector<PlaceholderEntry>* children) = 0;
+
+    // OnFetchData 응답 (범위는 4KB 정렬, 파일 끝에서 끝나는 경우 제외)
+    virtual HRESULT TransferData(const FetchKey& key, const BYTE* buffer, LONGLONG offset, LONGLONG length) = 0;
+    virtual HRESULT FailTransfer(const FetchKey& key, LONGLONG offset, LONGLONG length, TransferFailure reason) = 0;
+    virtual void ReportProgress(const FetchKey& key, LONGLONG total, LONGLONG completed) = 0;
+
+    // OnValidateData 중 하이드레이션된 데이터 읽기 (returnedLength는 실제로 읽은 바이트 수)
+    virtual HRESULT RetrieveData(const FetchKey& key, BYTE* buffer, LONGLONG offset, LONGLONG length,
+                                 LONGLONG& returnedLength) = 0;
+
+    // OnValidateData 응답 (여러 번 나눠 구간별로 응답할 수 있음)
+    virtual HRESULT AcknowledgeData(const FetchKey& key, LONGLONG offset, LONGLONG length, bool valid) = 0;
+
+    // provider가 시작하는 전체 하이드레이션 (완료될 때까지 블록, 데이터는 OnFetchData로 요청됨)
+    virtual HRESULT HydratePlaceholder(const std::wstring& relativePath) = 0;
+
+    // OnFetchData 없이 provider가 가진 데이터로 파일을 채울 때 (HydrateFile)
+    // 파일의 전송 키를 얻어 operation 안의 TransferData/ReportProgress에 쓰고, 끝나면 반납함
+    virtual HRESULT WithTransferKey(const std::wstring& relativePath,
+                                    const std::function<HRESULT(const FetchKey& key)>& operation) = 0;
+
+    // 파일 상태 변경
+    virtual HRESULT SetInSyncState(const std::wstring& relativePath, InSyncState state) = 0;
+    virtual HRESULT SetPinState(const std::wstring& relativePath, PinState state) = 0;
+
+    // 상태 변경에 쓰는 파일 핸들 캐시 (핸들을 캐시하지 않는 백엔드는 무시)
+    virtual void SetHandleCacheCapacity(size_t) {}
+    virtual FileHandleCacheStats GetHandleCacheStats() const { return FileHandleCacheStats(); }
+};
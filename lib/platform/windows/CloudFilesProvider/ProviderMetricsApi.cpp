@@ -0,0 +1,42 @@
+#include "ProviderMetricsApi.h"
+#include "CloudFilesProvider.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+int32_t MbdGetMetricsSnapshot(MbdMetricsSnapshot* snapshot) {
+    if (!snapshot || snapshot->structSize < offsetof(MbdMetricsSnapshot, fetchData)) {
+        return E_INVALIDARG;
+    }
+    
+    MbdMetricsSnapshot current = {};
+    HRESULT hr = CloudFilesProvider::GetInstance().GetMetricsSnapshot(current);
+    if (FAILED(hr)) {
+        return hr;
+    }
+    
+    // 호출자가 아는 크기까지만 복사
+    size_t size = (std::min)(static_cast<size_t>(snapshot->structSize), sizeof(current));
+    current.structSize = static_cast<uint32_t>(size);
+    memcpy(snapshot, &current, size);
+    return S_OK;
+}
+
+void MbdResetMetrics(void) {
+    CloudFilesProvider::GetInstance().ResetMetrics();
+}
+
+void MbdSetTracingEnabled(int32_t enabled, uint32_t capacity) {
+    if (enabled) {
+        CloudFilesProvider::GetInstance().EnableTracing(capacity > 0 ? capacity : 65536);
+    } else {
+        CloudFilesProvider::GetInstance().DisableTracing();
+    }
+}
+
+int32_t MbdDumpTrace(const wchar_t* path) {
+    if (!path || !*path) {
+        return E_INVALIDARG;
+    }
+    return CloudFilesProvider::GetInstance().DumpTrace(path);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+// Dart(FFI)에서 주기적으로 읽는 provider 지표와 하이드레이션 추적의 C ABI
+// 구조체는 고정 크기 필드만 사용하며, 호출자가 structSize를 채워 넘기면
+// 그 크기까지만 채우므로 필드가 뒤에 추가되어도 이전 바인딩이 깨지지 않음
+
+#include <stdint.h>
+#include <wchar.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MBD_METRICS_VERSION 3
+
+#ifndef MBD_API
+#define MBD_API __declspec(dllexport)
+#endif
+
+// 지연 시간 요약 (나노초)
+typedef struct MbdLatencySummary {
+    uint64_t count;
+    uint64_t meanNs;
+    uint64_t p50Ns;
+    uint64_t p90Ns;
+    uint64_t p99Ns;
+    uint64_t p999Ns;
+    uint64_t maxNs;
+} MbdLatencySummary;
+
+typedef struct MbdMetricsSnapshot {
+    uint32_t structSize;          // 호출자가 sizeof(MbdMetricsSnapshot)로 설정
+    uint32_t version;             // MBD_METRICS_VERSION
+
+    // 콜백별 처리 시간
+    MbdLatencySummary fetchData;
+    MbdLatencySummary validateData;
+    MbdLatencySummary cancelFetchData;
+    MbdLatencySummary fetchPlaceholders;
+    MbdLatencySummary notifications;
+
+    // 하이드레이션
+    MbdLatencySummary timeToFirstByte;
+    MbdLatencySummary queueWait;
+    MbdLatencySummary download;
+
+    // 누적 카운터
+    uint64_t bytesTransferred;
+    uint64_t fetchRequests;
+    uint64_t downloadsStarted;
+    uint64_t downloadsCompleted;
+    uint64_t downloadsFailed;
+    uint64_t downloadsCancelled;
+
+    // 현재 값
+    uint32_t queueDepth;          // 실행기 큐에서 기다리는 다운로드
+    uint32_t activeWorkers;
+    uint32_t workerCount;
+    uint32_t inFlightFetches;     // 완료되지 않은 FETCH_DATA 요청
+    double workerUtilization;     // activeWorkers / workerCount
+    uint64_t workerBusyMs;        // 워커가 작업을 실행한 누적 시간 (폴링 간 차이로 사용률 계산)
+
+    // 버전 2: 플레이스홀더 처리량과 하이드레이션 메모리
+    MbdLatencySummary placeholderBatch;   // 배치 하나의 생성/전송 시간 (처리량 = placeholdersCreated / 누적 시간)
+    uint64_t placeholdersCreated;
+    uint64_t transferPoolBytes;           // 전송 버퍼 풀이 할당한 총량
+    uint64_t transferBytesInUse;          // 진행 중인 전송이 잡고 있는 버퍼 (스레드 캐시 포함)
+
+    // 버전 3: 하이드레이션 데이터 검증 (검증 처리량 = bytesVerified / validateData 누적 시간)
+    uint64_t bytesVerified;
+    uint64_t blocksFailedVerification;
+    uint64_t unverifiedValidations;       // 매니페스트가 없어 해시 없이 응답한 VALIDATE_DATA
+} MbdMetricsSnapshot;
+
+// 현재 지표를 snapshot에 복사 (HRESULT 반환)
+MBD_API int32_t MbdGetMetricsSnapshot(MbdMetricsSnapshot* snapshot);
+
+// 히스토그램과 카운터를 0으로 초기화
+MBD_API void MbdResetMetrics(void);
+
+// 하이드레이션 추적 켜기/끄기 (capacity는 처음 켤 때만 적용되는 이벤트 수, 0이면 기본값)
+MBD_API void MbdSetTracingEnabled(int32_t enabled, uint32_t capacity);
+
+// 추적 버퍼를 Chrome/Perfetto trace JSON 파일로 저장 (HRESULT 반환)
+MBD_API int32_t MbdDumpTrace(const wchar_t* path);
+
+#ifdef __cplusplus
+}
+#endif
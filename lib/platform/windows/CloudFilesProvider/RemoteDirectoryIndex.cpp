@@ -0,0 +1,50 @@
+#include "RemoteDirectoryIndex.h"
+#include <cwctype>
+
+void RemoteDirectoryIndex::SetChildren(const std::wstring& relativeDirectory, std::vector<PlaceholderEntry> children) {
+    auto snapshot = std::make_shared<const std::vector<PlaceholderEntry>>(std::move(children));
+    std::wstring key = NormalizeKey(relativeDirectory);
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_directories[key] = std::move(snapshot);
+}
+
+void RemoteDirectoryIndex::Remove(const std::wstring& relativeDirectory) {
+    std::wstring key = NormalizeKey(relativeDirectory);
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_directories.erase(key);
+}
+
+void RemoteDirectoryIndex::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_directories.clear();
+}
+
+RemoteDirectoryIndex::Children RemoteDirectoryIndex::GetChildren(const std::wstring& relativeDirectory) const {
+    std::wstring key = NormalizeKey(relativeDirectory);
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_directories.find(key);
+    return found != m_directories.end() ? found->second : nullptr;
+}
+
+size_t RemoteDirectoryIndex::DirectoryCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_directories.size();
+}
+
+std::wstring RemoteDirectoryIndex::NormalizeKey(const std::wstring& relativeDirectory) {
+    std::wstring key;
+    key.reserve(relativeDirectory.size());
+    for (wchar_t c : relativeDirectory) {
+        key.push_back(c == L'/' ? L'\\' : static_cast<wchar_t>(towlower(c)));
+    }
+    
+    size_t start = key.find_first_not_of(L'\\');
+    if (start == std::wstring::npos) {
+        return std::wstring();
+    }
+    size_t end = key.find_last_not_of(L'\\');
+    return key.substr(start, end - start + 1);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "PlaceholderIdentity.h"
+
+// 일괄 생성할 플레이스홀더 항목 (name은 부모 폴더 안의 파일 이름)
+// 폴더는 basicInfo.FileAttributes에 FILE_ATTRIBUTE_DIRECTORY를 설정
+// identity에 객체 ID가 없으면 경로에서 만든 ID를 사용
+struct PlaceholderEntry {
+    std::wstring name;
+    FILE_BASIC_INFO basicInfo = {};
+    LARGE_INTEGER fileSize = {};
+    PlaceholderIdentity identity;
+};
+
+// 폴더별 원격 하위 항목 목록
+// 부분 채우기 모드에서 폴더가 처음 열거될 때 이 목록으로 플레이스홀더를 만듦
+class RemoteDirectoryIndex {
+public:
+    using Children = std::shared_ptr<const std::vector<PlaceholderEntry>>;
+    
+    void SetChildren(const std::wstring& relativeDirectory, std::vector<PlaceholderEntry> children);
+    void Remove(const std::wstring& relativeDirectory);
+    void Clear();
+    
+    // 모르는 폴더면 nullptr (읽는 동안 목록이 교체되어도 안전한 스냅샷)
+    Children GetChildren(const std::wstring& relativeDirectory) const;
+    
+    size_t DirectoryCount() const;
+    
+    // 대소문자와 구분자 차이를 없앤 키 ("Project/Tracks/" -> "project\tracks")
+    static std::wstring NormalizeKey(const std::wstring& relativeDirectory);
+
+private:
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::wstring, Children> m_directories;
+};
@@ -0,0 +1,286 @@
+#include "TraceRecorder.h"
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+size_t RoundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+// JSON 문자열 값으로 쓸 수 있게 이스케이프
+void AppendJsonString(std::string& out, const char* text, size_t length) {
+    out += '"';
+    for (size_t i = 0; i < length; ++i) {
+        char c = text[i];
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                out += escaped;
+            } else {
+                out += c;
+            }
+            break;
+        }
+    }
+    out += '"';
+}
+
+void AppendJsonString(std::string& out, const char* text) {
+    AppendJsonString(out, text ? text : "", text ? strlen(text) : 0);
+}
+
+std::string ToUtf8(const std::wstring& text) {
+    if (text.empty()) {
+        return std::string();
+    }
+    int size = WideCharToMultiByte(CP_UTF8, 0, text.c_str(), static_cast<int>(text.size()), nullptr, 0, nullptr, nullptr);
+    if (size <= 0) {
+        return std::string();
+    }
+    std::string result(static_cast<size_t>(size), '\0');
+    WideCharToMultiByte(CP_UTF8, 0, text.c_str(), static_cast<int>(text.size()), &result[0], size, nullptr, nullptr);
+    return result;
+}
+
+// 나노초를 Chrome trace가 쓰는 마이크로초(소수 3자리)로 기록
+void AppendMicroseconds(std::string& out, int64_t nanoseconds) {
+    char buffer[32];
+    unsigned long long magnitude = nanoseconds < 0 ? 0ULL - static_cast<unsigned long long>(nanoseconds)
+                                                   : static_cast<unsigned long long>(nanoseconds);
+    snprintf(buffer, sizeof(buffer), "%s%llu.%03llu", nanoseconds < 0 ? "-" : "", magnitude / 1000, magnitude % 1000);
+    out += buffer;
+}
+
+} // namespace
+
+TraceRecorder& TraceRecorder::Instance() {
+    static TraceRecorder instance;
+    return instance;
+}
+
+TraceRecorder::TraceRecorder() : m_epoch(Clock::now()) {
+}
+
+void TraceRecorder::Enable(size_t capacity) {
+    std::lock_guard<std::mutex> lock(m_allocationMutex);
+    if (!m_slots) {
+        // 기록 중인 스레드가 버퍼를 잡고 있을 수 있으므로 한 번 할당하면 해제하지 않음
+        m_capacity = RoundUpToPowerOfTwo((std::max)(capacity, size_t(1024)));
+        m_slots.reset(new Slot[m_capacity]);
+    }
+    m_enabled.store(true, std::memory_order_release);
+}
+
+void TraceRecorder::Disable() {
+    m_enabled.store(false, std::memory_order_relaxed);
+}
+
+void TraceRecorder::Clear() {
+    m_start.store(m_next.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+int64_t TraceRecorder::ToNanoseconds(Clock::time_point time) const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time - m_epoch).count();
+}
+
+void TraceRecorder::Record(char phase, const char* category, const char* name, Clock::time_point start,
+                           int64_t duration, uint64_t id, PathId pathId, TraceArg arg0, TraceArg arg1) {
+    if (!m_enabled.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    uint64_t index = m_next.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = m_slots[index & (m_capacity - 1)];
+
+    // 슬롯을 차지한 뒤에 씀: 링을 한 바퀴 돈 다른 스레드가 같은 슬롯에 쓰는 중이거나
+    // 이미 더 새로운 이벤트가 들어 있으면 이 이벤트를 버림 (두 이벤트가 섞이지 않게)
+    uint64_t current = slot.sequence.load(std::memory_order_relaxed);
+    if ((current & 1) || current > index * 2 ||
+        !slot.sequence.compare_exchange_strong(current, index * 2 + 1, std::memory_order_relaxed)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    TraceEvent& event = slot.event;
+    event.category = category;
+    event.name = name;
+    event.phase = phase;
+    event.threadId = GetCurrentThreadId();
+    event.timestamp = ToNanoseconds(start);
+    event.duration = duration;
+    event.id = id;
+    event.pathId = pathId;
+    event.args[0] = arg0;
+    event.args[1] = arg1;
+
+    slot.sequence.store(index * 2 + 2, std::memory_order_release);
+}
+
+void TraceRecorder::Complete(const char* category, const char* name, Clock::time_point start, Clock::time_point end,
+                             uint64_t id, PathId pathId, TraceArg arg0, TraceArg arg1) {
+    int64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    Record('X', category, name, start, duration, id, pathId, arg0, arg1);
+}
+
+void TraceRecorder::Instant(const char* category, const char* name, uint64_t id, PathId pathId,
+                            TraceArg arg0, TraceArg arg1) {
+    if (IsEnabled()) {
+        Record('i', category, name, Clock::now(), 0, id, pathId, arg0, arg1);
+    }
+}
+
+void TraceRecorder::AsyncBegin(const char* category, const char* name, uint64_t id, PathId pathId,
+                               TraceArg arg0, TraceArg arg1) {
+    if (IsEnabled()) {
+        Record('b', category, name, Clock::now(), 0, id, pathId, arg0, arg1);
+    }
+}
+
+void TraceRecorder::AsyncEnd(const char* category, const char* name, uint64_t id, PathId pathId,
+                             TraceArg arg0, TraceArg arg1) {
+    if (IsEnabled()) {
+        Record('e', category, name, Clock::now(), 0, id, pathId, arg0, arg1);
+    }
+}
+
+void TraceRecorder::AsyncSpan(const char* category, const char* name, uint64_t id, Clock::time_point start,
+                              Clock::time_point end, PathId pathId, TraceArg arg0, TraceArg arg1) {
+    if (IsEnabled()) {
+        Record('b', category, name, start, 0, id, pathId, arg0, arg1);
+        Record('e', category, name, end, 0, id, pathId, TraceArg(), TraceArg());
+    }
+}
+
+HRESULT TraceRecorder::WriteChromeTrace(const std::wstring& path, const PathResolver& resolvePath) const {
+    // 버퍼에 남은 이벤트를 복사 (기록 중이거나 그 사이 덮어쓴 슬롯은 건너뜀)
+    std::vector<TraceEvent> events;
+    if (m_slots) {
+        uint64_t end = m_next.load(std::memory_order_acquire);
+        uint64_t begin = (std::max)(m_start.load(std::memory_order_acquire),
+                                    end > m_capacity ? end - m_capacity : uint64_t(0));
+        events.reserve(static_cast<size_t>(end - begin));
+
+        for (uint64_t index = begin; index < end; ++index) {
+            const Slot& slot = m_slots[index & (m_capacity - 1)];
+            uint64_t expected = index * 2 + 2;
+            if (slot.sequence.load(std::memory_order_acquire) != expected) {
+                continue;
+            }
+            TraceEvent event = slot.event;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == expected) {
+                events.push_back(event);
+            }
+        }
+    }
+
+    std::stable_sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) {
+        return a.timestamp < b.timestamp;
+    });
+
+    // 경로는 ID별로 한 번만 변환
+    std::unordered_map<PathId, std::string> paths;
+    const DWORD processId = GetCurrentProcessId();
+
+    std::string json;
+    json.reserve(events.size() * 160 + 64);
+    json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    char buffer[64];
+    bool first = true;
+    for (const auto& event : events) {
+        if (!first) {
+            json += ",\n";
+        }
+        first = false;
+
+        json += "{\"name\":";
+        AppendJsonString(json, event.name);
+        json += ",\"cat\":";
+        AppendJsonString(json, event.category);
+        snprintf(buffer, sizeof(buffer), ",\"ph\":\"%c\",\"pid\":%lu,\"tid\":%lu,\"ts\":",
+                 event.phase, static_cast<unsigned long>(processId), static_cast<unsigned long>(event.threadId));
+        json += buffer;
+        AppendMicroseconds(json, event.timestamp);
+
+        if (event.phase == 'X') {
+            json += ",\"dur\":";
+            AppendMicroseconds(json, event.duration);
+        } else if (event.phase == 'i') {
+            json += ",\"s\":\"t\"";
+        }
+        if (event.phase == 'b' || event.phase == 'e') {
+            snprintf(buffer, sizeof(buffer), ",\"id\":\"0x%llx\"", static_cast<unsigned long long>(event.id));
+            json += buffer;
+        }
+
+        json += ",\"args\":{";
+        bool firstArg = true;
+        if (event.id != 0 && event.phase != 'b' && event.phase != 'e') {
+            snprintf(buffer, sizeof(buffer), "\"id\":%llu", static_cast<unsigned long long>(event.id));
+            json += buffer;
+            firstArg = false;
+        }
+        for (const auto& arg : event.args) {
+            if (!arg.name) {
+                continue;
+            }
+            if (!firstArg) {
+                json += ',';
+            }
+            firstArg = false;
+            AppendJsonString(json, arg.name);
+            snprintf(buffer, sizeof(buffer), ":%lld", static_cast<long long>(arg.value));
+            json += buffer;
+        }
+        if (event.pathId != kInvalidPathId && resolvePath) {
+            auto found = paths.find(event.pathId);
+            if (found == paths.end()) {
+                found = paths.emplace(event.pathId, ToUtf8(resolvePath(event.pathId))).first;
+            }
+            if (!firstArg) {
+                json += ',';
+            }
+            json += "\"path\":";
+            AppendJsonString(json, found->second.data(), found->second.size());
+        }
+        json += "}}";
+    }
+    json += "\n]}\n";
+
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+
+    HRESULT hr = S_OK;
+    size_t offset = 0;
+    while (offset < json.size()) {
+        DWORD chunk = static_cast<DWORD>((std::min)(json.size() - offset, size_t(1) << 24));
+        DWORD written = 0;
+        if (!WriteFile(file, json.data() + offset, chunk, &written, nullptr) || written == 0) {
+            hr = HRESULT_FROM_WIN32(GetLastError());
+            break;
+        }
+        offset += written;
+    }
+    CloseHandle(file);
+    return hr;
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <windows.h>
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <functional>
+
+#include "PathTable.h"
+
+// 하이드레이션 과정 이벤트의 분류
+constexpr const char* kHydrationTraceCategory = "hydration";
+
+// 이벤트에 붙는 정수 인자 (이름은 문자열 리터럴이어야 함)
+struct TraceArg {
+    const char* name = nullptr;
+    int64_t value = 0;
+};
+
+// 고정 크기 트레이스 이벤트 (이름과 분류는 정적 문자열만 가리킴)
+struct TraceEvent {
+    const char* category = nullptr;
+    const char* name = nullptr;
+    char phase = 0;              // 'X' 구간, 'i' 순간, 'b'/'e' 비동기 시작/끝
+    uint32_t threadId = 0;
+    int64_t timestamp = 0;       // 기록기 시작 기준 나노초
+    int64_t duration = 0;        // 'X' 이벤트만
+    uint64_t id = 0;             // 비동기 이벤트를 묶는 ID (다운로드 ID 등)
+    PathId pathId = kInvalidPathId;
+    TraceArg args[2];
+};
+
+// 하이드레이션 과정을 추적하는 프로세스 전역 기록기
+// 꺼져 있으면 원자 변수 하나만 읽고, 켜져 있으면 고정 크기 링 버퍼에 잠금 없이 기록함
+// (가득 차면 오래된 이벤트부터 덮어씀). 필요할 때 Chrome/Perfetto trace JSON으로 저장
+// 최선 노력 방식이라 손실이 있음: 같은 슬롯을 두 스레드가 동시에 쓰려 하면 나중 쪽을 버리고(DroppedCount),
+// 저장하는 동안 기록되거나 덮어쓴 이벤트는 빠짐
+class TraceRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+    using PathResolver = std::function<std::wstring(PathId)>;
+
+    static TraceRecorder& Instance();
+
+    // 처음 켤 때 버퍼를 할당 (이후에는 capacity가 무시됨)
+    void Enable(size_t capacity = 65536);
+    void Disable();
+    bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    // 지금까지의 이벤트를 버림
+    void Clear();
+
+    void Complete(const char* category, const char* name, Clock::time_point start, Clock::time_point end,
+                  uint64_t id = 0, PathId pathId = kInvalidPathId, TraceArg arg0 = {}, TraceArg arg1 = {});
+    void Instant(const char* category, const char* name, uint64_t id = 0, PathId pathId = kInvalidPathId,
+                 TraceArg arg0 = {}, TraceArg arg1 = {});
+    void AsyncBegin(const char* category, const char* name, uint64_t id, PathId pathId = kInvalidPathId,
+                    TraceArg arg0 = {}, TraceArg arg1 = {});
+    void AsyncEnd(const char* category, const char* name, uint64_t id, PathId pathId = kInvalidPathId,
+                  TraceArg arg0 = {}, TraceArg arg1 = {});
+    // 이미 끝난 비동기 구간을 한 번에 기록 (큐 대기처럼 시작 시점에는 기록할 필요가 없는 경우)
+    void AsyncSpan(const char* category, const char* name, uint64_t id, Clock::time_point start, Clock::time_point end,
+                   PathId pathId = kInvalidPathId, TraceArg arg0 = {}, TraceArg arg1 = {});
+
+    // Chrome trace-event JSON으로 저장 (chrome://tracing, ui.perfetto.dev에서 열 수 있음)
+    HRESULT WriteChromeTrace(const std::wstring& path, const PathResolver& resolvePath) const;
+
+    size_t Capacity() const { return m_capacity; }
+    uint64_t RecordedCount() const { return m_next.load(std::memory_order_relaxed); }
+    uint64_t DroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    TraceRecorder();
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    // 기록 중인 슬롯을 읽지 않도록 순번으로 보호 (홀수면 쓰는 중, 쓰기 전에 CAS로 차지)
+    struct Slot {
+        std::atomic<uint64_t> sequence{ 0 };
+        TraceEvent event;
+    };
+
+    void Record(char phase, const char* category, const char* name, Clock::time_point start, int64_t duration,
+                uint64_t id, PathId pathId, TraceArg arg0, TraceArg arg1);
+    int64_t ToNanoseconds(Clock::time_point time) const;
+
+    Clock::time_point m_epoch;
+    std::atomic<bool> m_enabled{ false };
+    std::mutex m_allocationMutex;
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_capacity = 0;
+    std::atomic<uint64_t> m_next{ 0 };
+    std::atomic<uint64_t> m_start{ 0 };   // Clear 이후 첫 이벤트 번호
+    std::atomic<uint64_t> m_dropped{ 0 };
+};
+
+// 범위 전체를 'X' 구간 이벤트로 기록 (꺼져 있으면 시간도 재지 않음)
+class ScopedTrace {
+public:
+    ScopedTrace(const char* category, const char* name, uint64_t id = 0, PathId pathId = kInvalidPathId,
+                TraceArg arg0 = {}, TraceArg arg1 = {})
+        : m_active(TraceRecorder::Instance().IsEnabled()) {
+        if (m_active) {
+            m_category = category;
+            m_name = name;
+            m_id = id;
+            m_pathId = pathId;
+            m_args[0] = arg0;
+            m_args[1] = arg1;
+            m_start = TraceRecorder::Clock::now();
+        }
+    }
+    ~ScopedTrace() {
+        if (m_active) {
+            TraceRecorder::Instance().Complete(m_category, m_name, m_start, TraceRecorder::Clock::now(),
+                                               m_id, m_pathId, m_args[0], m_args[1]);
+        }
+    }
+
+    ScopedTrace(const ScopedTrace&) = delete;
+    ScopedTrace& operator=(const ScopedTrace&) = delete;
+
+private:
+    bool m_active;
+    const char* m_category = nullptr;
+    const char* m_name = nullptr;
+    uint64_t m_id = 0;
+    PathId m_pathId = kInvalidPathId;
+    TraceArg m_args[2];
+    TraceRecorder::Clock::time_point m_start;
+};
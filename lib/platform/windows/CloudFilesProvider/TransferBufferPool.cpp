@@ -0,0 +1,235 @@
+#include "TransferBufferPool.h"
+#include <algorithm>
+
+struct TransferBufferPoolState {
+    TransferBufferPoolConfig config;
+    
+    mutable std::mutex mutex;
+    std::condition_variable available;
+    std::vector<BYTE*> freeBuffers;
+    TransferBufferPoolStats stats;
+    
+    ~TransferBufferPoolState() {
+        for (BYTE* buffer : freeBuffers) {
+            VirtualFree(buffer, 0, MEM_RELEASE);
+        }
+    }
+    
+    void ReturnToFreeList(BYTE* buffer) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            freeBuffers.push_back(buffer);
+            stats.freeBuffers = freeBuffers.size();
+        }
+        available.notify_one();
+    }
+};
+
+namespace {
+
+size_t RoundUpToPage(size_t size) {
+    SYSTEM_INFO info = {};
+    GetSystemInfo(&info);
+    const size_t page = info.dwPageSize ? info.dwPageSize : 4096;
+    return (size + page - 1) / page * page;
+}
+
+BYTE* AllocatePages(size_t size) {
+    // VirtualAlloc은 할당 단위(64KB) 경계로 정렬된 메모리를 반환
+    return static_cast<BYTE*>(VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+}
+
+// 스레드별 버퍼 캐시 (한 번에 하나의 풀만 캐시)
+struct ThreadBufferCache {
+    std::weak_ptr<TransferBufferPoolState> owner;
+    std::vector<BYTE*> buffers;
+    
+    ~ThreadBufferCache() {
+        Flush();
+    }
+    
+    // 캐시된 버퍼를 풀에 돌려주거나, 풀이 이미 없으면 해제
+    void Flush() {
+        auto pool = owner.lock();
+        for (BYTE* buffer : buffers) {
+            if (pool) {
+                pool->ReturnToFreeList(buffer);
+            } else {
+                VirtualFree(buffer, 0, MEM_RELEASE);
+            }
+        }
+        buffers.clear();
+    }
+    
+    bool Owns(const TransferBufferPoolState* pool) const {
+        auto current = owner.lock();
+        return current.get() == pool;
+    }
+};
+
+thread_local ThreadBufferCache t_bufferCache;
+
+} // namespace
+
+TransferBuffer::~TransferBuffer() {
+    Release();
+}
+
+TransferBuffer::TransferBuffer(TransferBuffer&& other) noexcept
+    : m_data(other.m_data), m_size(other.m_size), m_pool(std::move(other.m_pool)) {
+    other.m_data = nullptr;
+    other.m_size = 0;
+}
+
+TransferBuffer& TransferBuffer::operator=(TransferBuffer&& other) noexcept {
+    if (this != &other) {
+        Release();
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_pool = std::move(other.m_pool);
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+void TransferBuffer::Release() {
+    if (!m_data) {
+        return;
+    }
+    
+    if (!m_pool) {
+        VirtualFree(m_data, 0, MEM_RELEASE);
+    } else if (t_bufferCache.Owns(m_pool.get()) &&
+               t_bufferCache.buffers.size() < m_pool->config.perThreadCacheCount) {
+        // 같은 스레드에서 곧 다시 쓰일 가능성이 높으므로 잠금 없이 보관
+        t_bufferCache.buffers.push_back(m_data);
+    } else {
+        m_pool->ReturnToFreeList(m_data);
+    }
+    
+    m_data = nullptr;
+    m_size = 0;
+    m_pool.reset();
+}
+
+TransferBufferPool::TransferBufferPool(const TransferBufferPoolConfig& config)
+    : m_state(std::make_shared<TransferBufferPoolState>()) {
+    m_state->config = config;
+    m_state->config.bufferSize = RoundUpToPage((std::max)(config.bufferSize, static_cast<size_t>(1)));
+    m_state->stats.bufferSize = m_state->config.bufferSize;
+    m_state->stats.maxBytes = m_state->config.maxBytes;
+    m_state->freeBuffers.reserve(static_cast<size_t>(m_state->config.maxBytes / m_state->config.bufferSize));
+}
+
+TransferBufferPool::~TransferBufferPool() {
+    // 사용 중인 버퍼는 상태를 공유하므로 반환될 때까지 상태가 유지됨
+    if (t_bufferCache.Owns(m_state.get())) {
+        t_bufferCache.Flush();
+        t_bufferCache.owner.reset();
+    }
+}
+
+size_t TransferBufferPool::BufferSize() const {
+    return m_state->config.bufferSize;
+}
+
+TransferBufferPoolStats TransferBufferPool::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    return m_state->stats;
+}
+
+TransferBuffer TransferBufferPool::AllocateUnpooled(size_t size) {
+    TransferBuffer result;
+    size = RoundUpToPage((std::max)(size, static_cast<size_t>(1)));
+    result.m_data = AllocatePages(size);
+    result.m_size = result.m_data ? size : 0;
+    return result;
+}
+
+TransferBuffer TransferBufferPool::Acquire(size_t minSize) {
+    TransferBufferPoolState& state = *m_state;
+    const size_t bufferSize = state.config.bufferSize;
+    
+    TransferBuffer result;
+    if (minSize > bufferSize) {
+        // 풀 버퍼보다 큰 요청은 풀 밖에서 처리
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.stats.acquires++;
+        state.stats.oversizeAllocations++;
+        return AllocateUnpooled(minSize);
+    }
+    
+    // 1. 스레드 캐시
+    if (!t_bufferCache.Owns(m_state.get())) {
+        t_bufferCache.Flush();
+        t_bufferCache.owner = m_state;
+        t_bufferCache.buffers.reserve(state.config.perThreadCacheCount);
+    }
+    if (!t_bufferCache.buffers.empty()) {
+        result.m_data = t_bufferCache.buffers.back();
+        t_bufferCache.buffers.pop_back();
+        result.m_size = bufferSize;
+        result.m_pool = m_state;
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.stats.acquires++;
+        state.stats.threadCacheHits++;
+        return result;
+    }
+    
+    // 2. 공용 목록, 3. 한도 안에서 새로 할당, 4. 잠시 반환을 기다림
+    bool allocate = false;
+    {
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.stats.acquires++;
+        
+        auto canProceed = [&state, bufferSize]() {
+            return !state.freeBuffers.empty() || state.stats.pooledBytes + bufferSize <= state.config.maxBytes;
+        };
+        if (!canProceed()) {
+            state.stats.waits++;
+            state.available.wait_for(lock, state.config.exhaustedWait, canProceed);
+        }
+        
+        if (!state.freeBuffers.empty()) {
+            result.m_data = state.freeBuffers.back();
+            state.freeBuffers.pop_back();
+            state.stats.freeBuffers = state.freeBuffers.size();
+            state.stats.freeListHits++;
+            result.m_size = bufferSize;
+            result.m_pool = m_state;
+            return result;
+        }
+        
+        if (state.stats.pooledBytes + bufferSize <= state.config.maxBytes) {
+            // 할당 전에 용량을 예약
+            state.stats.pooledBytes += bufferSize;
+            state.stats.allocations++;
+            allocate = true;
+        } else {
+            state.stats.overflowAllocations++;
+        }
+    }
+    
+    result.m_data = AllocatePages(bufferSize);
+    if (!result.m_data) {
+        if (allocate) {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.stats.pooledBytes -= bufferSize;
+        }
+        return TransferBuffer();
+    }
+    result.m_size = bufferSize;
+    if (allocate) {
+        result.m_pool = m_state;
+    }
+    return result;
+}
+
+TransferBuffer AcquireTransferBuffer(TransferBufferPool* pool, size_t minSize) {
+    if (pool) {
+        return pool->Acquire(minSize);
+    }
+    
+    return TransferBufferPool::AllocateUnpooled(minSize);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <windows.h>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+// 전송 버퍼 풀 설정
+struct TransferBufferPoolConfig {
+    size_t bufferSize = 4 * 1024 * 1024;                       // 전송 청크 크기와 같게 유지 (페이지 단위로 올림)
+    ULONGLONG maxBytes = 256ULL * 1024 * 1024;                 // 풀이 보유할 수 있는 버퍼 총량 (풀 밖 할당은 포함하지 않음)
+    size_t perThreadCacheCount = 2;                            // 스레드별로 잠금 없이 재사용할 버퍼 수
+    std::chrono::milliseconds exhaustedWait{ 100 };            // 한도에 도달했을 때 반환을 기다리는 시간
+};
+
+struct TransferBufferPoolStats {
+    size_t bufferSize = 0;
+    ULONGLONG maxBytes = 0;
+    ULONGLONG pooledBytes = 0;        // 풀이 할당한 버퍼 총량 (사용 중 + 대기)
+    size_t freeBuffers = 0;           // 공용 목록에서 대기 중인 버퍼
+    ULONGLONG acquires = 0;
+    ULONGLONG threadCacheHits = 0;
+    ULONGLONG freeListHits = 0;
+    ULONGLONG allocations = 0;        // 새로 할당한 풀 버퍼
+    ULONGLONG waits = 0;              // 한도 때문에 반환을 기다린 횟수
+    ULONGLONG overflowAllocations = 0; // 기다려도 버퍼가 없어 풀 밖에서 할당한 횟수
+    ULONGLONG oversizeAllocations = 0; // 버퍼 크기보다 큰 요청
+};
+
+class TransferBufferPool;
+struct TransferBufferPoolState;
+
+// 풀에서 빌린 페이지 정렬 버퍼, 소멸 시 자동 반환
+class TransferBuffer {
+public:
+    TransferBuffer() = default;
+    ~TransferBuffer();
+    
+    TransferBuffer(TransferBuffer&& other) noexcept;
+    TransferBuffer& operator=(TransferBuffer&& other) noexcept;
+    TransferBuffer(const TransferBuffer&) = delete;
+    TransferBuffer& operator=(const TransferBuffer&) = delete;
+    
+    BYTE* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+    explicit operator bool() const { return m_data != nullptr; }
+    
+    void Release();
+
+private:
+    friend class TransferBufferPool;
+    
+    BYTE* m_data = nullptr;
+    size_t m_size = 0;
+    std::shared_ptr<TransferBufferPoolState> m_pool;  // 풀 밖에서 할당된 버퍼는 nullptr
+};
+
+// 고정 크기, 페이지 정렬 전송 버퍼 풀
+// 스레드별 캐시 -> 공용 목록 -> 새 할당 순으로 찾으므로 정상 상태의 하이드레이션은 힙 할당 없이 버퍼를 재사용함
+// maxBytes는 풀이 보유하는 버퍼만 제한하는 하드 캡이 아님: 한도에서 exhaustedWait만큼 기다려도 반환이 없으면
+// 전송을 막지 않도록 풀 밖에서 할당하고(overflowAllocations) 반환할 때 바로 해제하므로,
+// 최대 메모리 사용량은 maxBytes에 그 순간 사용 중인 풀 밖 버퍼를 더한 값
+class TransferBufferPool {
+public:
+    explicit TransferBufferPool(const TransferBufferPoolConfig& config = TransferBufferPoolConfig());
+    ~TransferBufferPool();
+    
+    TransferBufferPool(const TransferBufferPool&) = delete;
+    TransferBufferPool& operator=(const TransferBufferPool&) = delete;
+    
+    // 최소 minSize 바이트의 버퍼 (0이면 기본 버퍼 크기)
+    TransferBuffer Acquire(size_t minSize = 0);
+    
+    size_t BufferSize() const;
+    TransferBufferPoolStats GetStats() const;
+    
+    // 풀과 무관하게 해제되는 페이지 정렬 버퍼
+    static TransferBuffer AllocateUnpooled(size_t size);
+
+private:
+    std::shared_ptr<TransferBufferPoolState> m_state;
+};
+
+// pool이 없으면 풀 밖에서 할당한 버퍼를 반환
+TransferBuffer AcquireTransferBuffer(TransferBufferPool* pool, size_t minSize);
@@ -0,0 +1,167 @@
+#define FUSE_USE_VERSION 31
+
+#include "FuseMount.h"
+#include "Logger.h"
+#include <fuse.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// FILETIME(1601년부터 100ns 단위)과 Unix 시간의 차이
+const LONGLONG kUnixEpochTicks = 116444736000000000LL;
+const LONGLONG kTicksPerSecond = 10000000LL;
+
+FuseBackend& Backend() {
+    return *static_cast<FuseBackend*>(fuse_get_context()->private_data);
+}
+
+DWORD RequestingProcess() {
+    return static_cast<DWORD>(fuse_get_context()->pid);
+}
+
+// libfuse 경로("/Album/a.wav", UTF-8)를 동기화 루트 기준 경로로
+std::wstring ToRelativePath(const char* path) {
+    while (*path == '/') {
+        path++;
+    }
+    if (*path == '\0') {
+        return std::wstring();
+    }
+    int length = static_cast<int>(strlen(path));
+    int size = MultiByteToWideChar(CP_UTF8, 0, path, length, nullptr, 0);
+    std::wstring result(static_cast<size_t>(size), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, path, length, &result[0], size);
+    return result;
+}
+
+std::string ToUtf8(const std::wstring& text) {
+    if (text.empty()) {
+        return std::string();
+    }
+    int size = WideCharToMultiByte(CP_UTF8, 0, text.c_str(), static_cast<int>(text.size()), nullptr, 0, nullptr, nullptr);
+    std::string result(static_cast<size_t>(size), '\0');
+    WideCharToMultiByte(CP_UTF8, 0, text.c_str(), static_cast<int>(text.size()), &result[0], size, nullptr, nullptr);
+    return result;
+}
+
+int ToErrno(HRESULT hr) {
+    if (hr == HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND) || hr == HRESULT_FROM_WIN32(ERROR_PATH_NOT_FOUND)) {
+        return -ENOENT;
+    }
+    if (hr == HRESULT_FROM_WIN32(ERROR_DIRECTORY)) {
+        return -ENOTDIR;
+    }
+    if (hr == HRESULT_FROM_WIN32(ERROR_TIMEOUT)) {
+        return -ETIMEDOUT;
+    }
+    if (hr == HRESULT_FROM_WIN32(ERROR_OPERATION_ABORTED)) {
+        return -ECANCELED;
+    }
+    if (hr == HRESULT_FROM_WIN32(ERROR_NOT_READY)) {
+        return -ENXIO;
+    }
+    if (hr == E_INVALIDARG) {
+        return -EINVAL;
+    }
+    return -EIO;
+}
+
+timespec ToTimespec(const LARGE_INTEGER& time) {
+    timespec result = {};
+    if (time.QuadPart > kUnixEpochTicks) {
+        const LONGLONG ticks = time.QuadPart - kUnixEpochTicks;
+        result.tv_sec = static_cast<time_t>(ticks / kTicksPerSecond);
+        result.tv_nsec = static_cast<long>((ticks % kTicksPerSecond) * 100);
+    }
+    return result;
+}
+
+void FillStat(const FuseNodeInfo& info, struct stat* st) {
+    memset(st, 0, sizeof(*st));
+    st->st_mode = info.isDirectory ? (S_IFDIR | 0555) : (S_IFREG | 0444);
+    st->st_nlink = info.isDirectory ? 2 : 1;
+    st->st_uid = getuid();
+    st->st_gid = getgid();
+    st->st_size = static_cast<off_t>(info.fileSize);
+    // du 등에서 하이드레이션된 양이 보이도록 채워진 바이트만 블록으로 보고
+    st->st_blocks = static_cast<blkcnt_t>((info.hydratedBytes + 511) / 512);
+    st->st_atim = ToTimespec(info.basicInfo.LastAccessTime);
+    st->st_mtim = ToTimespec(info.basicInfo.LastWriteTime);
+    st->st_ctim = ToTimespec(info.basicInfo.ChangeTime);
+}
+
+int GetAttributes(const char* path, struct stat* st, fuse_file_info*) {
+    FuseNodeInfo info;
+    HRESULT hr = Backend().GetAttributes(ToRelativePath(path), info, RequestingProcess());
+    if (FAILED(hr)) {
+        return ToErrno(hr);
+    }
+    FillStat(info, st);
+    return 0;
+}
+
+int ReadDirectory(const char* path, void* buffer, fuse_fill_dir_t fill, off_t, fuse_file_info*, fuse_readdir_flags) {
+    std::vector<FuseNodeInfo> entries;
+    HRESULT hr = Backend().ReadDirectory(ToRelativePath(path), entries, RequestingProcess());
+    if (FAILED(hr)) {
+        return ToErrno(hr);
+    }
+
+    const fuse_fill_dir_flags noFlags = static_cast<fuse_fill_dir_flags>(0);
+    fill(buffer, ".", nullptr, 0, noFlags);
+    fill(buffer, "..", nullptr, 0, noFlags);
+    for (const FuseNodeInfo& entry : entries) {
+        struct stat st;
+        FillStat(entry, &st);
+        if (fill(buffer, ToUtf8(entry.name).c_str(), &st, 0, noFlags) != 0) {
+            break;
+        }
+    }
+    return 0;
+}
+
+int Open(const char* path, fuse_file_info* fileInfo) {
+    // 쓰기는 지원하지 않음 (변경은 앱이 provider API로 반영)
+    if ((fileInfo->flags & O_ACCMODE) != O_RDONLY) {
+        return -EROFS;
+    }
+    HRESULT hr = Backend().Open(ToRelativePath(path), RequestingProcess());
+    return FAILED(hr) ? ToErrno(hr) : 0;
+}
+
+int Read(const char* path, char* buffer, size_t size, off_t offset, fuse_file_info*) {
+    LONGLONG returned = 0;
+    HRESULT hr = Backend().Read(ToRelativePath(path), reinterpret_cast<BYTE*>(buffer), static_cast<LONGLONG>(offset),
+                                static_cast<LONGLONG>(size), returned, RequestingProcess());
+    if (FAILED(hr)) {
+        MBD_LOG_WARNING(L"FUSE read failed: ", ToRelativePath(path), L" (", LogHex(hr), L")");
+        return ToErrno(hr);
+    }
+    return static_cast<int>(returned);
+}
+
+int Release(const char* path, fuse_file_info*) {
+    Backend().Release(ToRelativePath(path), RequestingProcess());
+    return 0;
+}
+
+} // namespace
+
+int RunFuseMount(FuseBackend& backend, int argc, char* argv[]) {
+    fuse_operations operations = {};
+    operations.getattr = GetAttributes;
+    operations.readdir = ReadDirectory;
+    operations.open = Open;
+    operations.read = Read;
+    operations.release = Release;
+
+    MBD_LOG_INFO(L"Mounting FUSE backend");
+    int result = fuse_main(argc, argv, &operations, &backend);
+    MBD_LOG_INFO(L"FUSE mount exited: ", result);
+    return result;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "FuseBackend.h"
+
+// FuseBackend를 libfuse3 마운트에 연결 (Linux 전용, MBD_FUSE_BACKEND 빌드 옵션으로만 빌드됨)
+// getattr/readdir/open/read/release를 FuseBackend의 조회/열거/읽기로 넘기며, 마운트는 읽기 전용
+// argv는 fuse_main에 그대로 전달 (마운트 지점과 -f, -o 등의 libfuse 옵션)
+// backend는 CloudFilesProvider에 등록되어 연결된 상태여야 하고, 마운트가 내려갈 때까지 반환하지 않음
+int RunFuseMount(FuseBackend& backend, int argc, char* argv[]);
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include "BlockCache.h"
+#include "ProviderTestFixture.h"
+
+namespace {
+
+const LONGLONG kBlockSize = 4096;
+
+BlockKey Key(ULONGLONG blockIndex, const std::string& identity = "file") {
+    BlockKey key;
+    key.fileIdentity = identity;
+    key.version = 1;
+    key.blockIndex = blockIndex;
+    return key;
+}
+
+class BlockCacheTest : public ::testing::Test {
+protected:
+    BlockCacheConfig Config(ULONGLONG maxBytes = 16 * kBlockSize) {
+        BlockCacheConfig config;
+        config.directory = m_root.WidePath() + L"\\Blocks";
+        config.maxBytes = maxBytes;
+        config.blockSize = kBlockSize;
+        return config;
+    }
+
+    std::filesystem::path BlockFile(const std::vector<BYTE>& data) {
+        ContentHash hash;
+        EXPECT_EQ(S_OK, ComputeContentHash(data.data(), data.size(), hash));
+        std::wstring hex = hash.ToHex();
+        return std::filesystem::path(m_root.Path()) / "Blocks" / std::string(hex.begin(), hex.end());
+    }
+
+    std::vector<BYTE> Read(const std::shared_ptr<MappedBlock>& block) {
+        return block ? std::vector<BYTE>(block->Data(), block->Data() + block->Size()) : std::vector<BYTE>();
+    }
+
+    TempDirectory m_root;
+    std::vector<BYTE> m_a = MakePattern(kBlockSize, 1);
+    std::vector<BYTE> m_b = MakePattern(kBlockSize, 2);
+    std::vector<BYTE> m_c = MakePattern(kBlockSize, 3);
+};
+
+} // namespace
+
+TEST_F(BlockCacheTest, EvictsLeastRecentlyUsedContent) {
+    BlockCache cache(Config(2 * kBlockSize));
+    ASSERT_EQ(S_OK, cache.Open());
+    ASSERT_EQ(S_OK, cache.Insert(Key(0), m_a.data(), m_a.size()));
+    ASSERT_EQ(S_OK, cache.Insert(Key(1), m_b.data(), m_b.size()));
+    EXPECT_EQ(m_a, Read(cache.Lookup(Key(0))));
+
+    // 0번 블록을 방금 읽었으므로 1번 블록이 밀려남
+    ASSERT_EQ(S_OK, cache.Insert(Key(2), m_c.data(), m_c.size()));
+    EXPECT_TRUE(cache.Contains(Key(0)));
+    EXPECT_FALSE(cache.Contains(Key(1)));
+    EXPECT_TRUE(cache.Contains(Key(2)));
+    EXPECT_FALSE(std::filesystem::exists(BlockFile(m_b)));
+
+    BlockCacheStats stats = cache.GetStats();
+    EXPECT_EQ(1u, stats.evictions);
+    EXPECT_EQ(static_cast<ULONGLONG>(2 * kBlockSize), stats.usedBytes);
+}
+
+TEST_F(BlockCacheTest, IdenticalContentIsStoredOnce) {
+    BlockCache cache(Config());
+    ASSERT_EQ(S_OK, cache.Open());
+    ASSERT_EQ(S_OK, cache.Insert(Key(0, "one"), m_a.data(), m_a.size()));
+    ASSERT_EQ(S_OK, cache.Insert(Key(5, "two"), m_a.data(), m_a.size()));
+
+    BlockCacheStats stats = cache.GetStats();
+    EXPECT_EQ(1u, stats.blocks);
+    EXPECT_EQ(2u, stats.keys);
+    EXPECT_EQ(1u, stats.dedupedInsertions);
+
+    // 한 파일을 무효화해도 다른 파일이 쓰는 블록은 남음
+    cache.InvalidateFile("one");
+    EXPECT_EQ(m_a, Read(cache.Lookup(Key(5, "two"))));
+    cache.InvalidateFile("two");
+    EXPECT_FALSE(std::filesystem::exists(BlockFile(m_a)));
+}
+
+TEST_F(BlockCacheTest, InsertAsyncWritesOnBackgroundThread) {
+    BlockCache cache(Config());
+    ASSERT_EQ(S_OK, cache.Open());
+
+    TransferBuffer buffer = AcquireTransferBuffer(nullptr, m_a.size());
+    memcpy(buffer.Data(), m_a.data(), m_a.size());
+    EXPECT_TRUE(cache.InsertAsync(Key(0), std::move(buffer), m_a.size()));
+    cache.FlushPendingWrites();
+
+    EXPECT_EQ(m_a, Read(cache.Lookup(Key(0))));
+    BlockCacheStats stats = cache.GetStats();
+    EXPECT_EQ(0u, stats.pendingWrites);
+    EXPECT_EQ(1u, stats.insertions);
+}
+
+TEST_F(BlockCacheTest, FullWriteQueueDropsBlock) {
+    BlockCacheConfig config = Config();
+    config.maxPendingWrites = 0;
+    BlockCache cache(config);
+    ASSERT_EQ(S_OK, cache.Open());
+
+    EXPECT_FALSE(cache.InsertAsync(Key(0), AcquireTransferBuffer(nullptr, m_a.size()), m_a.size()));
+    EXPECT_EQ(1u, cache.GetStats().droppedWrites);
+    EXPECT_FALSE(cache.Contains(Key(0)));
+}
+
+TEST_F(BlockCacheTest, IndexSurvivesReopen) {
+    {
+        BlockCache cache(Config());
+        ASSERT_EQ(S_OK, cache.Open());
+        ASSERT_EQ(S_OK, cache.Insert(Key(0), m_a.data(), m_a.size()));
+    }
+    BlockCache reopened(Config());
+    ASSERT_EQ(S_OK, reopened.Open());
+    EXPECT_EQ(m_a, Read(reopened.Lookup(Key(0))));
+}
+
+TEST_F(BlockCacheTest, OpenReconcilesDirectoryWithIndex) {
+    {
+        BlockCache cache(Config());
+        ASSERT_EQ(S_OK, cache.Open());
+        ASSERT_EQ(S_OK, cache.Insert(Key(0), m_a.data(), m_a.size()));
+        ASSERT_EQ(S_OK, cache.Insert(Key(1), m_b.data(), m_b.size()));
+    }
+
+    // 비정상 종료 흉내: 인덱스 저장 뒤에 블록 하나가 지워지고, 인덱스에 없는 블록과 임시 파일이 남음
+    std::filesystem::remove(BlockFile(m_b));
+    std::filesystem::path orphan = BlockFile(m_c);
+    std::filesystem::path temp = orphan.string() + ".tmp42";
+    std::ofstream(orphan) << "orphan";
+    std::ofstream(temp) << "partial";
+
+    BlockCache cache(Config());
+    ASSERT_EQ(S_OK, cache.Open());
+    BlockCacheStats stats = cache.GetStats();
+    EXPECT_EQ(1u, stats.blocks);
+    EXPECT_EQ(static_cast<ULONGLONG>(kBlockSize), stats.usedBytes);
+    EXPECT_EQ(1u, stats.missingBlocks);
+    EXPECT_EQ(2u, stats.orphanedFiles);
+    EXPECT_FALSE(std::filesystem::exists(orphan));
+    EXPECT_FALSE(std::filesystem::exists(temp));
+    EXPECT_TRUE(cache.Contains(Key(0)));
+    EXPECT_FALSE(cache.Contains(Key(1)));
+}
+
+TEST_F(BlockCacheTest, ChangedIndexIsSavedPeriodically) {
+    BlockCacheConfig config = Config();
+    config.indexSaveInterval = std::chrono::milliseconds(10);
+    BlockCache cache(config);
+    ASSERT_EQ(S_OK, cache.Open());
+    ASSERT_EQ(S_OK, cache.Insert(Key(0), m_a.data(), m_a.size()));
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (cache.GetStats().indexSaves == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_GE(cache.GetStats().indexSaves, 1u);
+
+    // Close 없이 종료된 것처럼 다른 인스턴스로 열어도 블록이 남아 있음
+    BlockCache recovered(Config());
+    ASSERT_EQ(S_OK, recovered.Open());
+    EXPECT_TRUE(recovered.Contains(Key(0)));
+    EXPECT_EQ(0u, recovered.GetStats().missingBlocks);
+}
+
+TEST_F(BlockCacheTest, FetchThroughCacheServesRefetchFromDisk) {
+    BlockCache cache(Config());
+    ASSERT_EQ(S_OK, cache.Open());
+
+    std::vector<BYTE> file = MakePattern(static_cast<size_t>(3 * kBlockSize - 100), 9);
+    TestDataSource source(file);
+    FetchRequest request;
+    request.relativePath = L"a.wav";
+    request.fileIdentity = "a";
+    request.contentVersion = 1;
+    request.fileSize = static_cast<LONGLONG>(file.size());
+    request.offset = 0;
+    request.length = request.fileSize;
+
+    auto fetch = [&](const StreamingFetchCallback& upstream) {
+        std::vector<BYTE> received;
+        ChunkedFetchSink sink(0, request.length, static_cast<size_t>(kBlockSize),
+                              [&](const BYTE* data, LONGLONG, LONGLONG length) {
+                                  received.insert(received.end(), data, data + length);
+                                  return S_OK;
+                              });
+        EXPECT_EQ(S_OK, FetchThroughBlockCache(cache, upstream, request, sink));
+        EXPECT_EQ(S_OK, sink.Finish());
+        return received;
+    };
+
+    EXPECT_EQ(file, fetch(source.Callback()));
+    cache.FlushPendingWrites();
+    EXPECT_EQ(3u, cache.GetStats().blocks);
+
+    // 두 번째는 원격 없이 캐시에서만 채움
+    StreamingFetchCallback offline = [](const FetchRequest&, FetchSink&) { return E_FAIL; };
+    EXPECT_EQ(file, fetch(offline));
+    EXPECT_EQ(1u, source.Requests().size());
+}
@@ -0,0 +1,354 @@
+#include "ProviderTestFixture.h"
+#include "BlockManifest.h"
+#include "FetchExecutor.h"
+#include "FileHasher.h"
+#include "PlaceholderIdentity.h"
+#include "ProviderMetricsApi.h"
+#include "FileHashApi.h"
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+const LONGLONG kBlock = 4096;
+
+BlockManifest MakeManifest(const std::vector<BYTE>& data, LONGLONG blockSize) {
+    BlockManifest manifest;
+    manifest.fileSize = static_cast<LONGLONG>(data.size());
+    manifest.blockSize = blockSize;
+    for (LONGLONG offset = 0; offset < manifest.fileSize; offset += blockSize) {
+        ContentHash hash;
+        ComputeContentHash(data.data() + offset, static_cast<size_t>((std::min)(blockSize, manifest.fileSize - offset)), hash);
+        manifest.blockHashes.push_back(hash);
+    }
+    return manifest;
+}
+
+BlockReader ReaderFor(const std::vector<BYTE>& data) {
+    return [&data](BYTE* buffer, LONGLONG offset, LONGLONG length, LONGLONG& returned) {
+        returned = (std::min)(length, static_cast<LONGLONG>(data.size()) - offset);
+        memcpy(buffer, data.data() + offset, static_cast<size_t>(returned));
+        return S_OK;
+    };
+}
+
+std::vector<BYTE> ManifestId(BYTE seed) {
+    std::vector<BYTE> id(kManifestIdSize);
+    for (size_t i = 0; i < id.size(); ++i) {
+        id[i] = static_cast<BYTE>(seed + i);
+    }
+    return id;
+}
+
+} // namespace
+
+TEST(BlockManifestTest, ConsistencyChecksBlockSizeAndCount) {
+    BlockManifest manifest = MakeManifest(MakePattern(3 * kBlock + 10), kBlock);
+    EXPECT_EQ(4u, manifest.ExpectedBlockCount());
+    EXPECT_TRUE(manifest.IsConsistent());
+
+    BlockManifest unaligned = manifest;
+    unaligned.blockSize = kBlock + 1;
+    EXPECT_FALSE(unaligned.IsConsistent());
+
+    BlockManifest missingBlock = manifest;
+    missingBlock.blockHashes.pop_back();
+    EXPECT_FALSE(missingBlock.IsConsistent());
+}
+
+TEST(BlockManifestTest, StoreReadsPublishedManifestsBackFromDisk) {
+    TempDirectory root;
+    const std::wstring directory = root.WidePath() + L"\\Manifests";
+    BlockManifest manifest = MakeManifest(MakePattern(2 * kBlock + 1), kBlock);
+    const std::vector<BYTE> id = ManifestId(1);
+    {
+        BlockManifestStore store(directory, 4);
+        ASSERT_EQ(S_OK, store.Open());
+        ASSERT_EQ(S_OK, store.Put(id.data(), manifest));
+        EXPECT_EQ(E_INVALIDARG, store.Put(ManifestId(2).data(), BlockManifest()));
+    }
+
+    // 새 저장소는 메모리 캐시가 비어 있으므로 디스크에서 읽음
+    BlockManifestStore reopened(directory, 4);
+    ASSERT_EQ(S_OK, reopened.Open());
+    auto found = reopened.Find(id.data());
+    ASSERT_NE(nullptr, found);
+    EXPECT_EQ(manifest.fileSize, found->fileSize);
+    EXPECT_EQ(manifest.blockSize, found->blockSize);
+    EXPECT_TRUE(manifest.blockHashes == found->blockHashes);
+    EXPECT_EQ(nullptr, reopened.Find(ManifestId(2).data()));
+
+    reopened.Remove(id.data());
+    EXPECT_EQ(nullptr, reopened.Find(id.data()));
+}
+
+TEST(BlockManifestTest, VerifyMarksOnlyCorruptAndShortBlocks) {
+    std::vector<BYTE> data = MakePattern(4 * kBlock - 100);
+    BlockManifest manifest = MakeManifest(data, kBlock);
+    data[kBlock + 7] ^= 0xFF;
+    FetchExecutorConfig config;
+    config.workerCount = 2;
+    FetchExecutor executor(config);
+    executor.Start();
+
+    BlockVerification result;
+    ASSERT_EQ(S_OK, VerifyBlockRange(manifest, 0, manifest.fileSize, ReaderFor(data), nullptr, &executor, 3, result));
+    EXPECT_EQ(0u, result.firstBlock);
+    EXPECT_EQ((std::vector<BYTE>{ 1, 0, 1, 1 }), result.verified);
+    EXPECT_EQ(static_cast<ULONGLONG>(manifest.fileSize), result.bytesHashed);
+
+    // 범위와 겹치는 블록만 확인하고, 파일 끝 전에 읽기가 끝나면 불일치
+    std::vector<BYTE> truncated(data.begin(), data.end() - 50);
+    ASSERT_EQ(S_OK, VerifyBlockRange(manifest, 2 * kBlock + 10, kBlock, ReaderFor(truncated), nullptr, nullptr, 1, result));
+    EXPECT_EQ(2u, result.firstBlock);
+    EXPECT_EQ((std::vector<BYTE>{ 1, 0 }), result.verified);
+
+    EXPECT_EQ(E_INVALIDARG, VerifyBlockRange(manifest, manifest.fileSize, 10, ReaderFor(data), nullptr, nullptr, 1, result));
+}
+
+TEST(BlockManifestTest, VerifyDoesNotWaitForHelpersThatNeverStarted) {
+    std::vector<BYTE> data = MakePattern(3 * kBlock);
+    BlockManifest manifest = MakeManifest(data, kBlock);
+    FetchExecutorConfig config;
+    config.workerCount = 1;
+    FetchExecutor executor(config);
+    executor.Start();
+
+    // 유일한 워커를 막아 두면 도우미는 시작하지 못하고 호출한 스레드가 모든 블록을 처리
+    std::mutex mutex;
+    std::condition_variable released;
+    bool release = false;
+    executor.Submit(L"", HydrationPriority::Foreground, [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        released.wait(lock, [&release] { return release; });
+    });
+
+    BlockVerification result;
+    ASSERT_EQ(S_OK, VerifyBlockRange(manifest, 0, manifest.fileSize, ReaderFor(data), nullptr, &executor, 3, result));
+    EXPECT_EQ((std::vector<BYTE>{ 1, 1, 1 }), result.verified);
+    EXPECT_EQ(static_cast<ULONGLONG>(manifest.fileSize), result.bytesHashed);
+
+    // 늦게 시작한 도우미는 끝난 호출의 상태를 건드리지 않고 반환
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        release = true;
+    }
+    released.notify_all();
+    for (int i = 0; i < 500 && executor.GetStats().completedTasks < 3; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    EXPECT_EQ(3u, executor.GetStats().completedTasks);
+    executor.Stop();
+}
+
+TEST(BlockManifestTest, ManifestIdIsThePrefixOfTheTreeRoot) {
+    BlockManifest manifest = MakeManifest(MakePattern(2 * kBlock), kBlock);
+    ContentHash root;
+    ASSERT_EQ(S_OK, ComputeTreeRoot(manifest, root));
+    BYTE manifestId[kManifestIdSize];
+    ManifestIdFromTreeRoot(root, manifestId);
+    EXPECT_EQ(0, memcmp(root.bytes, manifestId, sizeof(manifestId)));
+}
+
+class ValidationTest : public ProviderTest {
+protected:
+    void Configure(CloudFilesProvider& provider) override {
+        DataValidationConfig config;
+        config.enabled = true;
+        config.requireManifest = m_requireManifest;
+        config.verifyThreads = 2;
+        provider.SetDataValidationConfig(config);
+    }
+
+    // 매니페스트 ID를 담은 플레이스홀더 ID와 그 매니페스트를 등록
+    std::string Publish(const std::vector<BYTE>& data, BYTE seed, LONGLONG blockSize = kBlock) {
+        const std::vector<BYTE> id = ManifestId(seed);
+        EXPECT_EQ(S_OK, Provider().PublishBlockManifest(id.data(), MakeManifest(data, blockSize)));
+        PlaceholderIdentity identity = PlaceholderIdentity::FromPath(L"a.wav");
+        memcpy(identity.manifestId, id.data(), id.size());
+        return identity.Serialize();
+    }
+
+    uint64_t Unverified() {
+        MbdMetricsSnapshot snapshot = {};
+        snapshot.structSize = sizeof(snapshot);
+        Provider().GetMetricsSnapshot(snapshot);
+        return snapshot.unverifiedValidations;
+    }
+
+    bool m_requireManifest = true;
+};
+
+TEST_F(ValidationTest, RegistersWithValidationAndAcceptsFilesWithoutAManifestByDefault) {
+    EXPECT_TRUE(m_backend->Policy().validateData);
+    // 다른 기기에서 올린 파일은 이 기기에 매니페스트가 없음
+    EXPECT_FALSE(DataValidationConfig().requireManifest);
+}
+
+TEST_F(ValidationTest, AcknowledgesConsecutiveBlocksWithTheSameResultTogether) {
+    std::vector<BYTE> data = MakePattern(5 * kBlock - 100);
+    const std::string identity = Publish(data, 1);
+    data[kBlock] ^= 0xFF;
+    data[2 * kBlock] ^= 0xFF;
+    m_backend->SetHydratedData(7, data);
+
+    const LONGLONG fileSize = static_cast<LONGLONG>(data.size());
+    m_backend->ValidateData(L"a.wav", fileSize, 7, 0, fileSize, identity.data(), identity.size());
+
+    // 블록 결과 1,0,0,1,1 -> 맞는 구간, 틀린 두 블록, 나머지 구간의 세 응답
+    auto acks = m_backend->Acks();
+    ASSERT_EQ(3u, acks.size());
+    EXPECT_EQ(0, acks[0].offset);
+    EXPECT_EQ(kBlock, acks[0].length);
+    EXPECT_TRUE(acks[0].valid);
+    EXPECT_EQ(kBlock, acks[1].offset);
+    EXPECT_EQ(2 * kBlock, acks[1].length);
+    EXPECT_FALSE(acks[1].valid);
+    EXPECT_EQ(3 * kBlock, acks[2].offset);
+    EXPECT_EQ(fileSize - 3 * kBlock, acks[2].length);
+    EXPECT_TRUE(acks[2].valid);
+}
+
+TEST_F(ValidationTest, AcknowledgesOnlyTheRequestedRange) {
+    std::vector<BYTE> data = MakePattern(4 * kBlock);
+    const std::string identity = Publish(data, 2);
+    m_backend->SetHydratedData(3, data);
+
+    // 블록 경계에 맞지 않는 범위도 요청 범위 그대로 응답
+    m_backend->ValidateData(L"a.wav", 4 * kBlock, 3, kBlock + 512, kBlock, identity.data(), identity.size());
+    auto acks = m_backend->Acks();
+    ASSERT_EQ(1u, acks.size());
+    EXPECT_EQ(kBlock + 512, acks[0].offset);
+    EXPECT_EQ(kBlock, acks[0].length);
+    EXPECT_TRUE(acks[0].valid);
+}
+
+TEST_F(ValidationTest, SizeMismatchFailsTheWholeRange) {
+    std::vector<BYTE> data = MakePattern(2 * kBlock);
+    const std::string identity = Publish(data, 3);
+    m_backend->SetHydratedData(4, data);
+
+    m_backend->ValidateData(L"a.wav", 3 * kBlock, 4, 0, 3 * kBlock, identity.data(), identity.size());
+    auto acks = m_backend->Acks();
+    ASSERT_EQ(1u, acks.size());
+    EXPECT_EQ(0, acks[0].offset);
+    EXPECT_EQ(3 * kBlock, acks[0].length);
+    EXPECT_FALSE(acks[0].valid);
+}
+
+TEST_F(ValidationTest, FileWithoutManifestIsRejected) {
+    const uint64_t before = Unverified();
+    m_backend->ValidateData(L"legacy.wav", kBlock, 5, 0, kBlock);
+
+    auto acks = m_backend->Acks();
+    ASSERT_EQ(1u, acks.size());
+    EXPECT_FALSE(acks[0].valid);
+    EXPECT_EQ(before + 1, Unverified());
+}
+
+class OptionalManifestTest : public ValidationTest {
+protected:
+    void Configure(CloudFilesProvider& provider) override {
+        m_requireManifest = false;
+        ValidationTest::Configure(provider);
+    }
+};
+
+TEST_F(OptionalManifestTest, FileWithoutManifestIsAcknowledgedUnverified) {
+    const uint64_t before = Unverified();
+    m_backend->ValidateData(L"legacy.wav", kBlock, 5, 0, kBlock);
+
+    auto acks = m_backend->Acks();
+    ASSERT_EQ(1u, acks.size());
+    EXPECT_TRUE(acks[0].valid);
+    EXPECT_EQ(before + 1, Unverified());
+}
+
+TEST_F(ValidationTest, PublishedFileManifestValidatesItsPlaceholder) {
+    const std::vector<BYTE> data = MakePattern(static_cast<size_t>(kFileHashBlockSize + 4 * kBlock));
+    {
+        std::ofstream file(m_cacheRoot.Path() + "/upload.wav", std::ios::binary);
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+    MbdFileTreeHash hash = {};
+    hash.structSize = sizeof(hash);
+    ASSERT_EQ(S_OK, MbdPublishBlockManifest((m_cacheRoot.WidePath() + L"\\upload.wav").c_str(), 2, &hash));
+    EXPECT_EQ(2u, hash.blockCount);
+    EXPECT_EQ(0, memcmp(hash.root, hash.manifestId, sizeof(hash.manifestId)));
+
+    // 플레이스홀더 ID에 트리 해시의 매니페스트 ID를 넣으면 저장된 매니페스트로 검증됨
+    PlaceholderIdentity identity = PlaceholderIdentity::FromPath(L"upload.wav");
+    memcpy(identity.manifestId, hash.manifestId, sizeof(identity.manifestId));
+    const std::string blob = identity.Serialize();
+    m_backend->SetHydratedData(9, data);
+    const LONGLONG fileSize = static_cast<LONGLONG>(data.size());
+    m_backend->ValidateData(L"upload.wav", fileSize, 9, 0, fileSize, blob.data(), blob.size());
+
+    auto acks = m_backend->Acks();
+    ASSERT_EQ(1u, acks.size());
+    EXPECT_EQ(fileSize, acks[0].length);
+    EXPECT_TRUE(acks[0].valid);
+}
+
+class PartialHydrationValidationTest : public ValidationTest {
+protected:
+    void Configure(CloudFilesProvider& provider) override {
+        ValidationTest::Configure(provider);
+        provider.SetStreamingFetchCallback(m_source.Callback());
+    }
+
+    static constexpr LONGLONG kManifestBlock = 16 * kBlock;
+    TestDataSource m_source{ MakePattern(static_cast<size_t>(3 * kManifestBlock + 100)) };
+};
+
+TEST_F(PartialHydrationValidationTest, FetchIsWidenedToManifestBlocksSoTheyValidate) {
+    const std::vector<BYTE>& content = m_source.Content();
+    const LONGLONG fileSize = static_cast<LONGLONG>(content.size());
+    const std::string identity = Publish(content, 10, kManifestBlock);
+
+    // 두 번째 블록 가운데의 작은 읽기도 블록 전체를 받음
+    const LONGLONG readOffset = kManifestBlock + 5000;
+    m_backend->FetchData(L"a.wav", fileSize, 11, readOffset, 100, identity.data(), identity.size());
+    ASSERT_TRUE(m_backend->WaitFor([](FakeBackend& backend) { return backend.TransferredBytes(11) == kManifestBlock; }));
+    auto requests = m_source.Requests();
+    ASSERT_EQ(1u, requests.size());
+    EXPECT_EQ(kManifestBlock, requests[0].offset);
+    EXPECT_EQ(kManifestBlock, requests[0].length);
+
+    // 부분 하이드레이션: 받은 블록 말고는 비어 있는 파일로 VALIDATE_DATA를 받음
+    std::vector<BYTE> hydrated(content.size(), 0);
+    const std::vector<BYTE> transferred = m_backend->TransferredData(11);
+    ASSERT_EQ(static_cast<size_t>(kManifestBlock), transferred.size());
+    std::copy(transferred.begin(), transferred.end(), hydrated.begin() + kManifestBlock);
+    m_backend->SetHydratedData(11, hydrated);
+
+    m_backend->ValidateData(L"a.wav", fileSize, 11, readOffset & ~(kBlock - 1), kBlock, identity.data(), identity.size());
+    auto acks = m_backend->Acks();
+    ASSERT_EQ(1u, acks.size());
+    EXPECT_TRUE(acks[0].valid);
+}
+
+TEST_F(PartialHydrationValidationTest, LastBlockIsWidenedOnlyToEndOfFile) {
+    const std::vector<BYTE>& content = m_source.Content();
+    const LONGLONG fileSize = static_cast<LONGLONG>(content.size());
+    const std::string identity = Publish(content, 11, kManifestBlock);
+
+    m_backend->FetchData(L"a.wav", fileSize, 12, fileSize - 10, 10, identity.data(), identity.size());
+    ASSERT_TRUE(m_backend->WaitFor([](FakeBackend& backend) { return backend.TransferredBytes(12) == 100; }));
+    auto requests = m_source.Requests();
+    ASSERT_EQ(1u, requests.size());
+    EXPECT_EQ(3 * kManifestBlock, requests[0].offset);
+    EXPECT_EQ(100, requests[0].length);
+}
+
+TEST_F(PartialHydrationValidationTest, FileWithoutManifestKeepsTheAlignedRange) {
+    const LONGLONG fileSize = static_cast<LONGLONG>(m_source.Content().size());
+    m_backend->FetchData(L"legacy.wav", fileSize, 13, kManifestBlock + 5000, 100);
+    ASSERT_TRUE(m_backend->WaitFor([](FakeBackend& backend) { return backend.TransferredBytes(13) == kBlock; }));
+    auto requests = m_source.Requests();
+    ASSERT_EQ(1u, requests.size());
+    EXPECT_EQ(kManifestBlock + kBlock, requests[0].offset);
+    EXPECT_EQ(kBlock, requests[0].length);
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "CfApiBackend.h"
+#include "RemoteDirectoryIndex.h"
+#include "ProviderTestFixture.h"
+
+namespace {
+
+std::vector<PlaceholderEntry> MakeEntries(size_t count) {
+    std::vector<PlaceholderEntry> entries(count);
+    for (size_t i = 0; i < count; ++i) {
+        entries[i].name = L"Track " + std::to_wstring(i) + L".wav";
+        entries[i].fileSize.QuadPart = static_cast<LONGLONG>(i + 1) * 1024;
+    }
+    return entries;
+}
+
+FetchKey MakeFetchKey(CF_CONNECTION_KEY connectionKey) {
+    FetchKey key;
+    key.connectionKey = connectionKey;
+    key.transferKey = 77;
+    return key;
+}
+
+} // namespace
+
+TEST(RemoteDirectoryIndexTest, NormalizeKeyIgnoresCaseAndSeparators) {
+    EXPECT_EQ(L"project\\tracks", RemoteDirectoryIndex::NormalizeKey(L"Project/Tracks/"));
+    EXPECT_EQ(L"project\\tracks", RemoteDirectoryIndex::NormalizeKey(L"\\PROJECT\\Tracks\\"));
+    EXPECT_EQ(L"project\\tracks", RemoteDirectoryIndex::NormalizeKey(L"//project/tracks"));
+    EXPECT_EQ(L"", RemoteDirectoryIndex::NormalizeKey(L""));
+    EXPECT_EQ(L"", RemoteDirectoryIndex::NormalizeKey(L"\\/"));
+}
+
+TEST(RemoteDirectoryIndexTest, LooksUpByNormalizedKey) {
+    RemoteDirectoryIndex index;
+    index.SetChildren(L"Project/Tracks", MakeEntries(3));
+    index.SetChildren(L"", MakeEntries(1));
+    EXPECT_EQ(2u, index.DirectoryCount());
+
+    RemoteDirectoryIndex::Children children = index.GetChildren(L"\\project\\TRACKS\\");
+    ASSERT_NE(nullptr, children);
+    EXPECT_EQ(3u, children->size());
+    ASSERT_NE(nullptr, index.GetChildren(L"\\"));
+    EXPECT_EQ(nullptr, index.GetChildren(L"Project"));
+
+    // 교체해도 먼저 받은 스냅샷은 그대로 유지
+    index.SetChildren(L"project\\tracks", MakeEntries(5));
+    EXPECT_EQ(3u, children->size());
+    EXPECT_EQ(5u, index.GetChildren(L"Project/Tracks")->size());
+    EXPECT_EQ(2u, index.DirectoryCount());
+
+    index.Remove(L"PROJECT/TRACKS/");
+    EXPECT_EQ(nullptr, index.GetChildren(L"Project/Tracks"));
+    index.Clear();
+    EXPECT_EQ(0u, index.DirectoryCount());
+}
+
+TEST(CfApiBackendTest, TransfersPlaceholdersInPagesOf512) {
+    TempDirectory root;
+    cfapi_stub::Reset();
+    CfApiBackend backend;
+    ASSERT_EQ(S_OK, backend.Connect(root.WidePath() + L"\\Drive", L"Test Drive", BackendSyncPolicy(), nullptr));
+
+    const size_t pageSize = CfApiBackend::kPlaceholderPageSize;
+    ASSERT_EQ(512u, pageSize);
+    std::vector<PlaceholderEntry> entries = MakeEntries(pageSize * 2 + 76);
+    EXPECT_EQ(S_OK, backend.TransferPlaceholders(MakeFetchKey(cfapi_stub::Get().connectionKey), L"Album", &entries));
+
+    auto operations = cfapi_stub::Operations(CF_OPERATION_TYPE_TRANSFER_PLACEHOLDERS);
+    ASSERT_EQ(3u, operations.size());
+    EXPECT_EQ(static_cast<LONGLONG>(pageSize), operations[0].length);
+    EXPECT_EQ(static_cast<LONGLONG>(pageSize), operations[1].length);
+    EXPECT_EQ(76, operations[2].length);
+
+    // 폴더가 모두 채워졌다는 표시는 마지막 페이지에만
+    EXPECT_EQ(static_cast<DWORD>(CF_OPERATION_TRANSFER_PLACEHOLDERS_FLAG_NONE), operations[0].flags);
+    EXPECT_EQ(static_cast<DWORD>(CF_OPERATION_TRANSFER_PLACEHOLDERS_FLAG_NONE), operations[1].flags);
+    EXPECT_EQ(static_cast<DWORD>(CF_OPERATION_TRANSFER_PLACEHOLDERS_FLAG_DISABLE_ON_DEMAND_POPULATION), operations[2].flags);
+
+    // 페이지 경계에서 항목이 빠지거나 겹치지 않음
+    EXPECT_EQ(L"Track 0.wav", operations[0].placeholderNames.front());
+    EXPECT_EQ(L"Track 511.wav", operations[0].placeholderNames.back());
+    EXPECT_EQ(L"Track 512.wav", operations[1].placeholderNames.front());
+    EXPECT_EQ(L"Track 1099.wav", operations[2].placeholderNames.back());
+    for (const auto& operation : operations) {
+        EXPECT_EQ(STATUS_SUCCESS, operation.completionStatus);
+    }
+    backend.Disconnect();
+}
+
+TEST(CfApiBackendTest, ExactPageAndEmptyFolderCompleteInOneCall) {
+    TempDirectory root;
+    cfapi_stub::Reset();
+    CfApiBackend backend;
+    ASSERT_EQ(S_OK, backend.Connect(root.WidePath() + L"\\Drive", L"Test Drive", BackendSyncPolicy(), nullptr));
+    const FetchKey key = MakeFetchKey(cfapi_stub::Get().connectionKey);
+
+    std::vector<PlaceholderEntry> fullPage = MakeEntries(CfApiBackend::kPlaceholderPageSize);
+    std::vector<PlaceholderEntry> empty;
+    EXPECT_EQ(S_OK, backend.TransferPlaceholders(key, L"Full", &fullPage));
+    EXPECT_EQ(S_OK, backend.TransferPlaceholders(key, L"Empty", &empty));
+    // 목록을 모르는 폴더는 채우기를 끄지 않아 다음 열거 때 다시 요청됨
+    EXPECT_EQ(S_OK, backend.TransferPlaceholders(key, L"Unknown", nullptr));
+
+    auto operations = cfapi_stub::Operations(CF_OPERATION_TYPE_TRANSFER_PLACEHOLDERS);
+    ASSERT_EQ(3u, operations.size());
+    EXPECT_EQ(static_cast<LONGLONG>(CfApiBackend::kPlaceholderPageSize), operations[0].length);
+    EXPECT_EQ(static_cast<DWORD>(CF_OPERATION_TRANSFER_PLACEHOLDERS_FLAG_DISABLE_ON_DEMAND_POPULATION), operations[0].flags);
+    EXPECT_EQ(0, operations[1].length);
+    EXPECT_EQ(static_cast<DWORD>(CF_OPERATION_TRANSFER_PLACEHOLDERS_FLAG_DISABLE_ON_DEMAND_POPULATION), operations[1].flags);
+    EXPECT_EQ(0, operations[2].length);
+    EXPECT_EQ(static_cast<DWORD>(CF_OPERATION_TRANSFER_PLACEHOLDERS_FLAG_NONE), operations[2].flags);
+    backend.Disconnect();
+}
+
+class FetchPlaceholdersTest : public ProviderTest {};
+
+TEST_F(FetchPlaceholdersTest, UnknownFolderCompletesEmptyAndAsksTheApp) {
+    std::vector<std::pair<std::wstring, std::wstring>> notifications;
+    Provider().SetNotifyCallback([&notifications](const std::wstring& path, const std::wstring& event) {
+        notifications.push_back({ path, event });
+    });
+
+    m_backend->FetchPlaceholders(L"Project\\Unlisted", 501);
+    Provider().SetNotifyCallback(nullptr);
+
+    auto transfers = m_backend->PlaceholderTransfers();
+    ASSERT_EQ(1u, transfers.size());
+    EXPECT_FALSE(transfers[0].hasChildren);
+    EXPECT_EQ(501, transfers[0].key.transferKey);
+    EXPECT_EQ(L"Project\\Unlisted", transfers[0].relativeDirectory);
+
+    ASSERT_EQ(1u, notifications.size());
+    EXPECT_EQ(L"Project\\Unlisted", notifications[0].first);
+    EXPECT_EQ(L"directory_requested", notifications[0].second);
+}
+
+TEST_F(FetchPlaceholdersTest, KnownFolderTransfersIndexedChildren) {
+    std::vector<std::wstring> events;
+    Provider().SetNotifyCallback([&events](const std::wstring&, const std::wstring& event) { events.push_back(event); });
+    Provider().SetDirectoryContents(L"project/album/", MakeEntries(3));
+
+    m_backend->FetchPlaceholders(L"Project\\Album", 502);
+    Provider().SetNotifyCallback(nullptr);
+    Provider().RemoveDirectoryContents(L"Project\\Album");
+
+    auto transfers = m_backend->PlaceholderTransfers();
+    ASSERT_EQ(1u, transfers.size());
+    EXPECT_TRUE(transfers[0].hasChildren);
+    EXPECT_EQ((std::vector<std::wstring>{ L"Track 0.wav", L"Track 1.wav", L"Track 2.wav" }), transfers[0].names);
+    EXPECT_TRUE(events.empty());
+
+    MbdMetricsSnapshot snapshot = {};
+    snapshot.structSize = sizeof(snapshot);
+    Provider().GetMetricsSnapshot(snapshot);
+    EXPECT_EQ(3u, snapshot.placeholdersCreated);
+    EXPECT_EQ(1u, snapshot.fetchPlaceholders.count);
+}
@@ -0,0 +1,332 @@
+#pragma once
+
+// 테스트용 ProviderBackend 구현
+// 엔진이 보내는 응답(TransferData/FailTransfer/AckData 등)을 기록하고, 테스트가 Events()로 OS 이벤트를 직접 발생시킴
+
+#include <windows.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ProviderBackend.h"
+
+class FakeBackend : public ProviderBackend {
+public:
+    struct Transfer {
+        FetchKey key;
+        LONGLONG offset = 0;
+        LONGLONG length = 0;
+        std::vector<BYTE> data;
+    };
+
+    struct Failure {
+        FetchKey key;
+        LONGLONG offset = 0;
+        LONGLONG length = 0;
+        TransferFailure reason = TransferFailure::Failed;
+    };
+
+    struct Ack {
+        FetchKey key;
+        LONGLONG offset = 0;
+        LONGLONG length = 0;
+        bool valid = false;
+    };
+
+    struct Progress {
+        FetchKey key;
+        LONGLONG total = 0;
+        LONGLONG completed = 0;
+    };
+
+    // children이 없으면 목록 없이 빈 결과로 완료한 호출
+    struct PlaceholderTransfer {
+        FetchKey key;
+        std::wstring relativeDirectory;
+        bool hasChildren = false;
+        std::vector<std::wstring> names;
+    };
+
+    struct StateChange {
+        std::wstring relativePath;
+        int state = 0;
+    };
+
+    const wchar_t* Name() const override { return L"fake"; }
+
+    HRESULT Connect(const std::wstring& syncRootPath, const std::wstring&, const BackendSyncPolicy& policy,
+                    ProviderBackendEvents* events) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_syncRootPath = syncRootPath;
+        m_policy = policy;
+        m_events = events;
+        return S_OK;
+    }
+
+    void Disconnect() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_events = nullptr;
+        m_disconnects++;
+    }
+
+    HRESULT Unregister(const std::wstring&) override { return S_OK; }
+
+    HRESULT CreatePlaceholders(const std::wstring& parentRelativePath, const PlaceholderEntry* entries, size_t count,
+                               std::vector<HRESULT>& results) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        results.assign(count, S_OK);
+        for (size_t i = 0; i < count; ++i) {
+            m_placeholders.push_back(parentRelativePath.empty() ? entries[i].name : parentRelativePath + L"\\" + entries[i].name);
+        }
+        return S_OK;
+    }
+
+    HRESULT TransferPlaceholders(const FetchKey& key, const std::wstring& relativeDirectory,
+                                 const std::vector<PlaceholderEntry>* children) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        PlaceholderTransfer transfer{ key, relativeDirectory, children != nullptr, {} };
+        if (children) {
+            for (const auto& entry : *children) {
+                transfer.names.push_back(entry.name);
+            }
+        }
+        m_placeholderTransfers.push_back(std::move(transfer));
+        return S_OK;
+    }
+
+    HRESULT TransferData(const FetchKey& key, const BYTE* buffer, LONGLONG offset, LONGLONG length) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_transfers.push_back({ key, offset, length, std::vector<BYTE>(buffer, buffer + length) });
+        m_changed.notify_all();
+        return S_OK;
+    }
+
+    HRESULT FailTransfer(const FetchKey& key, LONGLONG offset, LONGLONG length, TransferFailure reason) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_failures.push_back({ key, offset, length, reason });
+        m_changed.notify_all();
+        return S_OK;
+    }
+
+    void ReportProgress(const FetchKey& key, LONGLONG total, LONGLONG completed) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_progress.push_back({ key, total, completed });
+    }
+
+    // SetHydratedData로 정한 파일 내용을 돌려줌 (전송 키별)
+    HRESULT RetrieveData(const FetchKey& key, BYTE* buffer, LONGLONG offset, LONGLONG length, LONGLONG& returnedLength) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const std::vector<BYTE>& data = m_hydrated[key.transferKey];
+        LONGLONG available = (std::max)(0LL, static_cast<LONGLONG>(data.size()) - offset);
+        returnedLength = (std::min)(available, length);
+        if (returnedLength > 0) {
+            memcpy(buffer, data.data() + offset, static_cast<size_t>(returnedLength));
+        }
+        return S_OK;
+    }
+
+    HRESULT AcknowledgeData(const FetchKey& key, LONGLONG offset, LONGLONG length, bool valid) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_acks.push_back({ key, offset, length, valid });
+        m_changed.notify_all();
+        return S_OK;
+    }
+
+    HRESULT HydratePlaceholder(const std::wstring& relativePath) override {
+        std::function<HRESULT(const std::wstring&)> hook;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_hydrations.push_back(relativePath);
+            hook = m_onHydrate;
+        }
+        return hook ? hook(relativePath) : S_OK;
+    }
+
+    // 전송 키는 1000부터 차례로 발급 (FetchData로 흉내 낸 키와 겹치지 않게)
+    HRESULT WithTransferKey(const std::wstring& relativePath,
+                            const std::function<HRESULT(const FetchKey& key)>& operation) override {
+        FetchKey key;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            key = MakeKey(relativePath, m_nextTransferKey++);
+        }
+        return operation(key);
+    }
+
+    HRESULT SetInSyncState(const std::wstring& relativePath, InSyncState state) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_inSyncChanges.push_back({ relativePath, static_cast<int>(state) });
+        m_changed.notify_all();
+        return m_stateResult;
+    }
+
+    HRESULT SetPinState(const std::wstring& relativePath, PinState state) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pinChanges.push_back({ relativePath, static_cast<int>(state) });
+        return m_stateResult;
+    }
+
+    // --- 테스트 도우미 ---
+
+    ProviderBackendEvents* Events() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_events;
+    }
+
+    BackendSyncPolicy Policy() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_policy;
+    }
+
+    // OS가 보내는 FETCH_DATA 흉내 (전송 키는 transferKey, 파일 ID는 경로마다 다르게)
+    // processId는 요청한 프로세스 (0이면 알 수 없음)
+    void FetchData(const std::wstring& relativePath, LONGLONG fileSize, LONGLONG transferKey, LONGLONG offset, LONGLONG length,
+                   const void* identity = nullptr, size_t identityLength = 0, DWORD processId = 0) {
+        BackendFileInfo file = MakeFile(relativePath, fileSize, identity, identityLength);
+        file.processId = processId;
+        Events()->OnFetchData(file, MakeKey(relativePath, transferKey), offset, length);
+    }
+
+    void FetchPlaceholders(const std::wstring& relativeDirectory, LONGLONG transferKey) {
+        BackendFileInfo directory = MakeFile(relativeDirectory, 0, nullptr, 0);
+        Events()->OnFetchPlaceholders(directory, MakeKey(relativeDirectory, transferKey));
+    }
+
+    void CancelFetchData(const std::wstring& relativePath, LONGLONG fileSize, LONGLONG transferKey, LONGLONG offset, LONGLONG length) {
+        BackendFileInfo file = MakeFile(relativePath, fileSize, nullptr, 0);
+        Events()->OnCancelFetchData(file, MakeKey(relativePath, transferKey), offset, length);
+    }
+
+    // OS가 보내는 VALIDATE_DATA 흉내 (RetrieveData는 SetHydratedData로 정한 내용을 읽음)
+    void ValidateData(const std::wstring& relativePath, LONGLONG fileSize, LONGLONG transferKey, LONGLONG offset, LONGLONG length,
+                      const void* identity = nullptr, size_t identityLength = 0) {
+        BackendFileInfo file = MakeFile(relativePath, fileSize, identity, identityLength);
+        Events()->OnValidateData(file, MakeKey(relativePath, transferKey), offset, length);
+    }
+
+    FetchKey MakeKey(const std::wstring& relativePath, LONGLONG transferKey) const {
+        FetchKey key;
+        key.connectionKey = 1;
+        key.transferKey = transferKey;
+        key.fileId = static_cast<LONGLONG>(std::hash<std::wstring>()(relativePath) & 0x7fffffff);
+        return key;
+    }
+
+    void SetHydratedData(LONGLONG transferKey, std::vector<BYTE> data) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_hydrated[transferKey] = std::move(data);
+    }
+
+    // SetInSyncState/SetPinState가 돌려줄 결과
+    void SetStateResult(HRESULT result) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stateResult = result;
+    }
+
+    void SetHydrateHook(std::function<HRESULT(const std::wstring&)> hook) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_onHydrate = std::move(hook);
+    }
+
+    // 조건이 참이 될 때까지 기록이 바뀔 때마다(또는 10ms마다) 확인 (시간 초과면 false)
+    bool WaitFor(const std::function<bool(FakeBackend&)>& condition, std::chrono::milliseconds timeout = std::chrono::seconds(10)) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!condition(*this)) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_changed.wait_until(lock, (std::min)(deadline, std::chrono::steady_clock::now() + std::chrono::milliseconds(10))) ==
+                    std::cv_status::timeout && std::chrono::steady_clock::now() >= deadline) {
+                lock.unlock();
+                return condition(*this);
+            }
+        }
+        return true;
+    }
+
+    // 전송 키 하나로 지금까지 전송된 바이트 수
+    LONGLONG TransferredBytes(LONGLONG transferKey) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        LONGLONG total = 0;
+        for (const auto& transfer : m_transfers) {
+            if (transfer.key.transferKey == transferKey) {
+                total += transfer.length;
+            }
+        }
+        return total;
+    }
+
+    // 전송 키 하나로 전송된 데이터를 오프셋 순으로 이어 붙임 (겹치거나 빈 곳이 있으면 빈 벡터)
+    std::vector<BYTE> TransferredData(LONGLONG transferKey) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::map<LONGLONG, const Transfer*> ordered;
+        for (const auto& transfer : m_transfers) {
+            if (transfer.key.transferKey == transferKey) {
+                ordered[transfer.offset] = &transfer;
+            }
+        }
+        std::vector<BYTE> data;
+        LONGLONG next = ordered.empty() ? 0 : ordered.begin()->first;
+        for (const auto& entry : ordered) {
+            if (entry.first != next) {
+                return {};
+            }
+            data.insert(data.end(), entry.second->data.begin(), entry.second->data.end());
+            next += entry.second->length;
+        }
+        return data;
+    }
+
+    std::vector<Transfer> Transfers() { std::lock_guard<std::mutex> lock(m_mutex); return m_transfers; }
+    std::vector<Failure> Failures() { std::lock_guard<std::mutex> lock(m_mutex); return m_failures; }
+    std::vector<Ack> Acks() { std::lock_guard<std::mutex> lock(m_mutex); return m_acks; }
+    std::vector<Progress> ProgressReports() { std::lock_guard<std::mutex> lock(m_mutex); return m_progress; }
+    std::vector<std::wstring> Placeholders() { std::lock_guard<std::mutex> lock(m_mutex); return m_placeholders; }
+    std::vector<PlaceholderTransfer> PlaceholderTransfers() { std::lock_guard<std::mutex> lock(m_mutex); return m_placeholderTransfers; }
+    std::vector<std::wstring> Hydrations() { std::lock_guard<std::mutex> lock(m_mutex); return m_hydrations; }
+    std::vector<StateChange> InSyncChanges() { std::lock_guard<std::mutex> lock(m_mutex); return m_inSyncChanges; }
+    std::vector<StateChange> PinChanges() { std::lock_guard<std::mutex> lock(m_mutex); return m_pinChanges; }
+    int Disconnects() { std::lock_guard<std::mutex> lock(m_mutex); return m_disconnects; }
+
+private:
+    BackendFileInfo MakeFile(const std::wstring& relativePath, LONGLONG fileSize, const void* identity, size_t identityLength) {
+        // BackendFileInfo는 경로를 가리키기만 하므로 콜백이 끝날 때까지 유지되는 저장소에 보관
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const std::wstring& stored = *m_paths.insert(relativePath).first;
+        BackendFileInfo file;
+        file.relativePath = stored.c_str();
+        file.relativePathLength = stored.size();
+        file.displayPath = stored.c_str();
+        file.fileIdentity = identity;
+        file.fileIdentityLength = identityLength;
+        file.fileSize = fileSize;
+        return file;
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::wstring m_syncRootPath;
+    BackendSyncPolicy m_policy;
+    ProviderBackendEvents* m_events = nullptr;
+    int m_disconnects = 0;
+
+    std::set<std::wstring> m_paths;
+    std::vector<Transfer> m_transfers;
+    std::vector<Failure> m_failures;
+    std::vector<Ack> m_acks;
+    std::vector<Progress> m_progress;
+    std::vector<std::wstring> m_placeholders;
+    std::vector<std::wstring> m_hydrations;
+    std::vector<PlaceholderTransfer> m_placeholderTransfers;
+    std::unordered_map<LONGLONG, std::vector<BYTE>> m_hydrated;
+    std::function<HRESULT(const std::wstring&)> m_onHydrate;
+    std::vector<StateChange> m_inSyncChanges;
+    std::vector<StateChange> m_pinChanges;
+    HRESULT m_stateResult = S_OK;
+    LONGLONG m_nextTransferKey = 1000;
+};
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+#include "FetchExecutor.h"
+#include "ProviderTestFixture.h"
+#include "CfApiBackend.h"
+
+namespace {
+
+// 워커를 막아 두는 관문
+class Gate {
+public:
+    void Open() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_open = true;
+        m_changed.notify_all();
+    }
+
+    void Wait() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_entered++;
+        m_changed.notify_all();
+        m_changed.wait(lock, [this]() { return m_open; });
+    }
+
+    bool WaitEntered(size_t count) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_changed.wait_for(lock, std::chrono::seconds(10), [&]() { return m_entered >= count; });
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    bool m_open = false;
+    size_t m_entered = 0;
+};
+
+FetchExecutorConfig Workers(size_t count) {
+    FetchExecutorConfig config;
+    config.workerCount = count;
+    return config;
+}
+
+} // namespace
+
+TEST(FetchExecutorTest, RunsTasksConcurrently) {
+    FetchExecutor executor(Workers(4));
+    executor.Start();
+    EXPECT_EQ(4u, executor.GetWorkerCount());
+
+    Gate gate;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_NE(0u, executor.Submit(L"Tracks\\a.wav", HydrationPriority::Foreground, [&gate]() { gate.Wait(); }));
+    }
+    // 네 작업이 동시에 관문에 도달해야 함
+    EXPECT_TRUE(gate.WaitEntered(4));
+    gate.Open();
+    executor.Stop();
+    EXPECT_EQ(4u, executor.GetStats().completedTasks);
+}
+
+TEST(FetchExecutorTest, SubmitOutsideRunningStateIsRejected) {
+    FetchExecutor executor(Workers(1));
+    EXPECT_EQ(0u, executor.Submit(L"a", HydrationPriority::Foreground, []() {}));
+
+    executor.Start();
+    EXPECT_NE(0u, executor.Submit(L"a", HydrationPriority::Foreground, []() {}));
+    executor.Stop();
+
+    bool dropped = false;
+    EXPECT_EQ(0u, executor.Submit(L"a", HydrationPriority::Foreground, []() {}, [&]() { dropped = true; }));
+    EXPECT_FALSE(dropped);  // 받지 않은 작업은 호출자가 처리
+}
+
+TEST(FetchExecutorTest, StopDropsQueuedTasksAndNotifiesThem) {
+    FetchExecutor executor(Workers(1));
+    executor.Start();
+
+    Gate gate;
+    std::atomic<int> ran{ 0 };
+    std::atomic<int> dropped{ 0 };
+    executor.Submit(L"a", HydrationPriority::Foreground, [&]() { gate.Wait(); ran++; }, [&]() { dropped++; });
+    ASSERT_TRUE(gate.WaitEntered(1));
+    for (int i = 0; i < 3; ++i) {
+        executor.Submit(L"b", HydrationPriority::Foreground, [&]() { ran++; }, [&]() { dropped++; });
+    }
+
+    // Close는 실행 중인 작업을 기다리지 않고 큐에 남은 작업만 버림
+    executor.Close();
+    EXPECT_EQ(3, dropped.load());
+    EXPECT_EQ(0, ran.load());
+    EXPECT_EQ(0u, executor.Submit(L"c", HydrationPriority::Foreground, [&]() { ran++; }));
+
+    gate.Open();
+    executor.Stop();
+    EXPECT_EQ(1, ran.load());
+    EXPECT_EQ(3, dropped.load());
+    EXPECT_EQ(3u, executor.GetStats().abortedTasks);
+}
+
+TEST(FetchExecutorTest, CancelRemovesQueuedTaskWithoutDropNotification) {
+    FetchExecutor executor(Workers(1));
+    executor.Start();
+
+    Gate gate;
+    std::atomic<bool> ran{ false };
+    std::atomic<bool> dropped{ false };
+    uint64_t first = executor.Submit(L"a", HydrationPriority::Foreground, [&]() { gate.Wait(); });
+    ASSERT_TRUE(gate.WaitEntered(1));
+    uint64_t second = executor.Submit(L"b", HydrationPriority::Foreground, [&]() { ran = true; }, [&]() { dropped = true; });
+
+    EXPECT_FALSE(executor.Cancel(first));  // 이미 실행 중
+    EXPECT_TRUE(executor.Cancel(second));
+    EXPECT_FALSE(executor.Cancel(second));
+    gate.Open();
+    executor.Stop();
+
+    EXPECT_FALSE(ran.load());
+    EXPECT_FALSE(dropped.load());
+    EXPECT_EQ(1u, executor.GetStats().cancelledTasks);
+}
+
+TEST(FetchExecutorTest, RecommendedWorkerCountScalesWithBlockingRatio) {
+    size_t cores = (std::max)(std::thread::hardware_concurrency(), 1u);
+    EXPECT_EQ((std::min)(cores * 11, static_cast<size_t>(64)), FetchExecutor::RecommendedWorkerCount(50.0, 5.0, 64));
+    EXPECT_EQ(cores, FetchExecutor::RecommendedWorkerCount(0.0, 5.0, 64));
+    EXPECT_EQ(1u, FetchExecutor::RecommendedWorkerCount(1000.0, 1.0, 1));
+}
+
+class ShutdownTest : public ProviderTest {
+protected:
+    void Configure(CloudFilesProvider& provider) override {
+        FetchExecutorConfig executorConfig;
+        executorConfig.workerCount = 1;
+        provider.SetExecutorConfig(executorConfig);
+        provider.SetStreamingFetchCallback(m_source.Callback());
+    }
+
+    TestDataSource m_source{ MakePattern(1024 * 1024) };
+};
+
+TEST_F(ShutdownTest, QueuedDownloadsAreAbortedBeforeDisconnect) {
+    const LONGLONG fileSize = static_cast<LONGLONG>(m_source.Content().size());
+    m_source.Block();
+    m_backend->FetchData(L"a.wav", fileSize, 1, 0, fileSize);
+    ASSERT_TRUE(m_source.WaitUntilWaiting());
+    m_backend->FetchData(L"b.wav", fileSize, 2, 0, 65536);
+    m_backend->FetchData(L"b.wav", fileSize, 3, 0, 4096);
+
+    // 실행 중인 다운로드가 막혀 있어도 Shutdown은 큐의 요청을 먼저 끝내고 연결을 끊음
+    auto shutdown = std::async(std::launch::async, []() { Provider().Shutdown(); });
+    ASSERT_TRUE(m_backend->WaitFor([](FakeBackend& backend) { return backend.Disconnects() == 1; }));
+
+    auto failures = m_backend->Failures();
+    ASSERT_EQ(2u, failures.size());
+    std::set<LONGLONG> failedKeys;
+    for (const auto& failure : failures) {
+        EXPECT_EQ(TransferFailure::Aborted, failure.reason);
+        failedKeys.insert(failure.key.transferKey);
+    }
+    EXPECT_EQ((std::set<LONGLONG>{ 2, 3 }), failedKeys);
+    EXPECT_EQ(std::future_status::timeout, shutdown.wait_for(std::chrono::milliseconds(0)));
+
+    m_source.Release();
+    shutdown.get();
+    EXPECT_EQ(1u, m_source.Requests().size());
+}
+
+TEST_F(ShutdownTest, CfApiBackendReportsAbortedStatus) {
+    cfapi_stub::Reset();
+    CfApiBackend backend;
+    ASSERT_EQ(S_OK, backend.Connect(m_cacheRoot.WidePath() + L"\\CfDrive", L"Test Drive", BackendSyncPolicy(), nullptr));
+
+    FetchKey key;
+    key.transferKey = 5;
+    backend.FailTransfer(key, 0, 4096, TransferFailure::Aborted);
+    backend.FailTransfer(key, 4096, 4096, TransferFailure::Failed);
+    backend.Disconnect();
+
+    auto operations = cfapi_stub::Operations(CF_OPERATION_TYPE_TRANSFER_DATA);
+    ASSERT_EQ(2u, operations.size());
+    EXPECT_EQ(STATUS_CLOUD_FILE_REQUEST_ABORTED, operations[0].completionStatus);
+    EXPECT_EQ(STATUS_CLOUD_FILE_UNSUCCESSFUL, operations[1].completionStatus);
+}
+
+TEST_F(ShutdownTest, StopsTheLoggerItStarted) {
+    // 정적 소멸자에 기대지 않고 Shutdown에서 로거를 정지
+    EXPECT_TRUE(Logger::Instance().IsRunning());
+    Provider().Shutdown();
+    EXPECT_FALSE(Logger::Instance().IsRunning());
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include "FetchStream.h"
+
+namespace {
+
+struct Chunk {
+    LONGLONG offset;
+    LONGLONG length;
+    std::vector<BYTE> data;
+};
+
+std::vector<BYTE> Bytes(size_t count, BYTE first = 0) {
+    std::vector<BYTE> data(count);
+    for (size_t i = 0; i < count; ++i) {
+        data[i] = static_cast<BYTE>(first + i);
+    }
+    return data;
+}
+
+ChunkedFetchSink::ChunkWriter Recorder(std::vector<Chunk>& chunks) {
+    return [&chunks](const BYTE* buffer, LONGLONG offset, LONGLONG length) {
+        chunks.push_back({ offset, length, std::vector<BYTE>(buffer, buffer + length) });
+        return S_OK;
+    };
+}
+
+} // namespace
+
+TEST(ChunkedFetchSinkTest, RegroupsSmallWritesIntoFixedChunks) {
+    std::vector<Chunk> chunks;
+    ChunkedFetchSink sink(4096, 10, 4, Recorder(chunks));
+    std::vector<BYTE> data = Bytes(10);
+
+    EXPECT_EQ(S_OK, sink.Write(data.data(), 3));
+    EXPECT_EQ(S_OK, sink.Write(data.data() + 3, 3));
+    EXPECT_EQ(S_OK, sink.Write(data.data() + 6, 4));
+    EXPECT_EQ(S_OK, sink.Finish());
+
+    ASSERT_EQ(3u, chunks.size());
+    EXPECT_EQ(4096, chunks[0].offset);
+    EXPECT_EQ(4, chunks[0].length);
+    EXPECT_EQ(4100, chunks[1].offset);
+    EXPECT_EQ(4104, chunks[2].offset);
+    EXPECT_EQ(2, chunks[2].length);
+    std::vector<BYTE> joined;
+    for (const auto& chunk : chunks) {
+        joined.insert(joined.end(), chunk.data.begin(), chunk.data.end());
+    }
+    EXPECT_EQ(data, joined);
+    EXPECT_EQ(4106, sink.CommittedOffset());
+}
+
+TEST(ChunkedFetchSinkTest, PassesLargeWritesThroughWithoutStaging) {
+    std::vector<Chunk> chunks;
+    std::vector<BYTE> data = Bytes(8);
+    ChunkedFetchSink sink(0, 8, 4, [&](const BYTE* buffer, LONGLONG offset, LONGLONG length) {
+        // 스테이징 없이 호출자 버퍼를 그대로 넘김
+        EXPECT_EQ(data.data() + offset, buffer);
+        chunks.push_back({ offset, length, {} });
+        return S_OK;
+    });
+
+    EXPECT_EQ(S_OK, sink.Write(data.data(), data.size()));
+    EXPECT_EQ(S_OK, sink.Finish());
+    EXPECT_EQ(2u, chunks.size());
+}
+
+TEST(ChunkedFetchSinkTest, DropsDataBeyondRange) {
+    std::vector<Chunk> chunks;
+    ChunkedFetchSink sink(0, 5, 4, Recorder(chunks));
+    std::vector<BYTE> data = Bytes(9);
+
+    EXPECT_EQ(S_OK, sink.Write(data.data(), data.size()));
+    EXPECT_EQ(S_OK, sink.Finish());
+    ASSERT_EQ(2u, chunks.size());
+    EXPECT_EQ(1, chunks[1].length);
+    EXPECT_EQ(5, sink.CommittedOffset());
+}
+
+TEST(ChunkedFetchSinkTest, ShortRangeFailsWithoutFlushingPartialChunk) {
+    std::vector<Chunk> chunks;
+    ChunkedFetchSink sink(0, 10, 4, Recorder(chunks));
+    std::vector<BYTE> data = Bytes(6);
+
+    EXPECT_EQ(S_OK, sink.Write(data.data(), data.size()));
+    EXPECT_EQ(HRESULT_FROM_WIN32(ERROR_HANDLE_EOF), sink.Finish());
+    ASSERT_EQ(1u, chunks.size());
+    EXPECT_EQ(4, sink.CommittedOffset());
+}
+
+TEST(ChunkedFetchSinkTest, WriterFailureStopsFurtherWrites) {
+    int calls = 0;
+    ChunkedFetchSink sink(0, 12, 4, [&](const BYTE*, LONGLONG, LONGLONG) {
+        return ++calls == 2 ? E_FAIL : S_OK;
+    });
+    std::vector<BYTE> data = Bytes(12);
+
+    EXPECT_EQ(S_OK, sink.Write(data.data(), 4));
+    EXPECT_EQ(E_FAIL, sink.Write(data.data() + 4, 4));
+    EXPECT_EQ(E_FAIL, sink.Write(data.data() + 8, 4));
+    EXPECT_EQ(E_FAIL, sink.Finish());
+    EXPECT_EQ(2, calls);
+    EXPECT_EQ(4, sink.CommittedOffset());
+}
+
+TEST(ChunkedFetchSinkTest, CancelledSinkRejectsWrites) {
+    auto token = std::make_shared<CancelToken>();
+    std::vector<Chunk> chunks;
+    ChunkedFetchSink sink(0, 12, 4, Recorder(chunks), token);
+    std::vector<BYTE> data = Bytes(12);
+
+    EXPECT_EQ(S_OK, sink.Write(data.data(), 6));
+    token->Cancel();
+    EXPECT_TRUE(sink.IsCancelled());
+    EXPECT_EQ(HRESULT_FROM_WIN32(ERROR_CANCELLED), sink.Write(data.data() + 6, 6));
+    EXPECT_EQ(HRESULT_FROM_WIN32(ERROR_CANCELLED), sink.Finish());
+    EXPECT_EQ(1u, chunks.size());
+}
+
+TEST(FetchAdapterTest, WholeFileCallbackServesRequestedRange) {
+    std::vector<BYTE> file = Bytes(20);
+    auto callback = MakeStreamingFetchCallback(
+        std::function<std::vector<BYTE>(const std::wstring&)>([&](const std::wstring&) { return file; }));
+
+    std::vector<Chunk> chunks;
+    ChunkedFetchSink sink(8, 8, 4, Recorder(chunks));
+    FetchRequest request;
+    request.offset = 8;
+    request.length = 8;
+    EXPECT_EQ(S_OK, callback(request, sink));
+    EXPECT_EQ(S_OK, sink.Finish());
+    ASSERT_EQ(2u, chunks.size());
+    EXPECT_EQ(std::vector<BYTE>(file.begin() + 8, file.begin() + 12), chunks[0].data);
+}
+
+TEST(FetchAdapterTest, RangedCallbackIsCalledPerPreferredChunk) {
+    std::vector<BYTE> file = Bytes(10);
+    std::vector<std::pair<LONGLONG, LONGLONG>> calls;
+    auto callback = MakeStreamingFetchCallback(std::function<std::vector<BYTE>(const std::wstring&, LONGLONG, LONGLONG)>(
+        [&](const std::wstring&, LONGLONG offset, LONGLONG length) {
+            calls.emplace_back(offset, length);
+            return std::vector<BYTE>(file.begin() + offset, file.begin() + offset + length);
+        }));
+
+    std::vector<Chunk> chunks;
+    ChunkedFetchSink sink(0, 10, 4, Recorder(chunks));
+    FetchRequest request;
+    request.length = 10;
+    EXPECT_EQ(S_OK, callback(request, sink));
+    EXPECT_EQ(S_OK, sink.Finish());
+    ASSERT_EQ(3u, calls.size());
+    EXPECT_EQ(std::make_pair(8LL, 2LL), calls[2]);
+}
+
+TEST(FetchAdapterTest, EmptyRangedResultReportsEof) {
+    auto callback = MakeStreamingFetchCallback(std::function<std::vector<BYTE>(const std::wstring&, LONGLONG, LONGLONG)>(
+        [](const std::wstring&, LONGLONG, LONGLONG) { return std::vector<BYTE>(); }));
+
+    std::vector<Chunk> chunks;
+    ChunkedFetchSink sink(0, 4, 4, Recorder(chunks));
+    FetchRequest request;
+    request.length = 4;
+    EXPECT_EQ(HRESULT_FROM_WIN32(ERROR_HANDLE_EOF), callback(request, sink));
+}
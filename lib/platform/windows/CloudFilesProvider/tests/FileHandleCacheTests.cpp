@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <cfapi.h>
+#include "FileHandleCache.h"
+
+namespace {
+
+FileHandleCache::FullPathResolver PathFor(PathId key) {
+    return [key]() { return L"C:\\Drive\\" + std::to_wstring(key); };
+}
+
+HRESULT Touch(FileHandleCache& cache, PathId key) {
+    return cache.WithHandle(key, PathFor(key), [](HANDLE) { return S_OK; });
+}
+
+// key 파일에 대해 기록된 stub 호출 수
+size_t CountCalls(const std::string& operation, PathId key) {
+    size_t count = 0;
+    for (const auto& call : cfapi_stub::Get().handleCalls) {
+        if (call.operation == operation && call.path == PathFor(key)()) {
+            count++;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(FileHandleCacheTest, EvictsLeastRecentlyUsed) {
+    cfapi_stub::Reset();
+    FileHandleCache cache(2);
+
+    EXPECT_EQ(S_OK, Touch(cache, 1));
+    EXPECT_EQ(S_OK, Touch(cache, 2));
+    EXPECT_EQ(S_OK, Touch(cache, 1));  // 1이 가장 최근
+    EXPECT_EQ(S_OK, Touch(cache, 3));  // 2가 밀려남
+
+    EXPECT_EQ(1u, CountCalls("close", 2));
+    EXPECT_EQ(0u, CountCalls("close", 1));
+
+    EXPECT_EQ(S_OK, Touch(cache, 1));
+    EXPECT_EQ(S_OK, Touch(cache, 2));
+    EXPECT_EQ(1u, CountCalls("open", 1));
+    EXPECT_EQ(2u, CountCalls("open", 2));
+
+    FileHandleCacheStats stats = cache.GetStats();
+    EXPECT_EQ(2u, stats.openHandles);
+    EXPECT_EQ(2u, stats.hits);
+    EXPECT_EQ(4u, stats.misses);
+    EXPECT_EQ(2u, stats.evictions);
+}
+
+TEST(FileHandleCacheTest, EvictedHandleStaysValidWhileInUse) {
+    cfapi_stub::Reset();
+    FileHandleCache cache(1);
+
+    HRESULT inner = E_FAIL;
+    HRESULT hr = cache.WithHandle(1, PathFor(1), [&](HANDLE handle) {
+        // 사용 중에 다른 파일이 들어와 1이 목록에서 빠져도 핸들은 닫히지 않아야 함
+        inner = Touch(cache, 2);
+        EXPECT_EQ(0u, CountCalls("close", 1));
+        EXPECT_EQ(PathFor(1)(), static_cast<cfapi_stub::ProtectedHandle*>(handle)->path);
+        return S_OK;
+    });
+    EXPECT_EQ(S_OK, hr);
+    EXPECT_EQ(S_OK, inner);
+
+    // 마지막 사용자가 놓은 뒤에 닫힘
+    EXPECT_EQ(1u, CountCalls("close", 1));
+    EXPECT_EQ(1u, cache.GetStats().evictions);
+    EXPECT_EQ(1u, cache.GetStats().openHandles);
+}
+
+TEST(FileHandleCacheTest, ZeroCapacityDisablesCaching) {
+    cfapi_stub::Reset();
+    FileHandleCache cache(0);
+
+    EXPECT_EQ(S_OK, Touch(cache, 1));
+    EXPECT_EQ(S_OK, Touch(cache, 1));
+
+    EXPECT_EQ(2u, CountCalls("open", 1));
+    EXPECT_EQ(2u, CountCalls("close", 1));
+    FileHandleCacheStats stats = cache.GetStats();
+    EXPECT_EQ(0u, stats.openHandles);
+    EXPECT_EQ(0u, stats.hits);
+    EXPECT_EQ(0u, stats.evictions);
+}
+
+TEST(FileHandleCacheTest, ShrinkingCapacityClosesIdleHandles) {
+    cfapi_stub::Reset();
+    FileHandleCache cache(4);
+    for (PathId key = 1; key <= 3; ++key) {
+        EXPECT_EQ(S_OK, Touch(cache, key));
+    }
+
+    cache.SetCapacity(0);
+    EXPECT_EQ(0u, cache.GetStats().openHandles);
+    for (PathId key = 1; key <= 3; ++key) {
+        EXPECT_EQ(1u, CountCalls("close", key));
+    }
+}
+
+TEST(FileHandleCacheTest, InvalidateReopensOnNextUse) {
+    cfapi_stub::Reset();
+    FileHandleCache cache(4);
+
+    EXPECT_EQ(S_OK, Touch(cache, 1));
+    cache.Invalidate(1);
+    EXPECT_EQ(1u, CountCalls("close", 1));
+
+    EXPECT_EQ(S_OK, Touch(cache, 1));
+    EXPECT_EQ(2u, CountCalls("open", 1));
+}
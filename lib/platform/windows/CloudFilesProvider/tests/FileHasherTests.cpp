@@ -0,0 +1,85 @@
+#include "ProviderTestFixture.h"
+#include "FileHasher.h"
+#include "FileHashApi.h"
+#include <fstream>
+
+namespace {
+
+// test/utils/file_utils_test.dart(Dart 스트림 구현)와 같은 입력과 기대값으로 두 구현이 같은 해시를 내는지 고정
+// 내용: i % 251 바이트, 길이 2 x 4MB + 12345 (마지막 블록이 짧음)
+const size_t kVectorLength = 2 * 4 * 1024 * 1024 + 12345;
+const char kVectorTreeRoot[] = "1e4187d74c09ac5ecba418360e3aff8c86fed9e00ece62a4b8383a72b85f2cee";
+const char kVectorSha256[] = "2e95664474287447c6912034943e1fd218a31c3531caa5c25fec3428a519d8a7";
+const char kEmptySha256[] = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+
+std::string Hex(const BYTE* bytes, size_t length) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    for (size_t i = 0; i < length; ++i) {
+        hex.push_back(digits[bytes[i] >> 4]);
+        hex.push_back(digits[bytes[i] & 0x0F]);
+    }
+    return hex;
+}
+
+std::wstring WriteVector(TempDirectory& root, const char* name, size_t length) {
+    std::ofstream file(root.Path() + "/" + name, std::ios::binary);
+    for (size_t i = 0; i < length; ++i) {
+        file.put(static_cast<char>(i % 251));
+    }
+    return root.WidePath() + L"\\" + std::wstring(name, name + strlen(name));
+}
+
+} // namespace
+
+TEST(FileHasherTest, TreeHashMatchesTheSharedVector) {
+    TempDirectory root;
+    const std::wstring path = WriteVector(root, "vector.bin", kVectorLength);
+
+    for (size_t threads : { 1u, 3u }) {
+        BlockManifest manifest;
+        ContentHash hash;
+        ASSERT_EQ(S_OK, HashFileTree(path, threads, manifest, hash));
+        EXPECT_EQ(kVectorTreeRoot, Hex(hash.bytes, sizeof(hash.bytes)));
+        EXPECT_EQ(static_cast<LONGLONG>(kVectorLength), manifest.fileSize);
+        EXPECT_EQ(3u, manifest.blockHashes.size());
+        EXPECT_TRUE(manifest.IsConsistent());
+    }
+
+    ContentHash sha256;
+    ASSERT_EQ(S_OK, HashFileSha256(path, sha256));
+    EXPECT_EQ(kVectorSha256, Hex(sha256.bytes, sizeof(sha256.bytes)));
+}
+
+TEST(FileHasherTest, EmptyFileHashesToTheEmptyDigest) {
+    TempDirectory root;
+    const std::wstring path = WriteVector(root, "empty.bin", 0);
+
+    MbdFileTreeHash result = {};
+    result.structSize = sizeof(result);
+    ASSERT_EQ(S_OK, MbdHashFileTree(path.c_str(), 0, &result));
+    EXPECT_EQ(0u, result.blockCount);
+    EXPECT_EQ(kEmptySha256, Hex(result.root, sizeof(result.root)));
+
+    uint8_t digest[32] = {};
+    ASSERT_EQ(S_OK, MbdHashFileSha256(path.c_str(), digest));
+    EXPECT_EQ(kEmptySha256, Hex(digest, sizeof(digest)));
+}
+
+TEST(FileHasherTest, ResultIsCopiedOnlyUpToTheCallersStructSize) {
+    TempDirectory root;
+    const std::wstring path = WriteVector(root, "vector.bin", 4096);
+
+    // manifestId 이전 버전의 구조체 크기로 부르면 뒤쪽은 건드리지 않음
+    MbdFileTreeHash result;
+    memset(&result, 0xAB, sizeof(result));
+    result.structSize = offsetof(MbdFileTreeHash, manifestId);
+    ASSERT_EQ(S_OK, MbdHashFileTree(path.c_str(), 1, &result));
+    EXPECT_EQ(offsetof(MbdFileTreeHash, manifestId), result.structSize);
+    EXPECT_EQ(4096u, result.fileSize);
+    EXPECT_EQ(0xAB, result.manifestId[0]);
+
+    result.structSize = 4;
+    EXPECT_EQ(E_INVALIDARG, MbdHashFileTree(path.c_str(), 1, &result));
+    EXPECT_EQ(E_INVALIDARG, MbdHashFileTree(L"", 1, &result));
+}
@@ -0,0 +1,402 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
+#include "FuseBackend.h"
+#include "ProviderTestFixture.h"
+
+namespace {
+
+// FuseBackend가 보내는 엔진 이벤트를 기록하고, 설정한 방식대로 같은 스레드에서 바로 응답
+class ScriptedEvents : public ProviderBackendEvents {
+public:
+    struct Call {
+        std::wstring relativePath;
+        FetchKey key;
+        LONGLONG offset = 0;
+        LONGLONG length = 0;
+    };
+
+    explicit ScriptedEvents(std::vector<BYTE> content) : m_content(std::move(content)) {}
+
+    void Attach(FuseBackend* backend) { m_backend = backend; }
+
+    // OnFetchData 응답 방식
+    enum class FetchMode { Transfer, Fail, Ignore };
+    FetchMode fetchMode = FetchMode::Transfer;
+    bool validResult = true;
+    // 폴더 경로별 하위 항목 (없는 폴더는 목록 없이 완료)
+    std::map<std::wstring, std::vector<PlaceholderEntry>> directories;
+
+    void OnFetchData(const BackendFileInfo& file, const FetchKey& key, LONGLONG offset, LONGLONG length) override {
+        Record(m_fetches, file, key, offset, length);
+        if (fetchMode == FetchMode::Transfer) {
+            EXPECT_EQ(S_OK, m_backend->TransferData(key, m_content.data() + offset, offset, length));
+        } else if (fetchMode == FetchMode::Fail) {
+            EXPECT_EQ(S_OK, m_backend->FailTransfer(key, offset, length, TransferFailure::Failed));
+        }
+    }
+
+    void OnCancelFetchData(const BackendFileInfo& file, const FetchKey& key, LONGLONG offset, LONGLONG length) override {
+        Record(m_cancels, file, key, offset, length);
+    }
+
+    void OnValidateData(const BackendFileInfo& file, const FetchKey& key, LONGLONG offset, LONGLONG length) override {
+        Record(m_validations, file, key, offset, length);
+        std::vector<BYTE> retrieved(static_cast<size_t>(length));
+        LONGLONG returned = 0;
+        EXPECT_EQ(S_OK, m_backend->RetrieveData(key, retrieved.data(), offset, length, returned));
+        EXPECT_EQ(length, returned);
+        EXPECT_TRUE(std::equal(retrieved.begin(), retrieved.end(), m_content.begin() + offset));
+        EXPECT_EQ(S_OK, m_backend->AcknowledgeData(key, offset, length, validResult));
+    }
+
+    void OnFetchPlaceholders(const BackendFileInfo& directory, const FetchKey& key) override {
+        const std::wstring relativePath = directory.RelativePath();
+        Record(m_populations, directory, key, 0, 0);
+        auto found = directories.find(relativePath);
+        m_backend->TransferPlaceholders(key, relativePath, found != directories.end() ? &found->second : nullptr);
+    }
+
+    void OnFileOpened(const BackendFileInfo& file) override { Record(m_opens, file, FetchKey(), 0, 0); }
+    void OnFileClosed(const BackendFileInfo& file) override { Record(m_closes, file, FetchKey(), 0, 0); }
+    void OnFileDeleted(const BackendFileInfo&) override {}
+    void OnFileRenamed(const BackendFileInfo&) override {}
+
+    std::vector<Call> Fetches() const { return Copy(m_fetches); }
+    std::vector<Call> Cancels() const { return Copy(m_cancels); }
+    std::vector<Call> Validations() const { return Copy(m_validations); }
+    std::vector<Call> Populations() const { return Copy(m_populations); }
+    std::vector<Call> Opens() const { return Copy(m_opens); }
+    std::vector<Call> Closes() const { return Copy(m_closes); }
+
+    const std::vector<BYTE>& Content() const { return m_content; }
+
+private:
+    void Record(std::vector<Call>& calls, const BackendFileInfo& file, const FetchKey& key, LONGLONG offset, LONGLONG length) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        calls.push_back({ file.RelativePath(), key, offset, length });
+    }
+
+    std::vector<Call> Copy(const std::vector<Call>& calls) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return calls;
+    }
+
+    std::vector<BYTE> m_content;
+    FuseBackend* m_backend = nullptr;
+    mutable std::mutex m_mutex;
+    std::vector<Call> m_fetches;
+    std::vector<Call> m_cancels;
+    std::vector<Call> m_validations;
+    std::vector<Call> m_populations;
+    std::vector<Call> m_opens;
+    std::vector<Call> m_closes;
+};
+
+PlaceholderEntry MakeFile(const std::wstring& name, LONGLONG size) {
+    PlaceholderEntry entry;
+    entry.name = name;
+    entry.fileSize.QuadPart = size;
+    entry.basicInfo.FileAttributes = FILE_ATTRIBUTE_NORMAL;
+    return entry;
+}
+
+PlaceholderEntry MakeFolder(const std::wstring& name) {
+    PlaceholderEntry entry;
+    entry.name = name;
+    entry.basicInfo.FileAttributes = FILE_ATTRIBUTE_DIRECTORY;
+    return entry;
+}
+
+class FuseBackendTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_events.Attach(&m_backend);
+    }
+
+    void TearDown() override {
+        m_backend.Unregister(m_root.WidePath() + L"\\Mount");
+    }
+
+    // 동기화 루트에 파일 하나를 만들어 두고 연결
+    void Connect(BackendSyncPolicy policy = BackendSyncPolicy()) {
+        ASSERT_EQ(S_OK, m_backend.Connect(m_root.WidePath() + L"\\Mount", L"Test Drive", policy, &m_events));
+        if (policy.populationMode == PopulationMode::Full) {
+            PlaceholderEntry entry = MakeFile(L"a.wav", static_cast<LONGLONG>(m_events.Content().size()));
+            std::vector<HRESULT> results;
+            ASSERT_EQ(S_OK, m_backend.CreatePlaceholders(L"", &entry, 1, results));
+            ASSERT_EQ(S_OK, results[0]);
+        }
+    }
+
+    std::vector<BYTE> Expected(LONGLONG offset, LONGLONG length) const {
+        return std::vector<BYTE>(m_events.Content().begin() + offset, m_events.Content().begin() + offset + length);
+    }
+
+    TempDirectory m_root;
+    ScriptedEvents m_events{ MakePattern(10000) };
+    FuseBackend m_backend{ m_root.WidePath() + L"\\store" };
+};
+
+} // namespace
+
+TEST_F(FuseBackendTest, ReadFetchesOnlyTheAlignedMissingRange) {
+    Connect();
+
+    std::vector<BYTE> buffer(100);
+    LONGLONG returned = 0;
+    ASSERT_EQ(S_OK, m_backend.Read(L"/a.wav", buffer.data(), 5000, 100, returned, 42));
+    EXPECT_EQ(100, returned);
+    EXPECT_EQ(Expected(5000, 100), buffer);
+
+    auto fetches = m_events.Fetches();
+    ASSERT_EQ(1u, fetches.size());
+    EXPECT_EQ(L"a.wav", fetches[0].relativePath);
+    EXPECT_EQ(4096, fetches[0].offset);
+    EXPECT_EQ(4096, fetches[0].length);
+
+    // 이미 받은 범위는 다시 요청하지 않고, 파일 끝 요청은 정렬해도 파일 크기를 넘지 않음
+    ASSERT_EQ(S_OK, m_backend.Read(L"a.wav", buffer.data(), 4200, 100, returned));
+    ASSERT_EQ(S_OK, m_backend.Read(L"a.wav", buffer.data(), 9950, 100, returned));
+    EXPECT_EQ(50, returned);
+    fetches = m_events.Fetches();
+    ASSERT_EQ(2u, fetches.size());
+    EXPECT_EQ(8192, fetches[1].offset);
+    EXPECT_EQ(10000 - 8192, fetches[1].length);
+
+    FuseNodeInfo info;
+    ASSERT_EQ(S_OK, m_backend.GetAttributes(L"A.WAV", info));
+    EXPECT_EQ(10000, info.fileSize);
+    EXPECT_EQ(4096 + 10000 - 8192, info.hydratedBytes);
+    EXPECT_EQ(InSyncState::NotInSync, info.inSyncState);
+}
+
+TEST_F(FuseBackendTest, ReadPastTheEndReturnsNothing) {
+    Connect();
+    std::vector<BYTE> buffer(16);
+    LONGLONG returned = 1;
+    EXPECT_EQ(S_OK, m_backend.Read(L"a.wav", buffer.data(), 10000, 16, returned));
+    EXPECT_EQ(0, returned);
+    EXPECT_TRUE(m_events.Fetches().empty());
+}
+
+TEST_F(FuseBackendTest, FailedTransferFailsTheRead) {
+    Connect();
+    m_events.fetchMode = ScriptedEvents::FetchMode::Fail;
+
+    std::vector<BYTE> buffer(100);
+    LONGLONG returned = 0;
+    EXPECT_EQ(HRESULT_FROM_WIN32(ERROR_GEN_FAILURE), m_backend.Read(L"a.wav", buffer.data(), 0, 100, returned));
+    EXPECT_EQ(0, returned);
+
+    // 끝난 요청의 키로는 더 이상 데이터를 보낼 수 없음
+    const FetchKey key = m_events.Fetches()[0].key;
+    EXPECT_EQ(HRESULT_FROM_WIN32(ERROR_OPERATION_ABORTED), m_backend.TransferData(key, buffer.data(), 0, 100));
+}
+
+TEST_F(FuseBackendTest, UnansweredFetchTimesOutAndIsCancelled) {
+    Connect();
+    m_backend.SetRequestTimeout(std::chrono::milliseconds(50));
+    m_events.fetchMode = ScriptedEvents::FetchMode::Ignore;
+
+    std::vector<BYTE> buffer(100);
+    LONGLONG returned = 0;
+    EXPECT_EQ(HRESULT_FROM_WIN32(ERROR_TIMEOUT), m_backend.Read(L"a.wav", buffer.data(), 0, 100, returned));
+
+    auto fetches = m_events.Fetches();
+    auto cancels = m_events.Cancels();
+    ASSERT_EQ(1u, cancels.size());
+    EXPECT_EQ(fetches[0].key.transferKey, cancels[0].key.transferKey);
+    EXPECT_EQ(0, cancels[0].offset);
+    EXPECT_EQ(4096, cancels[0].length);
+}
+
+TEST_F(FuseBackendTest, ValidatedDataIsReadableOnlyAfterAValidAcknowledge) {
+    BackendSyncPolicy policy;
+    policy.validateData = true;
+    Connect(policy);
+
+    std::vector<BYTE> buffer(100);
+    LONGLONG returned = 0;
+    m_events.validResult = false;
+    EXPECT_EQ(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), m_backend.Read(L"a.wav", buffer.data(), 0, 100, returned));
+    FuseNodeInfo info;
+    ASSERT_EQ(S_OK, m_backend.GetAttributes(L"a.wav", info));
+    EXPECT_EQ(0, info.hydratedBytes);
+
+    // 다음 읽기는 같은 범위를 다시 받아 확인
+    m_events.validResult = true;
+    ASSERT_EQ(S_OK, m_backend.Read(L"a.wav", buffer.data(), 0, 100, returned));
+    EXPECT_EQ(Expected(0, 100), buffer);
+    EXPECT_EQ(2u, m_events.Fetches().size());
+    auto validations = m_events.Validations();
+    ASSERT_EQ(2u, validations.size());
+    EXPECT_EQ(0, validations[1].offset);
+    EXPECT_EQ(4096, validations[1].length);
+}
+
+TEST_F(FuseBackendTest, FullHydrationPolicyFetchesTheWholeFileOnOpen) {
+    BackendSyncPolicy policy;
+    policy.hydrationPolicy = HydrationPolicy::Full;
+    Connect(policy);
+
+    ASSERT_EQ(S_OK, m_backend.Open(L"a.wav", 7));
+    auto fetches = m_events.Fetches();
+    ASSERT_EQ(1u, fetches.size());
+    EXPECT_EQ(0, fetches[0].offset);
+    EXPECT_EQ(10000, fetches[0].length);
+    ASSERT_EQ(1u, m_events.Opens().size());
+
+    std::vector<BYTE> buffer(10000);
+    LONGLONG returned = 0;
+    ASSERT_EQ(S_OK, m_backend.Read(L"a.wav", buffer.data(), 0, 10000, returned));
+    EXPECT_EQ(m_events.Content(), buffer);
+    EXPECT_EQ(1u, m_events.Fetches().size());
+
+    m_backend.Release(L"a.wav", 7);
+    EXPECT_EQ(1u, m_events.Closes().size());
+}
+
+TEST_F(FuseBackendTest, ProviderDataSentWithATransferKeyIsReadable) {
+    Connect();
+    ASSERT_EQ(S_OK, m_backend.WithTransferKey(L"a.wav", [this](const FetchKey& key) {
+        return m_backend.TransferData(key, m_events.Content().data(), 0, 10000);
+    }));
+
+    std::vector<BYTE> buffer(10000);
+    LONGLONG returned = 0;
+    ASSERT_EQ(S_OK, m_backend.Read(L"a.wav", buffer.data(), 0, 10000, returned));
+    EXPECT_EQ(m_events.Content(), buffer);
+    EXPECT_TRUE(m_events.Fetches().empty());
+}
+
+TEST_F(FuseBackendTest, PartialPopulationFetchesFoldersAlongTheLookupPath) {
+    m_events.directories[L""] = { MakeFolder(L"Album"), MakeFolder(L"Unlisted") };
+    m_events.directories[L"Album"] = { MakeFile(L"a.wav", 10000) };
+    BackendSyncPolicy policy;
+    policy.populationMode = PopulationMode::Partial;
+    Connect(policy);
+
+    FuseNodeInfo info;
+    ASSERT_EQ(S_OK, m_backend.GetAttributes(L"/Album/a.wav", info));
+    EXPECT_FALSE(info.isDirectory);
+    EXPECT_EQ(10000, info.fileSize);
+    EXPECT_EQ(InSyncState::InSync, info.inSyncState);
+
+    auto populations = m_events.Populations();
+    ASSERT_EQ(2u, populations.size());
+    EXPECT_EQ(L"", populations[0].relativePath);
+    EXPECT_EQ(L"Album", populations[1].relativePath);
+
+    // 채워진 폴더는 다시 요청하지 않음
+    std::vector<FuseNodeInfo> entries;
+    ASSERT_EQ(S_OK, m_backend.ReadDirectory(L"Album", entries));
+    ASSERT_EQ(1u, entries.size());
+    EXPECT_EQ(L"a.wav", entries[0].name);
+    EXPECT_EQ(2u, m_events.Populations().size());
+    EXPECT_EQ(HRESULT_FROM_WIN32(ERROR_DIRECTORY), m_backend.ReadDirectory(L"Album\\a.wav", entries));
+
+    // 목록을 모르는 폴더는 비어 있고 다음 열거 때 다시 요청함
+    ASSERT_EQ(S_OK, m_backend.ReadDirectory(L"Unlisted", entries));
+    EXPECT_TRUE(entries.empty());
+    EXPECT_EQ(HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND), m_backend.GetAttributes(L"Unlisted/b.wav", info));
+    EXPECT_EQ(4u, m_events.Populations().size());
+}
+
+TEST_F(FuseBackendTest, DisconnectedBackendFailsReads) {
+    Connect();
+    m_backend.Disconnect();
+
+    std::vector<BYTE> buffer(100);
+    LONGLONG returned = 0;
+    EXPECT_EQ(HRESULT_FROM_WIN32(ERROR_NOT_READY), m_backend.Read(L"a.wav", buffer.data(), 0, 100, returned));
+}
+
+// FUSE 백엔드로 엔진 전체를 돌림 (cfapi 대신 FuseBackend의 읽기가 같은 하이드레이션 경로로 들어감)
+class FuseProviderTest : public ProviderTest {
+protected:
+    void Configure(CloudFilesProvider& provider) override {
+        FetchExecutorConfig executorConfig;
+        executorConfig.workerCount = 2;
+        provider.SetExecutorConfig(executorConfig);
+        provider.SetStreamingFetchCallback(m_source.Callback());
+    }
+
+    std::unique_ptr<ProviderBackend> CreateBackend() override {
+        auto backend = std::make_unique<FuseBackend>(m_cacheRoot.WidePath() + L"\\fuse-store");
+        m_fuse = backend.get();
+        return backend;
+    }
+
+    TestDataSource m_source{ MakePattern(64 * 1024, 3) };
+    FuseBackend* m_fuse = nullptr;
+};
+
+TEST_F(FuseProviderTest, LazyReadStreamsThroughTheProvider) {
+    EXPECT_EQ(nullptr, m_backend);
+    EXPECT_STREQ(L"fuse", m_fuse->Name());
+
+    FILE_BASIC_INFO folderInfo = {};
+    folderInfo.FileAttributes = FILE_ATTRIBUTE_DIRECTORY;
+    FILE_BASIC_INFO fileInfo = {};
+    fileInfo.FileAttributes = FILE_ATTRIBUTE_NORMAL;
+    LARGE_INTEGER folderSize = {};
+    LARGE_INTEGER fileSize;
+    fileSize.QuadPart = static_cast<LONGLONG>(m_source.Content().size());
+    ASSERT_EQ(S_OK, Provider().CreatePlaceholder(L"Songs", folderInfo, folderSize));
+    ASSERT_EQ(S_OK, Provider().CreatePlaceholder(L"Songs\\a.wav", fileInfo, fileSize));
+
+    std::vector<BYTE> buffer(100);
+    LONGLONG returned = 0;
+    ASSERT_EQ(S_OK, m_fuse->Read(L"/Songs/a.wav", buffer.data(), 5000, 100, returned));
+    EXPECT_EQ(100, returned);
+    EXPECT_EQ(std::vector<BYTE>(m_source.Content().begin() + 5000, m_source.Content().begin() + 5100), buffer);
+
+    auto requests = m_source.Requests();
+    ASSERT_EQ(1u, requests.size());
+    EXPECT_EQ(L"Songs\\a.wav", requests[0].relativePath);
+    EXPECT_EQ(4096, requests[0].offset);
+    EXPECT_EQ(4096, requests[0].length);
+
+    MbdMetricsSnapshot snapshot = {};
+    snapshot.structSize = sizeof(snapshot);
+    Provider().GetMetricsSnapshot(snapshot);
+    EXPECT_EQ(2u, snapshot.placeholdersCreated);
+    EXPECT_EQ(4096u, snapshot.bytesTransferred);
+}
+
+class FusePartialPopulationTest : public FuseProviderTest {
+protected:
+    void Configure(CloudFilesProvider& provider) override {
+        FuseProviderTest::Configure(provider);
+        provider.SetPopulationMode(PopulationMode::Partial);
+        provider.SetDirectoryContents(L"", { MakeFolder(L"Album") });
+        provider.SetDirectoryContents(L"Album", { MakeFile(L"a.wav", static_cast<LONGLONG>(m_source.Content().size())) });
+    }
+
+    void TearDown() override {
+        Provider().RemoveDirectoryContents(L"");
+        Provider().RemoveDirectoryContents(L"Album");
+        FuseProviderTest::TearDown();
+    }
+};
+
+TEST_F(FusePartialPopulationTest, LookupPopulatesFromTheDirectoryIndex) {
+    std::vector<FuseNodeInfo> entries;
+    ASSERT_EQ(S_OK, m_fuse->ReadDirectory(L"Album", entries));
+    ASSERT_EQ(1u, entries.size());
+    EXPECT_EQ(L"a.wav", entries[0].name);
+
+    std::vector<BYTE> buffer(m_source.Content().size());
+    LONGLONG returned = 0;
+    ASSERT_EQ(S_OK, m_fuse->Read(L"Album/a.wav", buffer.data(), 0, static_cast<LONGLONG>(buffer.size()), returned));
+    EXPECT_EQ(m_source.Content(), buffer);
+
+    MbdMetricsSnapshot snapshot = {};
+    snapshot.structSize = sizeof(snapshot);
+    Provider().GetMetricsSnapshot(snapshot);
+    EXPECT_EQ(2u, snapshot.fetchPlaceholders.count);
+}
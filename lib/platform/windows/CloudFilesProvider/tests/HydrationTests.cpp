@@ -0,0 +1,245 @@
+#include "ProviderTestFixture.h"
+#include "CfApiBackend.h"
+
+namespace {
+
+const LONGLONG kMiB = 1024 * 1024;
+
+// cfapi 대체 헤더가 기록한 등록 정책으로 하이드레이션 방식 매핑 확인
+CF_SYNC_POLICIES ConnectWithPolicy(const std::wstring& root, HydrationPolicy hydrationPolicy, bool validateData) {
+    cfapi_stub::Reset();
+    CfApiBackend backend;
+    BackendSyncPolicy policy;
+    policy.hydrationPolicy = hydrationPolicy;
+    policy.validateData = validateData;
+    EXPECT_EQ(S_OK, backend.Connect(root, L"Test Drive", policy, nullptr));
+    backend.Disconnect();
+    return cfapi_stub::Get().policies;
+}
+
+} // namespace
+
+TEST(CfApiBackendTest, MapsHydrationPolicyToCfPolicy) {
+    TempDirectory root;
+    std::wstring syncRoot = root.WidePath() + L"\\Drive";
+
+    CF_SYNC_POLICIES partial = ConnectWithPolicy(syncRoot, HydrationPolicy::Partial, false);
+    EXPECT_EQ(CF_HYDRATION_POLICY_PARTIAL, partial.Hydration.Primary);
+    EXPECT_EQ(CF_HYDRATION_POLICY_MODIFIER_NONE, partial.Hydration.Modifier);
+
+    CF_SYNC_POLICIES progressive = ConnectWithPolicy(syncRoot, HydrationPolicy::Progressive, true);
+    EXPECT_EQ(CF_HYDRATION_POLICY_PROGRESSIVE, progressive.Hydration.Primary);
+    EXPECT_EQ(CF_HYDRATION_POLICY_MODIFIER_VALIDATION_REQUIRED, progressive.Hydration.Modifier);
+
+    CF_SYNC_POLICIES full = ConnectWithPolicy(syncRoot, HydrationPolicy::Full, false);
+    EXPECT_EQ(CF_HYDRATION_POLICY_FULL, full.Hydration.Primary);
+}
+
+TEST(CfApiBackendTest, DefaultPolicyIsPartial) {
+    EXPECT_EQ(HydrationPolicy::Partial, BackendSyncPolicy().hydrationPolicy);
+}
+
+class HydrationTest : public ProviderTest {
+protected:
+    void Configure(CloudFilesProvider& provider) override {
+        FetchExecutorConfig executorConfig;
+        executorConfig.workerCount = 2;
+        provider.SetExecutorConfig(executorConfig);
+        provider.SetStreamingFetchCallback(m_source.Callback());
+    }
+
+    TestDataSource m_source{ MakePattern(static_cast<size_t>(12 * kMiB)) };
+};
+
+TEST_F(HydrationTest, ProviderRequestsPartialHydration) {
+    EXPECT_EQ(HydrationPolicy::Partial, m_backend->Policy().hydrationPolicy);
+}
+
+TEST_F(HydrationTest, FetchesOnlyTheAlignedRequiredRange) {
+    const LONGLONG fileSize = static_cast<LONGLONG>(m_source.Content().size());
+    m_backend->FetchData(L"Songs\\a.wav", fileSize, 1, 5000, 100);
+
+    ASSERT_TRUE(m_backend->WaitFor([](FakeBackend& backend) { return backend.TransferredBytes(1) == 4096; }));
+    auto requests = m_source.Requests();
+    ASSERT_EQ(1u, requests.size());
+    EXPECT_EQ(4096, requests[0].offset);
+    EXPECT_EQ(4096, requests[0].length);
+    EXPECT_EQ(fileSize, requests[0].fileSize);
+
+    auto transfers = m_backend->Transfers();
+    ASSERT_EQ(1u, transfers.size());
+    EXPECT_EQ(4096, transfers[0].offset);
+    std::vector<BYTE> expected(m_source.Content().begin() + 4096, m_source.Content().begin() + 8192);
+    EXPECT_EQ(expected, transfers[0].data);
+    EXPECT_TRUE(m_backend->Failures().empty());
+}
+
+TEST_F(HydrationTest, RangeEndingAtFileEndIsNotPaddedPastEof) {
+    const LONGLONG fileSize = 10000;
+    m_backend->FetchData(L"short.wav", fileSize, 1, 9000, 1000);
+
+    ASSERT_TRUE(m_backend->WaitFor([](FakeBackend& backend) { return backend.TransferredBytes(1) > 0; }));
+    auto transfers = m_backend->Transfers();
+    ASSERT_EQ(1u, transfers.size());
+    EXPECT_EQ(8192, transfers[0].offset);
+    EXPECT_EQ(fileSize - 8192, transfers[0].length);
+}
+
+TEST_F(HydrationTest, OverlappingRequestsShareOneDownload) {
+    const LONGLONG fileSize = static_cast<LONGLONG>(m_source.Content().size());
+    const uint64_t coalescedBefore = Provider().GetInFlightFetchStats().coalesced;
+    m_source.Block();
+
+    // 첫 요청의 다운로드가 데이터 소스에서 멈춘 동안 그 범위 안의 두 번째 요청이 들어옴
+    m_backend->FetchData(L"Songs\\a.wav", fileSize, 1, 0, 8 * kMiB);
+    ASSERT_TRUE(m_source.WaitUntilWaiting());
+    m_backend->FetchData(L"Songs\\a.wav", fileSize, 2, 5 * kMiB, kMiB);
+    m_source.Release();
+
+    ASSERT_TRUE(m_backend->WaitFor([](FakeBackend& backend) {
+        return backend.TransferredBytes(1) == 8 * kMiB && backend.TransferredBytes(2) == kMiB;
+    }));
+    EXPECT_EQ(1u, m_source.Requests().size());
+
+    std::vector<BYTE> first(m_source.Content().begin(), m_source.Content().begin() + 8 * kMiB);
+    std::vector<BYTE> second(m_source.Content().begin() + 5 * kMiB, m_source.Content().begin() + 6 * kMiB);
+    EXPECT_EQ(first, m_backend->TransferredData(1));
+    EXPECT_EQ(second, m_backend->TransferredData(2));
+    EXPECT_EQ(coalescedBefore + 1, Provider().GetInFlightFetchStats().coalesced);
+}
+
+TEST_F(HydrationTest, ProgressIsCumulativeAgainstFileSize) {
+    // 콜백은 워커 스레드에서 불리므로 테스트가 끝난 뒤에도 유효한 상태에 기록
+    struct AppProgress {
+        std::mutex mutex;
+        std::vector<std::pair<LONGLONG, LONGLONG>> reports;
+    };
+    auto appProgress = std::make_shared<AppProgress>();
+    Provider().SetProgressUpdateRate(1e9);
+    Provider().SetProgressCallback([appProgress](const std::wstring&, LONGLONG completed, LONGLONG total) {
+        std::lock_guard<std::mutex> lock(appProgress->mutex);
+        appProgress->reports.emplace_back(completed, total);
+    });
+
+    // 파일의 서로 다른 두 범위를 차례로 읽으면 진행률은 파일 크기 기준으로 누적됨
+    const LONGLONG fileSize = static_cast<LONGLONG>(m_source.Content().size());
+    m_backend->FetchData(L"Songs\\a.wav", fileSize, 1, 0, 4 * kMiB);
+    ASSERT_TRUE(m_backend->WaitFor([](FakeBackend& backend) { return backend.ProgressReports().size() == 1; }));
+    m_backend->FetchData(L"Songs\\a.wav", fileSize, 2, 8 * kMiB, 4 * kMiB);
+    ASSERT_TRUE(m_backend->WaitFor([](FakeBackend& backend) { return backend.ProgressReports().size() == 2; }));
+
+    auto reports = m_backend->ProgressReports();
+    EXPECT_EQ(1, reports[0].key.transferKey);
+    EXPECT_EQ(fileSize, reports[0].total);
+    EXPECT_EQ(4 * kMiB, reports[0].completed);
+    EXPECT_EQ(2, reports[1].key.transferKey);
+    EXPECT_EQ(fileSize, reports[1].total);
+    EXPECT_EQ(8 * kMiB, reports[1].completed);
+
+    // 앱 콜백은 셸 보고 뒤에 불리므로 두 번째 값이 들어올 때까지 기다림
+    auto appReports = [appProgress]() {
+        std::lock_guard<std::mutex> lock(appProgress->mutex);
+        return appProgress->reports;
+    };
+    ASSERT_TRUE(m_backend->WaitFor([&](FakeBackend&) { return appReports().size() == 2; }));
+    EXPECT_EQ((std::vector<std::pair<LONGLONG, LONGLONG>>{ { 4 * kMiB, fileSize }, { 8 * kMiB, fileSize } }), appReports());
+}
+
+TEST_F(HydrationTest, CancelStopsDownloadBetweenChunks) {
+    const LONGLONG fileSize = static_cast<LONGLONG>(m_source.Content().size());
+    m_source.Block(CloudFilesProvider::kTransferChunkSize);
+
+    m_backend->FetchData(L"Songs\\a.wav", fileSize, 1, 0, fileSize);
+    ASSERT_TRUE(m_source.WaitUntilWaiting());
+    ASSERT_TRUE(m_backend->WaitFor([](FakeBackend& backend) {
+        return backend.TransferredBytes(1) == CloudFilesProvider::kTransferChunkSize;
+    }));
+
+    m_backend->CancelFetchData(L"Songs\\a.wav", fileSize, 1, 0, fileSize);
+    m_source.Release();
+
+    // 데이터 소스는 다음 Write에서 취소를 받고, 취소된 전송에는 더 보내거나 실패로 완료하지 않음
+    ASSERT_TRUE(m_backend->WaitFor([this](FakeBackend&) { return m_source.LastWriteError() != S_OK; }));
+    EXPECT_EQ(HRESULT_FROM_WIN32(ERROR_CANCELLED), m_source.LastWriteError());
+    EXPECT_EQ(CloudFilesProvider::kTransferChunkSize, m_backend->TransferredBytes(1));
+    EXPECT_TRUE(m_backend->Failures().empty());
+}
+
+TEST_F(HydrationTest, CancelledQueuedDownloadNeverReachesDataSource) {
+    const LONGLONG fileSize = static_cast<LONGLONG>(m_source.Content().size());
+    m_source.Block();
+
+    // 워커 2개를 모두 막은 뒤 세 번째 다운로드는 큐에 남음
+    m_backend->FetchData(L"a.wav", fileSize, 1, 0, kMiB);
+    m_backend->FetchData(L"b.wav", fileSize, 2, 0, kMiB);
+    ASSERT_TRUE(m_source.WaitUntilWaiting(2));
+    m_backend->FetchData(L"c.wav", fileSize, 3, 0, kMiB);
+    m_backend->CancelFetchData(L"c.wav", fileSize, 3, 0, kMiB);
+    m_source.Release();
+
+    ASSERT_TRUE(m_backend->WaitFor([](FakeBackend& backend) {
+        return backend.TransferredBytes(1) == kMiB && backend.TransferredBytes(2) == kMiB;
+    }));
+    Provider().Shutdown();
+    for (const auto& request : m_source.Requests()) {
+        EXPECT_NE(L"c.wav", request.relativePath);
+    }
+    EXPECT_EQ(0, m_backend->TransferredBytes(3));
+    EXPECT_TRUE(m_backend->Failures().empty());
+}
+
+TEST_F(HydrationTest, HydrateFileTransfersThroughTheBackendKey) {
+    std::vector<BYTE> data = MakePattern(static_cast<size_t>(CloudFilesProvider::kTransferChunkSize + 100));
+    ASSERT_EQ(S_OK, Provider().HydrateFile(L"Songs\\push.wav", data, nullptr));
+
+    // 백엔드가 발급한 전송 키 하나로 청크를 나누어 보냄
+    auto transfers = m_backend->Transfers();
+    ASSERT_EQ(2u, transfers.size());
+    EXPECT_EQ(1000, transfers[0].key.transferKey);
+    EXPECT_EQ(1000, transfers[1].key.transferKey);
+    EXPECT_EQ(data, m_backend->TransferredData(1000));
+}
+
+TEST_F(HydrationTest, FileStateChangesGoThroughTheBackend) {
+    EXPECT_EQ(S_OK, Provider().SetPinState(L"Songs\\a.wav", PinState::Pinned));
+    Provider().QueueInSyncState(L"Songs\\a.wav", InSyncState::InSync);
+    Provider().FlushInSyncUpdates();
+
+    ASSERT_TRUE(m_backend->WaitFor([](FakeBackend& backend) { return backend.InSyncChanges().size() == 1; }));
+    EXPECT_EQ(L"Songs\\a.wav", m_backend->InSyncChanges()[0].relativePath);
+    EXPECT_EQ(static_cast<int>(InSyncState::InSync), m_backend->InSyncChanges()[0].state);
+    ASSERT_EQ(1u, m_backend->PinChanges().size());
+    EXPECT_EQ(static_cast<int>(PinState::Pinned), m_backend->PinChanges()[0].state);
+
+    m_backend->SetStateResult(HRESULT_FROM_WIN32(ERROR_ACCESS_DENIED));
+    EXPECT_EQ(HRESULT_FROM_WIN32(ERROR_ACCESS_DENIED), Provider().SetPinState(L"Songs\\a.wav", PinState::Unpinned));
+    m_backend->SetStateResult(S_OK);
+}
+
+TEST(CfApiBackendTest, FileStateCallsReuseOneProtectedHandle) {
+    TempDirectory root;
+    cfapi_stub::Reset();
+    CfApiBackend backend;
+    const std::wstring syncRoot = root.WidePath() + L"\\Drive";
+    ASSERT_EQ(S_OK, backend.Connect(syncRoot, L"Test Drive", BackendSyncPolicy(), nullptr));
+
+    EXPECT_EQ(S_OK, backend.SetInSyncState(L"a.wav", InSyncState::InSync));
+    EXPECT_EQ(S_OK, backend.SetPinState(L"a.wav", PinState::Unpinned));
+    LONGLONG transferKey = 0;
+    EXPECT_EQ(S_OK, backend.WithTransferKey(L"a.wav", [&transferKey](const FetchKey& key) {
+        transferKey = key.transferKey;
+        return S_OK;
+    }));
+    EXPECT_NE(0, transferKey);
+    EXPECT_EQ(2u, backend.GetHandleCacheStats().hits);
+    backend.Disconnect();
+
+    std::vector<std::string> operations;
+    for (const auto& call : cfapi_stub::Get().handleCalls) {
+        operations.push_back(call.operation);
+        EXPECT_EQ(syncRoot + L"\\a.wav", call.path);
+    }
+    EXPECT_EQ((std::vector<std::string>{ "open", "in_sync", "pin", "transfer_key", "release_transfer_key", "close" }), operations);
+    EXPECT_EQ(CF_IN_SYNC_STATE_IN_SYNC, cfapi_stub::Get().handleCalls[1].state);
+    EXPECT_EQ(CF_PIN_STATE_UNPINNED, cfapi_stub::Get().handleCalls[2].state);
+}
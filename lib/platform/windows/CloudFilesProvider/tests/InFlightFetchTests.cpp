@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include "InFlightFetches.h"
+
+namespace {
+
+FetchKey Key(LONGLONG transferKey, LONGLONG fileId = 7) {
+    FetchKey key;
+    key.connectionKey = 1;
+    key.transferKey = transferKey;
+    key.fileId = fileId;
+    return key;
+}
+
+} // namespace
+
+TEST(InFlightFetchCancelTest, CancellingOnlyConsumerOrphansDownload) {
+    InFlightFetchTable table;
+    auto fetch = table.Register(Key(1), 1, 0, 8192, HydrationPriority::Foreground);
+    ASSERT_TRUE(fetch->ownsDownload);
+
+    auto orphaned = table.Cancel(Key(1), 0, 8192);
+    ASSERT_EQ(1u, orphaned.size());
+    EXPECT_EQ(fetch->download, orphaned[0]);
+    EXPECT_TRUE(fetch->cancelToken->IsCancelled());
+    EXPECT_TRUE(orphaned[0]->cancelToken->IsCancelled());
+    EXPECT_TRUE(orphaned[0]->finished);
+
+    InFlightFetchStats stats = table.GetStats();
+    EXPECT_EQ(0u, stats.inFlight);
+    EXPECT_EQ(0u, stats.activeDownloads);
+    EXPECT_EQ(1u, stats.cancelledQueued);
+}
+
+TEST(InFlightFetchCancelTest, DownloadSurvivesWhileAnotherConsumerWaits) {
+    InFlightFetchTable table;
+    auto first = table.Register(Key(1), 1, 0, 8192, HydrationPriority::Foreground);
+    auto second = table.Register(Key(2), 1, 4096, 4096, HydrationPriority::Foreground);
+    ASSERT_EQ(first->download, second->download);
+    first->download->started = true;
+
+    EXPECT_TRUE(table.Cancel(Key(1), 0, 8192).empty());
+    EXPECT_TRUE(first->cancelToken->IsCancelled());
+    EXPECT_FALSE(second->cancelToken->IsCancelled());
+    EXPECT_FALSE(first->download->cancelToken->IsCancelled());
+    EXPECT_EQ(1u, table.GetStats().cancelledRunning);
+
+    // 남은 소비자만 다운로드 결과를 받음
+    auto remaining = table.FinishDownload(second->download);
+    ASSERT_EQ(1u, remaining.size());
+    EXPECT_EQ(second, remaining[0]);
+}
+
+TEST(InFlightFetchCancelTest, CancelOnlyAffectsOverlappingRanges) {
+    InFlightFetchTable table;
+    auto low = table.Register(Key(1), 1, 0, 4096, HydrationPriority::Foreground);
+    auto high = table.Register(Key(1), 1, 1 << 20, 4096, HydrationPriority::Foreground);
+
+    EXPECT_EQ(1u, table.Cancel(Key(1), 1 << 20, 4096).size());
+    EXPECT_FALSE(low->cancelToken->IsCancelled());
+    EXPECT_TRUE(high->cancelToken->IsCancelled());
+
+    // 길이 0은 전송 키의 모든 요청을 취소
+    EXPECT_EQ(1u, table.Cancel(Key(1), 0, 0).size());
+    EXPECT_TRUE(low->cancelToken->IsCancelled());
+    EXPECT_TRUE(table.Cancel(Key(1), 0, 0).empty());
+}
+
+TEST(InFlightFetchCancelTest, FinishedDownloadIsNotOrphaned) {
+    InFlightFetchTable table;
+    auto fetch = table.Register(Key(1), 1, 0, 4096, HydrationPriority::Foreground);
+    table.FinishDownload(fetch->download);
+    EXPECT_TRUE(table.Cancel(Key(1), 0, 4096).empty());
+    EXPECT_FALSE(fetch->download->cancelToken->IsCancelled());
+}
+
+TEST(InFlightFetchJoinTest, CoveredRangeJoinsExistingDownload) {
+    InFlightFetchTable table;
+    auto owner = table.Register(Key(1), 1, 0, 1 << 20, HydrationPriority::Foreground);
+    auto joined = table.Register(Key(2), 1, 4096, 4096, HydrationPriority::Foreground);
+
+    EXPECT_TRUE(owner->ownsDownload);
+    EXPECT_FALSE(joined->ownsDownload);
+    EXPECT_EQ(owner->download, joined->download);
+    EXPECT_EQ(1u, table.GetStats().coalesced);
+    EXPECT_EQ(1u, table.GetStats().activeDownloads);
+}
+
+TEST(InFlightFetchJoinTest, PartialOverlapOrOtherFileStartsNewDownload) {
+    InFlightFetchTable table;
+    auto owner = table.Register(Key(1), 1, 0, 8192, HydrationPriority::Foreground);
+    auto pastEnd = table.Register(Key(2), 1, 4096, 8192, HydrationPriority::Foreground);
+    auto otherFile = table.Register(Key(3, 8), 2, 0, 4096, HydrationPriority::Foreground);
+
+    EXPECT_TRUE(pastEnd->ownsDownload);
+    EXPECT_TRUE(otherFile->ownsDownload);
+    EXPECT_NE(owner->download, pastEnd->download);
+    EXPECT_EQ(3u, table.GetStats().activeDownloads);
+    EXPECT_EQ(0u, table.GetStats().coalesced);
+}
+
+TEST(InFlightFetchJoinTest, RangeAlreadyPassedStartsNewDownload) {
+    InFlightFetchTable table;
+    auto owner = table.Register(Key(1), 1, 0, 1 << 20, HydrationPriority::Foreground);
+    owner->download->started = true;
+
+    // 이미 나눠준 청크 안쪽에서 시작하는 요청은 그 데이터를 받을 수 없음
+    auto consumers = table.BeginChunk(owner->download, 65536);
+    EXPECT_EQ(1u, consumers.size());
+    auto behind = table.Register(Key(2), 1, 4096, 4096, HydrationPriority::Foreground);
+    auto ahead = table.Register(Key(3), 1, 65536, 4096, HydrationPriority::Foreground);
+
+    EXPECT_TRUE(behind->ownsDownload);
+    EXPECT_FALSE(ahead->ownsDownload);
+    EXPECT_EQ(2u, table.BeginChunk(owner->download, 131072).size());
+}
+
+TEST(InFlightFetchJoinTest, FinishedDownloadAcceptsNoJoins) {
+    InFlightFetchTable table;
+    auto owner = table.Register(Key(1), 1, 0, 8192, HydrationPriority::Foreground);
+    auto consumers = table.FinishDownload(owner->download);
+    EXPECT_EQ(1u, consumers.size());
+    EXPECT_TRUE(table.FinishDownload(owner->download).empty());
+
+    auto later = table.Register(Key(2), 1, 0, 4096, HydrationPriority::Foreground);
+    EXPECT_TRUE(later->ownsDownload);
+    EXPECT_EQ(1u, table.GetStats().completed);
+}
+
+TEST(InFlightFetchJoinTest, UrgentJoinPromotesQueuedDownloadOnly) {
+    InFlightFetchTable table;
+    auto queued = table.Register(Key(1), 1, 0, 1 << 20, HydrationPriority::Prefetch);
+    auto urgent = table.Register(Key(2), 1, 0, 4096, HydrationPriority::Foreground);
+    EXPECT_TRUE(urgent->promotedDownload);
+    EXPECT_EQ(HydrationPriority::Foreground, queued->download->priority.load());
+
+    auto running = table.Register(Key(3, 8), 2, 0, 1 << 20, HydrationPriority::Prefetch);
+    running->download->started = true;
+    auto late = table.Register(Key(4, 8), 2, 0, 4096, HydrationPriority::Foreground);
+    EXPECT_FALSE(late->promotedDownload);
+    EXPECT_EQ(running->download, late->download);
+    EXPECT_EQ(1u, table.GetStats().promoted);
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "InSyncUpdater.h"
+
+namespace {
+
+// 적용된 요청을 순서대로 기록하는 Applier
+class RecordingApplier {
+public:
+    struct Applied {
+        std::wstring relativePath;
+        InSyncState state;
+    };
+
+    InSyncUpdater::Applier Make() {
+        return [this](const std::wstring& relativePath, InSyncState state) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_applied.push_back({ relativePath, state });
+            m_changed.notify_all();
+            return relativePath == m_failingPath ? E_FAIL : S_OK;
+        };
+    }
+
+    void FailFor(const std::wstring& relativePath) { m_failingPath = relativePath; }
+
+    bool WaitForCount(size_t count, std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_changed.wait_for(lock, timeout, [&] { return m_applied.size() >= count; });
+    }
+
+    std::vector<Applied> Snapshot() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_applied;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::vector<Applied> m_applied;
+    std::wstring m_failingPath;
+};
+
+InSyncUpdaterConfig LongDelay() {
+    InSyncUpdaterConfig config;
+    config.batchDelay = std::chrono::seconds(30);
+    return config;
+}
+
+} // namespace
+
+TEST(InSyncUpdaterTest, CoalescesRepeatedPathToLastState) {
+    RecordingApplier applier;
+    InSyncUpdater updater(LongDelay(), applier.Make());
+    updater.Start();
+
+    updater.Queue(L"Tracks\\a.wav", InSyncState::NotInSync);
+    updater.Queue(L"tracks/A.wav", InSyncState::InSync);
+    updater.Queue(L"Tracks\\a.wav", InSyncState::NotInSync);
+    updater.Queue(L"Tracks\\b.wav", InSyncState::InSync);
+    updater.Flush();
+
+    auto applied = applier.Snapshot();
+    ASSERT_EQ(2u, applied.size());
+    EXPECT_EQ(L"Tracks\\a.wav", applied[0].relativePath);
+    EXPECT_EQ(InSyncState::NotInSync, applied[0].state);
+    EXPECT_EQ(L"Tracks\\b.wav", applied[1].relativePath);
+
+    InSyncUpdaterStats stats = updater.GetStats();
+    EXPECT_EQ(4u, stats.queued);
+    EXPECT_EQ(2u, stats.coalesced);
+    EXPECT_EQ(2u, stats.applied);
+    EXPECT_EQ(1u, stats.sweeps);
+    EXPECT_EQ(0u, stats.pending);
+}
+
+TEST(InSyncUpdaterTest, SweepsFolderByFolder) {
+    RecordingApplier applier;
+    InSyncUpdater updater(LongDelay(), applier.Make());
+    updater.Start();
+
+    updater.Queue(L"Tracks\\b.wav", InSyncState::InSync);
+    updater.Queue(L"References\\r.wav", InSyncState::InSync);
+    updater.Queue(L"Tracks\\a.wav", InSyncState::InSync);
+    updater.Queue(L"root.txt", InSyncState::InSync);
+    updater.Flush();
+
+    auto applied = applier.Snapshot();
+    ASSERT_EQ(4u, applied.size());
+    EXPECT_EQ(L"root.txt", applied[0].relativePath);
+    EXPECT_EQ(L"References\\r.wav", applied[1].relativePath);
+    EXPECT_EQ(L"Tracks\\a.wav", applied[2].relativePath);
+    EXPECT_EQ(L"Tracks\\b.wav", applied[3].relativePath);
+    EXPECT_EQ(3u, updater.GetStats().directoriesSwept);
+}
+
+TEST(InSyncUpdaterTest, FlushOnEmptyQueueKeepsBatching) {
+    RecordingApplier applier;
+    InSyncUpdater updater(LongDelay(), applier.Make());
+    updater.Start();
+
+    // 빈 큐에서의 Flush는 바로 돌아오고, 다음 요청의 모으는 시간을 건너뛰게 하지 않아야 함
+    updater.Flush();
+    updater.Queue(L"Tracks\\a.wav", InSyncState::InSync);
+    EXPECT_FALSE(applier.WaitForCount(1, std::chrono::milliseconds(100)));
+    EXPECT_EQ(1u, updater.GetStats().pending);
+
+    updater.Flush();
+    EXPECT_EQ(1u, applier.Snapshot().size());
+}
+
+TEST(InSyncUpdaterTest, MaxPendingSweepsWithoutDelay) {
+    RecordingApplier applier;
+    InSyncUpdaterConfig config = LongDelay();
+    config.maxPending = 3;
+    InSyncUpdater updater(config, applier.Make());
+    updater.Start();
+
+    updater.Queue(L"a.wav", InSyncState::InSync);
+    updater.Queue(L"b.wav", InSyncState::InSync);
+    EXPECT_FALSE(applier.WaitForCount(1, std::chrono::milliseconds(100)));
+
+    updater.Queue(L"c.wav", InSyncState::InSync);
+    EXPECT_TRUE(applier.WaitForCount(3));
+}
+
+TEST(InSyncUpdaterTest, ReportsFailuresToCallback) {
+    RecordingApplier applier;
+    applier.FailFor(L"Tracks\\bad.wav");
+
+    std::vector<std::pair<std::wstring, HRESULT>> failures;
+    InSyncUpdater updater(LongDelay(), applier.Make(),
+        [&failures](const std::wstring& relativePath, HRESULT hr) { failures.push_back({ relativePath, hr }); });
+    updater.Start();
+
+    updater.Queue(L"Tracks\\good.wav", InSyncState::InSync);
+    updater.Queue(L"Tracks\\bad.wav", InSyncState::InSync);
+    updater.Flush();
+
+    ASSERT_EQ(1u, failures.size());
+    EXPECT_EQ(L"Tracks\\bad.wav", failures[0].first);
+    EXPECT_EQ(E_FAIL, failures[0].second);
+
+    InSyncUpdaterStats stats = updater.GetStats();
+    EXPECT_EQ(1u, stats.applied);
+    EXPECT_EQ(1u, stats.failed);
+}
+
+TEST(InSyncUpdaterTest, StopDrainsPendingUpdates) {
+    RecordingApplier applier;
+    InSyncUpdater updater(LongDelay(), applier.Make());
+    updater.Start();
+
+    updater.Queue(L"a.wav", InSyncState::InSync);
+    updater.Queue(L"b.wav", InSyncState::NotInSync);
+    updater.Stop();
+
+    EXPECT_EQ(2u, applier.Snapshot().size());
+    EXPECT_EQ(0u, updater.GetStats().pending);
+}
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Logger.h"
+#include "ProviderTestFixture.h"
+
+namespace {
+
+// 프로세스 전역 로거를 임시 폴더의 파일로 시작하고 끝나면 정지
+class LoggerTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        Logger::Instance().Stop();
+    }
+
+    LoggerConfig MakeConfig() const {
+        LoggerConfig config;
+        config.console = false;
+        config.minLevel = LogLevel::Debug;
+        config.filePath = m_directory.WidePath() + L"\\app.log";
+        // 자동 주기로는 출력하지 않아 Flush 시점만 결정적으로 확인
+        config.flushInterval = std::chrono::minutes(10);
+        return config;
+    }
+
+    std::string ReadLog(const std::string& suffix = std::string()) const {
+        std::ifstream file(m_directory.Path() + "/app.log" + suffix, std::ios::binary);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    bool LogExists(const std::string& suffix) const {
+        return std::ifstream(m_directory.Path() + "/app.log" + suffix).good();
+    }
+
+    static std::vector<std::string> Lines(const std::string& text) {
+        std::vector<std::string> lines;
+        std::istringstream stream(text);
+        for (std::string line; std::getline(stream, line);) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    static size_t Count(const std::string& text, const std::string& needle) {
+        size_t count = 0;
+        for (size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + needle.size())) {
+            count++;
+        }
+        return count;
+    }
+
+    TempDirectory m_directory;
+};
+
+} // namespace
+
+TEST(LogRingTest, WrapsAndCountsDrops) {
+    LogRing ring(4, 1);
+
+    for (int i = 0; i < 4; ++i) {
+        LogRecord* record = ring.Reserve();
+        ASSERT_NE(nullptr, record);
+        LogLine(*record).Append(i);
+        ring.Commit();
+    }
+    EXPECT_EQ(nullptr, ring.Reserve());
+    EXPECT_EQ(nullptr, ring.Reserve());
+    EXPECT_EQ(2u, ring.TakeDropped());
+    EXPECT_EQ(0u, ring.TakeDropped());
+
+    std::wstring drained;
+    EXPECT_EQ(4u, ring.Drain([&drained](const LogRecord& record) { drained.append(record.text, record.length); }));
+    EXPECT_EQ(L"0123", drained);
+    EXPECT_TRUE(ring.IsEmpty());
+
+    // 비운 뒤에는 같은 슬롯을 다시 사용 (인덱스가 용량을 넘어 감김)
+    for (int i = 4; i < 7; ++i) {
+        LogRecord* record = ring.Reserve();
+        ASSERT_NE(nullptr, record);
+        LogLine(*record).Append(i);
+        ring.Commit();
+    }
+    drained.clear();
+    EXPECT_EQ(3u, ring.Drain([&drained](const LogRecord& record) { drained.append(record.text, record.length); }));
+    EXPECT_EQ(L"456", drained);
+}
+
+TEST(LogLineTest, FormatsValuesAndTruncates) {
+    LogRecord record;
+    LogLine line(record);
+    line.Append(L"hr=");
+    line.Append(LogHex(static_cast<HRESULT>(0x80070005L)));
+    line.Append(L' ');
+    line.Append(-42);
+    line.Append(L' ');
+    line.Append(1.5);
+    EXPECT_EQ(L"hr=0x80070005 -42 1.500", std::wstring(record.text, record.length));
+
+    line.Append(std::wstring(LogRecord::kTextCapacity, L'x'));
+    EXPECT_EQ(static_cast<size_t>(LogRecord::kTextCapacity), record.length);
+}
+
+TEST_F(LoggerTest, FullThreadRingReportsDroppedMessages) {
+    LoggerConfig config = MakeConfig();
+    config.ringCapacity = 4;
+    ASSERT_EQ(S_OK, Logger::Instance().Start(config));
+    const uint64_t droppedBefore = Logger::Instance().GetStats().dropped;
+
+    // 새 스레드라 설정한 용량의 링을 받음
+    std::thread([] {
+        for (int i = 0; i < 10; ++i) {
+            MBD_LOG_INFO(L"message ", i);
+        }
+    }).join();
+    Logger::Instance().Flush();
+
+    std::string log = ReadLog();
+    EXPECT_EQ(4u, Count(log, "] message ")) << log;
+    EXPECT_NE(std::string::npos, log.find("message 3")) << log;
+    EXPECT_EQ(std::string::npos, log.find("message 4")) << log;
+    EXPECT_NE(std::string::npos, log.find("[W] 6 log messages dropped")) << log;
+    EXPECT_EQ(6u, Logger::Instance().GetStats().dropped - droppedBefore);
+}
+
+TEST_F(LoggerTest, FlushWritesAllThreadsInTimestampOrder) {
+    ASSERT_EQ(S_OK, Logger::Instance().Start(MakeConfig()));
+
+    const int perThread = 200;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([t, perThread] {
+            for (int i = 0; i < perThread; ++i) {
+                MBD_LOG_INFO(L"thread ", t, L" seq ", i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    Logger::Instance().Flush();
+
+    std::vector<std::string> lines = Lines(ReadLog());
+    int next[3] = {};
+    for (size_t i = 0; i < lines.size(); ++i) {
+        // "YYYY-MM-DD HH:MM:SS.mmm"는 문자열 비교로 시간순
+        if (i > 0) {
+            ASSERT_LE(lines[i - 1].substr(0, 23), lines[i].substr(0, 23)) << lines[i];
+        }
+        // 로거가 멈춰 있던 동안 다른 테스트가 남긴 줄은 건너뜀
+        size_t at = lines[i].find("] thread ");
+        if (at == std::string::npos) {
+            continue;
+        }
+        at += 2;
+        int thread = lines[i][at + 7] - '0';
+        ASSERT_GE(thread, 0);
+        ASSERT_LT(thread, 3);
+        // 같은 스레드의 메시지는 남긴 순서 그대로
+        EXPECT_EQ("seq " + std::to_string(next[thread]), lines[i].substr(at + 9)) << lines[i];
+        next[thread]++;
+    }
+    for (int count : next) {
+        EXPECT_EQ(perThread, count);
+    }
+}
+
+TEST_F(LoggerTest, FiltersBelowMinLevel) {
+    LoggerConfig config = MakeConfig();
+    config.minLevel = LogLevel::Warning;
+    ASSERT_EQ(S_OK, Logger::Instance().Start(config));
+
+    MBD_LOG_INFO(L"hidden");
+    MBD_LOG_WARNING(L"shown");
+    MBD_LOG_ERROR(L"also shown");
+    Logger::Instance().Flush();
+
+    std::string log = ReadLog();
+    EXPECT_EQ(std::string::npos, log.find("hidden")) << log;
+    EXPECT_NE(std::string::npos, log.find("[W] [")) << log;
+    EXPECT_NE(std::string::npos, log.find("[E] [")) << log;
+}
+
+TEST_F(LoggerTest, RotatesThroughNumberedFiles) {
+    LoggerConfig config = MakeConfig();
+    config.maxFileBytes = 200;
+    config.maxFiles = 3;
+    ASSERT_EQ(S_OK, Logger::Instance().Start(config));
+    const uint64_t rotationsBefore = Logger::Instance().GetStats().rotations;
+
+    // Flush 한 번에 한도를 넘는 한 줄씩 써서 매번 회전
+    for (int batch = 0; batch < 5; ++batch) {
+        MBD_LOG_INFO(L"batch ", batch, L" ", std::wstring(200, L'x'));
+        Logger::Instance().Flush();
+    }
+    EXPECT_EQ(5u, Logger::Instance().GetStats().rotations - rotationsBefore);
+    Logger::Instance().Stop();
+
+    // 현재 파일은 방금 새로 열려 비어 있고, .1이 가장 최근, .2가 그 이전, 더 오래된 파일은 삭제됨
+    EXPECT_TRUE(ReadLog().empty());
+    EXPECT_NE(std::string::npos, ReadLog(".1").find("batch 4"));
+    EXPECT_NE(std::string::npos, ReadLog(".2").find("batch 3"));
+    EXPECT_FALSE(LogExists(".3"));
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include "MetadataIndex.h"
+#include "ProviderTestFixture.h"
+
+namespace {
+
+FileMetadata Entry(const std::wstring& relativePath, std::string identity, LONGLONG fileSize) {
+    FileMetadata entry;
+    entry.relativePath = relativePath;
+    entry.fileIdentity = std::move(identity);
+    entry.fileSize = fileSize;
+    entry.contentVersion = static_cast<ULONGLONG>(fileSize) + 1;
+    entry.contentHash.bytes[0] = static_cast<BYTE>(fileSize);
+    entry.syncState = MetadataSyncState::InSync;
+    return entry;
+}
+
+std::wstring ViewPath(const MetadataView& view) {
+    return std::wstring(view.relativePath, view.relativePathLength);
+}
+
+} // namespace
+
+TEST(MetadataIndexTest, NormalizesPaths) {
+    EXPECT_EQ(L"tracks\\a.wav", NormalizeMetadataPath(L"\\\\Tracks/A.WAV"));
+    EXPECT_EQ(L"", NormalizeMetadataPath(L"/"));
+}
+
+TEST(MetadataIndexTest, FindsEntriesCaseInsensitivelyAfterReopen) {
+    TempDirectory root;
+    const std::wstring path = root.WidePath() + L"\\index\\metadata.idx";
+
+    // 홀수 길이 식별자 뒤의 경로도 wchar_t 경계에 맞춰 저장되어야 함
+    std::vector<FileMetadata> entries = {
+        Entry(L"Tracks\\b.wav", "abc", 300),
+        Entry(L"Tracks/A.wav", "x", 100),
+        Entry(L"WorkRequests\\c.wav", "", 200),
+    };
+    ASSERT_EQ(S_OK, MetadataIndex::Write(path, entries));
+
+    MetadataIndex index;
+    ASSERT_EQ(S_OK, index.Open(path));
+    EXPECT_EQ(3u, index.Count());
+
+    MetadataView view;
+    ASSERT_TRUE(index.Find(L"\\tracks\\a.WAV", view));
+    EXPECT_EQ(L"tracks\\a.wav", ViewPath(view));
+    EXPECT_EQ(std::string("x"), std::string(reinterpret_cast<const char*>(view.fileIdentity), view.fileIdentityLength));
+    EXPECT_EQ(100, view.fileSize);
+    EXPECT_EQ(101u, view.contentVersion);
+    EXPECT_EQ(100, view.contentHash[0]);
+    EXPECT_EQ(MetadataSyncState::InSync, view.syncState);
+
+    ASSERT_TRUE(index.Find(L"Tracks/B.wav", view));
+    EXPECT_EQ(300, view.fileSize);
+    ASSERT_TRUE(index.Find(L"workrequests\\c.wav", view));
+    EXPECT_EQ(0u, view.fileIdentityLength);
+
+    EXPECT_FALSE(index.Find(L"Tracks", view));
+    EXPECT_FALSE(index.Find(L"Tracks\\a.wav2", view));
+    EXPECT_FALSE(index.Find(L"zzz", view));
+}
+
+TEST(MetadataIndexTest, DuplicatePathsKeepTheFirstEntry) {
+    TempDirectory root;
+    const std::wstring path = root.WidePath() + L"\\metadata.idx";
+    ASSERT_EQ(S_OK, MetadataIndex::Write(path, { Entry(L"a.wav", "1", 10), Entry(L"A.WAV", "2", 20) }));
+
+    MetadataIndex index;
+    ASSERT_EQ(S_OK, index.Open(path));
+    EXPECT_EQ(1u, index.Count());
+    MetadataView view;
+    ASSERT_TRUE(index.Find(L"a.wav", view));
+    EXPECT_EQ(10, view.fileSize);
+}
+
+TEST(MetadataIndexTest, ManyEntriesAreAllFound) {
+    TempDirectory root;
+    const std::wstring path = root.WidePath() + L"\\metadata.idx";
+    std::vector<FileMetadata> entries;
+    for (int i = 0; i < 1000; ++i) {
+        entries.push_back(Entry(L"Folder " + std::to_wstring(i % 10) + L"\\Track " + std::to_wstring(i) + L".wav", "id", i));
+    }
+    ASSERT_EQ(S_OK, MetadataIndex::Write(path, entries));
+
+    MetadataIndex index;
+    ASSERT_EQ(S_OK, index.Open(path));
+    ASSERT_EQ(entries.size(), index.Count());
+    MetadataView view;
+    for (const FileMetadata& entry : entries) {
+        ASSERT_TRUE(index.Find(entry.relativePath, view));
+        EXPECT_EQ(entry.fileSize, view.fileSize);
+    }
+}
+
+TEST(MetadataIndexTest, RejectsMissingAndCorruptFiles) {
+    TempDirectory root;
+    MetadataIndex index;
+    EXPECT_TRUE(FAILED(index.Open(root.WidePath() + L"\\missing.idx")));
+    EXPECT_FALSE(index.IsOpen());
+
+    const std::string corrupt = root.Path() + "/corrupt.idx";
+    {
+        std::ofstream file(corrupt, std::ios::binary);
+        file << std::string(64, 'x');
+    }
+    EXPECT_EQ(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), index.Open(root.WidePath() + L"\\corrupt.idx"));
+    EXPECT_FALSE(index.IsOpen());
+    MetadataView view;
+    EXPECT_FALSE(index.Find(L"a.wav", view));
+}
+
+TEST(MetadataIndexTest, WriteReplacesAnOpenIndexFile) {
+    TempDirectory root;
+    const std::wstring path = root.WidePath() + L"\\metadata.idx";
+    ASSERT_EQ(S_OK, MetadataIndex::Write(path, { Entry(L"a.wav", "1", 10) }));
+
+    MetadataIndex first;
+    ASSERT_EQ(S_OK, first.Open(path));
+    ASSERT_EQ(S_OK, MetadataIndex::Write(path, { Entry(L"a.wav", "1", 10), Entry(L"b.wav", "2", 20) }));
+
+    // 이미 연 인덱스는 이전 내용을 계속 보고, 새로 열면 교체된 내용을 봄
+    EXPECT_EQ(1u, first.Count());
+    MetadataIndex second;
+    ASSERT_EQ(S_OK, second.Open(path));
+    EXPECT_EQ(2u, second.Count());
+}
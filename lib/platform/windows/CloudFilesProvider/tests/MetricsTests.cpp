@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include "Metrics.h"
+#include "ProviderMetricsApi.h"
+#include "ProviderTestFixture.h"
+
+TEST(LatencyHistogramTest, SmallValuesHaveExactBuckets) {
+    for (uint64_t value = 0; value < LatencyHistogram::kSubBucketCount; ++value) {
+        EXPECT_EQ(value, LatencyHistogram::BucketIndex(value));
+        EXPECT_EQ(value, LatencyHistogram::BucketUpperBound(LatencyHistogram::BucketIndex(value)));
+    }
+}
+
+TEST(LatencyHistogramTest, SubBucketEdges) {
+    // 16..31은 폭 1, 32부터는 2의 거듭제곱마다 폭이 두 배
+    EXPECT_EQ(16u, LatencyHistogram::BucketIndex(16));
+    EXPECT_EQ(31u, LatencyHistogram::BucketIndex(31));
+    EXPECT_EQ(32u, LatencyHistogram::BucketIndex(32));
+    EXPECT_EQ(32u, LatencyHistogram::BucketIndex(33));
+    EXPECT_EQ(33u, LatencyHistogram::BucketIndex(34));
+    EXPECT_EQ(33u, LatencyHistogram::BucketUpperBound(32));
+    EXPECT_EQ(35u, LatencyHistogram::BucketUpperBound(33));
+
+    // 모든 구간에서 하위 버킷 경계 값이 자기 버킷 안에 들어가고 상대 폭은 1/16 이하
+    for (int exponent = LatencyHistogram::kSubBucketBits; exponent <= LatencyHistogram::kMaxExponent; ++exponent) {
+        for (uint64_t subBucket = 0; subBucket < LatencyHistogram::kSubBucketCount; ++subBucket) {
+            const int shift = exponent - LatencyHistogram::kSubBucketBits;
+            const uint64_t lower = (LatencyHistogram::kSubBucketCount + subBucket) << shift;
+            const uint64_t upper = lower + (uint64_t(1) << shift) - 1;
+            const size_t index = LatencyHistogram::BucketIndex(lower);
+            ASSERT_EQ(index, LatencyHistogram::BucketIndex(upper)) << "exponent " << exponent;
+            ASSERT_EQ(upper, LatencyHistogram::BucketUpperBound(index));
+            if (index + 1 < LatencyHistogram::kBucketCount) {
+                ASSERT_EQ(index + 1, LatencyHistogram::BucketIndex(upper + 1));
+            }
+            ASSERT_LE((upper - lower + 1) * LatencyHistogram::kSubBucketCount, lower);
+        }
+    }
+}
+
+TEST(LatencyHistogramTest, OverflowBucketCollectsLargeValues) {
+    const size_t last = LatencyHistogram::kBucketCount - 1;
+    EXPECT_EQ(last, LatencyHistogram::BucketIndex(uint64_t(1) << (LatencyHistogram::kMaxExponent + 1)));
+    EXPECT_EQ(last, LatencyHistogram::BucketIndex((std::numeric_limits<uint64_t>::max)()));
+
+    LatencyHistogram histogram;
+    const uint64_t huge = uint64_t(1) << 50;
+    histogram.Record(huge);
+    LatencySummary summary = histogram.Summarize();
+    EXPECT_EQ(1u, summary.count);
+    EXPECT_EQ(huge, summary.max);
+    // 마지막 버킷의 상한이 기록된 값보다 작아도 백분위는 그 버킷 상한으로 보고됨
+    EXPECT_EQ(LatencyHistogram::BucketUpperBound(last), summary.p99);
+}
+
+TEST(LatencyHistogramTest, SummarizesKnownDistribution) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 100; ++value) {
+        histogram.Record(value);
+    }
+
+    LatencySummary summary = histogram.Summarize();
+    EXPECT_EQ(100u, summary.count);
+    EXPECT_EQ(50u, summary.mean);
+    EXPECT_EQ(100u, summary.max);
+    EXPECT_EQ(51u, summary.p50);    // 50..51 버킷
+    EXPECT_EQ(91u, summary.p90);    // 88..91 버킷
+    EXPECT_EQ(99u, summary.p99);    // 96..99 버킷
+    EXPECT_EQ(100u, summary.p999);  // 100..103 버킷이지만 최댓값으로 제한
+
+    histogram.Reset();
+    summary = histogram.Summarize();
+    EXPECT_EQ(0u, summary.count);
+    EXPECT_EQ(0u, summary.max);
+    EXPECT_EQ(0u, summary.p50);
+}
+
+TEST(MetricsRegistryTest, CountersAndReset) {
+    MetricsRegistry registry;
+    registry.Add(MetricCounter::BytesTransferred, 4096);
+    registry.Add(MetricCounter::BytesTransferred, 4096);
+    registry.Add(MetricCounter::DownloadsStarted);
+    registry.Record(MetricHistogram::Download, std::chrono::microseconds(3));
+    registry.Record(MetricHistogram::Download, std::chrono::nanoseconds(-5));  // 음수는 0으로 기록
+
+    EXPECT_EQ(8192u, registry.Get(MetricCounter::BytesTransferred));
+    EXPECT_EQ(1u, registry.Get(MetricCounter::DownloadsStarted));
+    LatencySummary download = registry.Summarize(MetricHistogram::Download);
+    EXPECT_EQ(2u, download.count);
+    EXPECT_EQ(3000u, download.max);
+
+    registry.Reset();
+    EXPECT_EQ(0u, registry.Get(MetricCounter::BytesTransferred));
+    EXPECT_EQ(0u, registry.Summarize(MetricHistogram::Download).count);
+}
+
+class MetricsSnapshotTest : public ProviderTest {};
+
+TEST_F(MetricsSnapshotTest, TruncatesToCallerStructSize) {
+    // 버전 1 바인딩은 placeholderBatch 앞까지만 알고 있음
+    const size_t versionOneSize = offsetof(MbdMetricsSnapshot, placeholderBatch);
+    MbdMetricsSnapshot snapshot;
+    memset(&snapshot, 0xCC, sizeof(snapshot));
+    snapshot.structSize = static_cast<uint32_t>(versionOneSize);
+    Provider().ResetMetrics();
+
+    ASSERT_EQ(S_OK, MbdGetMetricsSnapshot(&snapshot));
+    EXPECT_EQ(versionOneSize, snapshot.structSize);
+    EXPECT_EQ(static_cast<uint32_t>(MBD_METRICS_VERSION), snapshot.version);
+    EXPECT_EQ(0u, snapshot.bytesTransferred);
+
+    const BYTE* bytes = reinterpret_cast<const BYTE*>(&snapshot);
+    for (size_t i = versionOneSize; i < sizeof(snapshot); ++i) {
+        ASSERT_EQ(0xCC, bytes[i]) << "byte " << i << " written past structSize";
+    }
+}
+
+TEST_F(MetricsSnapshotTest, RejectsHeaderOnlyStruct) {
+    MbdMetricsSnapshot snapshot = {};
+    snapshot.structSize = static_cast<uint32_t>(offsetof(MbdMetricsSnapshot, fetchData)) - 1;
+    EXPECT_EQ(E_INVALIDARG, MbdGetMetricsSnapshot(&snapshot));
+    EXPECT_EQ(E_INVALIDARG, MbdGetMetricsSnapshot(nullptr));
+}
+
+TEST_F(MetricsSnapshotTest, LargerCallerStructGetsCurrentSize) {
+    struct {
+        MbdMetricsSnapshot snapshot;
+        BYTE future[32];
+    } extended;
+    memset(&extended, 0xCC, sizeof(extended));
+    extended.snapshot.structSize = sizeof(extended);
+
+    ASSERT_EQ(S_OK, MbdGetMetricsSnapshot(&extended.snapshot));
+    EXPECT_EQ(sizeof(MbdMetricsSnapshot), extended.snapshot.structSize);
+    for (BYTE value : extended.future) {
+        EXPECT_EQ(0xCC, value);
+    }
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "PathTable.h"
+
+TEST(PathTableTest, SamePathGetsSameIdIgnoringCaseAndSeparators) {
+    PathTable table;
+    PathId id = table.Intern(L"Tracks\\Album\\a.wav");
+    EXPECT_NE(kRootPathId, id);
+    EXPECT_NE(kInvalidPathId, id);
+    EXPECT_EQ(id, table.Intern(L"tracks/ALBUM/a.WAV"));
+    EXPECT_EQ(id, table.Intern(L"\\Tracks\\\\Album\\a.wav\\"));
+    EXPECT_NE(id, table.Intern(L"Tracks\\Album\\b.wav"));
+
+    // 이름은 처음 등록된 표기로 보관
+    EXPECT_EQ(L"Tracks\\Album\\a.wav", table.GetPath(id));
+}
+
+TEST(PathTableTest, SiblingsShareTheirParentNode) {
+    PathTable table;
+    PathId a = table.Intern(L"Tracks\\Album\\a.wav");
+    const size_t size = table.Size();
+    PathId b = table.Intern(L"Tracks\\Album\\b.wav");
+
+    // 새 구성 요소 하나만 추가됨
+    EXPECT_EQ(size + 1, table.Size());
+    EXPECT_EQ(table.Parent(a), table.Parent(b));
+    EXPECT_EQ(table.Find(L"Tracks\\Album"), table.Parent(a));
+    EXPECT_EQ(table.Find(L"Tracks"), table.Parent(table.Parent(a)));
+    EXPECT_EQ(kRootPathId, table.Parent(table.Find(L"Tracks")));
+}
+
+TEST(PathTableTest, FindDoesNotAddPaths) {
+    PathTable table;
+    table.Intern(L"Tracks\\a.wav");
+    const size_t size = table.Size();
+
+    EXPECT_EQ(kInvalidPathId, table.Find(L"Tracks\\b.wav"));
+    EXPECT_EQ(kInvalidPathId, table.Find(L"Other\\a.wav"));
+    EXPECT_EQ(size, table.Size());
+    EXPECT_EQ(table.Intern(L"Tracks\\a.wav"), table.Find(L"TRACKS/A.WAV"));
+}
+
+TEST(PathTableTest, RootIsTheEmptyPath) {
+    PathTable table;
+    EXPECT_EQ(kRootPathId, table.Intern(L""));
+    EXPECT_EQ(kRootPathId, table.Intern(L"\\"));
+    EXPECT_EQ(kRootPathId, table.Find(L""));
+    EXPECT_EQ(L"", table.GetPath(kRootPathId));
+    EXPECT_EQ(kInvalidPathId, table.Parent(kRootPathId));
+
+    EXPECT_EQ(L"C:\\Drive", table.GetFullPath(L"C:\\Drive", kRootPathId));
+    EXPECT_EQ(L"C:\\Drive\\a\\b.wav", table.GetFullPath(L"C:\\Drive", table.Intern(L"a/b.wav")));
+}
+
+TEST(PathTableTest, AppendPathKeepsExistingPrefix) {
+    PathTable table;
+    std::wstring out = L"prefix:";
+    table.AppendPath(table.Intern(L"x\\y"), out);
+    EXPECT_EQ(L"prefix:x\\y", out);
+
+    // 잘못된 ID는 아무것도 붙이지 않음
+    table.AppendPath(12345, out);
+    EXPECT_EQ(L"prefix:x\\y", out);
+    EXPECT_EQ(kInvalidPathId, table.Parent(12345));
+}
+
+TEST(PathTableTest, IdsStayStableAcrossGrowth) {
+    PathTable table;
+    std::vector<PathId> ids;
+    for (int i = 0; i < 5000; ++i) {
+        ids.push_back(table.Intern(L"Folder " + std::to_wstring(i % 37) + L"\\File " + std::to_wstring(i)));
+    }
+    for (int i = 0; i < 5000; ++i) {
+        const std::wstring path = L"Folder " + std::to_wstring(i % 37) + L"\\File " + std::to_wstring(i);
+        ASSERT_EQ(ids[i], table.Find(path));
+        ASSERT_EQ(path, table.GetPath(ids[i]));
+    }
+    EXPECT_EQ(1u + 37u + 5000u, table.Size());
+}
+
+TEST(PathTableTest, ConcurrentInternAgreesOnIds) {
+    PathTable table;
+    const int kThreads = 4;
+    const int kPaths = 2000;
+    std::vector<std::vector<PathId>> results(kThreads, std::vector<PathId>(kPaths));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&table, &results, t]() {
+            for (int i = 0; i < kPaths; ++i) {
+                // 스레드마다 다른 순서로 같은 경로 집합을 등록
+                int index = t % 2 == 0 ? (i + t * 500) % kPaths : kPaths - 1 - i;
+                results[t][index] = table.Intern(L"Dir " + std::to_wstring(index % 50) + L"\\" + std::to_wstring(index));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int t = 1; t < kThreads; ++t) {
+        EXPECT_EQ(results[0], results[t]);
+    }
+    EXPECT_EQ(1u + 50u + kPaths, table.Size());
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include "PlaceholderArena.h"
+#include "ProviderTestFixture.h"
+#include "CfApiBackend.h"
+
+namespace {
+
+bool IsAligned(const void* pointer, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(pointer) % alignment == 0;
+}
+
+} // namespace
+
+TEST(PlaceholderArenaTest, AllocationsAreAlignedAndDoNotOverlap) {
+    PlaceholderArena arena(256);
+    BYTE* first = static_cast<BYTE*>(arena.Allocate(3, 1));
+    uint64_t* second = arena.AllocateArray<uint64_t>(4);
+    ASSERT_NE(nullptr, first);
+    ASSERT_NE(nullptr, second);
+    EXPECT_TRUE(IsAligned(second, alignof(uint64_t)));
+    EXPECT_GE(reinterpret_cast<BYTE*>(second), first + 3);
+
+    // 같은 블록 안에서 이어서 할당
+    EXPECT_EQ(256u, arena.BytesReserved());
+}
+
+TEST(PlaceholderArenaTest, GrowsWithNewBlocksAndKeepsEarlierData) {
+    PlaceholderArena arena(64);
+    LPCWSTR name = arena.CopyString(L"Track 01.wav");
+    ASSERT_NE(nullptr, name);
+
+    // 블록보다 큰 요청은 요청 크기만큼의 블록 하나로
+    void* large = arena.Allocate(1000);
+    ASSERT_NE(nullptr, large);
+    EXPECT_TRUE(IsAligned(large, alignof(std::max_align_t)));
+    EXPECT_GE(arena.BytesReserved(), 64u + 1000u);
+    EXPECT_EQ(std::wstring(L"Track 01.wav"), name);
+}
+
+TEST(PlaceholderArenaTest, CopiesStringsAndBytes) {
+    PlaceholderArena arena;
+    LPCWSTR empty = arena.CopyString(L"");
+    ASSERT_NE(nullptr, empty);
+    EXPECT_EQ(L'\0', empty[0]);
+
+    const BYTE identity[] = { 1, 2, 3, 4, 5 };
+    const void* copy = arena.CopyBytes(identity, sizeof(identity));
+    ASSERT_NE(nullptr, copy);
+    EXPECT_NE(static_cast<const void*>(identity), copy);
+    EXPECT_EQ(0, memcmp(identity, copy, sizeof(identity)));
+
+    // 0바이트 복사도 유효한 포인터를 돌려줌
+    EXPECT_NE(nullptr, arena.CopyBytes(nullptr, 0));
+}
+
+TEST(PlaceholderArenaTest, ResetKeepsOnlyTheFirstBlock) {
+    PlaceholderArena arena(128);
+    void* first = arena.Allocate(16);
+    arena.Allocate(512);
+    arena.Allocate(512);
+    EXPECT_GT(arena.BytesReserved(), 128u);
+
+    arena.Reset();
+    EXPECT_EQ(128u, arena.BytesReserved());
+    // 첫 블록을 처음부터 다시 사용
+    EXPECT_EQ(first, arena.Allocate(16));
+}
+
+TEST(CfApiBackendTest, CreatesAFolderOfPlaceholdersInOnePlatformCall) {
+    TempDirectory root;
+    cfapi_stub::Reset();
+    CfApiBackend backend;
+    ASSERT_EQ(S_OK, backend.Connect(root.WidePath() + L"\\Drive", L"Test Drive", BackendSyncPolicy(), nullptr));
+
+    // arena 초기 크기 추정을 넘는 긴 이름도 섞어 블록이 늘어나는 경로까지 확인
+    std::vector<PlaceholderEntry> entries(300);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        entries[i].name = L"Track " + std::to_wstring(i) + std::wstring(i % 7 == 0 ? 200 : 0, L'x') + L".wav";
+        entries[i].fileSize.QuadPart = static_cast<LONGLONG>(i) * 4096;
+        entries[i].identity.contentVersion = i + 1;
+    }
+
+    std::vector<HRESULT> results;
+    EXPECT_EQ(S_OK, backend.CreatePlaceholders(L"Album", entries.data(), entries.size(), results));
+    backend.Disconnect();
+
+    ASSERT_EQ(entries.size(), results.size());
+    for (HRESULT hr : results) {
+        EXPECT_EQ(S_OK, hr);
+    }
+    EXPECT_EQ(1u, cfapi_stub::Get().createCalls);
+    EXPECT_EQ(entries.size(), cfapi_stub::Get().placeholdersCreated);
+}
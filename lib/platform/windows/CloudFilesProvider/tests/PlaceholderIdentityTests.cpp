@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "PlaceholderIdentity.h"
+
+namespace {
+
+PlaceholderIdentity MakeIdentity() {
+    PlaceholderIdentity identity;
+    for (BYTE i = 0; i < 16; ++i) {
+        identity.objectId[i] = static_cast<BYTE>(0x10 + i);
+        identity.manifestId[i] = static_cast<BYTE>(0xA0 + i);
+    }
+    identity.contentVersion = 0x0102030405060708ULL;
+    return identity;
+}
+
+} // namespace
+
+TEST(PlaceholderIdentityTest, SerializeParseRoundTrip) {
+    PlaceholderIdentity identity = MakeIdentity();
+    std::string blob = identity.Serialize();
+    ASSERT_EQ(kPlaceholderIdentitySize, blob.size());
+
+    PlaceholderIdentity parsed;
+    ASSERT_TRUE(PlaceholderIdentity::Parse(blob.data(), blob.size(), parsed));
+    EXPECT_EQ(0, memcmp(identity.objectId, parsed.objectId, sizeof(parsed.objectId)));
+    EXPECT_EQ(identity.contentVersion, parsed.contentVersion);
+    EXPECT_EQ(0, memcmp(identity.manifestId, parsed.manifestId, sizeof(parsed.manifestId)));
+    EXPECT_TRUE(parsed.HasObjectId());
+    EXPECT_TRUE(parsed.HasManifestId());
+    EXPECT_EQ(L"101112131415161718191a1b1c1d1e1f", parsed.ObjectIdHex());
+}
+
+TEST(PlaceholderIdentityTest, BlobLayoutIsStable) {
+    // 앱(cloud_files_api.dart)이 같은 배치로 쓰므로 오프셋이 바뀌면 안 됨
+    std::string blob = MakeIdentity().Serialize();
+    const BYTE* bytes = reinterpret_cast<const BYTE*>(blob.data());
+
+    EXPECT_EQ(1, bytes[0]);
+    for (int i = 1; i < 8; ++i) {
+        EXPECT_EQ(0, bytes[i]) << "reserved byte " << i;
+    }
+    EXPECT_EQ(0x10, bytes[8]);
+    EXPECT_EQ(0x1F, bytes[23]);
+    EXPECT_EQ(0x08, bytes[24]);  // 버전은 리틀 엔디언
+    EXPECT_EQ(0x01, bytes[31]);
+    EXPECT_EQ(0xA0, bytes[32]);
+    EXPECT_EQ(0xAF, bytes[47]);
+}
+
+TEST(PlaceholderIdentityTest, RejectsUnknownFormat) {
+    std::string blob = MakeIdentity().Serialize();
+    blob[0] = 2;
+
+    PlaceholderIdentity parsed;
+    EXPECT_FALSE(PlaceholderIdentity::Parse(blob.data(), blob.size(), parsed));
+    EXPECT_FALSE(parsed.HasObjectId());
+}
+
+TEST(PlaceholderIdentityTest, RejectsWrongLength) {
+    std::string blob = MakeIdentity().Serialize();
+    PlaceholderIdentity parsed;
+
+    // 이전 형식 (경로 해시 8바이트)
+    EXPECT_FALSE(PlaceholderIdentity::Parse(blob.data(), 8, parsed));
+    EXPECT_FALSE(PlaceholderIdentity::Parse(blob.data(), blob.size() - 1, parsed));
+    blob.push_back('\0');
+    EXPECT_FALSE(PlaceholderIdentity::Parse(blob.data(), blob.size(), parsed));
+    EXPECT_FALSE(PlaceholderIdentity::Parse(nullptr, kPlaceholderIdentitySize, parsed));
+}
+
+TEST(PlaceholderIdentityTest, FromPathIsStableAndNormalized) {
+    PlaceholderIdentity identity = PlaceholderIdentity::FromPath(L"Tracks\\a.wav");
+    EXPECT_TRUE(identity.HasObjectId());
+    EXPECT_FALSE(identity.HasManifestId());
+    EXPECT_EQ(0u, identity.contentVersion);
+
+    // 정규화된 경로의 UTF-16LE SHA-256 앞 16바이트
+    EXPECT_EQ(L"ddd35775b1328540275486a043ef5917", identity.ObjectIdHex());
+    EXPECT_EQ(identity.ObjectIdHex(), PlaceholderIdentity::FromPath(L"tracks/A.WAV").ObjectIdHex());
+    EXPECT_EQ(identity.ObjectIdHex(), PlaceholderIdentity::FromPath(L"\\Tracks\\a.wav").ObjectIdHex());
+    EXPECT_NE(identity.ObjectIdHex(), PlaceholderIdentity::FromPath(L"Tracks\\b.wav").ObjectIdHex());
+}
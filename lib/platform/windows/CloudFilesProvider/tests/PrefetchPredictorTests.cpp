@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include "PrefetchPredictor.h"
+
+namespace {
+
+const DWORD kUserProcessId = 4242;
+
+// 미리 가져오기 요청을 기록하고, Block()이면 Release()까지 첫 요청을 멈춰 둠
+class RecordingPrefetcher {
+public:
+    PrefetchPredictor::PrefetchAction Action() {
+        return [this](const std::wstring& path) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_paths.push_back(path);
+            m_changed.notify_all();
+            m_changed.wait(lock, [this]() { return !m_blocked; });
+            return S_OK;
+        };
+    }
+
+    void Block() { std::lock_guard<std::mutex> lock(m_mutex); m_blocked = true; }
+
+    void Release() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_blocked = false;
+        m_changed.notify_all();
+    }
+
+    bool WaitForCount(size_t count) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_changed.wait_for(lock, std::chrono::seconds(10), [&]() { return m_paths.size() >= count; });
+    }
+
+    std::vector<std::wstring> Paths() { std::lock_guard<std::mutex> lock(m_mutex); return m_paths; }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    bool m_blocked = false;
+    std::vector<std::wstring> m_paths;
+};
+
+PrefetchPredictor::SiblingLister Siblings(std::vector<std::wstring> names) {
+    return [names](const std::wstring& directory) {
+        std::vector<std::wstring> files;
+        for (const auto& name : names) {
+            files.push_back(directory + L"\\" + name);
+        }
+        return files;
+    };
+}
+
+template <typename Condition>
+bool WaitUntil(Condition condition) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(PrefetchPredictorTest, SiblingsDoNotWrapAroundToFirstFile) {
+    RecordingPrefetcher prefetcher;
+    PrefetchPredictor predictor(PrefetchConfig(), prefetcher.Action(), Siblings({ L"a.wav", L"b.wav", L"c.wav" }));
+    predictor.Start();
+
+    // 마지막 파일을 열면 예측이 없어야 하고, 그 다음 열기만 예측을 만듦
+    predictor.OnFileOpened(L"Song\\Tracks\\c.wav", kUserProcessId);
+    predictor.OnFileClosed(L"Song\\Tracks\\c.wav", kInvalidPathId);
+    predictor.OnFileOpened(L"Song\\Tracks\\b.wav", kUserProcessId);
+    ASSERT_TRUE(prefetcher.WaitForCount(1));
+    predictor.Stop();
+
+    EXPECT_EQ((std::vector<std::wstring>{ L"Song\\Tracks\\c.wav" }), prefetcher.Paths());
+    EXPECT_EQ(1u, predictor.GetStats().predictions);
+}
+
+TEST(PrefetchPredictorTest, ByteBudgetSkipsLargeCandidates) {
+    PrefetchConfig config;
+    config.maxPrefetchBytesPerOpen = 1000;
+    std::map<std::wstring, LONGLONG> sizes = {
+        { L"Tracks\\b.wav", 5000 }, { L"Tracks\\c.wav", 600 }, { L"Tracks\\d.wav", 300 }, { L"Tracks\\e.wav", 300 },
+    };
+    RecordingPrefetcher prefetcher;
+    PrefetchPredictor predictor(config, prefetcher.Action(), Siblings({ L"a.wav", L"b.wav", L"c.wav", L"d.wav", L"e.wav" }),
+                                [&sizes](const std::wstring& path) { return sizes.count(path) ? sizes[path] : -1; });
+    predictor.Start();
+
+    predictor.OnFileOpened(L"Tracks\\a.wav", kUserProcessId);
+    ASSERT_TRUE(prefetcher.WaitForCount(2));
+    ASSERT_TRUE(WaitUntil([&]() { return predictor.GetStats().issued == 2; }));
+    predictor.Stop();
+
+    // b는 혼자서 한도를 넘고, e는 c와 d 뒤에 남은 한도를 넘음
+    EXPECT_EQ((std::vector<std::wstring>{ L"Tracks\\c.wav", L"Tracks\\d.wav" }), prefetcher.Paths());
+    EXPECT_EQ(2u, predictor.GetStats().overBudget);
+}
+
+TEST(PrefetchPredictorTest, OwnProcessOpensAreNotLearned) {
+    RecordingPrefetcher prefetcher;
+    PrefetchPredictor predictor(PrefetchConfig(), prefetcher.Action(), nullptr);
+    predictor.OnFileOpened(L"a.wav", GetCurrentProcessId());
+    predictor.OnFileOpened(L"b.wav", GetCurrentProcessId());
+    EXPECT_EQ(0u, predictor.GetStats().opens);
+    EXPECT_EQ(0u, predictor.GetStats().learnedFiles);
+
+    predictor.OnFileOpened(L"a.wav", kUserProcessId);
+    predictor.OnFileOpened(L"b.wav", 0);
+    EXPECT_EQ(2u, predictor.GetStats().opens);
+    EXPECT_EQ(1u, predictor.GetStats().learnedFiles);
+}
+
+TEST(PrefetchPredictorTest, UserOpenPromotesQueuedPrefetch) {
+    RecordingPrefetcher prefetcher;
+    prefetcher.Block();
+    PrefetchPredictor predictor(PrefetchConfig(), prefetcher.Action(), Siblings({ L"a.wav", L"b.wav", L"c.wav", L"d.wav" }));
+    predictor.Start();
+
+    // b를 가져오는 동안 c, d는 큐에서 대기
+    predictor.OnFileOpened(L"Tracks\\a.wav", kUserProcessId);
+    ASSERT_TRUE(prefetcher.WaitForCount(1));
+
+    predictor.OnFileOpened(L"Tracks\\c.wav", kUserProcessId);  // 큐에 있던 파일
+    predictor.OnFileOpened(L"Tracks\\b.wav", kUserProcessId);  // 가져오는 중인 파일
+    PrefetchStats stats = predictor.GetStats();
+    EXPECT_EQ(1u, stats.promoted);
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(3u, stats.opens);
+    EXPECT_EQ(2u, stats.learnedFiles);  // 큐에 있던 파일을 열어도 학습은 계속됨
+
+    prefetcher.Release();
+    ASSERT_TRUE(WaitUntil([&]() { return predictor.GetStats().issued == 2; }));
+    predictor.Stop();
+    EXPECT_EQ((std::vector<std::wstring>{ L"Tracks\\b.wav", L"Tracks\\d.wav" }), prefetcher.Paths());
+    EXPECT_EQ(1u, predictor.GetStats().hits);
+}
+
+TEST(PrefetchPredictorTest, UnusedPrefetchExpiresWithoutFurtherOpens) {
+    PrefetchConfig config;
+    config.prefetchTtl = std::chrono::milliseconds(20);
+    RecordingPrefetcher prefetcher;
+    PrefetchPredictor predictor(config, prefetcher.Action(), Siblings({ L"a.wav", L"b.wav" }));
+    predictor.Start();
+
+    predictor.OnFileOpened(L"Tracks\\a.wav", kUserProcessId);
+    ASSERT_TRUE(prefetcher.WaitForCount(1));
+    EXPECT_TRUE(WaitUntil([&]() { return predictor.GetStats().misses == 1; }));
+    predictor.Stop();
+    EXPECT_DOUBLE_EQ(0.0, predictor.GetStats().hitRate);
+}
+
+TEST(PrefetchPredictorTest, LearnedSuccessorsAreBounded) {
+    PrefetchConfig config;
+    config.maxLearnedFiles = 2;
+    RecordingPrefetcher prefetcher;
+    PrefetchPredictor predictor(config, prefetcher.Action(), nullptr);
+
+    for (const wchar_t* path : { L"x1", L"x2", L"x3", L"x4", L"x5" }) {
+        predictor.OnFileOpened(path, kUserProcessId);
+    }
+    EXPECT_EQ(2u, predictor.GetStats().learnedFiles);
+}
@@ -0,0 +1,322 @@
+// CloudFilesProvider 성능 측정 (Google Benchmark)
+// stubs/의 cfapi 대체 헤더 위에서 실제 CfApiBackend로 provider를 돌림
+// 플랫폼 호출 비용은 빠지므로 provider 쪽 비용(준비, 스케줄링, 전송 경로)만 측정됨
+//
+// 회귀 추적용 JSON: cloud_files_provider_bench --benchmark_out=bench.json --benchmark_out_format=json
+// (두 결과는 Google Benchmark의 tools/compare.py로 비교)
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "BlockManifest.h"
+#include "CloudFilesProvider.h"
+#include "FetchExecutor.h"
+
+namespace {
+
+const LONGLONG kFetchFileSize = 1024 * 1024;
+const auto kSourceLatency = std::chrono::microseconds(200);  // 데이터 소스의 첫 바이트 지연 흉내
+const auto kFetchTimeout = std::chrono::seconds(30);
+
+CloudFilesProvider& Provider() { return CloudFilesProvider::GetInstance(); }
+
+// 측정하는 동안 유지되는 provider (캐시와 로그는 임시 폴더 아래)
+class BenchEnvironment {
+public:
+    bool Start() {
+        char pattern[] = "/tmp/mbd_provider_bench_XXXXXX";
+        const char* created = mkdtemp(pattern);
+        if (!created) {
+            return false;
+        }
+        m_root = created;
+        const std::wstring root(m_root.begin(), m_root.end());
+        setenv("LOCALAPPDATA", m_root.c_str(), 1);
+
+        m_content.resize(static_cast<size_t>(kFetchFileSize));
+        for (size_t i = 0; i < m_content.size(); ++i) {
+            m_content[i] = static_cast<BYTE>(i * 31 + 7);
+        }
+
+        CloudFilesProvider& provider = Provider();
+        LoggerConfig logConfig;
+        logConfig.console = false;
+        logConfig.minLevel = LogLevel::Warning;
+        logConfig.filePath = root + L"\\provider.log";
+        provider.SetLogConfig(logConfig);
+        BlockCacheConfig cacheConfig;
+        cacheConfig.maxBytes = 0;
+        provider.SetBlockCacheConfig(cacheConfig);
+        PrefetchConfig prefetchConfig;
+        prefetchConfig.enabled = false;
+        provider.SetPrefetchConfig(prefetchConfig);
+        provider.SetMetadataIndexPath(root + L"\\metadata.idx");
+        provider.SetStreamingFetchCallback([this](const FetchRequest& request, FetchSink& sink) { return Serve(request, sink); });
+
+        cfapi_stub::Reset();
+        return SUCCEEDED(provider.Initialize()) && SUCCEEDED(provider.RegisterSyncRoot(root + L"\\Drive", L"Benchmark Drive"));
+    }
+
+    void Stop() {
+        Provider().Shutdown();
+        std::string command = "rm -rf '" + m_root + "'";
+        if (system(command.c_str()) != 0) {
+            // 임시 폴더 정리 실패는 결과와 무관
+        }
+    }
+
+private:
+    HRESULT Serve(const FetchRequest& request, FetchSink& sink) {
+        std::this_thread::sleep_for(kSourceLatency);
+        const LONGLONG end = (std::min)(request.offset + request.length, static_cast<LONGLONG>(m_content.size()));
+        const LONGLONG chunk = static_cast<LONGLONG>(sink.PreferredChunkSize());
+        for (LONGLONG offset = request.offset; offset < end; offset += chunk) {
+            HRESULT hr = sink.Write(m_content.data() + offset, static_cast<size_t>((std::min)(chunk, end - offset)));
+            if (FAILED(hr)) {
+                return hr;
+            }
+        }
+        return S_OK;
+    }
+
+    std::string m_root;
+    std::vector<BYTE> m_content;
+};
+
+// 한 폴더 분량의 원격 항목 (이름과 식별자가 항목마다 다름)
+std::vector<PlaceholderEntry> MakeEntries(size_t directory, size_t count) {
+    std::vector<PlaceholderEntry> entries(count);
+    for (size_t i = 0; i < count; ++i) {
+        PlaceholderEntry& entry = entries[i];
+        entry.name = L"Track " + std::to_wstring(directory) + L"-" + std::to_wstring(i) + L".wav";
+        entry.basicInfo.FileAttributes = FILE_ATTRIBUTE_NORMAL;
+        entry.fileSize.QuadPart = static_cast<LONGLONG>(4 * 1024 * 1024 + i);
+        const uint64_t id = (static_cast<uint64_t>(directory) << 32) | i;
+        memcpy(entry.identity.objectId, &id, sizeof(id));
+        entry.identity.contentVersion = 1;
+    }
+    return entries;
+}
+
+std::vector<std::vector<PlaceholderEntry>> MakeDirectories(size_t total, size_t perDirectory) {
+    std::vector<std::vector<PlaceholderEntry>> directories;
+    for (size_t remaining = total; remaining > 0;) {
+        const size_t count = (std::min)(remaining, perDirectory);
+        directories.push_back(MakeEntries(directories.size(), count));
+        remaining -= count;
+    }
+    return directories;
+}
+
+std::wstring DirectoryName(size_t directory) {
+    return L"Album " + std::to_wstring(directory);
+}
+
+size_t PlatformCreateCalls() {
+    cfapi_stub::State& stub = cfapi_stub::Get();
+    std::lock_guard<std::mutex> lock(stub.mutex);
+    return stub.createCalls;
+}
+
+// 대체 헤더가 기록한 전송 데이터를 비움 (반복마다 쌓이지 않도록)
+void ClearRecordedOperations() {
+    cfapi_stub::State& stub = cfapi_stub::Get();
+    std::lock_guard<std::mutex> lock(stub.mutex);
+    stub.operations.clear();
+    stub.progress.clear();
+}
+
+MbdMetricsSnapshot Snapshot() {
+    MbdMetricsSnapshot snapshot = {};
+    snapshot.structSize = sizeof(snapshot);
+    Provider().GetMetricsSnapshot(snapshot);
+    return snapshot;
+}
+
+double Microseconds(uint64_t nanoseconds) {
+    return nanoseconds / 1000.0;
+}
+
+// 폴더마다 CreatePlaceholders 한 번 (range(0): 전체 항목 수, 폴더당 1000개)
+void BM_CreatePlaceholdersBatched(benchmark::State& state) {
+    const auto directories = MakeDirectories(static_cast<size_t>(state.range(0)), 1000);
+    const size_t callsBefore = PlatformCreateCalls();
+    for (auto _ : state) {
+        for (size_t d = 0; d < directories.size(); ++d) {
+            if (FAILED(Provider().CreatePlaceholders(DirectoryName(d), directories[d].data(), directories[d].size()))) {
+                state.SkipWithError("CreatePlaceholders failed");
+                return;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["platformCalls"] = benchmark::Counter(static_cast<double>(PlatformCreateCalls() - callsBefore),
+                                                         benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_CreatePlaceholdersBatched)->Arg(100000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// 항목마다 CreatePlaceholder 한 번 (배치 이전 방식과 비교용)
+void BM_CreatePlaceholdersSingle(benchmark::State& state) {
+    const auto directories = MakeDirectories(static_cast<size_t>(state.range(0)), 1000);
+    for (auto _ : state) {
+        for (size_t d = 0; d < directories.size(); ++d) {
+            const std::wstring directory = DirectoryName(d);
+            for (const PlaceholderEntry& entry : directories[d]) {
+                LARGE_INTEGER fileSize = entry.fileSize;
+                if (FAILED(Provider().CreatePlaceholder(directory + L"\\" + entry.name, entry.basicInfo, fileSize, entry.identity))) {
+                    state.SkipWithError("CreatePlaceholder failed");
+                    return;
+                }
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CreatePlaceholdersSingle)->Arg(10000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// range(0)개의 FETCH_DATA를 동시에 보내고 모두 끝날 때까지 (파일마다 1MiB 전체)
+// 지연 백분위수는 provider 지표에서, 진행 중 하이드레이션당 메모리는 사용 중인 전송 버퍼 최대값에서 구함
+void BM_ConcurrentFetch(benchmark::State& state) {
+    const size_t concurrency = static_cast<size_t>(state.range(0));
+    std::vector<std::wstring> paths;
+    for (size_t i = 0; i < concurrency; ++i) {
+        paths.push_back(L"Fetch\\Stem " + std::to_wstring(i) + L".wav");
+    }
+
+    LONGLONG transferKey = 1;
+    uint64_t peakBytesInUse = 0;
+    MbdMetricsSnapshot snapshot = {};
+    for (auto _ : state) {
+        state.PauseTiming();
+        Provider().ResetMetrics();
+        ClearRecordedOperations();
+        state.ResumeTiming();
+
+        for (size_t i = 0; i < concurrency; ++i) {
+            CF_CALLBACK_INFO info = {};
+            info.NormalizedPath = paths[i].c_str();
+            info.FileId.QuadPart = static_cast<LONGLONG>(i + 1);
+            info.FileSize.QuadPart = kFetchFileSize;
+            info.TransferKey = transferKey++;
+            CF_CALLBACK_PARAMETERS parameters = {};
+            parameters.FetchData.RequiredFileOffset.QuadPart = 0;
+            parameters.FetchData.RequiredLength.QuadPart = kFetchFileSize;
+            cfapi_stub::Fire(CF_CALLBACK_TYPE_FETCH_DATA, info, parameters);
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + kFetchTimeout;
+        while (true) {
+            snapshot = Snapshot();
+            peakBytesInUse = (std::max)(peakBytesInUse, snapshot.transferBytesInUse);
+            if (snapshot.downloadsCompleted + snapshot.downloadsFailed >= concurrency) {
+                break;
+            }
+            if (std::chrono::steady_clock::now() > deadline) {
+                state.SkipWithError("downloads did not finish");
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        if (snapshot.downloadsFailed > 0) {
+            state.SkipWithError("downloads failed");
+            return;
+        }
+    }
+
+    // 마지막 반복의 지표
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(concurrency) * kFetchFileSize);
+    state.counters["workers"] = snapshot.workerCount;
+    state.counters["fetchCallbackP99Us"] = Microseconds(snapshot.fetchData.p99Ns);
+    state.counters["ttfbP50Us"] = Microseconds(snapshot.timeToFirstByte.p50Ns);
+    state.counters["ttfbP99Us"] = Microseconds(snapshot.timeToFirstByte.p99Ns);
+    state.counters["queueWaitP50Us"] = Microseconds(snapshot.queueWait.p50Ns);
+    state.counters["queueWaitP99Us"] = Microseconds(snapshot.queueWait.p99Ns);
+    state.counters["downloadP50Us"] = Microseconds(snapshot.download.p50Ns);
+    state.counters["downloadP99Us"] = Microseconds(snapshot.download.p99Ns);
+    // 전송 버퍼는 실행 중인 다운로드만 잡으므로 (큐에서 기다리는 요청은 0) 동시 요청이 워커 수를 넘으면 요청당 값이 줄어듦
+    state.counters["peakTransferBytesInUse"] = static_cast<double>(peakBytesInUse);
+    state.counters["bytesPerInFlight"] = static_cast<double>(peakBytesInUse) / concurrency;
+    state.counters["transferPoolBytes"] = static_cast<double>(snapshot.transferPoolBytes);
+}
+BENCHMARK(BM_ConcurrentFetch)->Arg(1)->Arg(8)->Arg(64)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// 빈 작업 하나를 워커 풀에 넣고 실행될 때까지 (큐 자체의 비용)
+void BM_ExecutorRoundTrip(benchmark::State& state) {
+    FetchExecutorConfig config;
+    config.workerCount = 1;
+    FetchExecutor executor(config);
+    executor.Start();
+    for (auto _ : state) {
+        std::promise<void> ran;
+        executor.Submit(L"Tracks\\a.wav", HydrationPriority::Foreground, [&ran]() { ran.set_value(); });
+        ran.get_future().wait();
+    }
+    executor.Stop();
+}
+BENCHMARK(BM_ExecutorRoundTrip)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// VALIDATE_DATA 한 번에 해당하는 블록 검증 (range(0): 스레드 수, 32MB 범위를 4MB 블록으로)
+// 메모리에서 읽으므로 해시 처리량만 측정됨 (목표는 수 GB/s)
+// stubs/bcrypt.h의 SHA-256은 단순한 소프트웨어 구현이라 목표와 비교할 값은 Windows(CNG) 빌드에서 잼
+void BM_VerifyBlockRange(benchmark::State& state) {
+    const LONGLONG blockSize = 4 * 1024 * 1024;
+    std::vector<BYTE> data(static_cast<size_t>(8 * blockSize));
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<BYTE>(i * 2654435761u >> 24);
+    }
+    BlockManifest manifest;
+    manifest.fileSize = static_cast<LONGLONG>(data.size());
+    manifest.blockSize = blockSize;
+    for (LONGLONG offset = 0; offset < manifest.fileSize; offset += blockSize) {
+        ContentHash hash;
+        ComputeContentHash(data.data() + offset, static_cast<size_t>(blockSize), hash);
+        manifest.blockHashes.push_back(hash);
+    }
+    BlockReader reader = [&data](BYTE* buffer, LONGLONG offset, LONGLONG length, LONGLONG& returned) {
+        memcpy(buffer, data.data() + offset, static_cast<size_t>(length));
+        returned = length;
+        return S_OK;
+    };
+
+    FetchExecutorConfig config;
+    config.workerCount = static_cast<size_t>(state.range(0));
+    FetchExecutor executor(config);
+    executor.Start();
+
+    for (auto _ : state) {
+        BlockVerification result;
+        VerifyBlockRange(manifest, 0, manifest.fileSize, reader, nullptr, &executor, static_cast<size_t>(state.range(0)), result);
+        benchmark::DoNotOptimize(result.verified.data());
+    }
+    executor.Stop();
+    state.SetBytesProcessed(state.iterations() * manifest.fileSize);
+}
+BENCHMARK(BM_VerifyBlockRange)->Arg(1)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    BenchEnvironment environment;
+    if (!environment.Start()) {
+        fprintf(stderr, "failed to start the provider\n");
+        return 1;
+    }
+    benchmark::AddCustomContext("backend", "cfapi-stub");
+    benchmark::RunSpecifiedBenchmarks();
+    environment.Stop();
+    benchmark::Shutdown();
+    return 0;
+}
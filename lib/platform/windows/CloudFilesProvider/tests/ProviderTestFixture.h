@@ -0,0 +1,202 @@
+#pragma once
+
+// CloudFilesProvider 싱글톤을 FakeBackend로 초기화하는 테스트 fixture
+// 싱글톤 설정은 테스트 사이에 남으므로 SetUp에서 테스트가 기대하는 기본값을 모두 다시 설정함
+
+#include <gtest/gtest.h>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <unistd.h>
+
+#include "CloudFilesProvider.h"
+#include "FakeBackend.h"
+
+// 임시 디렉토리 (소멸 시 삭제)
+class TempDirectory {
+public:
+    TempDirectory() {
+        char pattern[] = "/tmp/mbd_provider_test_XXXXXX";
+        const char* created = mkdtemp(pattern);
+        m_path = created ? created : "";
+    }
+
+    ~TempDirectory() {
+        if (!m_path.empty()) {
+            std::string command = "rm -rf '" + m_path + "'";
+            if (system(command.c_str()) != 0) {
+                // 정리 실패는 테스트 결과와 무관
+            }
+        }
+    }
+
+    TempDirectory(const TempDirectory&) = delete;
+    TempDirectory& operator=(const TempDirectory&) = delete;
+
+    const std::string& Path() const { return m_path; }
+    std::wstring WidePath() const { return std::wstring(m_path.begin(), m_path.end()); }
+
+private:
+    std::string m_path;
+};
+
+// 테스트용 파일 내용 (오프셋마다 다른 값이 나오도록)
+inline std::vector<BYTE> MakePattern(size_t size, unsigned seed = 1) {
+    std::vector<BYTE> data(size);
+    uint32_t state = seed * 2654435761u + 1;
+    for (size_t i = 0; i < size; ++i) {
+        state = state * 1103515245u + 12345u;
+        data[i] = static_cast<BYTE>(state >> 16);
+    }
+    return data;
+}
+
+// 파일 내용을 sink에 스트리밍하는 데이터 소스
+// Block()을 호출하면 다음 요청부터 blockAfterBytes만큼 쓴 뒤 Release()까지 기다림
+class TestDataSource {
+public:
+    explicit TestDataSource(std::vector<BYTE> content) : m_content(std::move(content)) {}
+
+    StreamingFetchCallback Callback() {
+        return [this](const FetchRequest& request, FetchSink& sink) { return Serve(request, sink); };
+    }
+
+    void Block(LONGLONG blockAfterBytes = 0) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_blocked = true;
+        m_blockAfterBytes = blockAfterBytes;
+    }
+
+    void Release() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_blocked = false;
+        m_changed.notify_all();
+    }
+
+    // 요청 하나가 Block 지점에 도달할 때까지 대기
+    bool WaitUntilWaiting(size_t waiters = 1) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_changed.wait_for(lock, std::chrono::seconds(10), [&]() { return m_waiting >= waiters; });
+    }
+
+    std::vector<FetchRequest> Requests() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_requests;
+    }
+
+    // 데이터 소스가 sink에서 받은 마지막 실패 (취소 확인용)
+    HRESULT LastWriteError() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_lastWriteError;
+    }
+
+    const std::vector<BYTE>& Content() const { return m_content; }
+
+private:
+    HRESULT Serve(const FetchRequest& request, FetchSink& sink) {
+        LONGLONG blockAfter = -1;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_requests.push_back(request);
+            if (m_blocked) {
+                blockAfter = m_blockAfterBytes;
+            }
+        }
+
+        const LONGLONG end = (std::min)(request.offset + request.length, static_cast<LONGLONG>(m_content.size()));
+        const LONGLONG chunk = static_cast<LONGLONG>(sink.PreferredChunkSize());
+        LONGLONG written = 0;
+        for (LONGLONG offset = request.offset; offset < end;) {
+            if (written == blockAfter) {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_waiting++;
+                m_changed.notify_all();
+                m_changed.wait(lock, [&]() { return !m_blocked; });
+                m_waiting--;
+            }
+            LONGLONG part = (std::min)(chunk, end - offset);
+            if (blockAfter > written) {
+                part = (std::min)(part, blockAfter - written);
+            }
+            HRESULT hr = sink.Write(m_content.data() + offset, static_cast<size_t>(part));
+            if (FAILED(hr)) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_lastWriteError = hr;
+                return hr;
+            }
+            offset += part;
+            written += part;
+        }
+        return S_OK;
+    }
+
+    std::vector<BYTE> m_content;
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    bool m_blocked = false;
+    LONGLONG m_blockAfterBytes = 0;
+    size_t m_waiting = 0;
+    std::vector<FetchRequest> m_requests;
+    HRESULT m_lastWriteError = S_OK;
+};
+
+class ProviderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        setenv("LOCALAPPDATA", m_cacheRoot.Path().c_str(), 1);
+
+        CloudFilesProvider& provider = Provider();
+        LoggerConfig logConfig;
+        logConfig.console = false;
+        logConfig.minLevel = LogLevel::Warning;
+        logConfig.filePath = m_cacheRoot.WidePath() + L"\\provider.log";
+        provider.SetLogConfig(logConfig);
+
+        BlockCacheConfig cacheConfig;
+        cacheConfig.maxBytes = 0;
+        provider.SetBlockCacheConfig(cacheConfig);
+
+        PrefetchConfig prefetchConfig;
+        prefetchConfig.enabled = false;
+        provider.SetPrefetchConfig(prefetchConfig);
+
+        provider.SetDataValidationConfig(DataValidationConfig());
+        provider.SetExecutorConfig(FetchExecutorConfig());
+        provider.SetTransferBufferConfig(TransferBufferPoolConfig());
+        provider.SetHydrationPolicy(HydrationPolicy::Partial);
+        provider.SetPopulationMode(PopulationMode::Full);
+        provider.SetReadAheadSize(0);
+        provider.SetMetadataIndexPath(m_cacheRoot.WidePath() + L"\\metadata.idx");
+        provider.SetStreamingFetchCallback(nullptr);
+        provider.SetProgressCallback(nullptr);
+        provider.SetProgressUpdateRate(4.0);
+        provider.SetNotifyCallback(nullptr);
+        provider.ResetMetrics();
+
+        Configure(provider);
+
+        std::unique_ptr<ProviderBackend> backend = CreateBackend();
+        m_backend = dynamic_cast<FakeBackend*>(backend.get());
+        provider.SetBackend(std::move(backend));
+        ASSERT_EQ(S_OK, provider.Initialize());
+        ASSERT_EQ(S_OK, provider.RegisterSyncRoot(m_cacheRoot.WidePath() + L"\\Drive", L"Test Drive"));
+    }
+
+    void TearDown() override {
+        Provider().Shutdown();
+        Provider().SetBackend(nullptr);
+        m_backend = nullptr;
+    }
+
+    // Initialize 전에 테스트별 설정을 바꿀 때 재정의
+    virtual void Configure(CloudFilesProvider&) {}
+
+    // 다른 백엔드로 엔진을 돌릴 때 재정의 (FakeBackend가 아니면 m_backend는 nullptr)
+    virtual std::unique_ptr<ProviderBackend> CreateBackend() { return std::make_unique<FakeBackend>(); }
+
+    static CloudFilesProvider& Provider() { return CloudFilesProvider::GetInstance(); }
+
+    TempDirectory m_cacheRoot;
+    FakeBackend* m_backend = nullptr;
+};
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+#include "HydrationScheduler.h"
+#include "ProviderTestFixture.h"
+
+namespace {
+
+ScheduledTask MakeTask(uint64_t id, const std::wstring& label, HydrationPriority priority) {
+    ScheduledTask task;
+    task.info.id = id;
+    task.info.label = label;
+    task.info.priority = priority;
+    return task;
+}
+
+std::vector<uint64_t> PopAll(HydrationScheduler& scheduler) {
+    std::vector<uint64_t> order;
+    while (!scheduler.Empty()) {
+        order.push_back(scheduler.Pop().info.id);
+    }
+    return order;
+}
+
+const DWORD kOtherProcessId = 4242;
+
+} // namespace
+
+TEST(HydrationSchedulerTest, FoldersShareClassByWeight) {
+    HydrationScheduler scheduler;
+    uint64_t id = 1;
+    for (int i = 0; i < 6; ++i) {
+        scheduler.Push(MakeTask(id++, L"Tracks\\t.wav", HydrationPriority::Foreground));
+        scheduler.Push(MakeTask(id++, L"WorkRequests\\w.wav", HydrationPriority::Foreground));
+        scheduler.Push(MakeTask(id++, L"References\\r.wav", HydrationPriority::Foreground));
+    }
+
+    // 처음 6개는 가중치 3:2:1 비율로 섞여야 함
+    int tracks = 0, work = 0, references = 0;
+    for (int i = 0; i < 6; ++i) {
+        uint64_t popped = scheduler.Pop().info.id;
+        switch ((popped - 1) % 3) {
+        case 0: tracks++; break;
+        case 1: work++; break;
+        default: references++; break;
+        }
+    }
+    EXPECT_EQ(3, tracks);
+    EXPECT_EQ(2, work);
+    EXPECT_EQ(1, references);
+    EXPECT_EQ(12u, scheduler.Size());
+}
+
+TEST(HydrationSchedulerTest, HigherClassAlwaysRunsFirst) {
+    HydrationScheduler scheduler;
+    scheduler.Push(MakeTask(1, L"Tracks\\a.wav", HydrationPriority::Prefetch));
+    scheduler.Push(MakeTask(2, L"References\\b.wav", HydrationPriority::PinnedBackground));
+    scheduler.Push(MakeTask(3, L"References\\c.wav", HydrationPriority::Foreground));
+
+    EXPECT_EQ(1u, scheduler.Size(HydrationPriority::Prefetch));
+    EXPECT_EQ((std::vector<uint64_t>{ 3, 2, 1 }), PopAll(scheduler));
+}
+
+TEST(HydrationSchedulerTest, FifoModeKeepsArrivalOrder) {
+    HydrationScheduler scheduler(true);
+    scheduler.Push(MakeTask(1, L"a", HydrationPriority::Prefetch));
+    scheduler.Push(MakeTask(2, L"b", HydrationPriority::Foreground));
+    EXPECT_EQ((std::vector<uint64_t>{ 1, 2 }), PopAll(scheduler));
+}
+
+TEST(HydrationSchedulerTest, ReprioritizeMovesQueuedTask) {
+    HydrationScheduler scheduler;
+    scheduler.Push(MakeTask(1, L"a", HydrationPriority::Foreground));
+    scheduler.Push(MakeTask(2, L"b", HydrationPriority::Prefetch));
+
+    EXPECT_TRUE(scheduler.Reprioritize(2, HydrationPriority::Foreground));
+    EXPECT_FALSE(scheduler.Reprioritize(7, HydrationPriority::Foreground));
+    EXPECT_EQ(0u, scheduler.Size(HydrationPriority::Prefetch));
+    EXPECT_EQ(2u, scheduler.Size(HydrationPriority::Foreground));
+    EXPECT_EQ((std::vector<uint64_t>{ 1, 2 }), PopAll(scheduler));
+}
+
+TEST(HydrationSchedulerTest, RemoveAndDrain) {
+    HydrationScheduler scheduler;
+    scheduler.Push(MakeTask(1, L"Tracks\\a", HydrationPriority::Foreground));
+    scheduler.Push(MakeTask(2, L"b", HydrationPriority::Prefetch));
+    scheduler.Push(MakeTask(3, L"c", HydrationPriority::Prefetch));
+
+    EXPECT_TRUE(scheduler.Remove(2));
+    EXPECT_FALSE(scheduler.Remove(2));
+    EXPECT_EQ(2u, scheduler.Drain().size());
+    EXPECT_TRUE(scheduler.Empty());
+    EXPECT_EQ(0u, scheduler.Size(HydrationPriority::Foreground));
+}
+
+// 워커 1개를 다른 다운로드로 막아 두고 큐에 들어간 우선순위를 확인
+class PriorityTest : public ProviderTest {
+protected:
+    void Configure(CloudFilesProvider& provider) override {
+        FetchExecutorConfig executorConfig;
+        executorConfig.workerCount = 1;
+        provider.SetExecutorConfig(executorConfig);
+        provider.SetStreamingFetchCallback(m_source.Callback());
+    }
+
+    void SetUp() override {
+        ProviderTest::SetUp();
+        m_source.Block();
+        m_backend->FetchData(L"busy.wav", kFileSize, 1, 0, 4096, nullptr, 0, kOtherProcessId);
+        ASSERT_TRUE(m_source.WaitUntilWaiting());
+    }
+
+    void TearDown() override {
+        m_source.Release();
+        ProviderTest::TearDown();
+    }
+
+    // HydratePlaceholder가 보내는 FETCH_DATA를 processId가 보낸 것으로 흉내
+    void HydrateFrom(DWORD processId) {
+        m_backend->SetHydrateHook([this, processId](const std::wstring& path) {
+            m_backend->FetchData(path, kFileSize, 2, 0, kFileSize, nullptr, 0, processId);
+            return S_OK;
+        });
+    }
+
+    size_t Queued(HydrationPriority priority) {
+        return Provider().GetExecutorStats().queuedByPriority[static_cast<size_t>(priority)];
+    }
+
+    static constexpr LONGLONG kFileSize = 64 * 1024;
+    TestDataSource m_source{ MakePattern(static_cast<size_t>(kFileSize)) };
+};
+
+TEST_F(PriorityTest, OwnHydrationUsesRequestedPriority) {
+    HydrateFrom(GetCurrentProcessId());
+    EXPECT_EQ(S_OK, Provider().HydratePlaceholder(L"next.wav", HydrationPriority::Prefetch));
+    EXPECT_EQ(1u, Queued(HydrationPriority::Prefetch));
+    EXPECT_EQ(0u, Queued(HydrationPriority::Foreground));
+}
+
+TEST_F(PriorityTest, OtherProcessDuringHydrationStaysForeground) {
+    // provider가 같은 파일을 미리 가져오는 중에 사용자가 연 요청은 낮은 우선순위를 물려받지 않음
+    HydrateFrom(kOtherProcessId);
+    EXPECT_EQ(S_OK, Provider().HydratePlaceholder(L"next.wav", HydrationPriority::Prefetch));
+    EXPECT_EQ(0u, Queued(HydrationPriority::Prefetch));
+    EXPECT_EQ(1u, Queued(HydrationPriority::Foreground));
+}
+
+TEST_F(PriorityTest, ForegroundJoinPromotesQueuedPrefetch) {
+    const uint64_t promotedBefore = Provider().GetInFlightFetchStats().promoted;
+    HydrateFrom(GetCurrentProcessId());
+    ASSERT_EQ(S_OK, Provider().HydratePlaceholder(L"next.wav", HydrationPriority::Prefetch));
+    ASSERT_EQ(1u, Queued(HydrationPriority::Prefetch));
+
+    m_backend->FetchData(L"next.wav", kFileSize, 3, 0, 4096, nullptr, 0, kOtherProcessId);
+    EXPECT_EQ(promotedBefore + 1, Provider().GetInFlightFetchStats().promoted);
+    EXPECT_EQ(0u, Queued(HydrationPriority::Prefetch));
+    EXPECT_EQ(1u, Queued(HydrationPriority::Foreground));
+
+    // 다운로드 하나로 두 요청을 모두 처리
+    m_source.Release();
+    ASSERT_TRUE(m_backend->WaitFor([](FakeBackend& backend) {
+        return backend.TransferredBytes(2) == kFileSize && backend.TransferredBytes(3) == 4096;
+    }));
+    EXPECT_EQ(2u, m_source.Requests().size());
+}
+
+TEST_F(PriorityTest, NestedHydrationKeepsOuterPriority) {
+    // 같은 파일의 안쪽 호출이 끝나도 바깥 호출의 우선순위가 지워지지 않아야 함
+    int depth = 0;
+    m_backend->SetHydrateHook([&](const std::wstring& path) {
+        if (depth++ == 0) {
+            EXPECT_EQ(S_OK, Provider().HydratePlaceholder(path, HydrationPriority::Prefetch));
+            m_backend->FetchData(path, kFileSize, 2, 0, kFileSize, nullptr, 0, GetCurrentProcessId());
+        }
+        return S_OK;
+    });
+    EXPECT_EQ(S_OK, Provider().HydratePlaceholder(L"next.wav", HydrationPriority::PinnedBackground));
+    EXPECT_EQ(1u, Queued(HydrationPriority::PinnedBackground));
+    EXPECT_EQ(0u, Queued(HydrationPriority::Foreground));
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "TraceRecorder.h"
+#include "ProviderTestFixture.h"
+
+namespace {
+
+class TraceRecorderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Recorder().Enable(1024);
+        Recorder().Clear();
+    }
+
+    void TearDown() override {
+        Recorder().Disable();
+        Recorder().Clear();
+    }
+
+    static TraceRecorder& Recorder() { return TraceRecorder::Instance(); }
+
+    std::string Export(const TraceRecorder::PathResolver& resolvePath = nullptr) {
+        const std::string path = m_directory.Path() + "/trace.json";
+        EXPECT_EQ(S_OK, Recorder().WriteChromeTrace(std::wstring(path.begin(), path.end()), resolvePath));
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    static size_t Count(const std::string& json, const std::string& text) {
+        size_t count = 0;
+        for (size_t at = json.find(text); at != std::string::npos; at = json.find(text, at + text.size())) {
+            count++;
+        }
+        return count;
+    }
+
+    TempDirectory m_directory;
+};
+
+} // namespace
+
+TEST_F(TraceRecorderTest, EscapesNamesAndPaths) {
+    Recorder().Instant(kHydrationTraceCategory, "say \"hi\"\\\n\x01", 0, 5);
+
+    std::string json = Export([](PathId) { return std::wstring(L"Tracks\\\"a\".wav"); });
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"say \\\"hi\\\"\\\\\\n\\u0001\"")) << json;
+    EXPECT_NE(std::string::npos, json.find("\"path\":\"Tracks\\\\\\\"a\\\".wav\"")) << json;
+    EXPECT_NE(std::string::npos, json.find("\"cat\":\"hydration\"")) << json;
+    EXPECT_NE(std::string::npos, json.find("\"ph\":\"i\"")) << json;
+    EXPECT_NE(std::string::npos, json.find("\"s\":\"t\"")) << json;
+}
+
+TEST_F(TraceRecorderTest, AsyncEventsCarryIdOutsideArgs) {
+    Recorder().AsyncBegin(kHydrationTraceCategory, "download", 42, kInvalidPathId, TraceArg{ "bytes", 4096 });
+    Recorder().AsyncEnd(kHydrationTraceCategory, "download", 42);
+    Recorder().Instant(kHydrationTraceCategory, "fetch", 7);
+
+    std::string json = Export();
+    EXPECT_EQ(1u, Count(json, "\"ph\":\"b\"")) << json;
+    EXPECT_EQ(1u, Count(json, "\"ph\":\"e\"")) << json;
+    // 비동기 이벤트는 최상위 id로 묶이고, 다른 이벤트의 id는 인자로 들어감
+    EXPECT_EQ(2u, Count(json, "\"id\":\"0x2a\"")) << json;
+    EXPECT_EQ(0u, Count(json, "\"id\":42")) << json;
+    EXPECT_EQ(1u, Count(json, "\"args\":{\"bytes\":4096}")) << json;
+    EXPECT_EQ(1u, Count(json, "\"args\":{\"id\":7}")) << json;
+}
+
+TEST_F(TraceRecorderTest, CompleteEventsHaveDuration) {
+    auto start = TraceRecorder::Clock::now();
+    Recorder().Complete(kHydrationTraceCategory, "transfer", start, start + std::chrono::microseconds(1500));
+
+    std::string json = Export();
+    EXPECT_NE(std::string::npos, json.find("\"ph\":\"X\"")) << json;
+    EXPECT_NE(std::string::npos, json.find("\"dur\":1500.000")) << json;
+}
+
+TEST_F(TraceRecorderTest, RingKeepsNewestEvents) {
+    const size_t capacity = Recorder().Capacity();
+    const int64_t extra = 10;
+    const uint64_t dropped = Recorder().DroppedCount();
+    for (int64_t i = 0; i < static_cast<int64_t>(capacity) + extra; ++i) {
+        Recorder().Instant(kHydrationTraceCategory, "tick", 0, kInvalidPathId, TraceArg{ "n", i });
+    }
+    EXPECT_EQ(dropped, Recorder().DroppedCount());
+
+    std::string json = Export();
+    EXPECT_EQ(capacity, Count(json, "\"name\":\"tick\""));
+    // 가장 오래된 extra개가 덮어써짐
+    EXPECT_EQ(0u, Count(json, "{\"n\":" + std::to_string(extra - 1) + "}"));
+    EXPECT_EQ(1u, Count(json, "{\"n\":" + std::to_string(extra) + "}"));
+    EXPECT_EQ(1u, Count(json, "{\"n\":" + std::to_string(capacity + extra - 1) + "}"));
+}
+
+TEST_F(TraceRecorderTest, ClearAndDisableDropEvents) {
+    Recorder().Instant(kHydrationTraceCategory, "before");
+    Recorder().Clear();
+    Recorder().Disable();
+    Recorder().Instant(kHydrationTraceCategory, "disabled");
+
+    std::string json = Export();
+    EXPECT_EQ(0u, Count(json, "\"name\""));
+    EXPECT_NE(std::string::npos, json.find("\"traceEvents\":[")) << json;
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <future>
+#include <thread>
+#include "TransferBufferPool.h"
+
+namespace {
+
+TransferBufferPoolConfig PoolConfig(size_t buffers, size_t perThreadCache = 2,
+                                    std::chrono::milliseconds exhaustedWait = std::chrono::milliseconds(10)) {
+    TransferBufferPoolConfig config;
+    config.bufferSize = 64 * 1024;
+    config.maxBytes = buffers * config.bufferSize;
+    config.perThreadCacheCount = perThreadCache;
+    config.exhaustedWait = exhaustedWait;
+    return config;
+}
+
+} // namespace
+
+TEST(TransferBufferPoolTest, BuffersArePageAlignedAndRoundedUp) {
+    TransferBufferPoolConfig config = PoolConfig(4);
+    config.bufferSize = 5000;
+    TransferBufferPool pool(config);
+
+    EXPECT_EQ(0u, pool.BufferSize() % 4096);
+    EXPECT_GE(pool.BufferSize(), 5000u);
+    TransferBuffer buffer = pool.Acquire();
+    ASSERT_TRUE(buffer);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(buffer.Data()) % 4096);
+    EXPECT_EQ(pool.BufferSize(), buffer.Size());
+}
+
+TEST(TransferBufferPoolTest, ReleasedBufferIsReusedFromThreadCache) {
+    TransferBufferPool pool(PoolConfig(4));
+    BYTE* first = nullptr;
+    {
+        TransferBuffer buffer = pool.Acquire();
+        first = buffer.Data();
+    }
+    TransferBuffer again = pool.Acquire();
+    EXPECT_EQ(first, again.Data());
+
+    TransferBufferPoolStats stats = pool.GetStats();
+    EXPECT_EQ(1u, stats.allocations);
+    EXPECT_EQ(1u, stats.threadCacheHits);
+    EXPECT_EQ(2u, stats.acquires);
+}
+
+TEST(TransferBufferPoolTest, BufferReleasedOnAnotherThreadComesFromFreeList) {
+    TransferBufferPool pool(PoolConfig(4, 0));
+    TransferBuffer buffer = pool.Acquire();
+    BYTE* data = buffer.Data();
+    std::thread([moved = std::move(buffer)]() mutable { moved.Release(); }).join();
+
+    TransferBuffer reused = pool.Acquire();
+    EXPECT_EQ(data, reused.Data());
+    EXPECT_EQ(1u, pool.GetStats().freeListHits);
+}
+
+TEST(TransferBufferPoolTest, ExhaustedPoolFallsBackToUnpooledBuffer) {
+    TransferBufferPool pool(PoolConfig(2));
+    TransferBuffer a = pool.Acquire();
+    TransferBuffer b = pool.Acquire();
+    TransferBuffer c = pool.Acquire();
+    ASSERT_TRUE(c);
+
+    TransferBufferPoolStats stats = pool.GetStats();
+    EXPECT_EQ(2u, stats.allocations);
+    EXPECT_EQ(1u, stats.waits);
+    EXPECT_EQ(1u, stats.overflowAllocations);
+    EXPECT_EQ(2 * pool.BufferSize(), stats.pooledBytes);
+
+    // 한도 밖 버퍼는 반환해도 풀에 들어가지 않음
+    c.Release();
+    EXPECT_EQ(0u, pool.GetStats().freeBuffers);
+}
+
+TEST(TransferBufferPoolTest, WaitingAcquireGetsReturnedBuffer) {
+    TransferBufferPool pool(PoolConfig(1, 0, std::chrono::seconds(10)));
+    TransferBuffer held = pool.Acquire();
+    BYTE* data = held.Data();
+
+    auto waiter = std::async(std::launch::async, [&pool]() { return pool.Acquire(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    held.Release();
+
+    TransferBuffer received = waiter.get();
+    EXPECT_EQ(data, received.Data());
+    TransferBufferPoolStats stats = pool.GetStats();
+    EXPECT_EQ(0u, stats.overflowAllocations);
+    EXPECT_EQ(1u, stats.freeListHits);
+}
+
+TEST(TransferBufferPoolTest, OversizeRequestBypassesPool) {
+    TransferBufferPool pool(PoolConfig(2));
+    TransferBuffer large = pool.Acquire(pool.BufferSize() + 1);
+    ASSERT_TRUE(large);
+    EXPECT_GT(large.Size(), pool.BufferSize());
+    EXPECT_EQ(1u, pool.GetStats().oversizeAllocations);
+    EXPECT_EQ(0u, pool.GetStats().pooledBytes);
+}
+
+TEST(TransferBufferPoolTest, BufferMayOutliveItsPool) {
+    TransferBuffer survivor;
+    {
+        TransferBufferPool pool(PoolConfig(2));
+        survivor = pool.Acquire();
+    }
+    ASSERT_TRUE(survivor);
+    survivor.Data()[0] = 1;
+    survivor.Release();
+    EXPECT_FALSE(survivor);
+}
+
+TEST(TransferBufferPoolTest, NullPoolAllocatesUnpooled) {
+    TransferBuffer buffer = AcquireTransferBuffer(nullptr, 100);
+    ASSERT_TRUE(buffer);
+    EXPECT_EQ(0u, buffer.Size() % 4096);
+}
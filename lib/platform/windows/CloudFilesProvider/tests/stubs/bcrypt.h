@@ -0,0 +1,128 @@
+#pragma once
+
+// 테스트용 bcrypt 대체 헤더: SHA-256만 직접 구현 (FIPS 180-4)
+
+#include <windows.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+typedef void* BCRYPT_ALG_HANDLE;
+typedef void* BCRYPT_HASH_HANDLE;
+#define BCRYPT_SHA256_ALG_HANDLE ((BCRYPT_ALG_HANDLE)0x00000041)
+#define BCRYPT_SUCCESS(Status) (((NTSTATUS)(Status)) >= 0)
+#define STATUS_INVALID_PARAMETER ((NTSTATUS)0xC000000DL)
+
+namespace bcrypt_stub {
+
+struct Sha256 {
+    uint32_t state[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+    uint8_t block[64] = {};
+    size_t blockLength = 0;
+    uint64_t totalLength = 0;
+
+    static uint32_t Rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+    void Compress(const uint8_t* data) {
+        static const uint32_t k[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2 };
+        uint32_t w[64];
+        for (int i = 0; i < 16; ++i) {
+            w[i] = (uint32_t(data[i * 4]) << 24) | (uint32_t(data[i * 4 + 1]) << 16) |
+                   (uint32_t(data[i * 4 + 2]) << 8) | uint32_t(data[i * 4 + 3]);
+        }
+        for (int i = 16; i < 64; ++i) {
+            uint32_t s0 = Rotr(w[i - 15], 7) ^ Rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = Rotr(w[i - 2], 17) ^ Rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; ++i) {
+            uint32_t t1 = h + (Rotr(e, 6) ^ Rotr(e, 11) ^ Rotr(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+            uint32_t t2 = (Rotr(a, 2) ^ Rotr(a, 13) ^ Rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+
+    void Update(const uint8_t* data, size_t length) {
+        totalLength += length;
+        while (length > 0) {
+            size_t part = (std::min)(length, sizeof(block) - blockLength);
+            memcpy(block + blockLength, data, part);
+            blockLength += part;
+            data += part;
+            length -= part;
+            if (blockLength == sizeof(block)) {
+                Compress(block);
+                blockLength = 0;
+            }
+        }
+    }
+
+    void Finish(uint8_t* digest) {
+        uint64_t bits = totalLength * 8;
+        uint8_t pad = 0x80;
+        Update(&pad, 1);
+        uint8_t zero = 0;
+        while (blockLength != 56) {
+            Update(&zero, 1);
+        }
+        uint8_t length[8];
+        for (int i = 0; i < 8; ++i) {
+            length[i] = static_cast<uint8_t>(bits >> (56 - i * 8));
+        }
+        Update(length, 8);
+        for (int i = 0; i < 8; ++i) {
+            digest[i * 4] = static_cast<uint8_t>(state[i] >> 24);
+            digest[i * 4 + 1] = static_cast<uint8_t>(state[i] >> 16);
+            digest[i * 4 + 2] = static_cast<uint8_t>(state[i] >> 8);
+            digest[i * 4 + 3] = static_cast<uint8_t>(state[i]);
+        }
+    }
+};
+
+} // namespace bcrypt_stub
+
+inline NTSTATUS BCryptCreateHash(BCRYPT_ALG_HANDLE, BCRYPT_HASH_HANDLE* hash, BYTE*, ULONG, BYTE*, ULONG, ULONG) {
+    *hash = new bcrypt_stub::Sha256();
+    return STATUS_SUCCESS;
+}
+
+inline NTSTATUS BCryptHashData(BCRYPT_HASH_HANDLE hash, BYTE* input, ULONG length, ULONG) {
+    static_cast<bcrypt_stub::Sha256*>(hash)->Update(input, length);
+    return STATUS_SUCCESS;
+}
+
+inline NTSTATUS BCryptFinishHash(BCRYPT_HASH_HANDLE hash, BYTE* output, ULONG length, ULONG) {
+    if (length != 32) {
+        return STATUS_INVALID_PARAMETER;
+    }
+    static_cast<bcrypt_stub::Sha256*>(hash)->Finish(output);
+    return STATUS_SUCCESS;
+}
+
+inline NTSTATUS BCryptDestroyHash(BCRYPT_HASH_HANDLE hash) {
+    delete static_cast<bcrypt_stub::Sha256*>(hash);
+    return STATUS_SUCCESS;
+}
+
+inline NTSTATUS BCryptHash(BCRYPT_ALG_HANDLE, BYTE*, ULONG, BYTE* input, ULONG inputLength, BYTE* output, ULONG outputLength) {
+    if (outputLength != 32) {
+        return STATUS_INVALID_PARAMETER;
+    }
+    bcrypt_stub::Sha256 sha;
+    sha.Update(input, inputLength);
+    sha.Finish(output);
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,566 @@
+#pragma once
+
+// 테스트용 cfapi 대체 헤더
+// 등록/연결된 콜백 표와 CfExecute 등 플랫폼 호출을 기록해 테스트가 콜백을 직접 발생시키고 응답을 확인할 수 있게 함
+// 파일 핸들을 쓰는 호출(CfOpenFileWithOplock 등)은 실제 파일을 열지 않고 경로만 기억함
+
+#include <windows.h>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+typedef LONGLONG CF_CONNECTION_KEY;
+typedef LONGLONG CF_TRANSFER_KEY;
+typedef LONGLONG CF_REQUEST_KEY;
+#define CF_CONNECTION_KEY_INVALID ((CF_CONNECTION_KEY)0)
+#define CF_TRANSFER_KEY_INVALID ((CF_TRANSFER_KEY)0)
+
+#define STATUS_CLOUD_FILE_VALIDATION_FAILED ((NTSTATUS)0xC000CF06L)
+#define STATUS_CLOUD_FILE_NETWORK_UNAVAILABLE ((NTSTATUS)0xC000CF07L)
+#define STATUS_CLOUD_FILE_UNSUCCESSFUL ((NTSTATUS)0xC000CF0BL)
+#define STATUS_CLOUD_FILE_INVALID_REQUEST ((NTSTATUS)0xC000CF0FL)
+#define STATUS_CLOUD_FILE_REQUEST_ABORTED ((NTSTATUS)0xC000CF17L)
+#define STATUS_CLOUD_FILE_REQUEST_CANCELED ((NTSTATUS)0xC000CF18L)
+
+typedef enum CF_IN_SYNC_STATE { CF_IN_SYNC_STATE_NOT_IN_SYNC = 0, CF_IN_SYNC_STATE_IN_SYNC = 1 } CF_IN_SYNC_STATE;
+typedef enum CF_PIN_STATE {
+    CF_PIN_STATE_UNSPECIFIED = 0,
+    CF_PIN_STATE_PINNED = 1,
+    CF_PIN_STATE_UNPINNED = 2,
+    CF_PIN_STATE_EXCLUDED = 3,
+    CF_PIN_STATE_INHERIT = 4
+} CF_PIN_STATE;
+
+typedef struct CF_FS_METADATA {
+    FILE_BASIC_INFO BasicInfo;
+    LARGE_INTEGER FileSize;
+} CF_FS_METADATA;
+
+typedef DWORD CF_PLACEHOLDER_CREATE_FLAGS;
+#define CF_PLACEHOLDER_CREATE_FLAG_NONE 0x00000000
+#define CF_PLACEHOLDER_CREATE_FLAG_DISABLE_ON_DEMAND_POPULATION 0x00000001
+#define CF_PLACEHOLDER_CREATE_FLAG_MARK_IN_SYNC 0x00000002
+#define CF_PLACEHOLDER_CREATE_FLAG_SUPERSEDE 0x00000004
+
+typedef struct CF_PLACEHOLDER_CREATE_INFO {
+    LPCWSTR RelativeFileName;
+    CF_FS_METADATA FsMetadata;
+    LPCVOID FileIdentity;
+    DWORD FileIdentityLength;
+    CF_PLACEHOLDER_CREATE_FLAGS Flags;
+    HRESULT Result;
+    LONGLONG CreateUsn;
+} CF_PLACEHOLDER_CREATE_INFO;
+
+typedef DWORD CF_CREATE_FLAGS;
+#define CF_CREATE_FLAG_NONE 0x00000000
+#define CF_CREATE_FLAG_STOP_ON_ERROR 0x00000001
+
+typedef struct CF_PROCESS_INFO {
+    DWORD StructSize;
+    DWORD ProcessId;
+    PCWSTR ImagePath;
+    PCWSTR PackageName;
+    PCWSTR ApplicationId;
+    PCWSTR CommandLine;
+    DWORD SessionId;
+} CF_PROCESS_INFO;
+
+typedef struct CF_CALLBACK_INFO {
+    DWORD StructSize;
+    CF_CONNECTION_KEY ConnectionKey;
+    LPVOID CallbackContext;
+    PCWSTR VolumeGuidName;
+    PCWSTR VolumeDosName;
+    DWORD VolumeSerialNumber;
+    LARGE_INTEGER SyncRootFileId;
+    LPCVOID SyncRootIdentity;
+    DWORD SyncRootIdentityLength;
+    LARGE_INTEGER FileId;
+    LARGE_INTEGER FileSize;
+    LPCVOID FileIdentity;
+    DWORD FileIdentityLength;
+    PCWSTR NormalizedPath;
+    CF_TRANSFER_KEY TransferKey;
+    BYTE PriorityHint;
+    void* CorrelationVector;
+    CF_PROCESS_INFO* ProcessInfo;
+    CF_REQUEST_KEY RequestKey;
+} CF_CALLBACK_INFO;
+
+typedef struct CF_CALLBACK_PARAMETERS {
+    ULONG ParamSize;
+    union {
+        struct { DWORD Flags; LARGE_INTEGER FileOffset; LARGE_INTEGER Length; } FetchData_Cancel_Placeholder;
+        struct {
+            DWORD Flags;
+            union { struct { LARGE_INTEGER FileOffset; LARGE_INTEGER Length; } FetchData; };
+        } Cancel;
+        struct {
+            DWORD Flags;
+            LARGE_INTEGER RequiredFileOffset;
+            LARGE_INTEGER RequiredLength;
+            LARGE_INTEGER OptionalFileOffset;
+            LARGE_INTEGER OptionalLength;
+            LARGE_INTEGER LastDehydrationTime;
+            DWORD LastDehydrationReason;
+        } FetchData;
+        struct { DWORD Flags; LARGE_INTEGER RequiredFileOffset; LARGE_INTEGER RequiredLength; } ValidateData;
+        struct { DWORD Flags; PCWSTR Pattern; } FetchPlaceholders;
+        struct { DWORD Flags; } OpenCompletion;
+        struct { DWORD Flags; } CloseCompletion;
+        struct { DWORD Flags; DWORD Reason; } Dehydrate;
+        struct { DWORD Flags; DWORD Reason; } DehydrateCompletion;
+        struct { DWORD Flags; } Delete;
+        struct { DWORD Flags; } DeleteCompletion;
+        struct { DWORD Flags; PCWSTR TargetPath; } Rename;
+        struct { DWORD Flags; PCWSTR SourcePath; } RenameCompletion;
+    };
+} CF_CALLBACK_PARAMETERS;
+
+typedef void (CALLBACK* CF_CALLBACK)(const CF_CALLBACK_INFO* CallbackInfo, const CF_CALLBACK_PARAMETERS* CallbackParameters);
+
+typedef enum CF_CALLBACK_TYPE {
+    CF_CALLBACK_TYPE_FETCH_DATA,
+    CF_CALLBACK_TYPE_VALIDATE_DATA,
+    CF_CALLBACK_TYPE_CANCEL_FETCH_DATA,
+    CF_CALLBACK_TYPE_FETCH_PLACEHOLDERS,
+    CF_CALLBACK_TYPE_CANCEL_FETCH_PLACEHOLDERS,
+    CF_CALLBACK_TYPE_NOTIFY_FILE_OPEN_COMPLETION,
+    CF_CALLBACK_TYPE_NOTIFY_FILE_CLOSE_COMPLETION,
+    CF_CALLBACK_TYPE_NOTIFY_DEHYDRATE,
+    CF_CALLBACK_TYPE_NOTIFY_DEHYDRATE_COMPLETION,
+    CF_CALLBACK_TYPE_NOTIFY_DELETE,
+    CF_CALLBACK_TYPE_NOTIFY_DELETE_COMPLETION,
+    CF_CALLBACK_TYPE_NOTIFY_RENAME,
+    CF_CALLBACK_TYPE_NOTIFY_RENAME_COMPLETION,
+    CF_CALLBACK_TYPE_NONE = 0xffffffff
+} CF_CALLBACK_TYPE;
+
+typedef struct CF_CALLBACK_REGISTRATION {
+    CF_CALLBACK_TYPE Type;
+    CF_CALLBACK Callback;
+} CF_CALLBACK_REGISTRATION;
+#define CF_CALLBACK_REGISTRATION_END { CF_CALLBACK_TYPE_NONE, nullptr }
+
+typedef enum CF_OPERATION_TYPE {
+    CF_OPERATION_TYPE_TRANSFER_DATA,
+    CF_OPERATION_TYPE_RETRIEVE_DATA,
+    CF_OPERATION_TYPE_ACK_DATA,
+    CF_OPERATION_TYPE_RESTART_HYDRATION,
+    CF_OPERATION_TYPE_TRANSFER_PLACEHOLDERS,
+    CF_OPERATION_TYPE_ACK_DEHYDRATE,
+    CF_OPERATION_TYPE_ACK_DELETE,
+    CF_OPERATION_TYPE_ACK_RENAME
+} CF_OPERATION_TYPE;
+
+typedef struct CF_OPERATION_INFO {
+    DWORD StructSize;
+    CF_OPERATION_TYPE Type;
+    CF_CONNECTION_KEY ConnectionKey;
+    CF_TRANSFER_KEY TransferKey;
+    const void* CorrelationVector;
+    const void* SyncStatus;
+    CF_REQUEST_KEY RequestKey;
+} CF_OPERATION_INFO;
+
+typedef DWORD CF_OPERATION_TRANSFER_PLACEHOLDERS_FLAGS;
+#define CF_OPERATION_TRANSFER_PLACEHOLDERS_FLAG_NONE 0x00000000
+#define CF_OPERATION_TRANSFER_PLACEHOLDERS_FLAG_STOP_ON_ERROR 0x00000001
+#define CF_OPERATION_TRANSFER_PLACEHOLDERS_FLAG_DISABLE_ON_DEMAND_POPULATION 0x00000002
+
+typedef struct CF_OPERATION_PARAMETERS {
+    ULONG ParamSize;
+    union {
+        struct { DWORD Flags; NTSTATUS CompletionStatus; LPCVOID Buffer; LARGE_INTEGER Offset; LARGE_INTEGER Length; } TransferData;
+        struct { DWORD Flags; LPVOID Buffer; LARGE_INTEGER Offset; LARGE_INTEGER Length; LARGE_INTEGER ReturnedLength; } RetrieveData;
+        struct { DWORD Flags; NTSTATUS CompletionStatus; LARGE_INTEGER Offset; LARGE_INTEGER Length; } AckData;
+        struct {
+            CF_OPERATION_TRANSFER_PLACEHOLDERS_FLAGS Flags;
+            NTSTATUS CompletionStatus;
+            LARGE_INTEGER PlaceholderTotalCount;
+            CF_PLACEHOLDER_CREATE_INFO* PlaceholderArray;
+            DWORD PlaceholderCount;
+            DWORD EntriesProcessed;
+        } TransferPlaceholders;
+        struct { DWORD Flags; NTSTATUS CompletionStatus; } AckDehydrate;
+    };
+} CF_OPERATION_PARAMETERS;
+
+typedef enum CF_HYDRATION_POLICY_PRIMARY {
+    CF_HYDRATION_POLICY_PARTIAL = 0,
+    CF_HYDRATION_POLICY_PROGRESSIVE = 1,
+    CF_HYDRATION_POLICY_FULL = 2,
+    CF_HYDRATION_POLICY_ALWAYS_FULL = 3
+} CF_HYDRATION_POLICY_PRIMARY;
+
+typedef USHORT CF_HYDRATION_POLICY_MODIFIER;
+#define CF_HYDRATION_POLICY_MODIFIER_NONE 0x0000
+#define CF_HYDRATION_POLICY_MODIFIER_VALIDATION_REQUIRED 0x0001
+#define CF_HYDRATION_POLICY_MODIFIER_STREAMING_ALLOWED 0x0002
+
+typedef struct CF_HYDRATION_POLICY {
+    CF_HYDRATION_POLICY_PRIMARY Primary;
+    CF_HYDRATION_POLICY_MODIFIER Modifier;
+} CF_HYDRATION_POLICY;
+
+typedef enum CF_POPULATION_POLICY_PRIMARY {
+    CF_POPULATION_POLICY_PARTIAL = 0,
+    CF_POPULATION_POLICY_FULL = 2,
+    CF_POPULATION_POLICY_ALWAYS_FULL = 3
+} CF_POPULATION_POLICY_PRIMARY;
+
+typedef struct CF_POPULATION_POLICY {
+    CF_POPULATION_POLICY_PRIMARY Primary;
+    USHORT Modifier;
+} CF_POPULATION_POLICY;
+
+typedef DWORD CF_INSYNC_POLICY;
+typedef DWORD CF_HARDLINK_POLICY;
+typedef DWORD CF_PLACEHOLDER_MANAGEMENT_POLICY;
+#define CF_INSYNC_POLICY_TRACK_ALL 0x00ffffff
+#define CF_HARDLINK_POLICY_NONE 0x00000000
+#define CF_PLACEHOLDER_MANAGEMENT_POLICY_DEFAULT 0x00000000
+
+typedef struct CF_SYNC_POLICIES {
+    ULONG StructSize;
+    CF_HYDRATION_POLICY Hydration;
+    CF_POPULATION_POLICY Population;
+    CF_INSYNC_POLICY InSync;
+    CF_HARDLINK_POLICY HardLink;
+    CF_PLACEHOLDER_MANAGEMENT_POLICY PlaceholderManagement;
+} CF_SYNC_POLICIES;
+
+typedef struct CF_SYNC_REGISTRATION {
+    ULONG StructSize;
+    LPCWSTR ProviderName;
+    LPCWSTR ProviderVersion;
+    LPCVOID SyncRootIdentity;
+    DWORD SyncRootIdentityLength;
+    LPCVOID FileIdentity;
+    DWORD FileIdentityLength;
+    GUID ProviderId;
+} CF_SYNC_REGISTRATION;
+
+typedef DWORD CF_REGISTER_FLAGS;
+typedef DWORD CF_CONNECT_FLAGS;
+typedef DWORD CF_SET_IN_SYNC_FLAGS;
+typedef DWORD CF_SET_PIN_FLAGS;
+typedef DWORD CF_OPEN_FILE_FLAGS;
+typedef DWORD CF_HYDRATE_FLAGS;
+#define CF_REGISTER_FLAG_NONE 0x00000000
+#define CF_CONNECT_FLAG_NONE 0x00000000
+#define CF_CONNECT_FLAG_REQUIRE_PROCESS_INFO 0x00000002
+#define CF_CONNECT_FLAG_REQUIRE_FULL_FILE_PATH 0x00000004
+#define CF_SET_IN_SYNC_FLAG_NONE 0x00000000
+#define CF_SET_PIN_FLAG_NONE 0x00000000
+#define CF_OPEN_FILE_FLAG_NONE 0x00000000
+#define CF_OPEN_FILE_FLAG_EXCLUSIVE 0x00000001
+#define CF_OPEN_FILE_FLAG_WRITE_ACCESS 0x00000002
+#define CF_OPEN_FILE_FLAG_DELETE_ACCESS 0x00000004
+#define CF_OPEN_FILE_FLAG_FOREGROUND 0x00000008
+#define CF_HYDRATE_FLAG_NONE 0x00000000
+
+namespace cfapi_stub {
+
+// CfExecute 한 번의 기록 (TRANSFER_DATA는 데이터도 복사)
+struct Operation {
+    CF_OPERATION_TYPE type = CF_OPERATION_TYPE_TRANSFER_DATA;
+    CF_CONNECTION_KEY connectionKey = CF_CONNECTION_KEY_INVALID;
+    CF_TRANSFER_KEY transferKey = CF_TRANSFER_KEY_INVALID;
+    NTSTATUS completionStatus = STATUS_SUCCESS;
+    LONGLONG offset = 0;
+    LONGLONG length = 0;
+    DWORD flags = 0;
+    std::vector<BYTE> data;
+    std::vector<std::wstring> placeholderNames;
+};
+
+struct Progress {
+    CF_TRANSFER_KEY transferKey = CF_TRANSFER_KEY_INVALID;
+    LONGLONG total = 0;
+    LONGLONG completed = 0;
+};
+
+// 파일 핸들 작업 기록 (핸들은 경로로 식별)
+struct HandleCall {
+    std::string operation;
+    std::wstring path;
+    int state = 0;
+};
+
+struct State {
+    std::mutex mutex;
+
+    // 등록/연결
+    std::wstring registeredPath;
+    CF_SYNC_POLICIES policies = {};
+    CF_CONNECT_FLAGS connectFlags = 0;
+    std::unordered_map<int, CF_CALLBACK> callbacks;
+    LPCVOID callbackContext = nullptr;
+    CF_CONNECTION_KEY connectionKey = CF_CONNECTION_KEY_INVALID;
+    int disconnects = 0;
+
+    // 플랫폼 호출 기록
+    std::vector<Operation> operations;
+    std::vector<Progress> progress;
+    std::vector<HandleCall> handleCalls;
+    size_t placeholdersCreated = 0;
+    size_t createCalls = 0;
+    CF_TRANSFER_KEY nextTransferKey = 1000;
+
+    // 테스트가 정하는 동작
+    std::unordered_map<CF_TRANSFER_KEY, std::vector<BYTE>> hydratedData;  // RETRIEVE_DATA가 읽는 데이터
+    std::function<HRESULT(const std::wstring& path)> onHydratePlaceholder;
+    HRESULT executeResult = S_OK;
+};
+
+inline State& Get() {
+    static State state;
+    return state;
+}
+
+inline void Reset() {
+    State& state = Get();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.registeredPath.clear();
+    state.policies = {};
+    state.connectFlags = 0;
+    state.callbacks.clear();
+    state.callbackContext = nullptr;
+    state.connectionKey = CF_CONNECTION_KEY_INVALID;
+    state.disconnects = 0;
+    state.operations.clear();
+    state.progress.clear();
+    state.handleCalls.clear();
+    state.placeholdersCreated = 0;
+    state.createCalls = 0;
+    state.hydratedData.clear();
+    state.onHydratePlaceholder = nullptr;
+    state.executeResult = S_OK;
+}
+
+inline std::vector<Operation> Operations(CF_OPERATION_TYPE type) {
+    State& state = Get();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    std::vector<Operation> result;
+    for (const auto& operation : state.operations) {
+        if (operation.type == type) {
+            result.push_back(operation);
+        }
+    }
+    return result;
+}
+
+// 연결된 콜백 표로 콜백 하나를 발생시킴 (등록되지 않은 종류면 false)
+inline bool Fire(CF_CALLBACK_TYPE type, CF_CALLBACK_INFO info, const CF_CALLBACK_PARAMETERS& parameters) {
+    CF_CALLBACK callback = nullptr;
+    {
+        State& state = Get();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        auto found = state.callbacks.find(static_cast<int>(type));
+        if (found == state.callbacks.end()) {
+            return false;
+        }
+        callback = found->second;
+        info.StructSize = sizeof(CF_CALLBACK_INFO);
+        info.ConnectionKey = state.connectionKey;
+        info.CallbackContext = const_cast<LPVOID>(state.callbackContext);
+    }
+    callback(&info, &parameters);
+    return true;
+}
+
+// CfOpenFileWithOplock이 돌려주는 보호 핸들
+struct ProtectedHandle {
+    std::wstring path;
+    int references = 1;
+};
+
+inline void RecordHandleCall(const char* operation, HANDLE handle, int state) {
+    State& stub = Get();
+    std::lock_guard<std::mutex> lock(stub.mutex);
+    stub.handleCalls.push_back({ operation, handle ? static_cast<ProtectedHandle*>(handle)->path : std::wstring(), state });
+}
+
+} // namespace cfapi_stub
+
+inline HRESULT CfRegisterSyncRoot(LPCWSTR syncRootPath, const CF_SYNC_REGISTRATION*, const CF_SYNC_POLICIES* policies,
+                                  CF_REGISTER_FLAGS) {
+    cfapi_stub::State& state = cfapi_stub::Get();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.registeredPath = syncRootPath;
+    state.policies = *policies;
+    return S_OK;
+}
+
+inline HRESULT CfUnregisterSyncRoot(LPCWSTR) {
+    cfapi_stub::State& state = cfapi_stub::Get();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.registeredPath.clear();
+    return S_OK;
+}
+
+inline HRESULT CfConnectSyncRoot(LPCWSTR, const CF_CALLBACK_REGISTRATION* callbackTable, LPCVOID callbackContext,
+                                 CF_CONNECT_FLAGS connectFlags, CF_CONNECTION_KEY* connectionKey) {
+    cfapi_stub::State& state = cfapi_stub::Get();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.callbacks.clear();
+    for (const CF_CALLBACK_REGISTRATION* entry = callbackTable; entry->Type != CF_CALLBACK_TYPE_NONE; ++entry) {
+        state.callbacks[static_cast<int>(entry->Type)] = entry->Callback;
+    }
+    state.callbackContext = callbackContext;
+    state.connectFlags = connectFlags;
+    state.connectionKey = 77;
+    *connectionKey = state.connectionKey;
+    return S_OK;
+}
+
+inline HRESULT CfDisconnectSyncRoot(CF_CONNECTION_KEY) {
+    cfapi_stub::State& state = cfapi_stub::Get();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.callbacks.clear();
+    state.disconnects++;
+    return S_OK;
+}
+
+inline HRESULT CfCreatePlaceholders(LPCWSTR, CF_PLACEHOLDER_CREATE_INFO* placeholders, DWORD count, CF_CREATE_FLAGS,
+                                   DWORD* entriesProcessed) {
+    for (DWORD i = 0; i < count; ++i) {
+        placeholders[i].Result = S_OK;
+        placeholders[i].CreateUsn = i + 1;
+    }
+    *entriesProcessed = count;
+    cfapi_stub::State& state = cfapi_stub::Get();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.placeholdersCreated += count;
+    state.createCalls++;
+    return S_OK;
+}
+
+inline HRESULT CfExecute(const CF_OPERATION_INFO* info, CF_OPERATION_PARAMETERS* parameters) {
+    cfapi_stub::Operation operation;
+    operation.type = info->Type;
+    operation.connectionKey = info->ConnectionKey;
+    operation.transferKey = info->TransferKey;
+
+    cfapi_stub::State& state = cfapi_stub::Get();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    switch (info->Type) {
+    case CF_OPERATION_TYPE_TRANSFER_DATA: {
+        const auto& transfer = parameters->TransferData;
+        operation.completionStatus = transfer.CompletionStatus;
+        operation.offset = transfer.Offset.QuadPart;
+        operation.length = transfer.Length.QuadPart;
+        if (transfer.Buffer) {
+            const BYTE* data = static_cast<const BYTE*>(transfer.Buffer);
+            operation.data.assign(data, data + transfer.Length.QuadPart);
+        }
+        break;
+    }
+    case CF_OPERATION_TYPE_RETRIEVE_DATA: {
+        auto& retrieve = parameters->RetrieveData;
+        operation.offset = retrieve.Offset.QuadPart;
+        operation.length = retrieve.Length.QuadPart;
+        const std::vector<BYTE>& data = state.hydratedData[info->TransferKey];
+        LONGLONG available = (std::max)(0LL, static_cast<LONGLONG>(data.size()) - retrieve.Offset.QuadPart);
+        LONGLONG returned = (std::min)(available, retrieve.Length.QuadPart);
+        if (returned > 0) {
+            memcpy(retrieve.Buffer, data.data() + retrieve.Offset.QuadPart, static_cast<size_t>(returned));
+        }
+        retrieve.ReturnedLength.QuadPart = returned;
+        break;
+    }
+    case CF_OPERATION_TYPE_ACK_DATA:
+        operation.completionStatus = parameters->AckData.CompletionStatus;
+        operation.offset = parameters->AckData.Offset.QuadPart;
+        operation.length = parameters->AckData.Length.QuadPart;
+        break;
+    case CF_OPERATION_TYPE_TRANSFER_PLACEHOLDERS: {
+        auto& transfer = parameters->TransferPlaceholders;
+        operation.completionStatus = transfer.CompletionStatus;
+        operation.flags = transfer.Flags;
+        operation.length = transfer.PlaceholderCount;
+        for (DWORD i = 0; i < transfer.PlaceholderCount; ++i) {
+            operation.placeholderNames.push_back(transfer.PlaceholderArray[i].RelativeFileName);
+        }
+        transfer.EntriesProcessed = transfer.PlaceholderCount;
+        break;
+    }
+    default:
+        break;
+    }
+    state.operations.push_back(std::move(operation));
+    return state.executeResult;
+}
+
+inline HRESULT CfReportProviderProgress(CF_CONNECTION_KEY, CF_TRANSFER_KEY transferKey, LARGE_INTEGER total, LARGE_INTEGER completed) {
+    cfapi_stub::State& state = cfapi_stub::Get();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.progress.push_back({ transferKey, total.QuadPart, completed.QuadPart });
+    return S_OK;
+}
+
+inline HRESULT CfOpenFileWithOplock(LPCWSTR filePath, CF_OPEN_FILE_FLAGS, HANDLE* protectedHandle) {
+    *protectedHandle = new cfapi_stub::ProtectedHandle{ filePath };
+    cfapi_stub::RecordHandleCall("open", *protectedHandle, 0);
+    return S_OK;
+}
+
+inline void CfCloseHandle(HANDLE handle) {
+    auto* protectedHandle = static_cast<cfapi_stub::ProtectedHandle*>(handle);
+    cfapi_stub::RecordHandleCall("close", handle, 0);
+    delete protectedHandle;
+}
+
+inline BOOL CfReferenceProtectedHandle(HANDLE handle) {
+    static_cast<cfapi_stub::ProtectedHandle*>(handle)->references++;
+    return TRUE;
+}
+
+inline void CfReleaseProtectedHandle(HANDLE handle) {
+    static_cast<cfapi_stub::ProtectedHandle*>(handle)->references--;
+}
+
+inline HANDLE CfGetWin32HandleFromProtectedHandle(HANDLE handle) {
+    return handle;
+}
+
+inline HRESULT CfGetTransferKey(HANDLE handle, CF_TRANSFER_KEY* transferKey) {
+    cfapi_stub::RecordHandleCall("transfer_key", handle, 0);
+    cfapi_stub::State& state = cfapi_stub::Get();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    *transferKey = state.nextTransferKey++;
+    return S_OK;
+}
+
+inline void CfReleaseTransferKey(HANDLE handle, CF_TRANSFER_KEY*) {
+    cfapi_stub::RecordHandleCall("release_transfer_key", handle, 0);
+}
+
+inline HRESULT CfSetInSyncState(HANDLE handle, CF_IN_SYNC_STATE inSyncState, CF_SET_IN_SYNC_FLAGS, LONGLONG*) {
+    cfapi_stub::RecordHandleCall("in_sync", handle, inSyncState);
+    return S_OK;
+}
+
+inline HRESULT CfSetPinState(HANDLE handle, CF_PIN_STATE pinState, CF_SET_PIN_FLAGS, void*) {
+    cfapi_stub::RecordHandleCall("pin", handle, pinState);
+    return S_OK;
+}
+
+// 실제 API는 파일 핸들을 받지만 대체 구현에서는 CreateFileW로 연 파일의 경로를 알 수 없으므로
+// 테스트가 onHydratePlaceholder에서 FETCH_DATA를 발생시켜 플랫폼 동작을 흉내 냄
+inline HRESULT CfHydratePlaceholder(HANDLE, LARGE_INTEGER, LARGE_INTEGER, CF_HYDRATE_FLAGS, void*) {
+    std::function<HRESULT(const std::wstring&)> hook;
+    {
+        cfapi_stub::State& state = cfapi_stub::Get();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        hook = state.onHydratePlaceholder;
+    }
+    return hook ? hook(std::wstring()) : S_OK;
+}
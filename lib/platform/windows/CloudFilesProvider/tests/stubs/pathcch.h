@@ -0,0 +1,5 @@
+#pragma once
+
+// 테스트용 빈 대체 헤더 (provider는 pathcch 선언을 쓰지 않음)
+
+#include <windows.h>
@@ -0,0 +1,792 @@
+#pragma once
+
+// 테스트용 Win32 대체 헤더
+// provider 소스가 쓰는 Win32 부분집합만 POSIX로 구현해 Windows SDK 없이 CI에서 빌드하고 실행할 수 있게 함
+// (타입 크기와 오류 코드는 Windows와 같게 맞춤, 동작은 테스트에 필요한 만큼만)
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <cwctype>
+#include <cerrno>
+#include <ctime>
+#include <string>
+#include <mutex>
+#include <unordered_map>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef __declspec
+#define __declspec(x)
+#endif
+#define WINAPI
+#define CALLBACK
+
+typedef int32_t LONG;
+typedef uint32_t ULONG;
+typedef uint32_t DWORD;
+typedef int32_t BOOL;
+typedef uint8_t BYTE;
+typedef uint8_t BOOLEAN;
+typedef uint16_t WORD;
+typedef uint16_t USHORT;
+typedef long long LONGLONG;
+typedef unsigned long long ULONGLONG;
+typedef int64_t INT64;
+typedef uint64_t DWORD64;
+typedef uintptr_t ULONG_PTR;
+typedef size_t SIZE_T;
+typedef LONG HRESULT;
+typedef LONG NTSTATUS;
+typedef wchar_t WCHAR;
+typedef WCHAR* LPWSTR;
+typedef const WCHAR* LPCWSTR;
+typedef const WCHAR* PCWSTR;
+typedef void* PVOID;
+typedef void* LPVOID;
+typedef const void* LPCVOID;
+typedef void* HANDLE;
+typedef HANDLE HMODULE;
+typedef void (*FARPROC)();
+
+typedef union _LARGE_INTEGER {
+    struct {
+        DWORD LowPart;
+        LONG HighPart;
+    };
+    LONGLONG QuadPart;
+} LARGE_INTEGER;
+
+typedef struct _FILETIME {
+    DWORD dwLowDateTime;
+    DWORD dwHighDateTime;
+} FILETIME;
+
+typedef struct _SYSTEMTIME {
+    WORD wYear, wMonth, wDayOfWeek, wDay, wHour, wMinute, wSecond, wMilliseconds;
+} SYSTEMTIME;
+
+typedef struct _FILE_BASIC_INFO {
+    LARGE_INTEGER CreationTime;
+    LARGE_INTEGER LastAccessTime;
+    LARGE_INTEGER LastWriteTime;
+    LARGE_INTEGER ChangeTime;
+    DWORD FileAttributes;
+} FILE_BASIC_INFO;
+
+typedef struct _GUID {
+    uint32_t Data1;
+    uint16_t Data2;
+    uint16_t Data3;
+    uint8_t Data4[8];
+} GUID;
+
+typedef struct _OVERLAPPED {
+    ULONG_PTR Internal;
+    ULONG_PTR InternalHigh;
+    DWORD Offset;
+    DWORD OffsetHigh;
+    HANDLE hEvent;
+} OVERLAPPED;
+
+typedef struct _SYSTEM_INFO {
+    DWORD dwPageSize;
+    DWORD dwAllocationGranularity;
+    DWORD dwNumberOfProcessors;
+} SYSTEM_INFO;
+
+#define MAX_PATH 260
+
+typedef struct _WIN32_FIND_DATAW {
+    DWORD dwFileAttributes;
+    FILETIME ftCreationTime;
+    FILETIME ftLastAccessTime;
+    FILETIME ftLastWriteTime;
+    DWORD nFileSizeHigh;
+    DWORD nFileSizeLow;
+    DWORD dwReserved0;
+    DWORD dwReserved1;
+    WCHAR cFileName[MAX_PATH];
+    WCHAR cAlternateFileName[14];
+} WIN32_FIND_DATAW;
+
+typedef struct _WIN32_FILE_ATTRIBUTE_DATA {
+    DWORD dwFileAttributes;
+    FILETIME ftCreationTime;
+    FILETIME ftLastAccessTime;
+    FILETIME ftLastWriteTime;
+    DWORD nFileSizeHigh;
+    DWORD nFileSizeLow;
+} WIN32_FILE_ATTRIBUTE_DATA;
+
+typedef enum _GET_FILEEX_INFO_LEVELS { GetFileExInfoStandard } GET_FILEEX_INFO_LEVELS;
+
+#define TRUE 1
+#define FALSE 0
+#define INFINITE 0xFFFFFFFF
+#define MAXDWORD 0xffffffffUL
+#define MAXULONG 0xffffffffUL
+#define UNREFERENCED_PARAMETER(P) ((void)(P))
+
+#define S_OK ((HRESULT)0)
+#define S_FALSE ((HRESULT)1)
+#define E_FAIL ((HRESULT)0x80004005L)
+#define E_ABORT ((HRESULT)0x80004004L)
+#define E_NOTIMPL ((HRESULT)0x80004001L)
+#define E_PENDING ((HRESULT)0x8000000AL)
+#define E_UNEXPECTED ((HRESULT)0x8000FFFFL)
+#define E_OUTOFMEMORY ((HRESULT)0x8007000EL)
+#define E_INVALIDARG ((HRESULT)0x80070057L)
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define HRESULT_FROM_WIN32(x) \
+    ((HRESULT)(x) <= 0 ? ((HRESULT)(x)) : ((HRESULT)((((uint32_t)(x)) & 0x0000FFFF) | (7 << 16) | 0x80000000)))
+#define HRESULT_FROM_NT(x) ((HRESULT)(((uint32_t)(x)) | 0x10000000))
+
+#define STATUS_SUCCESS ((NTSTATUS)0x00000000L)
+
+#define ERROR_SUCCESS 0L
+#define ERROR_FILE_NOT_FOUND 2L
+#define ERROR_PATH_NOT_FOUND 3L
+#define ERROR_ACCESS_DENIED 5L
+#define ERROR_INVALID_HANDLE 6L
+#define ERROR_NOT_ENOUGH_MEMORY 8L
+#define ERROR_INVALID_DATA 13L
+#define ERROR_NOT_READY 21L
+#define ERROR_GEN_FAILURE 31L
+#define ERROR_HANDLE_EOF 38L
+#define ERROR_NOT_SUPPORTED 50L
+#define ERROR_FILE_EXISTS 80L
+#define ERROR_INVALID_PARAMETER 87L
+#define ERROR_DISK_FULL 112L
+#define ERROR_INSUFFICIENT_BUFFER 122L
+#define ERROR_ALREADY_EXISTS 183L
+#define ERROR_DIRECTORY 267L
+#define ERROR_OPLOCK_NOT_GRANTED 300L
+#define ERROR_OPERATION_ABORTED 995L
+#define ERROR_FILE_INVALID 1006L
+#define ERROR_CANCELLED 1223L
+#define ERROR_TIMEOUT 1460L
+
+#define GENERIC_READ 0x80000000L
+#define GENERIC_WRITE 0x40000000L
+#define FILE_APPEND_DATA 0x0004
+#define FILE_SHARE_READ 0x00000001
+#define FILE_SHARE_WRITE 0x00000002
+#define FILE_SHARE_DELETE 0x00000004
+#define CREATE_NEW 1
+#define CREATE_ALWAYS 2
+#define OPEN_EXISTING 3
+#define OPEN_ALWAYS 4
+#define TRUNCATE_EXISTING 5
+#define FILE_ATTRIBUTE_READONLY 0x00000001
+#define FILE_ATTRIBUTE_DIRECTORY 0x00000010
+#define FILE_ATTRIBUTE_NORMAL 0x00000080
+#define INVALID_FILE_ATTRIBUTES ((DWORD)-1)
+#define FILE_FLAG_BACKUP_SEMANTICS 0x02000000
+#define FILE_FLAG_SEQUENTIAL_SCAN 0x08000000
+#define FILE_FLAG_RANDOM_ACCESS 0x10000000
+#define FILE_FLAG_NO_BUFFERING 0x20000000
+#define FILE_FLAG_WRITE_THROUGH 0x80000000
+#define FILE_BEGIN 0
+#define FILE_CURRENT 1
+#define FILE_END 2
+#define MOVEFILE_REPLACE_EXISTING 0x00000001
+#define MOVEFILE_WRITE_THROUGH 0x00000008
+
+#define PAGE_READONLY 0x02
+#define PAGE_READWRITE 0x04
+#define FILE_MAP_WRITE 0x0002
+#define FILE_MAP_READ 0x0004
+#define MEM_COMMIT 0x00001000
+#define MEM_RESERVE 0x00002000
+#define MEM_RELEASE 0x00008000
+
+#define THREAD_PRIORITY_LOWEST (-2)
+#define THREAD_PRIORITY_BELOW_NORMAL (-1)
+#define THREAD_PRIORITY_NORMAL 0
+#define THREAD_MODE_BACKGROUND_BEGIN 0x00010000
+#define THREAD_MODE_BACKGROUND_END 0x00020000
+
+#define CP_UTF8 65001
+
+#define INVALID_HANDLE_VALUE ((HANDLE)(intptr_t)-1)
+
+#define ZeroMemory(destination, length) memset((destination), 0, (length))
+#define CopyMemory(destination, source, length) memcpy((destination), (source), (length))
+#define _countof(array) (sizeof(array) / sizeof((array)[0]))
+
+namespace win32_stub {
+
+inline DWORD& LastError() {
+    thread_local DWORD error = 0;
+    return error;
+}
+
+inline DWORD FromErrno(int error) {
+    switch (error) {
+    case 0: return ERROR_SUCCESS;
+    case ENOENT: return ERROR_FILE_NOT_FOUND;
+    case ENOTDIR: return ERROR_PATH_NOT_FOUND;
+    case EACCES:
+    case EPERM: return ERROR_ACCESS_DENIED;
+    case EEXIST: return ERROR_ALREADY_EXISTS;
+    case ENOSPC: return ERROR_DISK_FULL;
+    case ENOMEM: return ERROR_NOT_ENOUGH_MEMORY;
+    case EBADF: return ERROR_INVALID_HANDLE;
+    case EINVAL: return ERROR_INVALID_PARAMETER;
+    default: return ERROR_GEN_FAILURE;
+    }
+}
+
+inline BOOL Fail(DWORD error) {
+    LastError() = error;
+    return FALSE;
+}
+
+inline BOOL FailErrno() {
+    return Fail(FromErrno(errno));
+}
+
+// UTF-8 변환 (wchar_t는 UTF-32)
+inline std::string Narrow(const wchar_t* text, size_t length) {
+    std::string result;
+    result.reserve(length);
+    for (size_t i = 0; i < length; ++i) {
+        uint32_t c = static_cast<uint32_t>(text[i]);
+        if (c < 0x80) {
+            result.push_back(static_cast<char>(c));
+        } else if (c < 0x800) {
+            result.push_back(static_cast<char>(0xC0 | (c >> 6)));
+            result.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        } else if (c < 0x10000) {
+            result.push_back(static_cast<char>(0xE0 | (c >> 12)));
+            result.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        } else {
+            result.push_back(static_cast<char>(0xF0 | (c >> 18)));
+            result.push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        }
+    }
+    return result;
+}
+
+inline std::wstring Widen(const char* text, size_t length) {
+    std::wstring result;
+    result.reserve(length);
+    for (size_t i = 0; i < length;) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        uint32_t code = c;
+        size_t extra = 0;
+        if (c >= 0xF0) { code = c & 0x07; extra = 3; }
+        else if (c >= 0xE0) { code = c & 0x0F; extra = 2; }
+        else if (c >= 0xC0) { code = c & 0x1F; extra = 1; }
+        i++;
+        for (size_t k = 0; k < extra && i < length; ++k, ++i) {
+            code = (code << 6) | (static_cast<unsigned char>(text[i]) & 0x3F);
+        }
+        result.push_back(static_cast<wchar_t>(code));
+    }
+    return result;
+}
+
+// Windows 경로 구분자를 '/'로 바꾼 POSIX 경로
+inline std::string ToPosixPath(LPCWSTR path) {
+    std::string result = Narrow(path, wcslen(path));
+    for (char& c : result) {
+        if (c == '\\') {
+            c = '/';
+        }
+    }
+    return result;
+}
+
+// HANDLE이 가리키는 객체 (파일, 매핑, 디렉터리 열거)
+struct Object {
+    enum Kind { File, Mapping, Find } kind;
+    int fd = -1;
+    ULONGLONG mappingSize = 0;
+    DIR* directory = nullptr;
+    std::string directoryPath;
+    std::string pattern;
+};
+
+inline Object* FromHandle(HANDLE handle) {
+    return handle == INVALID_HANDLE_VALUE ? nullptr : static_cast<Object*>(handle);
+}
+
+inline int FileDescriptor(HANDLE handle) {
+    Object* object = FromHandle(handle);
+    return object && object->kind == Object::File ? object->fd : -1;
+}
+
+// MapViewOfFile로 만든 뷰의 길이 (UnmapViewOfFile에 필요)
+inline std::mutex& ViewMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+inline std::unordered_map<const void*, size_t>& Views() {
+    static std::unordered_map<const void*, size_t> views;
+    return views;
+}
+
+inline bool MatchPattern(const char* pattern, const char* name) {
+    if (*pattern == '\0') {
+        return *name == '\0';
+    }
+    if (*pattern == '*') {
+        return MatchPattern(pattern + 1, name) || (*name != '\0' && MatchPattern(pattern, name + 1));
+    }
+    return *name != '\0' && (*pattern == '?' || *pattern == *name) && MatchPattern(pattern + 1, name + 1);
+}
+
+inline FILETIME ToFileTime(const struct timespec& time) {
+    ULONGLONG ticks = static_cast<ULONGLONG>(time.tv_sec) * 10000000ull + time.tv_nsec / 100 + 116444736000000000ull;
+    FILETIME result;
+    result.dwLowDateTime = static_cast<DWORD>(ticks);
+    result.dwHighDateTime = static_cast<DWORD>(ticks >> 32);
+    return result;
+}
+
+inline bool NextFindEntry(Object* find, WIN32_FIND_DATAW* data) {
+    while (struct dirent* entry = readdir(find->directory)) {
+        if (!MatchPattern(find->pattern.c_str(), entry->d_name)) {
+            continue;
+        }
+        struct stat info = {};
+        std::string path = find->directoryPath + "/" + entry->d_name;
+        if (stat(path.c_str(), &info) != 0) {
+            continue;
+        }
+        memset(data, 0, sizeof(*data));
+        data->dwFileAttributes = S_ISDIR(info.st_mode) ? FILE_ATTRIBUTE_DIRECTORY : FILE_ATTRIBUTE_NORMAL;
+        data->nFileSizeHigh = static_cast<DWORD>(static_cast<ULONGLONG>(info.st_size) >> 32);
+        data->nFileSizeLow = static_cast<DWORD>(info.st_size);
+        data->ftLastWriteTime = ToFileTime(info.st_mtim);
+        std::wstring name = Widen(entry->d_name, strlen(entry->d_name));
+        wcsncpy(data->cFileName, name.c_str(), MAX_PATH - 1);
+        return true;
+    }
+    return false;
+}
+
+} // namespace win32_stub
+
+inline DWORD GetLastError() { return win32_stub::LastError(); }
+inline void SetLastError(DWORD error) { win32_stub::LastError() = error; }
+
+inline HANDLE CreateFileW(LPCWSTR path, DWORD access, DWORD /*shareMode*/, void* /*security*/, DWORD disposition,
+                          DWORD flags, HANDLE /*templateFile*/) {
+    int mode = 0;
+    if ((access & GENERIC_READ) && (access & (GENERIC_WRITE | FILE_APPEND_DATA))) {
+        mode = O_RDWR;
+    } else if (access & (GENERIC_WRITE | FILE_APPEND_DATA)) {
+        mode = O_WRONLY;
+    } else {
+        mode = O_RDONLY;
+    }
+    if ((access & FILE_APPEND_DATA) && !(access & GENERIC_WRITE)) {
+        mode |= O_APPEND;
+    }
+    switch (disposition) {
+    case CREATE_NEW: mode |= O_CREAT | O_EXCL; break;
+    case CREATE_ALWAYS: mode |= O_CREAT | O_TRUNC; break;
+    case OPEN_ALWAYS: mode |= O_CREAT; break;
+    case TRUNCATE_EXISTING: mode |= O_TRUNC; break;
+    default: break;
+    }
+    if (flags & FILE_FLAG_BACKUP_SEMANTICS) {
+        mode = O_RDONLY;
+    }
+
+    int fd = ::open(win32_stub::ToPosixPath(path).c_str(), mode | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        win32_stub::FailErrno();
+        if (errno == EEXIST) {
+            win32_stub::LastError() = ERROR_FILE_EXISTS;
+        }
+        return INVALID_HANDLE_VALUE;
+    }
+    win32_stub::LastError() = ERROR_SUCCESS;
+    auto* object = new win32_stub::Object{ win32_stub::Object::File };
+    object->fd = fd;
+    return object;
+}
+
+inline BOOL CloseHandle(HANDLE handle) {
+    win32_stub::Object* object = win32_stub::FromHandle(handle);
+    if (!object) {
+        return win32_stub::Fail(ERROR_INVALID_HANDLE);
+    }
+    if (object->fd >= 0) {
+        ::close(object->fd);
+    }
+    delete object;
+    return TRUE;
+}
+
+inline BOOL ReadFile(HANDLE handle, LPVOID buffer, DWORD length, DWORD* read, OVERLAPPED* overlapped) {
+    int fd = win32_stub::FileDescriptor(handle);
+    if (fd < 0) {
+        return win32_stub::Fail(ERROR_INVALID_HANDLE);
+    }
+    ssize_t result;
+    if (overlapped) {
+        off_t offset = static_cast<off_t>((static_cast<ULONGLONG>(overlapped->OffsetHigh) << 32) | overlapped->Offset);
+        result = ::pread(fd, buffer, length, offset);
+        // 동기 핸들에서 파일 끝 이후를 위치 지정으로 읽으면 ERROR_HANDLE_EOF
+        if (result == 0 && length > 0) {
+            if (read) {
+                *read = 0;
+            }
+            return win32_stub::Fail(ERROR_HANDLE_EOF);
+        }
+    } else {
+        result = ::read(fd, buffer, length);
+    }
+    if (result < 0) {
+        return win32_stub::FailErrno();
+    }
+    if (read) {
+        *read = static_cast<DWORD>(result);
+    }
+    return TRUE;
+}
+
+inline BOOL WriteFile(HANDLE handle, LPCVOID data, DWORD length, DWORD* written, OVERLAPPED* overlapped) {
+    int fd = win32_stub::FileDescriptor(handle);
+    if (fd < 0) {
+        return win32_stub::Fail(ERROR_INVALID_HANDLE);
+    }
+    ssize_t result;
+    if (overlapped) {
+        off_t offset = static_cast<off_t>((static_cast<ULONGLONG>(overlapped->OffsetHigh) << 32) | overlapped->Offset);
+        result = ::pwrite(fd, data, length, offset);
+    } else {
+        result = ::write(fd, data, length);
+    }
+    if (result < 0) {
+        return win32_stub::FailErrno();
+    }
+    if (written) {
+        *written = static_cast<DWORD>(result);
+    }
+    return TRUE;
+}
+
+inline BOOL FlushFileBuffers(HANDLE handle) {
+    int fd = win32_stub::FileDescriptor(handle);
+    return fd >= 0 && ::fsync(fd) == 0 ? TRUE : win32_stub::FailErrno();
+}
+
+inline BOOL GetFileSizeEx(HANDLE handle, LARGE_INTEGER* size) {
+    struct stat info = {};
+    int fd = win32_stub::FileDescriptor(handle);
+    if (fd < 0 || ::fstat(fd, &info) != 0) {
+        return win32_stub::FailErrno();
+    }
+    size->QuadPart = info.st_size;
+    return TRUE;
+}
+
+inline BOOL SetFilePointerEx(HANDLE handle, LARGE_INTEGER distance, LARGE_INTEGER* newPosition, DWORD method) {
+    int whence = method == FILE_END ? SEEK_END : method == FILE_CURRENT ? SEEK_CUR : SEEK_SET;
+    off_t position = ::lseek(win32_stub::FileDescriptor(handle), static_cast<off_t>(distance.QuadPart), whence);
+    if (position < 0) {
+        return win32_stub::FailErrno();
+    }
+    if (newPosition) {
+        newPosition->QuadPart = position;
+    }
+    return TRUE;
+}
+
+inline BOOL SetEndOfFile(HANDLE handle) {
+    int fd = win32_stub::FileDescriptor(handle);
+    off_t position = ::lseek(fd, 0, SEEK_CUR);
+    return position >= 0 && ::ftruncate(fd, position) == 0 ? TRUE : win32_stub::FailErrno();
+}
+
+inline BOOL DeleteFileW(LPCWSTR path) {
+    return ::unlink(win32_stub::ToPosixPath(path).c_str()) == 0 ? TRUE : win32_stub::FailErrno();
+}
+
+inline BOOL MoveFileExW(LPCWSTR from, LPCWSTR to, DWORD flags) {
+    std::string target = win32_stub::ToPosixPath(to);
+    struct stat info = {};
+    if (!(flags & MOVEFILE_REPLACE_EXISTING) && ::stat(target.c_str(), &info) == 0) {
+        return win32_stub::Fail(ERROR_ALREADY_EXISTS);
+    }
+    return ::rename(win32_stub::ToPosixPath(from).c_str(), target.c_str()) == 0 ? TRUE : win32_stub::FailErrno();
+}
+
+inline BOOL CreateDirectoryW(LPCWSTR path, void* /*security*/) {
+    return ::mkdir(win32_stub::ToPosixPath(path).c_str(), 0755) == 0 ? TRUE : win32_stub::FailErrno();
+}
+
+inline BOOL RemoveDirectoryW(LPCWSTR path) {
+    return ::rmdir(win32_stub::ToPosixPath(path).c_str()) == 0 ? TRUE : win32_stub::FailErrno();
+}
+
+inline DWORD GetFileAttributesW(LPCWSTR path) {
+    struct stat info = {};
+    if (::stat(win32_stub::ToPosixPath(path).c_str(), &info) != 0) {
+        win32_stub::FailErrno();
+        return INVALID_FILE_ATTRIBUTES;
+    }
+    return S_ISDIR(info.st_mode) ? FILE_ATTRIBUTE_DIRECTORY : FILE_ATTRIBUTE_NORMAL;
+}
+
+inline BOOL GetFileAttributesExW(LPCWSTR path, GET_FILEEX_INFO_LEVELS /*level*/, LPVOID result) {
+    struct stat info = {};
+    if (::stat(win32_stub::ToPosixPath(path).c_str(), &info) != 0) {
+        return win32_stub::FailErrno();
+    }
+    auto* data = static_cast<WIN32_FILE_ATTRIBUTE_DATA*>(result);
+    memset(data, 0, sizeof(*data));
+    data->dwFileAttributes = S_ISDIR(info.st_mode) ? FILE_ATTRIBUTE_DIRECTORY : FILE_ATTRIBUTE_NORMAL;
+    data->nFileSizeHigh = static_cast<DWORD>(static_cast<ULONGLONG>(info.st_size) >> 32);
+    data->nFileSizeLow = static_cast<DWORD>(info.st_size);
+    data->ftLastWriteTime = win32_stub::ToFileTime(info.st_mtim);
+    return TRUE;
+}
+
+// "폴더\\패턴" 형식의 와일드카드 열거 (., .. 포함)
+inline HANDLE FindFirstFileW(LPCWSTR pattern, WIN32_FIND_DATAW* data) {
+    std::string path = win32_stub::ToPosixPath(pattern);
+    size_t separator = path.find_last_of('/');
+    std::string directory = separator == std::string::npos ? "." : path.substr(0, separator);
+    DIR* handle = ::opendir(directory.c_str());
+    if (!handle) {
+        win32_stub::FailErrno();
+        return INVALID_HANDLE_VALUE;
+    }
+    auto* find = new win32_stub::Object{ win32_stub::Object::Find };
+    find->directory = handle;
+    find->directoryPath = directory;
+    find->pattern = separator == std::string::npos ? path : path.substr(separator + 1);
+    bool found = win32_stub::NextFindEntry(find, data);
+    if (!found) {
+        ::closedir(handle);
+        delete find;
+        win32_stub::Fail(ERROR_FILE_NOT_FOUND);
+        return INVALID_HANDLE_VALUE;
+    }
+    return find;
+}
+
+inline BOOL FindNextFileW(HANDLE handle, WIN32_FIND_DATAW* data) {
+    win32_stub::Object* find = win32_stub::FromHandle(handle);
+    if (!find || find->kind != win32_stub::Object::Find) {
+        return win32_stub::Fail(ERROR_INVALID_HANDLE);
+    }
+    bool found = win32_stub::NextFindEntry(find, data);
+    return found ? TRUE : win32_stub::Fail(18 /* ERROR_NO_MORE_FILES */);
+}
+
+inline BOOL FindClose(HANDLE handle) {
+    win32_stub::Object* find = win32_stub::FromHandle(handle);
+    if (!find || find->kind != win32_stub::Object::Find) {
+        return win32_stub::Fail(ERROR_INVALID_HANDLE);
+    }
+    ::closedir(find->directory);
+    delete find;
+    return TRUE;
+}
+
+inline HANDLE CreateFileMappingW(HANDLE file, void* /*security*/, DWORD /*protect*/, DWORD sizeHigh, DWORD sizeLow, LPCWSTR /*name*/) {
+    int fd = win32_stub::FileDescriptor(file);
+    struct stat info = {};
+    if (fd < 0 || ::fstat(fd, &info) != 0) {
+        win32_stub::FailErrno();
+        return nullptr;
+    }
+    ULONGLONG size = (static_cast<ULONGLONG>(sizeHigh) << 32) | sizeLow;
+    if (size == 0) {
+        size = static_cast<ULONGLONG>(info.st_size);
+    }
+    if (size == 0) {
+        win32_stub::Fail(ERROR_FILE_INVALID);  // 빈 파일은 매핑할 수 없음
+        return nullptr;
+    }
+    auto* mapping = new win32_stub::Object{ win32_stub::Object::Mapping };
+    mapping->fd = ::dup(fd);
+    mapping->mappingSize = size;
+    return mapping;
+}
+
+inline LPVOID MapViewOfFile(HANDLE mapping, DWORD access, DWORD offsetHigh, DWORD offsetLow, SIZE_T bytes) {
+    win32_stub::Object* object = win32_stub::FromHandle(mapping);
+    if (!object || object->kind != win32_stub::Object::Mapping) {
+        win32_stub::Fail(ERROR_INVALID_HANDLE);
+        return nullptr;
+    }
+    ULONGLONG offset = (static_cast<ULONGLONG>(offsetHigh) << 32) | offsetLow;
+    size_t length = bytes != 0 ? bytes : static_cast<size_t>(object->mappingSize - offset);
+    int protection = (access & FILE_MAP_WRITE) ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* view = ::mmap(nullptr, length, protection, MAP_SHARED, object->fd, static_cast<off_t>(offset));
+    if (view == MAP_FAILED) {
+        win32_stub::FailErrno();
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(win32_stub::ViewMutex());
+    win32_stub::Views()[view] = length;
+    return view;
+}
+
+inline BOOL UnmapViewOfFile(LPCVOID view) {
+    size_t length = 0;
+    {
+        std::lock_guard<std::mutex> lock(win32_stub::ViewMutex());
+        auto found = win32_stub::Views().find(view);
+        if (found == win32_stub::Views().end()) {
+            return win32_stub::Fail(ERROR_INVALID_PARAMETER);
+        }
+        length = found->second;
+        win32_stub::Views().erase(found);
+    }
+    ::munmap(const_cast<void*>(view), length);
+    return TRUE;
+}
+
+inline LPVOID VirtualAlloc(LPVOID /*address*/, SIZE_T size, DWORD /*type*/, DWORD /*protect*/) {
+    void* memory = nullptr;
+    if (::posix_memalign(&memory, 4096, size == 0 ? 4096 : size) != 0) {
+        win32_stub::Fail(ERROR_NOT_ENOUGH_MEMORY);
+        return nullptr;
+    }
+    return memory;
+}
+
+inline BOOL VirtualFree(LPVOID address, SIZE_T /*size*/, DWORD /*type*/) {
+    ::free(address);
+    return TRUE;
+}
+
+inline HANDLE GetProcessHeap() { return reinterpret_cast<HANDLE>(1); }
+inline LPVOID HeapAlloc(HANDLE, DWORD, SIZE_T size) { return ::malloc(size); }
+inline BOOL HeapFree(HANDLE, DWORD, LPVOID memory) { ::free(memory); return TRUE; }
+
+inline void GetSystemInfo(SYSTEM_INFO* info) {
+    info->dwPageSize = static_cast<DWORD>(::sysconf(_SC_PAGESIZE));
+    info->dwAllocationGranularity = 65536;
+    info->dwNumberOfProcessors = static_cast<DWORD>(::sysconf(_SC_NPROCESSORS_ONLN));
+}
+
+inline DWORD GetEnvironmentVariableW(LPCWSTR name, LPWSTR buffer, DWORD size) {
+    const char* value = ::getenv(win32_stub::Narrow(name, wcslen(name)).c_str());
+    if (!value) {
+        win32_stub::Fail(203 /* ERROR_ENVVAR_NOT_FOUND */);
+        return 0;
+    }
+    std::wstring wide = win32_stub::Widen(value, strlen(value));
+    if (wide.size() + 1 > size) {
+        return static_cast<DWORD>(wide.size() + 1);
+    }
+    wcscpy(buffer, wide.c_str());
+    return static_cast<DWORD>(wide.size());
+}
+
+inline BOOL QueryPerformanceCounter(LARGE_INTEGER* counter) {
+    struct timespec now = {};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    counter->QuadPart = static_cast<LONGLONG>(now.tv_sec) * 1000000000LL + now.tv_nsec;
+    return TRUE;
+}
+
+inline BOOL QueryPerformanceFrequency(LARGE_INTEGER* frequency) {
+    frequency->QuadPart = 1000000000LL;
+    return TRUE;
+}
+
+inline void GetSystemTimePreciseAsFileTime(FILETIME* time) {
+    struct timespec now = {};
+    clock_gettime(CLOCK_REALTIME, &now);
+    *time = win32_stub::ToFileTime(now);
+}
+
+inline void GetSystemTimeAsFileTime(FILETIME* time) { GetSystemTimePreciseAsFileTime(time); }
+
+inline BOOL FileTimeToLocalFileTime(const FILETIME* time, FILETIME* localTime) {
+    *localTime = *time;
+    return TRUE;
+}
+
+inline BOOL FileTimeToSystemTime(const FILETIME* time, SYSTEMTIME* systemTime) {
+    ULONGLONG ticks = (static_cast<ULONGLONG>(time->dwHighDateTime) << 32) | time->dwLowDateTime;
+    time_t seconds = static_cast<time_t>((ticks - 116444736000000000ull) / 10000000ull);
+    struct tm parts = {};
+    gmtime_r(&seconds, &parts);
+    systemTime->wYear = static_cast<WORD>(parts.tm_year + 1900);
+    systemTime->wMonth = static_cast<WORD>(parts.tm_mon + 1);
+    systemTime->wDayOfWeek = static_cast<WORD>(parts.tm_wday);
+    systemTime->wDay = static_cast<WORD>(parts.tm_mday);
+    systemTime->wHour = static_cast<WORD>(parts.tm_hour);
+    systemTime->wMinute = static_cast<WORD>(parts.tm_min);
+    systemTime->wSecond = static_cast<WORD>(parts.tm_sec);
+    systemTime->wMilliseconds = static_cast<WORD>(ticks / 10000 % 1000);
+    return TRUE;
+}
+
+inline DWORD GetCurrentThreadId() { return static_cast<DWORD>(::syscall(SYS_gettid)); }
+inline DWORD GetCurrentProcessId() { return static_cast<DWORD>(::getpid()); }
+inline HANDLE GetCurrentThread() { return reinterpret_cast<HANDLE>(-2); }
+inline BOOL SetThreadPriority(HANDLE, int) { return TRUE; }
+inline void Sleep(DWORD milliseconds) { ::usleep(static_cast<useconds_t>(milliseconds) * 1000); }
+
+inline HMODULE LoadLibraryW(LPCWSTR) { return nullptr; }
+inline FARPROC GetProcAddress(HMODULE, const char*) { return nullptr; }
+
+inline int WideCharToMultiByte(unsigned /*codePage*/, DWORD /*flags*/, const wchar_t* text, int length, char* output, int capacity,
+                               const char* /*defaultChar*/, BOOL* /*usedDefault*/) {
+    std::string utf8 = win32_stub::Narrow(text, length < 0 ? wcslen(text) + 1 : static_cast<size_t>(length));
+    if (capacity == 0) {
+        return static_cast<int>(utf8.size());
+    }
+    if (utf8.size() > static_cast<size_t>(capacity)) {
+        win32_stub::Fail(ERROR_INSUFFICIENT_BUFFER);
+        return 0;
+    }
+    memcpy(output, utf8.data(), utf8.size());
+    return static_cast<int>(utf8.size());
+}
+
+inline int MultiByteToWideChar(unsigned /*codePage*/, DWORD /*flags*/, const char* text, int length, wchar_t* output, int capacity) {
+    std::wstring wide = win32_stub::Widen(text, length < 0 ? strlen(text) + 1 : static_cast<size_t>(length));
+    if (capacity == 0) {
+        return static_cast<int>(wide.size());
+    }
+    if (wide.size() > static_cast<size_t>(capacity)) {
+        win32_stub::Fail(ERROR_INSUFFICIENT_BUFFER);
+        return 0;
+    }
+    wmemcpy(output, wide.data(), wide.size());
+    return static_cast<int>(wide.size());
+}
+
+inline int _wcsnicmp(const wchar_t* a, const wchar_t* b, size_t count) { return wcsncasecmp(a, b, count); }
+inline int _wcsicmp(const wchar_t* a, const wchar_t* b) { return wcscasecmp(a, b); }
+inline int wcscpy_s(wchar_t* destination, size_t size, const wchar_t* source) {
+    if (wcslen(source) + 1 > size) {
+        return ERANGE;
+    }
+    wcscpy(destination, source);
+    return 0;
+}
+inline int wmemcpy_s(wchar_t* destination, size_t size, const wchar_t* source, size_t count) {
+    if (count > size) {
+        return ERANGE;
+    }
+    wmemcpy(destination, source, count);
+    return 0;
+}
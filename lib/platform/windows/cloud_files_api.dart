@@ -4,6 +4,7 @@
 import 'dart:ffi';
 import 'dart:io';
 import 'package:ffi/ffi.dart';
+import '../../utils/file_utils.dart';
 import '../../utils/logger.dart';
 
 /// Windows Cloud Files API (CFAPI)를 Dart에서 사용하기 위한 래퍼
@@ -110,6 +111,8 @@ class WindowsCloudFilesAPI {
   }
 
   /// 플레이스홀더 생성
+  /// [metadata]에 fileTreeHash가 있으면 그 블록 매니페스트 ID를 플레이스홀더 ID에 넣어 하이드레이션 데이터를 검증받음
+  /// 콘텐츠 버전은 version이나 파일 해시에서 얻어 내용이 바뀌면 provider 캐시를 새로 받음
   Future<void> createPlaceholder({
     required String relativePath,
     required int fileSize,
@@ -120,8 +123,9 @@ class WindowsCloudFilesAPI {
     try {
       final placeholderInfo = calloc<CF_PLACEHOLDER_CREATE_INFO>();
       placeholderInfo.ref.RelativeFileName = relativePath.toNativeUtf16();
-      placeholderInfo.ref.FileIdentity = _generateFileIdentity(relativePath);
-      placeholderInfo.ref.FileIdentityLength = 128;
+      final identity = _generateFileIdentity(relativePath, metadata);
+      placeholderInfo.ref.FileIdentity = identity;
+      placeholderInfo.ref.FileIdentityLength = _fileIdentitySize;
 
       // 파일 정보 설정
       final fsInfo = calloc<CF_FS_METADATA>();
@@ -150,6 +154,7 @@ class WindowsCloudFilesAPI {
       // 메모리 해제
       calloc.free(placeholderInfo);
       calloc.free(fsInfo);
+      calloc.free(identity);
     } catch (e) {
       _logger.error('플레이스홀더 생성 실패', e);
       rethrow;
@@ -160,6 +165,7 @@ class WindowsCloudFilesAPI {
   Future<void> hydrateFile({
     required String relativePath,
     required Stream<List<int>> dataStream,
+    required int fileSize,
     required void Function(double) onProgress,
   }) async {
     try {
@@ -177,25 +183,41 @@ class WindowsCloudFilesAPI {
       }
 
       // 데이터 전송
+      // 셸 진행 표시줄(CfReportProviderProgress)과 앱 콜백을 함께 갱신하되,
+      // 네이티브 ProgressThrottle과 같이 처음과 마지막은 항상, 그 사이는 초당 최대 _maxProgressUpdatesPerSecond회
       int totalBytes = 0;
-      await for (var chunk in dataStream) {
-        final buffer = calloc<Uint8>(chunk.length);
-        for (int i = 0; i < chunk.length; i++) {
-          buffer[i] = chunk[i];
+      final progressTimer = Stopwatch()..start();
+      int lastProgressMs = -_progressIntervalMs;
+      // 청크마다 할당하지 않고 하나의 전송 버퍼를 재사용 (더 큰 청크가 올 때만 키움)
+      Pointer<Uint8> buffer = nullptr;
+      int bufferSize = 0;
+      try {
+        await for (var chunk in dataStream) {
+          if (chunk.length > bufferSize) {
+            if (buffer != nullptr) {
+              calloc.free(buffer);
+            }
+            bufferSize = chunk.length;
+            buffer = calloc<Uint8>(bufferSize);
+          }
+          buffer.asTypedList(chunk.length).setAll(0, chunk);
+
+          totalBytes += chunk.length;
+          final elapsedMs = progressTimer.elapsedMilliseconds;
+          if (elapsedMs - lastProgressMs >= _progressIntervalMs) {
+            lastProgressMs = elapsedMs;
+            _reportProgress(transferKey.ref.value, totalBytes, fileSize, onProgress);
+          }
+        }
+      } finally {
+        if (buffer != nullptr) {
+          calloc.free(buffer);
         }
-
-        CfReportProviderProgress(
-          transferKey.ref.value,
-          totalBytes,
-          chunk.length,
-        );
-
-        totalBytes += chunk.length;
-        onProgress(totalBytes / 100.0); // 임시 진행률
-
-        calloc.free(buffer);
       }
 
+      // 마지막 진행률은 항상 전달
+      _reportProgress(transferKey.ref.value, totalBytes, fileSize, onProgress);
+
       // 하이드레이션 완료
       CfSetInSyncState(
         _getFileHandle(relativePath),
@@ -212,6 +234,23 @@ class WindowsCloudFilesAPI {
     }
   }
 
+  static const int _maxProgressUpdatesPerSecond = 4;
+  static const int _progressIntervalMs = 1000 ~/ _maxProgressUpdatesPerSecond;
+
+  void _reportProgress(int transferKey, int transferred, int fileSize,
+      void Function(double) onProgress) {
+    final total = fileSize > 0 ? fileSize : transferred;
+    CfReportProviderProgress(transferKey, total, transferred);
+    onProgress(_progressFraction(transferred, fileSize));
+  }
+
+  double _progressFraction(int transferred, int fileSize) {
+    if (fileSize <= 0) {
+      return 1.0;
+    }
+    return (transferred / fileSize).clamp(0.0, 1.0).toDouble();
+  }
+
   /// 동기화 상태 업데이트
   Future<void> updateSyncStatus({
     required String relativePath,
@@ -275,14 +314,31 @@ class WindowsCloudFilesAPI {
     return guid.cast<CF_PROVIDER_ID>();
   }
 
-  /// 파일 ID 생성
-  Pointer<Uint8> _generateFileIdentity(String relativePath) {
-    final identity = calloc<Uint8>(128);
-    final hash = relativePath.hashCode;
+  /// 플레이스홀더 ID 크기 (PlaceholderIdentity.h의 kPlaceholderIdentitySize)
+  static const int _fileIdentitySize = 48;
 
-    // 간단한 해시 기반 ID 생성
+  /// 파일 ID 생성 (네이티브 PlaceholderIdentity 형식)
+  /// 형식 1바이트(1), 예약 7바이트, 객체 ID 16바이트, 콘텐츠 버전 8바이트, 매니페스트 ID 16바이트
+  Pointer<Uint8> _generateFileIdentity(String relativePath, Map<String, dynamic> metadata) {
+    final identity = calloc<Uint8>(_fileIdentitySize);
+    final objectId = FileUtils.placeholderObjectId(relativePath);
+    final contentVersion = FileUtils.placeholderContentVersion(metadata);
+    final fileTreeHash = metadata['fileTreeHash'] ?? metadata['fileHash'];
+    final manifestId =
+        fileTreeHash is String ? FileUtils.manifestIdFromHash(fileTreeHash) : null;
+
+    identity[0] = 1;
     for (int i = 0; i < 16; i++) {
-      identity[i] = (hash >> (i * 2)) & 0xFF;
+      identity[8 + i] = objectId[i];
+    }
+    // 콘텐츠 버전은 리틀 엔디언
+    for (int i = 0; i < 8; i++) {
+      identity[24 + i] = (contentVersion >> (i * 8)) & 0xFF;
+    }
+    if (manifestId != null) {
+      for (int i = 0; i < 16; i++) {
+        identity[32 + i] = manifestId[i];
+      }
     }
 
     return identity;
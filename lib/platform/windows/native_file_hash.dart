@@ -0,0 +1,142 @@
+/// 네이티브 파일 해시
+/// MbdHashFileTree(C ABI)로 4MB 블록별 SHA-256을 여러 스레드에서 계산해 트리 해시 루트를 얻음
+/// 호출하는 동안 스레드가 막히므로 UI isolate가 아닌 곳에서 호출 (FileUtils는 Isolate.run 사용)
+/// MbdPublishBlockManifest는 같은 해시의 블록 목록을 provider의 검증 매니페스트로도 저장함
+
+import 'dart:ffi';
+import 'dart:io';
+import 'package:ffi/ffi.dart';
+import '../../utils/logger.dart';
+
+/// FileHashApi.h의 MbdFileTreeHash
+final class MbdFileTreeHash extends Struct {
+  @Uint32()
+  external int structSize;
+  @Uint32()
+  external int blockSize;
+  @Uint64()
+  external int fileSize;
+  @Uint64()
+  external int blockCount;
+  @Array(32)
+  external Array<Uint8> root;
+  @Array(16)
+  external Array<Uint8> manifestId;
+}
+
+typedef _MbdHashFileTreeNative = Int32 Function(Pointer<Utf16>, Uint32, Pointer<MbdFileTreeHash>);
+typedef _MbdHashFileTreeDart = int Function(Pointer<Utf16>, int, Pointer<MbdFileTreeHash>);
+typedef _MbdHashFileSha256Native = Int32 Function(Pointer<Utf16>, Pointer<Uint8>);
+typedef _MbdHashFileSha256Dart = int Function(Pointer<Utf16>, Pointer<Uint8>);
+
+/// 로드한 export의 함수 주소
+/// 정수라 Isolate.run 클로저로 넘길 수 있고, 받은 isolate는 DLL을 다시 찾지 않고 주소로 바로 호출함
+final class NativeFileHashFunctions {
+  final int hashFileTree;
+  final int publishBlockManifest;
+  final int hashFileSha256;
+
+  const NativeFileHashFunctions({
+    required this.hashFileTree,
+    required this.publishBlockManifest,
+    required this.hashFileSha256,
+  });
+}
+
+/// 네이티브 파일 해시 (provider가 로드되지 않았거나 Windows가 아니면 사용할 수 없음)
+/// DLL은 처음 사용한 isolate에서 한 번만 찾고, 계산은 주소를 받은 정적 함수가 어느 isolate에서든 수행
+class NativeFileHasher {
+  static NativeFileHasher? _instance;
+  static NativeFileHasher get instance => _instance ??= NativeFileHasher._();
+
+  static const String _libraryName = 'CloudFilesProvider.dll';
+  static const int _sFalse = 1;
+
+  static final Logger _logger = Logger('NativeFileHasher');
+  NativeFileHashFunctions? _functions;
+  bool _loadAttempted = false;
+
+  NativeFileHasher._();
+
+  bool get isAvailable => _ensureLoaded();
+
+  /// export 주소 (사용할 수 없으면 null)
+  NativeFileHashFunctions? get functions => _ensureLoaded() ? _functions : null;
+
+  /// 트리 해시 루트 (16진수, 실패하면 null)
+  /// [threads]가 0이면 코어 수 (최대 8)
+  /// [publishManifest]면 블록 해시를 provider의 검증 매니페스트로 저장 (검증이 꺼져 있어 저장하지 못해도 해시는 돌려줌)
+  static String? hashFileTree(NativeFileHashFunctions functions, String path,
+      {int threads = 0, bool publishManifest = false}) {
+    final function = Pointer<NativeFunction<_MbdHashFileTreeNative>>.fromAddress(
+            publishManifest ? functions.publishBlockManifest : functions.hashFileTree)
+        .asFunction<_MbdHashFileTreeDart>();
+
+    final nativePath = path.toNativeUtf16();
+    final result = calloc<MbdFileTreeHash>();
+    try {
+      result.ref.structSize = sizeOf<MbdFileTreeHash>();
+      final hr = function(nativePath, threads, result);
+      if (hr < 0) {
+        _logger.warning('트리 해시 실패: $path (0x${hr.toUnsigned(32).toRadixString(16)})');
+        return null;
+      }
+      if (publishManifest && hr == _sFalse) {
+        _logger.debug('블록 매니페스트를 저장하지 않음: $path');
+      }
+      return _toHex(List<int>.generate(32, (i) => result.ref.root[i]));
+    } finally {
+      calloc.free(result);
+      calloc.free(nativePath);
+    }
+  }
+
+  /// 파일 전체의 SHA-256 (16진수, 실패하면 null)
+  static String? hashFileSha256(NativeFileHashFunctions functions, String path) {
+    final function = Pointer<NativeFunction<_MbdHashFileSha256Native>>.fromAddress(functions.hashFileSha256)
+        .asFunction<_MbdHashFileSha256Dart>();
+
+    final nativePath = path.toNativeUtf16();
+    final digest = calloc<Uint8>(32);
+    try {
+      final hr = function(nativePath, digest);
+      if (hr < 0) {
+        _logger.warning('SHA-256 계산 실패: $path (0x${hr.toUnsigned(32).toRadixString(16)})');
+        return null;
+      }
+      return _toHex(digest.asTypedList(32));
+    } finally {
+      calloc.free(digest);
+      calloc.free(nativePath);
+    }
+  }
+
+  static String _toHex(List<int> bytes) =>
+      bytes.map((b) => b.toRadixString(16).padLeft(2, '0')).join();
+
+  bool _ensureLoaded() {
+    if (_functions != null) return true;
+    if (_loadAttempted || !Platform.isWindows) return false;
+    _loadAttempted = true;
+
+    // provider가 실행 파일에 링크된 경우를 먼저 확인하고 없으면 DLL을 찾음
+    for (final open in [DynamicLibrary.process, () => DynamicLibrary.open(_libraryName)]) {
+      try {
+        final library = open();
+        if (!library.providesSymbol('MbdHashFileTree')) continue;
+        _functions = NativeFileHashFunctions(
+          hashFileTree: library.lookup<NativeFunction<_MbdHashFileTreeNative>>('MbdHashFileTree').address,
+          publishBlockManifest:
+              library.lookup<NativeFunction<_MbdHashFileTreeNative>>('MbdPublishBlockManifest').address,
+          hashFileSha256: library.lookup<NativeFunction<_MbdHashFileSha256Native>>('MbdHashFileSha256').address,
+        );
+        return true;
+      } catch (_) {
+        continue;
+      }
+    }
+
+    _logger.info('네이티브 파일 해시를 사용할 수 없음');
+    return false;
+  }
+}
@@ -0,0 +1,347 @@
+/// 네이티브 Cloud Files provider 지표
+/// MbdGetMetricsSnapshot(C ABI)으로 콜백 지연 시간, 첫 바이트까지 시간, 전송량, 큐 깊이를 읽음
+/// MbdDumpTrace로 하이드레이션 추적을 Chrome trace JSON으로 저장
+
+import 'dart:ffi';
+import 'dart:io';
+import 'package:ffi/ffi.dart';
+import '../../utils/logger.dart';
+
+/// ProviderMetricsApi.h의 MbdLatencySummary (나노초)
+final class MbdLatencySummary extends Struct {
+  @Uint64()
+  external int count;
+  @Uint64()
+  external int meanNs;
+  @Uint64()
+  external int p50Ns;
+  @Uint64()
+  external int p90Ns;
+  @Uint64()
+  external int p99Ns;
+  @Uint64()
+  external int p999Ns;
+  @Uint64()
+  external int maxNs;
+}
+
+/// ProviderMetricsApi.h의 MbdMetricsSnapshot
+final class MbdMetricsSnapshot extends Struct {
+  @Uint32()
+  external int structSize;
+  @Uint32()
+  external int version;
+
+  external MbdLatencySummary fetchData;
+  external MbdLatencySummary validateData;
+  external MbdLatencySummary cancelFetchData;
+  external MbdLatencySummary fetchPlaceholders;
+  external MbdLatencySummary notifications;
+  external MbdLatencySummary timeToFirstByte;
+  external MbdLatencySummary queueWait;
+  external MbdLatencySummary download;
+
+  @Uint64()
+  external int bytesTransferred;
+  @Uint64()
+  external int fetchRequests;
+  @Uint64()
+  external int downloadsStarted;
+  @Uint64()
+  external int downloadsCompleted;
+  @Uint64()
+  external int downloadsFailed;
+  @Uint64()
+  external int downloadsCancelled;
+
+  @Uint32()
+  external int queueDepth;
+  @Uint32()
+  external int activeWorkers;
+  @Uint32()
+  external int workerCount;
+  @Uint32()
+  external int inFlightFetches;
+  @Double()
+  external double workerUtilization;
+  @Uint64()
+  external int workerBusyMs;
+
+  // 버전 2
+  external MbdLatencySummary placeholderBatch;
+  @Uint64()
+  external int placeholdersCreated;
+  @Uint64()
+  external int transferPoolBytes;
+  @Uint64()
+  external int transferBytesInUse;
+
+  // 버전 3
+  @Uint64()
+  external int bytesVerified;
+  @Uint64()
+  external int blocksFailedVerification;
+  @Uint64()
+  external int unverifiedValidations;
+}
+
+typedef _MbdGetMetricsSnapshotNative = Int32 Function(Pointer<MbdMetricsSnapshot>);
+typedef _MbdGetMetricsSnapshotDart = int Function(Pointer<MbdMetricsSnapshot>);
+typedef _MbdSetTracingEnabledNative = Void Function(Int32, Uint32);
+typedef _MbdSetTracingEnabledDart = void Function(int, int);
+typedef _MbdDumpTraceNative = Int32 Function(Pointer<Utf16>);
+typedef _MbdDumpTraceDart = int Function(Pointer<Utf16>);
+
+/// 지연 시간 분포 요약
+class LatencyStats {
+  final int count;
+  final Duration mean;
+  final Duration p50;
+  final Duration p90;
+  final Duration p99;
+  final Duration p999;
+  final Duration max;
+
+  LatencyStats._(MbdLatencySummary summary)
+      : count = summary.count,
+        mean = _fromNanoseconds(summary.meanNs),
+        p50 = _fromNanoseconds(summary.p50Ns),
+        p90 = _fromNanoseconds(summary.p90Ns),
+        p99 = _fromNanoseconds(summary.p99Ns),
+        p999 = _fromNanoseconds(summary.p999Ns),
+        max = _fromNanoseconds(summary.maxNs);
+
+  static Duration _fromNanoseconds(int nanoseconds) =>
+      Duration(microseconds: nanoseconds ~/ 1000);
+
+  Map<String, dynamic> toJson() => {
+        'count': count,
+        'meanUs': mean.inMicroseconds,
+        'p50Us': p50.inMicroseconds,
+        'p90Us': p90.inMicroseconds,
+        'p99Us': p99.inMicroseconds,
+        'p999Us': p999.inMicroseconds,
+        'maxUs': max.inMicroseconds,
+      };
+}
+
+/// 한 시점의 provider 지표
+class NativeProviderMetrics {
+  final LatencyStats fetchData;
+  final LatencyStats validateData;
+  final LatencyStats cancelFetchData;
+  final LatencyStats fetchPlaceholders;
+  final LatencyStats notifications;
+  final LatencyStats timeToFirstByte;
+  final LatencyStats queueWait;
+  final LatencyStats download;
+
+  final int bytesTransferred;
+  final int fetchRequests;
+  final int downloadsStarted;
+  final int downloadsCompleted;
+  final int downloadsFailed;
+  final int downloadsCancelled;
+
+  final int queueDepth;
+  final int activeWorkers;
+  final int workerCount;
+  final int inFlightFetches;
+  final double workerUtilization;
+  final Duration workerBusyTime;
+
+  final LatencyStats placeholderBatch;
+  final int placeholdersCreated;
+  final int transferPoolBytes;
+  final int transferBytesInUse;
+
+  final int bytesVerified;
+  final int blocksFailedVerification;
+  final int unverifiedValidations;
+
+  NativeProviderMetrics._(MbdMetricsSnapshot snapshot)
+      : fetchData = LatencyStats._(snapshot.fetchData),
+        validateData = LatencyStats._(snapshot.validateData),
+        cancelFetchData = LatencyStats._(snapshot.cancelFetchData),
+        fetchPlaceholders = LatencyStats._(snapshot.fetchPlaceholders),
+        notifications = LatencyStats._(snapshot.notifications),
+        timeToFirstByte = LatencyStats._(snapshot.timeToFirstByte),
+        queueWait = LatencyStats._(snapshot.queueWait),
+        download = LatencyStats._(snapshot.download),
+        bytesTransferred = snapshot.bytesTransferred,
+        fetchRequests = snapshot.fetchRequests,
+        downloadsStarted = snapshot.downloadsStarted,
+        downloadsCompleted = snapshot.downloadsCompleted,
+        downloadsFailed = snapshot.downloadsFailed,
+        downloadsCancelled = snapshot.downloadsCancelled,
+        queueDepth = snapshot.queueDepth,
+        activeWorkers = snapshot.activeWorkers,
+        workerCount = snapshot.workerCount,
+        inFlightFetches = snapshot.inFlightFetches,
+        workerUtilization = snapshot.workerUtilization,
+        workerBusyTime = Duration(milliseconds: snapshot.workerBusyMs),
+        placeholderBatch = LatencyStats._(snapshot.placeholderBatch),
+        placeholdersCreated = snapshot.placeholdersCreated,
+        transferPoolBytes = snapshot.transferPoolBytes,
+        transferBytesInUse = snapshot.transferBytesInUse,
+        bytesVerified = snapshot.bytesVerified,
+        blocksFailedVerification = snapshot.blocksFailedVerification,
+        unverifiedValidations = snapshot.unverifiedValidations;
+
+  /// 플레이스홀더 생성/전송 처리량 (배치 시간 합 기준)
+  double get placeholdersPerSecond {
+    final totalMicros = placeholderBatch.mean.inMicroseconds * placeholderBatch.count;
+    return totalMicros > 0 ? placeholdersCreated * 1e6 / totalMicros : 0.0;
+  }
+
+  /// VALIDATE_DATA 블록 해시 검증 처리량 (콜백 시간 합 기준)
+  double get verifyBytesPerSecond {
+    final totalMicros = validateData.mean.inMicroseconds * validateData.count;
+    return totalMicros > 0 ? bytesVerified * 1e6 / totalMicros : 0.0;
+  }
+
+  /// 진행 중인 FETCH_DATA 요청 하나가 잡고 있는 전송 버퍼
+  int get bytesPerInFlightFetch =>
+      inFlightFetches > 0 ? transferBytesInUse ~/ inFlightFetches : 0;
+
+  Map<String, dynamic> toJson() => {
+        'callbacks': {
+          'fetchData': fetchData.toJson(),
+          'validateData': validateData.toJson(),
+          'cancelFetchData': cancelFetchData.toJson(),
+          'fetchPlaceholders': fetchPlaceholders.toJson(),
+          'notifications': notifications.toJson(),
+        },
+        'timeToFirstByte': timeToFirstByte.toJson(),
+        'queueWait': queueWait.toJson(),
+        'download': download.toJson(),
+        'bytesTransferred': bytesTransferred,
+        'fetchRequests': fetchRequests,
+        'downloadsStarted': downloadsStarted,
+        'downloadsCompleted': downloadsCompleted,
+        'downloadsFailed': downloadsFailed,
+        'downloadsCancelled': downloadsCancelled,
+        'queueDepth': queueDepth,
+        'activeWorkers': activeWorkers,
+        'workerCount': workerCount,
+        'inFlightFetches': inFlightFetches,
+        'workerUtilization': workerUtilization,
+        'workerBusyMs': workerBusyTime.inMilliseconds,
+        'placeholders': {
+          'batch': placeholderBatch.toJson(),
+          'created': placeholdersCreated,
+          'perSecond': placeholdersPerSecond,
+        },
+        'memory': {
+          'transferPoolBytes': transferPoolBytes,
+          'transferBytesInUse': transferBytesInUse,
+          'bytesPerInFlightFetch': bytesPerInFlightFetch,
+        },
+        'validation': {
+          'bytesVerified': bytesVerified,
+          'blocksFailed': blocksFailedVerification,
+          'unverified': unverifiedValidations,
+          'bytesPerSecond': verifyBytesPerSecond,
+        },
+      };
+}
+
+/// 네이티브 provider 지표 읽기
+/// 스냅샷 버퍼는 한 번만 할당해 재사용하므로 상태 타이머에서 자주 호출해도 부담이 적음
+class ProviderMetricsReader {
+  static ProviderMetricsReader? _instance;
+  static ProviderMetricsReader get instance =>
+      _instance ??= ProviderMetricsReader._();
+
+  static const String _libraryName = 'CloudFilesProvider.dll';
+
+  final Logger _logger = Logger('ProviderMetrics');
+  _MbdGetMetricsSnapshotDart? _getSnapshot;
+  _MbdSetTracingEnabledDart? _setTracingEnabled;
+  _MbdDumpTraceDart? _dumpTrace;
+  Pointer<MbdMetricsSnapshot> _snapshot = nullptr;
+  bool _loadAttempted = false;
+
+  ProviderMetricsReader._();
+
+  /// 현재 지표 (provider가 로드되지 않았으면 null)
+  NativeProviderMetrics? poll() {
+    if (!_ensureLoaded()) return null;
+
+    _snapshot.ref.structSize = sizeOf<MbdMetricsSnapshot>();
+    final result = _getSnapshot!(_snapshot);
+    if (result < 0) {
+      _logger.warning('provider 지표 읽기 실패: 0x${result.toUnsigned(32).toRadixString(16)}');
+      return null;
+    }
+    return NativeProviderMetrics._(_snapshot.ref);
+  }
+
+  /// 하이드레이션 추적 켜기/끄기 ([capacity]는 처음 켤 때의 이벤트 수, 0이면 기본값)
+  void setTracingEnabled(bool enabled, {int capacity = 0}) {
+    if (!_ensureLoaded() || _setTracingEnabled == null) return;
+    _setTracingEnabled!(enabled ? 1 : 0, capacity);
+  }
+
+  /// 추적 버퍼를 Chrome/Perfetto trace JSON으로 저장 (chrome://tracing, ui.perfetto.dev에서 열기)
+  bool dumpTrace(String path) {
+    if (!_ensureLoaded() || _dumpTrace == null) return false;
+
+    final nativePath = path.toNativeUtf16();
+    try {
+      final result = _dumpTrace!(nativePath);
+      if (result < 0) {
+        _logger.warning('추적 저장 실패: 0x${result.toUnsigned(32).toRadixString(16)}');
+        return false;
+      }
+      return true;
+    } finally {
+      calloc.free(nativePath);
+    }
+  }
+
+  bool _ensureLoaded() {
+    if (_getSnapshot != null) return true;
+    if (_loadAttempted || !Platform.isWindows) return false;
+    _loadAttempted = true;
+
+    // provider가 실행 파일에 링크된 경우를 먼저 확인하고 없으면 DLL을 찾음
+    for (final open in [DynamicLibrary.process, () => DynamicLibrary.open(_libraryName)]) {
+      try {
+        final library = open();
+        _getSnapshot = library
+            .lookup<NativeFunction<_MbdGetMetricsSnapshotNative>>('MbdGetMetricsSnapshot')
+            .asFunction<_MbdGetMetricsSnapshotDart>();
+        _snapshot = calloc<MbdMetricsSnapshot>();
+
+        // 추적 함수가 없는 이전 provider에서도 지표는 읽을 수 있게 함
+        if (library.providesSymbol('MbdDumpTrace')) {
+          _setTracingEnabled = library
+              .lookup<NativeFunction<_MbdSetTracingEnabledNative>>('MbdSetTracingEnabled')
+              .asFunction<_MbdSetTracingEnabledDart>();
+          _dumpTrace = library
+              .lookup<NativeFunction<_MbdDumpTraceNative>>('MbdDumpTrace')
+              .asFunction<_MbdDumpTraceDart>();
+        }
+        return true;
+      } catch (_) {
+        continue;
+      }
+    }
+
+    _logger.info('네이티브 provider 지표를 사용할 수 없음');
+    return false;
+  }
+
+  /// 스냅샷 버퍼 해제
+  void dispose() {
+    if (_snapshot != nullptr) {
+      calloc.free(_snapshot);
+      _snapshot = nullptr;
+    }
+    _getSnapshot = null;
+    _setTracingEnabled = null;
+    _dumpTrace = null;
+    _loadAttempted = false;
+  }
+}
@@ -10,21 +10,25 @@ class ConflictResolver {
   final Logger _logger = Logger('ConflictResolver');
 
   /// 충돌 감지
+  /// [remoteTreeHash](Firestore fileTreeHash)가 있으면 병렬로 계산되는 트리 해시로 비교하고,
+  /// 없으면 [remoteHash](fileHash)와 같은 형식으로 계산해 비교
   Future<ConflictType?> detectConflict(
     File localFile,
     String remoteHash,
-    DateTime remoteModified,
-  ) async {
+    DateTime remoteModified, {
+    String? remoteTreeHash,
+  }) async {
     if (!await localFile.exists()) {
       return null; // 로컬 파일이 없으면 충돌 없음
     }
 
-    // 로컬 파일 해시 계산
-    final localHash = await FileUtils.calculateFileHash(localFile);
+    final expectedHash = remoteTreeHash ?? remoteHash;
+    final localHash =
+        await FileUtils.calculateMatchingFileHash(localFile, expectedHash);
     final localModified = await localFile.lastModified();
 
     // 해시가 다르고 수정 시간도 다른 경우
-    if (localHash != remoteHash) {
+    if (localHash != expectedHash) {
       if (localModified.isAfter(remoteModified)) {
         return ConflictType.localNewer;
       } else if (remoteModified.isAfter(localModified)) {
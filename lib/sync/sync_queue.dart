@@ -207,7 +207,14 @@ class SyncQueue {
     // 파일 정보 추출
     final fileName = file.path.split(Platform.pathSeparator).last;
     final fileSize = await file.length();
-    final fileHash = await FileUtils.calculateFileHash(file);
+    // 트리 해시를 구하면서 블록 매니페스트도 저장해 나중에 이 파일을 다시 하이드레이션할 때 검증할 수 있게 함
+    // fileHash는 트리 해시를 모르는 이전 클라이언트를 위해 파일 전체 SHA-256을 그대로 저장
+    final hashes = await Future.wait([
+      FileUtils.calculateFileHash(file, publishManifest: true),
+      FileUtils.calculateLegacyFileHash(file),
+    ]);
+    final fileTreeHash = hashes[0];
+    final fileHash = hashes[1];
 
     // Storage 경로 생성
     String storagePath = '';
@@ -237,7 +244,7 @@ class SyncQueue {
     final downloadUrl = await ref.getDownloadURL();
 
     // Firestore 업데이트
-    await _updateFirestore(task, downloadUrl, fileSize, fileHash);
+    await _updateFirestore(task, downloadUrl, fileSize, fileHash, fileTreeHash);
   }
 
   /// 파일 다운로드
@@ -264,6 +271,13 @@ class SyncQueue {
       // 작은 파일은 한 번에 다운로드
       await ref.writeToFile(file);
     }
+
+    // 받은 파일의 블록 매니페스트 저장 (실패해도 다운로드는 완료로 처리)
+    try {
+      await FileUtils.publishBlockManifest(file);
+    } catch (e) {
+      _logger.warning('블록 매니페스트 저장 실패: ${task.localPath} - $e');
+    }
   }
 
   /// 청크 단위 다운로드
@@ -347,6 +361,7 @@ class SyncQueue {
     String downloadUrl,
     int fileSize,
     String fileHash,
+    String fileTreeHash,
   ) async {
     final fileName = task.localPath.split(Platform.pathSeparator).last;
     final now = FieldValue.serverTimestamp();
@@ -361,6 +376,7 @@ class SyncQueue {
         'duration': 0, // TODO: 오디오 파일 길이 계산
         'fileSize': fileSize,
         'fileHash': fileHash,
+        'fileTreeHash': fileTreeHash,
         'createdAt': now,
         'updatedAt': now,
       };
@@ -3,21 +3,162 @@
 
 import 'dart:io';
 import 'dart:convert';
+import 'dart:isolate';
+import 'dart:math';
+import 'dart:typed_data';
 import 'package:crypto/crypto.dart';
 import '../config/drive_config.dart';
+import '../platform/windows/native_file_hash.dart';
 
 class FileUtils {
-  /// 파일 해시 계산 (SHA-256)
-  static Future<String> calculateFileHash(File file) async {
+  /// 트리 해시 접두사 (접두사가 없는 해시는 이전 형식인 파일 전체 SHA-256)
+  static const String treeHashPrefix = 'sha256t:';
+
+  /// 트리 해시 블록 크기 (provider 블록 매니페스트와 같은 4MB)
+  static const int hashBlockSize = 4 * 1024 * 1024;
+
+  static bool isTreeHash(String hash) => hash.startsWith(treeHashPrefix);
+
+  /// 트리 해시의 블록 매니페스트 ID (루트 앞 16바이트, 플레이스홀더 ID에 저장)
+  /// 이전 형식 해시면 null
+  static Uint8List? manifestIdFromHash(String hash) {
+    if (!isTreeHash(hash)) return null;
+    final hex = hash.substring(treeHashPrefix.length);
+    if (hex.length < 32) return null;
+    return Uint8List.fromList(List<int>.generate(
+        16, (i) => int.parse(hex.substring(i * 2, i * 2 + 2), radix: 16)));
+  }
+
+  /// 플레이스홀더 객체 ID (네이티브 PlaceholderIdentity::FromPath와 같은 값)
+  /// 소문자, '/'를 '\'로, 앞 구분자를 뺀 경로의 UTF-16LE SHA-256 앞 16바이트
+  static Uint8List placeholderObjectId(String relativePath) {
+    final normalized = relativePath
+        .replaceAll('/', '\\')
+        .replaceFirst(RegExp(r'^\\+'), '')
+        .toLowerCase();
+    final bytes = Uint8List(normalized.length * 2);
+    for (var i = 0; i < normalized.length; i++) {
+      final unit = normalized.codeUnitAt(i);
+      bytes[i * 2] = unit & 0xFF;
+      bytes[i * 2 + 1] = unit >> 8;
+    }
+    return Uint8List.fromList(sha256.convert(bytes).bytes.sublist(0, 16));
+  }
+
+  /// 플레이스홀더 콘텐츠 버전 (provider 캐시 키라 내용이 바뀌면 달라져야 함)
+  /// 정수 version이 있으면 그 값, 없으면 파일 해시 앞 8바이트, 둘 다 없으면 updatedAt 밀리초
+  static int placeholderContentVersion(Map<String, dynamic> metadata) {
+    final version = metadata['version'];
+    if (version is int) return version;
+
+    final hash = metadata['fileTreeHash'] ?? metadata['fileHash'];
+    if (hash is String) {
+      final hex = isTreeHash(hash) ? hash.substring(treeHashPrefix.length) : hash;
+      if (hex.length >= 16 && RegExp(r'^[0-9a-fA-F]+$').hasMatch(hex)) {
+        // 리틀 엔디언으로 기록되므로 앞 바이트를 하위 바이트로
+        var value = 0;
+        for (var i = 7; i >= 0; i--) {
+          value = (value << 8) | int.parse(hex.substring(i * 2, i * 2 + 2), radix: 16);
+        }
+        return value;
+      }
+    }
+
+    final updatedAt = metadata['updatedAt'];
+    if (updatedAt is DateTime) return updatedAt.millisecondsSinceEpoch;
+    if (updatedAt is String) {
+      return DateTime.tryParse(updatedAt)?.millisecondsSinceEpoch ?? 0;
+    }
+    return 0;
+  }
+
+  /// 파일 해시 계산 (SHA-256 트리 해시)
+  /// 4MB 블록마다 SHA-256을 구하고 블록 해시를 이어 붙인 값의 SHA-256을 사용해 블록을 나눠 병렬로 계산할 수 있음
+  /// Windows에서는 네이티브 provider가 여러 스레드로 계산하고, 그 외에는 스트림으로 읽어 파일 전체를 메모리에 올리지 않음
+  /// [publishManifest]면 같은 블록 해시를 provider 검증 매니페스트로 저장 (네이티브에서만)
+  /// 결과는 Firestore의 fileTreeHash 값 (fileHash는 이전 클라이언트를 위해 calculateLegacyFileHash로 계속 저장)
+  static Future<String> calculateFileHash(File file, {bool publishManifest = false}) async {
+    if (!await file.exists()) {
+      throw Exception('파일이 존재하지 않습니다: ${file.path}');
+    }
+
+    // 함수 주소만 넘겨 새 isolate가 DLL을 다시 찾지 않게 함 (isolate 생성 비용은 수백 μs로 해시 시간에 비해 작음)
+    final path = file.path;
+    final functions = NativeFileHasher.instance.functions;
+    if (functions != null) {
+      final root = await Isolate.run(() => NativeFileHasher.hashFileTree(functions, path,
+          publishManifest: publishManifest));
+      if (root != null) return '$treeHashPrefix$root';
+    }
+    return '$treeHashPrefix${await _streamTreeHash(file)}';
+  }
+
+  /// 파일의 블록 매니페스트만 저장 (네이티브 provider가 없으면 아무것도 하지 않고 false)
+  static Future<bool> publishBlockManifest(File file) async {
+    final functions = NativeFileHasher.instance.functions;
+    if (functions == null) return false;
+    final path = file.path;
+    final root = await Isolate.run(() => NativeFileHasher.hashFileTree(functions, path,
+        publishManifest: true));
+    return root != null;
+  }
+
+  /// 파일 전체의 SHA-256 (Firestore fileHash, 트리 해시를 모르는 클라이언트와 비교할 때)
+  static Future<String> calculateLegacyFileHash(File file) async {
     if (!await file.exists()) {
       throw Exception('파일이 존재하지 않습니다: ${file.path}');
     }
 
-    final bytes = await file.readAsBytes();
-    final digest = sha256.convert(bytes);
+    final path = file.path;
+    final functions = NativeFileHasher.instance.functions;
+    if (functions != null) {
+      final digest = await Isolate.run(() => NativeFileHasher.hashFileSha256(functions, path));
+      if (digest != null) return digest;
+    }
+    final digest = await sha256.bind(file.openRead()).first;
     return digest.toString();
   }
 
+  /// 저장된 해시와 같은 형식으로 파일 해시 계산
+  static Future<String> calculateMatchingFileHash(File file, String storedHash) {
+    return isTreeHash(storedHash)
+        ? calculateFileHash(file)
+        : calculateLegacyFileHash(file);
+  }
+
+  /// 스트림으로 읽으며 블록 해시를 누적해 트리 해시 루트 계산
+  static Future<String> _streamTreeHash(File file) async {
+    final leaves = BytesBuilder(copy: false);
+    var digestSink = _DigestSink();
+    var blockInput = sha256.startChunkedConversion(digestSink);
+    var filled = 0;
+
+    await for (final chunk in file.openRead()) {
+      final bytes = chunk is Uint8List ? chunk : Uint8List.fromList(chunk);
+      var offset = 0;
+      while (offset < bytes.length) {
+        final take = min(hashBlockSize - filled, bytes.length - offset);
+        blockInput.add(Uint8List.sublistView(bytes, offset, offset + take));
+        offset += take;
+        filled += take;
+
+        if (filled == hashBlockSize) {
+          blockInput.close();
+          leaves.add(digestSink.value!.bytes);
+          digestSink = _DigestSink();
+          blockInput = sha256.startChunkedConversion(digestSink);
+          filled = 0;
+        }
+      }
+    }
+    if (filled > 0) {
+      blockInput.close();
+      leaves.add(digestSink.value!.bytes);
+    }
+
+    return sha256.convert(leaves.takeBytes()).toString();
+  }
+
   /// 파일 크기를 읽기 쉬운 형식으로 변환
   static String formatFileSize(int bytes) {
     if (bytes < 1024) return '$bytes B';
@@ -315,6 +456,19 @@ class FileUtils {
   }
 }
 
+/// 블록 하나의 SHA-256 결과를 받는 싱크
+class _DigestSink implements Sink<Digest> {
+  Digest? value;
+
+  @override
+  void add(Digest data) {
+    value = data;
+  }
+
+  @override
+  void close() {}
+}
+
 /// 파일 권한 정보
 class FilePermissions {
   final bool exists;
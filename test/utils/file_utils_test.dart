@@ -0,0 +1,98 @@
+/// FileUtils 트리 해시 테스트
+/// 기대값은 네이티브 FileHasherTests.cpp와 같은 벡터라 Dart 스트림 구현과 네이티브 구현이 같은 해시를 내는지 확인됨
+/// (Windows에서 provider DLL이 로드되면 네이티브 경로를 그대로 검사)
+
+import 'dart:io';
+import 'dart:typed_data';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:mainbooth_drive/utils/file_utils.dart';
+
+const int _vectorLength = 2 * 4 * 1024 * 1024 + 12345;
+const String _vectorTreeRoot =
+    '1e4187d74c09ac5ecba418360e3aff8c86fed9e00ece62a4b8383a72b85f2cee';
+const String _vectorSha256 =
+    '2e95664474287447c6912034943e1fd218a31c3531caa5c25fec3428a519d8a7';
+const String _emptySha256 =
+    'e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855';
+
+void main() {
+  late Directory root;
+
+  setUp(() async {
+    root = await Directory.systemTemp.createTemp('file_utils_test');
+  });
+
+  tearDown(() async {
+    await root.delete(recursive: true);
+  });
+
+  Future<File> writeVector(String name, int length) async {
+    final bytes = Uint8List(length);
+    for (var i = 0; i < length; i++) {
+      bytes[i] = i % 251;
+    }
+    final file = File('${root.path}${Platform.pathSeparator}$name');
+    await file.writeAsBytes(bytes);
+    return file;
+  }
+
+  test('트리 해시가 네이티브와 같은 벡터 값을 냄', () async {
+    final file = await writeVector('vector.bin', _vectorLength);
+    expect(await FileUtils.calculateFileHash(file),
+        '${FileUtils.treeHashPrefix}$_vectorTreeRoot');
+    expect(await FileUtils.calculateLegacyFileHash(file), _vectorSha256);
+  });
+
+  test('빈 파일의 트리 해시는 빈 입력의 SHA-256', () async {
+    final file = await writeVector('empty.bin', 0);
+    expect(await FileUtils.calculateFileHash(file),
+        '${FileUtils.treeHashPrefix}$_emptySha256');
+  });
+
+  test('저장된 해시 형식에 맞춰 계산', () async {
+    final file = await writeVector('vector.bin', _vectorLength);
+    expect(await FileUtils.calculateMatchingFileHash(file, _vectorSha256),
+        _vectorSha256);
+    expect(
+        await FileUtils.calculateMatchingFileHash(
+            file, '${FileUtils.treeHashPrefix}0000'),
+        '${FileUtils.treeHashPrefix}$_vectorTreeRoot');
+  });
+
+  test('매니페스트 ID는 트리 루트 앞 16바이트', () {
+    final id = FileUtils.manifestIdFromHash(
+        '${FileUtils.treeHashPrefix}$_vectorTreeRoot')!;
+    expect(id.length, 16);
+    expect(id.first, 0x1e);
+    expect(id.last, 0x8c);
+    expect(FileUtils.manifestIdFromHash(_vectorSha256), isNull);
+  });
+
+  test('플레이스홀더 객체 ID는 네이티브 FromPath와 같은 정규화 경로 해시', () {
+    // PlaceholderIdentityTests.cpp와 같은 기대값
+    String hex(List<int> bytes) =>
+        bytes.map((b) => b.toRadixString(16).padLeft(2, '0')).join();
+    expect(hex(FileUtils.placeholderObjectId('Tracks\\a.wav')),
+        'ddd35775b1328540275486a043ef5917');
+    expect(hex(FileUtils.placeholderObjectId('/tracks/A.WAV')),
+        'ddd35775b1328540275486a043ef5917');
+    expect(hex(FileUtils.placeholderObjectId('Tracks\\b.wav')),
+        isNot('ddd35775b1328540275486a043ef5917'));
+  });
+
+  test('콘텐츠 버전은 version, 파일 해시, updatedAt 순으로 결정', () {
+    expect(FileUtils.placeholderContentVersion({'version': 7}), 7);
+    // 트리 루트 앞 8바이트를 리틀 엔디언으로 읽은 값
+    expect(
+        FileUtils.placeholderContentVersion(
+            {'fileTreeHash': '${FileUtils.treeHashPrefix}$_vectorTreeRoot'}),
+        6821837761197588766);
+    expect(FileUtils.placeholderContentVersion({'fileHash': _vectorSha256}),
+        isNot(0));
+    expect(
+        FileUtils.placeholderContentVersion(
+            {'updatedAt': '2024-01-02T03:04:05.000Z'}),
+        DateTime.utc(2024, 1, 2, 3, 4, 5).millisecondsSinceEpoch);
+    expect(FileUtils.placeholderContentVersion({}), 0);
+  });
+}